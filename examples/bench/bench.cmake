@@ -0,0 +1,18 @@
+include_directories("${CMAKE_SOURCE_DIR}/bench/")
+
+# decide which benchmark to compile
+option(BENCH_PASCINFERENCE "BENCH_PASCINFERENCE" OFF)
+
+# print info
+print("Benchmarks")
+printinfo_onoff(" BENCH_PASCINFERENCE                                                                  " "${BENCH_PASCINFERENCE}")
+
+if(${BENCH_PASCINFERENCE})
+	if(NOT ${USE_PETSC})
+		message(FATAL_ERROR "${Red}BENCH_PASCINFERENCE requires USE_PETSC=ON!${ColourReset}")
+	endif()
+
+	# kernels and whole solver on synthetic signal
+	testadd_executable("bench/bench_pascinference.cpp" "bench_pascinference")
+endif()
+
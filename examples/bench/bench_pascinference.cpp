@@ -0,0 +1,505 @@
+/** @file bench_pascinference.cpp
+ *  @brief benchmark of computational kernels and of the whole time-series solver
+ *
+ *  Synthetic k-means signal (the same as in test_signal1D_generate) on 1D/2D grid graph is solved for all combinations of given T and K.
+ *  SPG-QP and FISTA-QP solvers are compared on the gamma problem.
+ *  Results are stored into CSV file, which can be compared with the results of previous version of the library.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "pascinference.h"
+
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#ifndef USE_PETSC
+ #error 'This example is for PETSC'
+#endif
+
+#define DEFAULT_WIDTH 1
+#define DEFAULT_HEIGHT 1
+#define DEFAULT_TPERIOD 100
+#define DEFAULT_NOISE 0.1
+#define DEFAULT_EPSSQR 10
+#define DEFAULT_FEM_REDUCE 1.0
+#define DEFAULT_REPEAT 10
+#define DEFAULT_WEAK false
+#define DEFAULT_SOLVE true
+#define DEFAULT_QP true
+#define DEFAULT_APPEND false
+#define DEFAULT_OUTPUT "results/bench.csv"
+
+using namespace pascinference;
+
+/* the same clusters as in test_signal1D_generate */
+int bench_get_cluster_id(int t, int Tperiod){
+	int tperiod = t - (int)(t/(double)Tperiod)*Tperiod;
+	double step = Tperiod/11.0;
+	int cluster_id=0;
+	if( ( (tperiod >= 1*step) && (tperiod < 3*step) ) || ( (tperiod >= 4*step) && (tperiod < 5*step) ) || ( (tperiod >= 8*step) && (tperiod < 9*step) ) ) {
+		cluster_id = 1;
+	}
+	if( ( (tperiod >= 3*step) && (tperiod < 4*step) ) || ( (tperiod >= 7*step) && (tperiod < 8*step) ) || (tperiod >= 9*step) ) {
+		cluster_id = 2;
+	}
+	return cluster_id;
+}
+
+/* pseudo-random number from [-0.5,0.5] given by global index, independent on number of processes */
+double bench_get_noise(int idx){
+	unsigned int x = (unsigned int)idx*2654435761u + 12345u;
+	x ^= x >> 16;
+	x *= 0x45d9f3bu;
+	x ^= x >> 16;
+	return x/4294967296.0 - 0.5;
+}
+
+/* one row of results */
+struct BenchRecord {
+	std::string name;
+	int nproc;
+	int T;
+	int R;
+	int K;
+	double time_min;
+	double time_avg;
+	double bandwidth;
+	int it;
+};
+
+/* compute statistics of measured times, the slowest process is taken */
+BenchRecord bench_record(std::string name, int T, int R, int K, std::vector<double> &times, double bytes, int it){
+	BenchRecord record;
+	record.name = name;
+	record.nproc = GlobalManager.get_size();
+	record.T = T;
+	record.R = R;
+	record.K = K;
+	record.it = it;
+
+	std::vector<double> times_max(times.size());
+	MPI_Allreduce(&times[0], &times_max[0], times.size(), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+	record.time_min = std::numeric_limits<double>::max();
+	record.time_avg = 0.0;
+	for(size_t i=0; i < times_max.size(); i++){
+		record.time_min = std::min(record.time_min, times_max[i]);
+		record.time_avg += times_max[i]/(double)times_max.size();
+	}
+	record.bandwidth = (record.time_min > 0)? bytes/record.time_min*1e-9 : 0.0;
+
+	coutMaster << " " << std::setw(18) << std::left << name << std::right;
+	coutMaster << " t_min = " << std::setw(12) << record.time_min;
+	coutMaster << ", t_avg = " << std::setw(12) << record.time_avg;
+	coutMaster << ", GB/s = " << std::setw(10) << record.bandwidth;
+	coutMaster << ", it = " << it << std::endl;
+
+	return record;
+}
+
+/* read CSV file with results, key is composed from benchmark name and size of problem */
+bool bench_load(std::string filename, std::map<std::string, BenchRecord> &records){
+	std::ifstream file(filename.c_str());
+	if(!file.is_open()){
+		coutMaster << "ERROR: file " << filename << " cannot be opened" << std::endl;
+		return false;
+	}
+
+	std::string line;
+	std::getline(file, line); /* header */
+	while(std::getline(file, line)){
+		if(line.empty()) continue;
+
+		std::replace(line.begin(), line.end(), ',', ' ');
+		std::istringstream iss(line);
+
+		BenchRecord record;
+		iss >> record.name >> record.nproc >> record.T >> record.R >> record.K >> record.time_min >> record.time_avg >> record.bandwidth >> record.it;
+
+		std::ostringstream key;
+		key << record.name << " nproc=" << record.nproc << " T=" << record.T << " R=" << record.R << " K=" << record.K;
+		records[key.str()] = record;
+	}
+	file.close();
+
+	return true;
+}
+
+/* print the comparison of two result files */
+void bench_compare(std::string filename_old, std::string filename_new){
+	std::map<std::string, BenchRecord> records_old;
+	std::map<std::string, BenchRecord> records_new;
+	if(!bench_load(filename_old, records_old) || !bench_load(filename_new, records_new)){
+		return;
+	}
+
+	coutMaster << "--- COMPARISON ---" << std::endl;
+	coutMaster << " old: " << filename_old << std::endl;
+	coutMaster << " new: " << filename_new << std::endl;
+	coutMaster << " (speedup = t_old/t_new, values > 1 mean that the new version is faster)" << std::endl;
+
+	for(std::map<std::string, BenchRecord>::iterator it = records_new.begin(); it != records_new.end(); ++it){
+		std::map<std::string, BenchRecord>::iterator it_old = records_old.find(it->first);
+		coutMaster << " " << std::setw(50) << std::left << it->first << std::right;
+		if(it_old == records_old.end()){
+			coutMaster << " not in old results" << std::endl;
+			continue;
+		}
+		double speedup = it_old->second.time_min/it->second.time_min;
+		coutMaster << " t_old = " << std::setw(12) << it_old->second.time_min;
+		coutMaster << ", t_new = " << std::setw(12) << it->second.time_min;
+		coutMaster << ", speedup = " << std::setw(8) << speedup;
+		if(it_old->second.it != it->second.it){
+			coutMaster << ", it: " << it_old->second.it << " -> " << it->second.it;
+		}
+		coutMaster << std::endl;
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("BENCHMARK", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("bench_T", boost::program_options::value<std::vector<int> >()->multitoken(), "lengths of time-series (per process for weak scaling) [int]")
+		("bench_K", boost::program_options::value<std::vector<int> >()->multitoken(), "numbers of clusters [int]")
+		("bench_width", boost::program_options::value<int>(), "width of grid graph, R = width*height [int]")
+		("bench_height", boost::program_options::value<int>(), "height of grid graph, 2D grid if larger than 1 [int]")
+		("bench_Tperiod", boost::program_options::value<int>(), "length of one period of synthetic signal [int]")
+		("bench_noise", boost::program_options::value<double>(), "parameter of noise [double]")
+		("bench_epssqr", boost::program_options::value<double>(), "penalty parameter [double]")
+		("bench_fem_reduce", boost::program_options::value<double>(), "parameter of the reduction of FEM nodes, FemHat is used [double]")
+		("bench_repeat", boost::program_options::value<int>(), "number of repetitions of each kernel [int]")
+		("bench_weak", boost::program_options::value<bool>(), "weak scaling, T is multiplied by the number of processes [bool]")
+		("bench_solve", boost::program_options::value<bool>(), "benchmark also the whole TSSolver [bool]")
+		("bench_qp", boost::program_options::value<bool>(), "compare SPG-QP and FISTA-QP solvers on the gamma problem [bool]")
+		("bench_output", boost::program_options::value<std::string>(), "name of output CSV file [string]")
+		("bench_append", boost::program_options::value<bool>(), "append results to existing output file, useful for scaling runs [bool]")
+		("bench_compare_old", boost::program_options::value<std::string>(), "compare results: old CSV file [string]")
+		("bench_compare_new", boost::program_options::value<std::string>(), "compare results: new CSV file [string]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	/* comparison mode, nothing is computed */
+	std::string filename_old, filename_new;
+	if(consoleArg.set_option_value("bench_compare_old", &filename_old) && consoleArg.set_option_value("bench_compare_new", &filename_new)){
+		bench_compare(filename_old, filename_new);
+		Finalize<PetscVector>();
+		return 0;
+	}
+
+	std::vector<int> T_list;
+	std::vector<int> K_list;
+	if(!consoleArg.set_option_value("bench_T", &T_list)){
+		T_list.push_back(10000);
+	}
+	if(!consoleArg.set_option_value("bench_K", &K_list)){
+		K_list.push_back(3);
+	}
+
+	int width, height, Tperiod, repeat;
+	double noise, epssqr, fem_reduce;
+	bool weak, solve, qp, append;
+	std::string output_filename;
+
+	consoleArg.set_option_value("bench_width", &width, DEFAULT_WIDTH);
+	consoleArg.set_option_value("bench_height", &height, DEFAULT_HEIGHT);
+	consoleArg.set_option_value("bench_Tperiod", &Tperiod, DEFAULT_TPERIOD);
+	consoleArg.set_option_value("bench_noise", &noise, DEFAULT_NOISE);
+	consoleArg.set_option_value("bench_epssqr", &epssqr, DEFAULT_EPSSQR);
+	consoleArg.set_option_value("bench_fem_reduce", &fem_reduce, DEFAULT_FEM_REDUCE);
+	consoleArg.set_option_value("bench_repeat", &repeat, DEFAULT_REPEAT);
+	consoleArg.set_option_value("bench_weak", &weak, DEFAULT_WEAK);
+	consoleArg.set_option_value("bench_solve", &solve, DEFAULT_SOLVE);
+	consoleArg.set_option_value("bench_qp", &qp, DEFAULT_QP);
+	consoleArg.set_option_value("bench_output", &output_filename, DEFAULT_OUTPUT);
+	consoleArg.set_option_value("bench_append", &append, DEFAULT_APPEND);
+
+	if(repeat < 1){
+		coutMaster << "bench_repeat has to be positive! Call application with parameter -h to see all parameters" << std::endl;
+		Finalize<PetscVector>();
+		return 0;
+	}
+
+	int nproc = GlobalManager.get_size();
+	int R = width*height;
+
+	coutMaster << "- BENCHMARK INFO ----------------------------" << std::endl;
+	coutMaster << " nproc                       = " << std::setw(30) << nproc << " (number of processes, DDT)" << std::endl;
+	coutMaster << " bench_T                     = " << std::setw(30) << print_vector(T_list) << " (lengths of time-series)" << std::endl;
+	coutMaster << " bench_K                     = " << std::setw(30) << print_vector(K_list) << " (numbers of clusters)" << std::endl;
+	coutMaster << " bench_width                 = " << std::setw(30) << width << " (width of grid graph)" << std::endl;
+	coutMaster << " bench_height                = " << std::setw(30) << height << " (height of grid graph)" << std::endl;
+	coutMaster << " bench_Tperiod               = " << std::setw(30) << Tperiod << " (length of one period of signal)" << std::endl;
+	coutMaster << " bench_noise                 = " << std::setw(30) << noise << " (parameter of noise)" << std::endl;
+	coutMaster << " bench_epssqr                = " << std::setw(30) << epssqr << " (penalty parameter)" << std::endl;
+	coutMaster << " bench_fem_reduce            = " << std::setw(30) << fem_reduce << " (parameter of FEM reduction)" << std::endl;
+	coutMaster << " bench_repeat                = " << std::setw(30) << repeat << " (number of repetitions)" << std::endl;
+	coutMaster << " bench_weak                  = " << std::setw(30) << printbool(weak) << " (weak scaling)" << std::endl;
+	coutMaster << " bench_solve                 = " << std::setw(30) << printbool(solve) << " (benchmark the whole TSSolver)" << std::endl;
+	coutMaster << " bench_qp                    = " << std::setw(30) << printbool(qp) << " (compare SPG-QP and FISTA-QP)" << std::endl;
+	coutMaster << " bench_output                = " << std::setw(30) << output_filename << " (output CSV file)" << std::endl;
+	coutMaster << " bench_append                = " << std::setw(30) << printbool(append) << " (append to output file)" << std::endl;
+	coutMaster << "-------------------------------------------" << std::endl;
+
+	/* prepare graph */
+	BGMGraphGrid1D<PetscVector> *graph1D = NULL;
+	BGMGraphGrid2D<PetscVector> *graph2D = NULL;
+	BGMGraph<PetscVector> *graph;
+	if(height > 1){
+		graph2D = new BGMGraphGrid2D<PetscVector>(width, height);
+		graph2D->process_grid();
+		graph = graph2D;
+	} else {
+		graph1D = new BGMGraphGrid1D<PetscVector>(width);
+		graph1D->process_grid();
+		graph = graph1D;
+	}
+
+	std::vector<BenchRecord> records;
+	std::vector<double> times(repeat);
+	Timer timer;
+
+	for(size_t iT=0; iT < T_list.size(); iT++){
+	for(size_t iK=0; iK < K_list.size(); iK++){
+		int T = (weak)? T_list[iT]*nproc : T_list[iT];
+		int K = K_list[iK];
+		int xdim = 1;
+
+		coutMaster << "--- T = " << T << ", R = " << R << ", K = " << K << " ---" << std::endl;
+
+		/* prepare decomposition in time */
+		Decomposition<PetscVector> decomposition(T, *graph, K, xdim, nproc, 1);
+
+		/* synthetic data in original layout, independent on the number of processes */
+		TSData<PetscVector> mydata(decomposition);
+		Vec data_orig_Vec;
+		decomposition.createGlobalVec_data(&data_orig_Vec);
+		int low, high;
+		double *arr;
+		double mu[3] = {0.0,1.0,2.0};
+		TRYCXX( VecGetOwnershipRange(data_orig_Vec, &low, &high) );
+		TRYCXX( VecGetArray(data_orig_Vec, &arr) );
+		for(int i=low; i < high; i++){
+			arr[i-low] = mu[bench_get_cluster_id(i/(R*xdim), Tperiod)] + noise*bench_get_noise(i);
+		}
+		TRYCXX( VecRestoreArray(data_orig_Vec, &arr) );
+		decomposition.permute_TRxdim(data_orig_Vec, mydata.get_datavector()->get_vector(), false);
+		TRYCXX( VecDestroy(&data_orig_Vec) );
+
+		/* model and solver, fem has to live longer than both of them */
+		FemHat<PetscVector> fem(fem_reduce);
+		GraphH1FEMModel<PetscVector> mymodel(mydata, epssqr, &fem);
+		TSSolver<PetscVector> mysolver(mydata, 1);
+
+		/* deterministic initial gamma */
+		Vec gamma_orig_Vec;
+		decomposition.createGlobalVec_gamma(&gamma_orig_Vec);
+		TRYCXX( VecGetOwnershipRange(gamma_orig_Vec, &low, &high) );
+		TRYCXX( VecGetArray(gamma_orig_Vec, &arr) );
+		for(int i=low; i < high; i++){
+			arr[i-low] = bench_get_noise(i) + 0.5;
+		}
+		TRYCXX( VecRestoreArray(gamma_orig_Vec, &arr) );
+		decomposition.permute_TRK(gamma_orig_Vec, mydata.get_gammavector()->get_vector(), false);
+
+		GeneralSolver *gammasolver = mysolver.get_gammasolver();
+		GeneralSolver *thetasolver = mysolver.get_thetasolver();
+		QPData<PetscVector> *gammadata = mymodel.get_gammadata();
+		GeneralVector<PetscVector> *x = gammadata->get_x();
+		GeneralVector<PetscVector> *y = new GeneralVector<PetscVector>(*x);
+		GeneralVector<PetscVector> *z = new GeneralVector<PetscVector>(*x);
+		Vec x_Vec = x->get_vector();
+		Vec y_Vec = y->get_vector();
+		Vec z_Vec = z->get_vector();
+
+		int n, n_gamma;
+		TRYCXX( VecGetSize(x_Vec, &n) ); /* the size of (reduced) gamma problem */
+		TRYCXX( VecGetSize(mydata.get_gammavector()->get_vector(), &n_gamma) );
+		double vecsize = n*sizeof(double);
+
+		/* theta update: residuum, theta problem */
+		for(int i=0; i < repeat; i++){
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 mymodel.updatebeforesolve_thetasolver(thetasolver);
+			 thetasolver->solve();
+			 mymodel.updateaftersolve_thetasolver(thetasolver);
+			timer.stop();
+			times[i] = timer.get_value_last();
+		}
+		records.push_back(bench_record("theta_update", T, R, K, times, ((double)T*R*xdim + n_gamma)*sizeof(double), 1));
+
+		/* gamma update: residuum, linear term, reduction */
+		for(int i=0; i < repeat; i++){
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 mymodel.updatebeforesolve_gammasolver(gammasolver);
+			timer.stop();
+			times[i] = timer.get_value_last();
+		}
+		records.push_back(bench_record("gamma_update", T, R, K, times, ((double)T*R*xdim + 2*n_gamma)*sizeof(double), 1));
+
+		/* QP solvers on the same gamma problem from the same initial approximation */
+		if(qp){
+			Vec x_init_Vec;
+			TRYCXX( VecDuplicate(x_Vec, &x_init_Vec) );
+			TRYCXX( VecCopy(x_Vec, x_init_Vec) );
+
+			std::vector<double> times_qp(1);
+
+			SPGQPSolver<PetscVector> spgqpsolver(*gammadata);
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 spgqpsolver.solve();
+			timer.stop();
+			times_qp[0] = timer.get_value_last();
+			records.push_back(bench_record("qp_spg", T, R, K, times_qp, 0.0, spgqpsolver.get_it()));
+			coutMaster << " - qp_spg:   it = " << std::setw(6) << spgqpsolver.get_it() << ", hessmult = " << std::setw(6) << spgqpsolver.get_hessmult() << ", fx = " << std::setprecision(17) << spgqpsolver.get_fx() << std::setprecision(6) << std::endl;
+
+			TRYCXX( VecCopy(x_init_Vec, x_Vec) );
+
+			FISTAQPSolver<PetscVector> fistaqpsolver(*gammadata);
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 fistaqpsolver.solve();
+			timer.stop();
+			times_qp[0] = timer.get_value_last();
+			records.push_back(bench_record("qp_fista", T, R, K, times_qp, 0.0, fistaqpsolver.get_it()));
+			coutMaster << " - qp_fista: it = " << std::setw(6) << fistaqpsolver.get_it() << ", hessmult = " << std::setw(6) << fistaqpsolver.get_hessmult() << ", fx = " << std::setprecision(17) << fistaqpsolver.get_fx() << std::setprecision(6) << std::endl;
+
+			TRYCXX( VecCopy(x_init_Vec, x_Vec) );
+			TRYCXX( VecDestroy(&x_init_Vec) );
+		}
+
+		/* projection onto feasible set */
+		for(int i=0; i < repeat; i++){
+			TRYCXX( VecCopy(x_Vec, y_Vec) );
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 gammadata->get_feasibleset()->project(*y);
+			timer.stop();
+			times[i] = timer.get_value_last();
+		}
+		records.push_back(bench_record("projection", T, R, K, times, 2*vecsize, 1));
+
+		/* multiplication by Hessian matrix */
+		for(int i=0; i < repeat; i++){
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 gammadata->get_A()->matmult(*y, *x);
+			timer.stop();
+			times[i] = timer.get_value_last();
+		}
+		records.push_back(bench_record("matmult", T, R, K, times, 2*vecsize, 1));
+
+		/* dot product */
+		double dot_value;
+		for(int i=0; i < repeat; i++){
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 TRYCXX( VecDot(x_Vec, y_Vec, &dot_value) );
+			timer.stop();
+			times[i] = timer.get_value_last();
+		}
+		records.push_back(bench_record("dot", T, R, K, times, 2*vecsize, 1));
+
+		/* three dot products with one vector as in SPG */
+		Vec mdot_Vecs[3] = {x_Vec, y_Vec, z_Vec};
+		double mdot_values[3];
+		for(int i=0; i < repeat; i++){
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 TRYCXX( VecMDot(x_Vec, 3, mdot_Vecs, mdot_values) );
+			timer.stop();
+			times[i] = timer.get_value_last();
+		}
+		records.push_back(bench_record("mdot3", T, R, K, times, 3*vecsize, 1));
+
+		/* FEM reduction and prolongation */
+		if(fem.is_reduced()){
+			for(int i=0; i < repeat; i++){
+				MPI_Barrier(MPI_COMM_WORLD);
+				timer.restart();
+				timer.start();
+				 fem.reduce_gamma(mydata.get_gammavector(), x);
+				timer.stop();
+				times[i] = timer.get_value_last();
+			}
+			records.push_back(bench_record("fem_reduce", T, R, K, times, ((double)n_gamma + n)*sizeof(double), 1));
+
+			for(int i=0; i < repeat; i++){
+				MPI_Barrier(MPI_COMM_WORLD);
+				timer.restart();
+				timer.start();
+				 fem.prolongate_gamma(x, mydata.get_gammavector());
+				timer.stop();
+				times[i] = timer.get_value_last();
+			}
+			records.push_back(bench_record("fem_prolongate", T, R, K, times, ((double)n_gamma + n)*sizeof(double), 1));
+		}
+
+		/* the whole solver, always from the same initial approximation */
+		if(solve){
+			std::vector<double> times_solve(1);
+			decomposition.permute_TRK(gamma_orig_Vec, mydata.get_gammavector()->get_vector(), false);
+			mysolver.set_init_permute(false);
+
+			MPI_Barrier(MPI_COMM_WORLD);
+			timer.restart();
+			timer.start();
+			 mysolver.solve();
+			timer.stop();
+			times_solve[0] = timer.get_value_last();
+
+			records.push_back(bench_record("tssolver", T, R, K, times_solve, 0.0, mysolver.get_it()));
+		}
+
+		TRYCXX( VecDestroy(&gamma_orig_Vec) );
+		delete y;
+		delete z;
+	}
+	}
+
+	/* write results, master writes everything */
+	if(GlobalManager.get_rank() == 0){
+		bool write_header = true;
+		if(append){
+			std::ifstream test_file(output_filename.c_str());
+			write_header = !test_file.good() || test_file.peek() == std::ifstream::traits_type::eof();
+		}
+
+		std::ofstream output_file(output_filename.c_str(), (append)? std::ios::app : std::ios::trunc);
+		output_file << std::setprecision(10);
+		if(write_header){
+			output_file << "benchmark,nproc,T,R,K,time_min,time_avg,bandwidth_GBs,it" << std::endl;
+		}
+		for(size_t i=0; i < records.size(); i++){
+			output_file << records[i].name << "," << records[i].nproc << "," << records[i].T << "," << records[i].R << "," << records[i].K << ",";
+			output_file << records[i].time_min << "," << records[i].time_avg << "," << records[i].bandwidth << "," << records[i].it << std::endl;
+		}
+		output_file.close();
+	}
+	coutMaster << "- results written to " << output_filename << std::endl;
+
+	if(graph1D) delete graph1D;
+	if(graph2D) delete graph2D;
+
+	Finalize<PetscVector>();
+
+	return 0;
+}
@@ -14,6 +14,8 @@
 #include <sstream>
 #include <string>
 
+#include "lodplot.h"
+
 #define NUMBER_OF_LABELS 9
 
 using namespace dlib;
@@ -27,6 +29,14 @@ class eegimageplotter : public drawable {
 
 		void draw (const canvas& c) const;
 		void plot_image(const canvas& c) const;
+		void plot_pyramid(const canvas& c) const;
+
+		/* zoom of pyramid */
+		void on_wheel_up(unsigned long state);
+		void on_wheel_down(unsigned long state);
+
+		common::LODPyramid pyramid;		/* level-of-detail pyramid, used instead of Vec if available */
+		gui::lodview view;				/* visible time window of pyramid */
 
 		int image_width;
 		int image_height;
@@ -41,6 +51,9 @@ class eegimageplotter : public drawable {
 		void load_image( const std::string& file_name );
 		bool get_myvector_loaded();
 		Vec *get_myvector_Vec();
+		bool get_pyramid_loaded() const;
+		const common::LODPyramid &get_pyramid() const;
+		gui::lodview &get_view();
 		
 		void set_size(int new_width);
 		
@@ -245,14 +258,19 @@ void show_image_window::on_window_resized() {
 
 void show_image_window::on_timescroll() {
 
-	std::cout << "slider position: " << timescroll->slider_pos() << "/" << timescroll->max_slider_pos() << std::endl;
+	if(myeegimageplotter.get_pyramid_loaded()){
+		/* move visible window of pyramid */
+		myeegimageplotter.get_view().move_to(timescroll->slider_pos()/(double)timescroll->max_slider_pos());
+		myeegimageplotter.set_size(myeegimageplotter.get_width());
+	}
 
 }
 
 void show_image_window::load_image( const std::string& file_name ) {
 	myeegimageplotter.load_image(file_name);
+	timescroll->set_slider_pos(0);
 
-	if(myeegimageplotter.get_myvector_loaded()){
+	if(myeegimageplotter.get_myvector_loaded() || myeegimageplotter.get_pyramid_loaded()){
 		/* get recomputed height and set value */
 		select_width.set_text(std::to_string(myeegimageplotter.get_width()));
 		select_height.set_text(std::to_string(myeegimageplotter.get_height()));
@@ -267,6 +285,23 @@ void show_image_window::load_image( const std::string& file_name ) {
 
 void show_image_window::fill_labels() {
 
+	if(myeegimageplotter.get_pyramid_loaded()){
+		/* the vector is not loaded, the properties are taken from the coarsest level of pyramid */
+		const common::LODPyramid &pyramid = myeegimageplotter.get_pyramid();
+		common::LODPyramid::Record summary = gui::get_lod_summary(pyramid);
+
+		set_label_myvector_properties(0, "name:    ", cut_filename(myeegimageplotter.get_filename()));
+		set_label_myvector_properties(1, "size:    ", pyramid.get_T()*pyramid.get_C());
+		set_label_myvector_properties(2, "norm2:   ", "n/a");
+		set_label_myvector_properties(3, "norm1:   ", "n/a");
+		set_label_myvector_properties(4, "normInf: ", std::max(std::abs(summary.min),std::abs(summary.max)));
+		set_label_myvector_properties(5, "sum:     ", summary.mean*(double)(pyramid.get_T()*pyramid.get_C()));
+		set_label_myvector_properties(6, "max:     ", summary.max);
+		set_label_myvector_properties(7, "min:     ", summary.min);
+		set_label_myvector_properties(8, "mean:    ", summary.mean);
+		return;
+	}
+
 	Vec *myvector_Vec = myeegimageplotter.get_myvector_Vec();
 
 	/* compute basic properties of loaded vector */
@@ -325,7 +360,7 @@ void show_image_window::on_button_apply_size(){
 	select_height.set_text(std::to_string(myeegimageplotter.get_height()));
 	select_scale.set_text(std::to_string(myeegimageplotter.get_scale()));
 
-	if(myeegimageplotter.get_myvector_loaded()){
+	if(myeegimageplotter.get_myvector_loaded() || myeegimageplotter.get_pyramid_loaded()){
 		fill_labels();
 	}
 
@@ -338,7 +373,9 @@ void eegimageplotter::draw(const canvas& c) const {
 	fill_rect(c,rect,rgb_pixel(255,255,255));
 	
 	/* plot vector */
-	if(myvector_loaded){
+	if(pyramid.is_open()){
+		plot_pyramid(c);
+	} else if(myvector_loaded){
 		plot_image(c);
 	}
 
@@ -373,6 +410,16 @@ void eegimageplotter::set_plotting_area(rectangle area){
 void eegimageplotter::load_image( const std::string& file_name ) {
 	this->filename = file_name;
 
+	/* if there is a pyramid of the vector, then the vector is not loaded at all,
+	 * the image has one row per channel and its width is the length of visible time window */
+	pyramid.close();
+	if(boost::filesystem::exists(common::LODPyramid::get_filename(file_name))
+		&& pyramid.open(common::LODPyramid::get_filename(file_name), file_name)){
+		view.reset(pyramid.get_T());
+		set_size(view.get_length());
+		return;
+	}
+
 	if(myvector_loaded){
 		/* destroy existing vector */
 		TRYCXX( VecDestroy(myvector_Vec) );
@@ -419,6 +466,67 @@ bool eegimageplotter::get_myvector_loaded(){
 	return myvector_loaded;
 }
 
+bool eegimageplotter::get_pyramid_loaded() const {
+	return pyramid.is_open();
+}
+
+const common::LODPyramid &eegimageplotter::get_pyramid() const {
+	return pyramid;
+}
+
+gui::lodview &eegimageplotter::get_view() {
+	return view;
+}
+
+void eegimageplotter::plot_pyramid(const canvas& c) const{
+	unsigned long x_size = this->width();
+	unsigned long y_size = this->height();
+	if(x_size < 1 || view.get_length() < 2) return;
+
+	/* one column of pixels for one record, the level is chosen to have approximately one record per column */
+	int level = pyramid.get_level((double)view.get_length()/(double)x_size);
+	int64_t decimation = pyramid.get_decimation(level);
+	int64_t rec_begin = view.get_begin()/decimation;
+	int64_t rec_end = (view.get_begin() + view.get_length() + decimation - 1)/decimation;
+	double pixel_size_x = x_size/(double)(rec_end - rec_begin);
+	double pixel_size_y = y_size/(double)pyramid.get_C();
+
+	/* the means are mapped to gray scale using the range of whole vector */
+	common::LODPyramid::Record summary = gui::get_lod_summary(pyramid);
+	double scale = (summary.max > summary.min) ? 255.0/(summary.max - summary.min) : 0.0;
+
+	rectangle rect_pixel;
+	std::vector<common::LODPyramid::Record> records;
+	for(int ch=0;ch<pyramid.get_C();ch++){
+		pyramid.get_records(level, ch, rec_begin, rec_end, records);
+
+		for(size_t i=0;i<records.size();i++){
+			unsigned char value = (unsigned char)(scale*(records[i].mean - summary.min));
+
+			rect_pixel.set_left(this->left() + i*pixel_size_x);
+			rect_pixel.set_top(this->top() + ch*pixel_size_y);
+			rect_pixel.set_right(this->left() + (i+1)*pixel_size_x);
+			rect_pixel.set_bottom(this->top() + (ch+1)*pixel_size_y);
+
+			fill_rect(c,rect_pixel,rgb_pixel(value,value,value));
+		}
+	}
+}
+
+void eegimageplotter::on_wheel_up(unsigned long state){
+	if(pyramid.is_open() && rect.contains(lastx,lasty)){
+		view.zoom(1.0/LODPLOT_ZOOM, (lastx - rect.left())/(double)rect.width());
+		set_size(view.get_length());
+	}
+}
+
+void eegimageplotter::on_wheel_down(unsigned long state){
+	if(pyramid.is_open() && rect.contains(lastx,lasty)){
+		view.zoom(LODPLOT_ZOOM, (lastx - rect.left())/(double)rect.width());
+		set_size(view.get_length());
+	}
+}
+
 void eegimageplotter::plot_image(const canvas& c) const{
 	unsigned long x_begin = this->left();
 	unsigned long y_begin = this->top();
@@ -469,6 +577,14 @@ void eegimageplotter::plot_image(const canvas& c) const{
 }
 
 void eegimageplotter::set_size(int new_width){
+	if(pyramid.is_open()){
+		/* the size of image is given by visible time window and number of channels */
+		this->image_width = view.get_length();
+		this->image_height = pyramid.get_C();
+		parent.invalidate_rectangle(rect);
+		return;
+	}
+
 	this->image_width = new_width;
 
 	/* compute height */
@@ -503,7 +619,7 @@ std::string eegimageplotter::get_filename() const{
 }
 
 void eegimageplotter::recompute_scale() {
-	if(!myvector_loaded){
+	if(!myvector_loaded || pyramid.is_open()){
 		image_scale = 1.0;
 	} else {
 		unsigned long x_size = this->width();
@@ -14,6 +14,8 @@
 #include <sstream>
 #include <string>
 
+#include "lodplot.h"
+
 #define NUMBER_OF_LABELS 11
 
 using namespace dlib;
@@ -28,8 +30,19 @@ class gammaplotter : public drawable {
 		std::string filename;
 		int myvector_size;
 
+		common::LODPyramid pyramid;		/* level-of-detail pyramid, used instead of Vec if available */
+		gui::lodview view;				/* visible window of pyramid */
+		long drag_x;					/* last position of mouse during panning */
+
 		void draw (const canvas& c) const;
 		void plot_vector(const canvas& c) const;
+		void plot_pyramid(const canvas& c) const;
+
+		/* zoom and pan of pyramid */
+		void on_wheel_up(unsigned long state);
+		void on_wheel_down(unsigned long state);
+		void on_mouse_down(unsigned long btn, unsigned long state, long x, long y, bool is_double_click);
+		void on_mouse_move(unsigned long state, long x, long y);
 
 	public: 
 		gammaplotter(drawable_window& w);
@@ -39,6 +52,8 @@ class gammaplotter : public drawable {
 		void load_vector( const std::string& file_name );
 		bool get_myvector_loaded();
 		Vec *get_myvector_Vec();
+		bool get_pyramid_loaded() const;
+		const common::LODPyramid &get_pyramid() const;
 		
 		void set_K(int new_K);
 		int get_K() const;
@@ -199,12 +214,32 @@ void show_gamma_window::on_window_resized() {
 void show_gamma_window::load_vector( const std::string& file_name ) {
 	mygammaplotter.load_vector(file_name);
 
-	if(mygammaplotter.get_myvector_loaded()){
+	if(mygammaplotter.get_myvector_loaded() || mygammaplotter.get_pyramid_loaded()){
+		select_K.set_text(std::to_string(mygammaplotter.get_K()));
 		fill_labels();
 	}
 }
 
 void show_gamma_window::fill_labels() {
+	if(mygammaplotter.get_pyramid_loaded()){
+		/* the vector is not loaded, the properties are taken from the coarsest level of pyramid */
+		const common::LODPyramid &pyramid = mygammaplotter.get_pyramid();
+		common::LODPyramid::Record summary = gui::get_lod_summary(pyramid);
+
+		set_label_myvector_properties(0, "name:    ", cut_filename(mygammaplotter.get_filename()));
+		set_label_myvector_properties(1, "K:       ", mygammaplotter.get_K());
+		set_label_myvector_properties(2, "T:       ", mygammaplotter.get_T());
+		set_label_myvector_properties(3, "size:    ", pyramid.get_T()*pyramid.get_C());
+		set_label_myvector_properties(4, "norm2:   ", "n/a");
+		set_label_myvector_properties(5, "norm1:   ", "n/a");
+		set_label_myvector_properties(6, "normInf: ", std::max(std::abs(summary.min),std::abs(summary.max)));
+		set_label_myvector_properties(7, "sum:     ", summary.mean*(double)(pyramid.get_T()*pyramid.get_C()));
+		set_label_myvector_properties(8, "max:     ", summary.max);
+		set_label_myvector_properties(9, "min:     ", summary.min);
+		set_label_myvector_properties(10, "mean:    ", summary.mean);
+		return;
+	}
+
 	Vec *myvector_Vec = mygammaplotter.get_myvector_Vec();
 
 	/* compute basic properties of loaded vector */
@@ -256,8 +291,9 @@ std::string show_gamma_window::cut_filename(const std::string &input){
 void show_gamma_window::on_button_K(){
 	int newK = std::stoi(trim(select_K.text()));
 	mygammaplotter.set_K(newK);
+	select_K.set_text(std::to_string(mygammaplotter.get_K()));
 	
-	if(mygammaplotter.get_myvector_loaded()){
+	if(mygammaplotter.get_myvector_loaded() || mygammaplotter.get_pyramid_loaded()){
 		fill_labels();
 	}
 
@@ -271,7 +307,9 @@ void gammaplotter::draw(const canvas& c) const {
 	fill_rect(c,rect,rgb_pixel(255,255,255));
 	
 	/* plot vector */
-	if(myvector_loaded){
+	if(pyramid.is_open()){
+		plot_pyramid(c);
+	} else if(myvector_loaded){
 		plot_vector(c);
 	}
 
@@ -288,6 +326,7 @@ gammaplotter::gammaplotter(drawable_window& w):
 	/* default number of clusters */
 	K = 1;
 	T = 0;
+	drag_x = 0;
 	
 	enable_events();
 }
@@ -305,6 +344,18 @@ void gammaplotter::set_plotting_area(rectangle area){
 
 void gammaplotter::load_vector( const std::string& file_name ) {
 	this->filename = file_name;
+
+	/* if there is a pyramid of the vector, then the vector is not loaded at all, K is given by the pyramid */
+	pyramid.close();
+	if(boost::filesystem::exists(common::LODPyramid::get_filename(file_name))
+		&& pyramid.open(common::LODPyramid::get_filename(file_name), file_name)){
+		this->K = pyramid.get_C();
+		this->T = pyramid.get_T();
+		this->myvector_size = K*T;
+		view.reset(pyramid.get_T());
+		parent.invalidate_rectangle(rect);
+		return;
+	}
 	
 	if(myvector_loaded){
 		/* destroy existing vector */
@@ -347,6 +398,61 @@ bool gammaplotter::get_myvector_loaded(){
 	return myvector_loaded;
 }
 
+bool gammaplotter::get_pyramid_loaded() const {
+	return pyramid.is_open();
+}
+
+const common::LODPyramid &gammaplotter::get_pyramid() const {
+	return pyramid;
+}
+
+void gammaplotter::plot_pyramid(const canvas& c) const{
+	/* free space parameters, the same as in plot_vector */
+	double py_min = 0.1*this->height();
+	double py_max = 0.9*this->height();
+	double py_space = 0.1*this->height();
+	double py_step = (py_max-py_min - (K-1)*py_space)/(double)K;
+
+	for(int k=0;k<K;k++){
+		long top = this->top() + py_min + k*(py_step + py_space);
+		rectangle area(this->left() + 0.01*this->width(), top, this->left() + 0.99*this->width(), top + py_step);
+		gui::plot_lod_channel(c, area, pyramid, k, view, 0.0, 1.0, rgb_pixel(255,0,0));
+	}
+}
+
+void gammaplotter::on_wheel_up(unsigned long state){
+	if(pyramid.is_open() && rect.contains(lastx,lasty)){
+		view.zoom(1.0/LODPLOT_ZOOM, (lastx - rect.left())/(double)rect.width());
+		parent.invalidate_rectangle(rect);
+	}
+}
+
+void gammaplotter::on_wheel_down(unsigned long state){
+	if(pyramid.is_open() && rect.contains(lastx,lasty)){
+		view.zoom(LODPLOT_ZOOM, (lastx - rect.left())/(double)rect.width());
+		parent.invalidate_rectangle(rect);
+	}
+}
+
+void gammaplotter::on_mouse_down(unsigned long btn, unsigned long state, long x, long y, bool is_double_click){
+	if(pyramid.is_open() && rect.contains(x,y)){
+		if(is_double_click){
+			/* show whole signal */
+			view.reset(pyramid.get_T());
+			parent.invalidate_rectangle(rect);
+		}
+		drag_x = x;
+	}
+}
+
+void gammaplotter::on_mouse_move(unsigned long state, long x, long y){
+	if(pyramid.is_open() && (state & base_window::LEFT)){
+		view.pan((drag_x - x)/(double)rect.width());
+		drag_x = x;
+		parent.invalidate_rectangle(rect);
+	}
+}
+
 void gammaplotter::plot_vector(const canvas& c) const{
 	unsigned long x_begin = this->left();
 	unsigned long y_begin = this->top();
@@ -406,6 +512,11 @@ void gammaplotter::plot_vector(const canvas& c) const{
 }
 
 void gammaplotter::set_K(int new_K){
+	if(pyramid.is_open()){
+		/* the number of channels is fixed by the pyramid */
+		return;
+	}
+
 	this->K = new_K;
 
 	if(myvector_loaded){
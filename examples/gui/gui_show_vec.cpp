@@ -14,6 +14,8 @@
 #include <sstream>
 #include <string>
 
+#include "lodplot.h"
+
 #define NUMBER_OF_LABELS 9
 
 using namespace dlib;
@@ -24,8 +26,19 @@ class graphplotter : public drawable {
 		Vec *myvector_Vec;
 		bool myvector_loaded;
 
+		common::LODPyramid pyramid;		/* level-of-detail pyramid, used instead of Vec if available */
+		gui::lodview view;				/* visible window of pyramid */
+		long drag_x;					/* last position of mouse during panning */
+
 		void draw (const canvas& c) const;
 		void plot_vector(const canvas& c) const;
+		void plot_pyramid(const canvas& c) const;
+
+		/* zoom and pan of pyramid */
+		void on_wheel_up(unsigned long state);
+		void on_wheel_down(unsigned long state);
+		void on_mouse_down(unsigned long btn, unsigned long state, long x, long y, bool is_double_click);
+		void on_mouse_move(unsigned long state, long x, long y);
 
 	public: 
 		graphplotter(drawable_window& w);
@@ -35,6 +48,8 @@ class graphplotter : public drawable {
 		void load_vector( const std::string& file_name );
 		bool get_myvector_loaded();
 		Vec *get_myvector_Vec();
+		bool get_pyramid_loaded() const;
+		const common::LODPyramid &get_pyramid() const;
 };
 
 class show_vec_window : public drawable_window {
@@ -170,6 +185,23 @@ void show_vec_window::on_window_resized() {
 void show_vec_window::load_vector( const std::string& file_name ) {
 	mygraphplotter.load_vector(file_name);
 
+	if(mygraphplotter.get_pyramid_loaded()){
+		/* the vector is not loaded, the properties are taken from the coarsest level of pyramid */
+		const common::LODPyramid &pyramid = mygraphplotter.get_pyramid();
+		common::LODPyramid::Record summary = gui::get_lod_summary(pyramid);
+
+		set_label_myvector_properties(0, "name:    ", cut_filename(file_name));
+		set_label_myvector_properties(1, "size:    ", pyramid.get_T()*pyramid.get_C());
+		set_label_myvector_properties(2, "norm2:   ", "n/a");
+		set_label_myvector_properties(3, "norm1:   ", "n/a");
+		set_label_myvector_properties(4, "normInf: ", std::max(std::abs(summary.min),std::abs(summary.max)));
+		set_label_myvector_properties(5, "sum:     ", summary.mean*(double)(pyramid.get_T()*pyramid.get_C()));
+		set_label_myvector_properties(6, "max:     ", summary.max);
+		set_label_myvector_properties(7, "min:     ", summary.min);
+		set_label_myvector_properties(8, "mean:    ", summary.mean);
+		return;
+	}
+
 	Vec *myvector_Vec = mygraphplotter.get_myvector_Vec();
 
 	/* compute basic properties of loaded vector */
@@ -224,7 +256,9 @@ void graphplotter::draw(const canvas& c) const {
 	fill_rect(c,rect,rgb_pixel(255,255,255));
 	
 	/* plot vector */
-	if(myvector_loaded){
+	if(pyramid.is_open()){
+		plot_pyramid(c);
+	} else if(myvector_loaded){
 		plot_vector(c);
 	}
 
@@ -237,6 +271,7 @@ graphplotter::graphplotter(drawable_window& w):
 	myvector_Vec = new Vec();
 	TRYCXX( VecCreate(PETSC_COMM_WORLD,myvector_Vec) );
 	myvector_loaded = false;
+	drag_x = 0;
 	
 	enable_events();
 }
@@ -253,6 +288,15 @@ void graphplotter::set_plotting_area(rectangle area){
 }
 
 void graphplotter::load_vector( const std::string& file_name ) {
+	/* if there is a pyramid of the vector, then the vector is not loaded at all */
+	pyramid.close();
+	if(boost::filesystem::exists(common::LODPyramid::get_filename(file_name))
+		&& pyramid.open(common::LODPyramid::get_filename(file_name), file_name)){
+		view.reset(pyramid.get_T());
+		parent.invalidate_rectangle(rect);
+		return;
+	}
+
 	if(myvector_loaded){
 		/* destroy existing vector */
 		TRYCXX( VecDestroy(myvector_Vec) );
@@ -287,6 +331,59 @@ bool graphplotter::get_myvector_loaded(){
 	return myvector_loaded;
 }
 
+bool graphplotter::get_pyramid_loaded() const {
+	return pyramid.is_open();
+}
+
+const common::LODPyramid &graphplotter::get_pyramid() const {
+	return pyramid;
+}
+
+void graphplotter::plot_pyramid(const canvas& c) const{
+	/* free space parameters */
+	rectangle area(this->left() + 0.01*this->width(), this->top() + 0.1*this->height(),
+					this->left() + 0.99*this->width(), this->top() + 0.9*this->height());
+
+	/* all channels have the same scale */
+	common::LODPyramid::Record summary = gui::get_lod_summary(pyramid);
+	for(int ch=0;ch<pyramid.get_C();ch++){
+		gui::plot_lod_channel(c, area, pyramid, ch, view, summary.min, summary.max, rgb_pixel(0,0,255));
+	}
+}
+
+void graphplotter::on_wheel_up(unsigned long state){
+	if(pyramid.is_open() && rect.contains(lastx,lasty)){
+		view.zoom(1.0/LODPLOT_ZOOM, (lastx - rect.left())/(double)rect.width());
+		parent.invalidate_rectangle(rect);
+	}
+}
+
+void graphplotter::on_wheel_down(unsigned long state){
+	if(pyramid.is_open() && rect.contains(lastx,lasty)){
+		view.zoom(LODPLOT_ZOOM, (lastx - rect.left())/(double)rect.width());
+		parent.invalidate_rectangle(rect);
+	}
+}
+
+void graphplotter::on_mouse_down(unsigned long btn, unsigned long state, long x, long y, bool is_double_click){
+	if(pyramid.is_open() && rect.contains(x,y)){
+		if(is_double_click){
+			/* show whole signal */
+			view.reset(pyramid.get_T());
+			parent.invalidate_rectangle(rect);
+		}
+		drag_x = x;
+	}
+}
+
+void graphplotter::on_mouse_move(unsigned long state, long x, long y){
+	if(pyramid.is_open() && (state & base_window::LEFT)){
+		view.pan((drag_x - x)/(double)rect.width());
+		drag_x = x;
+		parent.invalidate_rectangle(rect);
+	}
+}
+
 void graphplotter::plot_vector(const canvas& c) const{
 	unsigned long x_begin = this->left();
 	unsigned long y_begin = this->top();
@@ -0,0 +1,159 @@
+/** @file lodplot.h
+ *  @brief Plotting of long vectors from level-of-detail pyramid in dlib viewers.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#ifndef PASC_GUI_LODPLOT_H
+#define	PASC_GUI_LODPLOT_H
+
+#include <dlib/gui_widgets.h>
+#include <algorithm>
+#include <vector>
+
+#include "general/common/lodpyramid.h"
+
+#define LODPLOT_ZOOM 1.25		/**< scaling of visible window per one step of mouse wheel */
+
+namespace pascinference {
+namespace gui {
+
+/** \class lodview
+ *  \brief Visible time window [begin, begin+length) of the signal with length T.
+ *
+ *  Wheel zooms around the mouse position, dragging with left button pans the window.
+*/
+class lodview {
+	private:
+		int64_t T;			/**< length of signal */
+		int64_t begin;		/**< the first visible time */
+		int64_t length;		/**< number of visible times */
+
+		void fix() {
+			length = std::max((int64_t)2, std::min(length, T));
+			begin = std::max((int64_t)0, std::min(begin, T - length));
+		}
+
+	public:
+		lodview() : T(0), begin(0), length(0) {}
+
+		/** @brief show the whole signal of given length
+		*/
+		void reset(int64_t new_T) {
+			T = new_T;
+			begin = 0;
+			length = T;
+		}
+
+		/** @brief scale the window around given relative position
+		*
+		* @param factor new_length = factor*length
+		* @param position relative position of fixed point in window, in [0,1]
+		*/
+		void zoom(double factor, double position) {
+			if(T <= 0) return;
+			double center = begin + position*length;
+			length = (int64_t)(factor*length + 0.5);
+			begin = (int64_t)(center - position*length);
+			fix();
+		}
+
+		/** @brief move the window by given fraction of its length
+		*/
+		void pan(double fraction) {
+			if(T <= 0) return;
+			begin += (int64_t)(fraction*length);
+			fix();
+		}
+
+		/** @brief move the window to given relative position, 0 is the beginning and 1 is the end of signal
+		*/
+		void move_to(double position) {
+			if(T <= 0) return;
+			begin = (int64_t)(position*(T - length));
+			fix();
+		}
+
+		/** @brief relative position of the window, see move_to
+		*/
+		double get_position() const {
+			return (T > length) ? begin/(double)(T - length) : 0.0;
+		}
+
+		int64_t get_T() const { return T; }
+		int64_t get_begin() const { return begin; }
+		int64_t get_length() const { return length; }
+};
+
+/** @brief min, max and mean of all channels of pyramid
+*/
+inline common::LODPyramid::Record get_lod_summary(const common::LODPyramid &pyramid) {
+	common::LODPyramid::Record summary = pyramid.get_summary(0);
+	for(int c=1;c<pyramid.get_C();c++){
+		common::LODPyramid::Record summary_c = pyramid.get_summary(c);
+		summary.min = std::min(summary.min, summary_c.min);
+		summary.max = std::max(summary.max, summary_c.max);
+		summary.mean += summary_c.mean;
+	}
+	summary.mean /= (float)pyramid.get_C();
+	return summary;
+}
+
+/** @brief plot one channel of pyramid in visible window
+*
+* The level is chosen to have approximately one record per pixel, only the records covering the window are read.
+* Each record is drawn as vertical min-max line and the means are connected.
+*
+* @param c canvas
+* @param area plotting area
+* @param pyramid opened pyramid
+* @param channel index of channel
+* @param view visible time window
+* @param value_min value mapped to the bottom of area
+* @param value_max value mapped to the top of area
+* @param color color of the line
+*/
+inline void plot_lod_channel(const dlib::canvas &c, const dlib::rectangle &area, const common::LODPyramid &pyramid, int channel, const lodview &view, double value_min, double value_max, dlib::rgb_pixel color) {
+	if(!pyramid.is_open() || view.get_length() < 2 || area.width() < 2) return;
+
+	int level = pyramid.get_level((double)view.get_length()/(double)area.width());
+	int64_t decimation = pyramid.get_decimation(level);
+
+	/* records covering visible window */
+	int64_t rec_begin = view.get_begin()/decimation;
+	int64_t rec_end = (view.get_begin() + view.get_length() + decimation - 1)/decimation + 1;
+	std::vector<common::LODPyramid::Record> records;
+	pyramid.get_records(level, channel, rec_begin, rec_end, records);
+
+	/* coefficients of mapping t to x and value to y */
+	double ax = (area.width() - 1)/(double)(view.get_length() - 1);
+	double bx = area.left() - ax*view.get_begin();
+	double ay = (value_max > value_min) ? (area.height() - 1)/(value_max - value_min) : 0.0;
+	double by = area.bottom() + ay*value_min;
+
+	dlib::point mypoint1;
+	dlib::point mypoint2;
+	for(size_t i=0;i<records.size();i++){
+		/* the record is drawn in the middle of its bin */
+		double t = (rec_begin + (int64_t)i)*decimation + 0.5*(decimation - 1);
+		long x = (long)(ax*t + bx);
+
+		if(decimation > 1){
+			mypoint1 = dlib::point(x, (long)(by - ay*records[i].min));
+			mypoint2 = dlib::point(x, (long)(by - ay*records[i].max));
+			dlib::draw_line(c, mypoint1, mypoint2, color, area);
+		}
+
+		if(i > 0){
+			double t_prev = t - decimation;
+			mypoint1 = dlib::point((long)(ax*t_prev + bx), (long)(by - ay*records[i-1].mean));
+			mypoint2 = dlib::point(x, (long)(by - ay*records[i].mean));
+			dlib::draw_line(c, mypoint1, mypoint2, color, area);
+		}
+	}
+}
+
+}
+} /* end of namespace */
+
+#endif
@@ -42,6 +42,14 @@ def commit_batch(batchfile_list, additional_parameters):
         call(["sbatch", batchfile_name, additional_parameters])
     return
 
+def write_taskfarm_manifest(manifest_name, tasks):
+    "this function writes the list of tasks for util_taskfarm, task is (nprocs, shortinfo_filename, exec_name)"
+    myfile = open(manifest_name, 'w+');
+    myfile.write("# nprocs shortinfo_filename executable [arguments]\n")
+    for (nprocs, shortinfo_filename, exec_name) in tasks:
+        myfile.write("%d %s %s\n" % (nprocs, shortinfo_filename, exec_name))
+    return
+
 def show_jobs(account):
     "this function shows queue"
     print "--------------------------------------- MY JOBS: -----------------------------------"
@@ -2,6 +2,10 @@
  *  @brief test class and methods: BlockGraphSparseMatrix
  *
  *  This file tests the class for manipulation with block diagonal matrix.
+ *  The matrix given by graph from file is printed as dense matrix.
+ *  Then the matrix on 2D grid (MATSHELL with space-time stencil if it is used) is compared with assembled AIJ matrix:
+ *  MatMult (separately in rows with t=0, t=T-1 and other t), MatGetDiagonal and MatScale (used by PERMON).
+ *  The comparison is performed with decomposition in time (halo in time) and with T=1 and decomposition in space (halo in space).
  * 
  *  @author Lukas Pospisil
  */
@@ -11,7 +15,6 @@
 #include <algorithm>
 
 #include "pascinference.h"
-#include "algebra/matrix/blockgraphsparse.h"
 
 typedef petscvector::PetscVector PetscVector;
 
@@ -19,6 +22,119 @@ using namespace pascinference;
 
 extern int pascinference::DEBUG_MODE;
 
+/* maximum differences of y1 and y2 in rows with t=0, t=T-1 and other t */
+void test_stencil_diff(Vec y1_Vec, Vec y2_Vec, const Decomposition<PetscVector> &decomposition, double *diff_first, double *diff_last, double *diff_inner){
+	int T = decomposition.get_T();
+	int R = decomposition.get_R();
+	int K = decomposition.get_K();
+
+	int low, high;
+	const double *y1_arr;
+	const double *y2_arr;
+	TRYCXX( VecGetOwnershipRange(y1_Vec, &low, &high) );
+	TRYCXX( VecGetArrayRead(y1_Vec, &y1_arr) );
+	TRYCXX( VecGetArrayRead(y2_Vec, &y2_arr) );
+
+	double diff[3] = {0.0, 0.0, 0.0};
+	for(int i=low;i<high;i++){
+		int t = i/(R*K);
+		int type = (t == 0)? 0 : ((t == T-1)? 1 : 2);
+		diff[type] = std::max(diff[type], std::abs(y1_arr[i-low] - y2_arr[i-low]));
+	}
+
+	TRYCXX( VecRestoreArrayRead(y1_Vec, &y1_arr) );
+	TRYCXX( VecRestoreArrayRead(y2_Vec, &y2_arr) );
+
+	MPI_Allreduce(MPI_IN_PLACE, diff, 3, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+	*diff_first = diff[0];
+	*diff_last = diff[1];
+	*diff_inner = diff[2];
+}
+
+/* compare internal matrix of BlockGraphSparseMatrix on 2D grid with assembled AIJ matrix */
+bool test_stencil_compare(int width, int height, int T, int K, int DDT_size, int DDR_size, double tol){
+	coutMaster << "- grid " << width << "x" << height << ", T = " << T << ", K = " << K << ", DDT = " << DDT_size << ", DDR = " << DDR_size << std::endl;
+
+	BGMGraphGrid2D<PetscVector> graph(width, height);
+	graph.process_grid();
+	Decomposition<PetscVector> decomposition(T, graph, K, 1, DDT_size, DDR_size);
+
+	BlockGraphSparseMatrix<PetscVector> A(decomposition, 1.0);
+	Mat A_petsc = A.get_externalcontent()->A_petsc;
+	coutMaster << "  stencil                    = " << std::setw(30) << printbool(A.get_externalcontent()->stencil) << std::endl;
+
+	/* reference assembled matrix */
+	BlockGraphSparseMatrix<PetscVector>::ExternalContent aij;
+	aij.assemble(&decomposition);
+
+	/* deterministic x */
+	Vec x_Vec, y1_Vec, y2_Vec;
+	decomposition.createGlobalVec_gamma(&x_Vec);
+	TRYCXX( VecDuplicate(x_Vec, &y1_Vec) );
+	TRYCXX( VecDuplicate(x_Vec, &y2_Vec) );
+
+	int low, high;
+	double *x_arr;
+	TRYCXX( VecGetOwnershipRange(x_Vec, &low, &high) );
+	TRYCXX( VecGetArray(x_Vec, &x_arr) );
+	for(int i=low;i<high;i++){
+		x_arr[i-low] = sin(0.37*i) + 0.2*cos(1.3*i);
+	}
+	TRYCXX( VecRestoreArray(x_Vec, &x_arr) );
+
+	bool passed = true;
+	double diff_first, diff_last, diff_inner, diff;
+
+	/* MatMult */
+	TRYCXX( MatMult(A_petsc, x_Vec, y1_Vec) );
+	TRYCXX( MatMult(aij.A_petsc, x_Vec, y2_Vec) );
+	test_stencil_diff(y1_Vec, y2_Vec, decomposition, &diff_first, &diff_last, &diff_inner);
+	coutMaster << "  MatMult, t = 0            : " << std::setw(15) << diff_first << std::endl;
+	coutMaster << "  MatMult, t = T-1          : " << std::setw(15) << diff_last << std::endl;
+	coutMaster << "  MatMult, 0 < t < T-1      : " << std::setw(15) << diff_inner << std::endl;
+	if(diff_first > tol || diff_last > tol || diff_inner > tol){
+		passed = false;
+	}
+
+	/* MatGetDiagonal */
+	TRYCXX( MatGetDiagonal(A_petsc, y1_Vec) );
+	TRYCXX( MatGetDiagonal(aij.A_petsc, y2_Vec) );
+	TRYCXX( VecAXPY(y1_Vec, -1.0, y2_Vec) );
+	TRYCXX( VecNorm(y1_Vec, NORM_INFINITY, &diff) );
+	coutMaster << "  MatGetDiagonal            : " << std::setw(15) << diff << std::endl;
+	if(diff > tol){
+		passed = false;
+	}
+
+	/* MatScale, the scaled matrices have to be the same */
+	TRYCXX( MatScale(A_petsc, 2.5) );
+	TRYCXX( MatScale(aij.A_petsc, 2.5) );
+	TRYCXX( MatMult(A_petsc, x_Vec, y1_Vec) );
+	TRYCXX( MatMult(aij.A_petsc, x_Vec, y2_Vec) );
+	test_stencil_diff(y1_Vec, y2_Vec, decomposition, &diff_first, &diff_last, &diff_inner);
+	diff = std::max(diff_first, std::max(diff_last, diff_inner));
+	coutMaster << "  MatScale + MatMult        : " << std::setw(15) << diff << std::endl;
+	if(diff > 2.5*tol){
+		passed = false;
+	}
+
+	TRYCXX( MatGetDiagonal(A_petsc, y1_Vec) );
+	TRYCXX( MatGetDiagonal(aij.A_petsc, y2_Vec) );
+	TRYCXX( VecAXPY(y1_Vec, -1.0, y2_Vec) );
+	TRYCXX( VecNorm(y1_Vec, NORM_INFINITY, &diff) );
+	coutMaster << "  MatScale + MatGetDiagonal : " << std::setw(15) << diff << std::endl;
+	if(diff > 2.5*tol){
+		passed = false;
+	}
+
+	TRYCXX( VecDestroy(&x_Vec) );
+	TRYCXX( VecDestroy(&y1_Vec) );
+	TRYCXX( VecDestroy(&y2_Vec) );
+	TRYCXX( MatDestroy(&(aij.A_petsc)) );
+
+	return passed;
+}
+
 int main( int argc, char *argv[] )
 {
 	/* add local program options */
@@ -35,19 +151,24 @@ int main( int argc, char *argv[] )
 		("test_print_graph", boost::program_options::value<bool>(), "print content of graph or not [bool]")
 		("test_print_decomposition", boost::program_options::value<bool>(), "print content of decomposition or not [bool]")
 		("test_print_matrix", boost::program_options::value<bool>(), "print dense matrix or not [bool]")
-		("test_print_matrix_unsorted", boost::program_options::value<bool>(), "print dense matrix in original unsorted form or not [bool]");
+		("test_print_matrix_unsorted", boost::program_options::value<bool>(), "print dense matrix in original unsorted form or not [bool]")
+		("test_grid_width", boost::program_options::value<int>(), "width of 2D grid in comparison with assembled matrix [int]")
+		("test_grid_height", boost::program_options::value<int>(), "height of 2D grid in comparison with assembled matrix [int]")
+		("test_grid_T", boost::program_options::value<int>(), "length of time-series in comparison with assembled matrix [int]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of differences in comparison with assembled matrix [double]");
 	consoleArg.get_description()->add(opt_problem);
 
 	/* call initialize */
-	if(!Initialize(argc, argv)){
+	if(!Initialize<PetscVector>(argc, argv)){
 		return 0;
 	} 
 
 	/* load console arguments */
 	int T, K, DDT_size, DDR_size, graph_dim;
+	int grid_width, grid_height, grid_T;
 	std::string graph_filename;
 	bool print_matrix, print_graph, print_matrix_unsorted, print_decomposition;
-	double alpha, graph_coeff;
+	double alpha, graph_coeff, tol;
 	int nproc = GlobalManager.get_size();
 	
 	consoleArg.set_option_value("test_T", &T, 3);
@@ -62,6 +183,10 @@ int main( int argc, char *argv[] )
 	consoleArg.set_option_value("test_print_matrix_unsorted", &print_matrix_unsorted, false);
 	consoleArg.set_option_value("test_print_graph", &print_graph, false);
 	consoleArg.set_option_value("test_print_decomposition", &print_decomposition, false);
+	consoleArg.set_option_value("test_grid_width", &grid_width, 7);
+	consoleArg.set_option_value("test_grid_height", &grid_height, 5);
+	consoleArg.set_option_value("test_grid_T", &grid_T, 4*nproc);
+	consoleArg.set_option_value("test_tol", &tol, 1e-12);
 
 	/* print settings */
 	coutMaster << " test_T                     = " << std::setw(30) << T << " (length of time-series)" << std::endl;
@@ -76,6 +201,10 @@ int main( int argc, char *argv[] )
 	coutMaster << " test_print_decomposition   = " << std::setw(30) << print_decomposition << " (print content of decomposition or not)" << std::endl;
 	coutMaster << " test_print_matrix          = " << std::setw(30) << print_matrix << " (print matrix or not)" << std::endl;
 	coutMaster << " test_print_matrix_unsorted = " << std::setw(30) << print_matrix_unsorted << " (print matrix in unsorted form or not)" << std::endl;
+	coutMaster << " test_grid_width            = " << std::setw(30) << grid_width << " (width of 2D grid in comparison)" << std::endl;
+	coutMaster << " test_grid_height           = " << std::setw(30) << grid_height << " (height of 2D grid in comparison)" << std::endl;
+	coutMaster << " test_grid_T                = " << std::setw(30) << grid_T << " (length of time-series in comparison)" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of differences in comparison)" << std::endl;
 	coutMaster << std::endl;
 
 	if(DDT_size*DDR_size != nproc){
@@ -84,6 +213,7 @@ int main( int argc, char *argv[] )
 		coutMaster << " DDR   = " << std::setw(15) << DDR_size << std::endl;
 		coutMaster << " nproc = " << std::setw(15) << nproc << std::endl;
 		
+		Finalize<PetscVector>();
 		return 0;
 	}
 
@@ -93,7 +223,7 @@ int main( int argc, char *argv[] )
 	
 	/* create graph (i.e. load from filename) */
 	mytimer.start();
-	 BGMGraph graph(graph_filename,graph_dim);
+	 BGMGraph<PetscVector> graph(graph_filename,graph_dim);
 	mytimer.stop();
 	coutMaster << "- time load graph           : " << std::setw(15) << mytimer.get_value_last() << " s" << std::endl;
 	
@@ -115,9 +245,9 @@ int main( int argc, char *argv[] )
 	}
 
 	/* create decomposition */
-	Decomposition *decomposition;
+	Decomposition<PetscVector> *decomposition;
 	mytimer.start();
-	 decomposition = new Decomposition(T, graph, K, 1, DDT_size, DDR_size);
+	 decomposition = new Decomposition<PetscVector>(T, graph, K, 1, DDT_size, DDR_size);
 	mytimer.stop();
 	coutMaster << "- time create decomposition : " << std::setw(15) << mytimer.get_value_last() << " s" << std::endl;
 	if(!print_decomposition){
@@ -155,7 +285,6 @@ int main( int argc, char *argv[] )
 
 	/* we will print full matrix as a results of multiplication A*e_k, k = 1,...n */
 	double *values_arr;
-	double *gamma_arr;
 	int R = decomposition->get_R(); /* we have T,K, why not to define also R - we obtain it from decomposed graph */
 
 	/* print header of matrix print */
@@ -264,15 +393,24 @@ int main( int argc, char *argv[] )
 	/* print final info */
 	coutMaster << "- time multiplication all   : " << std::setw(15) << mytimer.get_value_sum() << " s" << std::endl;
 	coutMaster << "- time multiplication avg   : " << std::setw(15) << mytimer.get_value_sum()/(double)(decomposition->get_T()*decomposition->get_R()*K) << " s" << std::endl;
+	coutMaster << std::endl;
 
-	
-	/* say bye */	
-	coutMaster << "- end of program" << std::endl;
+	delete A;
+	delete decomposition;
+
+	/* compare with assembled matrix: halo in time (t=0, t=T-1 on different processes), then T=1 with halo in space */
+	coutMaster << "--- COMPARISON WITH ASSEMBLED MATRIX ---" << std::endl;
+	bool passed = true;
+	passed = test_stencil_compare(grid_width, grid_height, grid_T, K, nproc, 1, tol) && passed;
+	passed = test_stencil_compare(grid_width, grid_height, 1, K, 1, nproc, tol) && passed;
+	coutMaster << std::endl;
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
 	coutMaster << std::endl;
 
-	Finalize();
+	Finalize<PetscVector>();
 
-	return 0;
+	return passed ? 0 : 1;
 }
 
 
@@ -0,0 +1,9 @@
+/** @file test_petscvectorexpr.cpp
+ *  @brief compare lazy expressions of PetscVector with eager PETSc operations
+ *
+ *  This is file compilable with standard c++ compiler. It simply includes cuda .cu source file with same name.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "test_petscvectorexpr.cu"
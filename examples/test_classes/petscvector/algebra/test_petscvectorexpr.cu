@@ -0,0 +1,175 @@
+/** @file test_petscvectorexpr.cu
+ *  @brief compare lazy expressions of PetscVector with eager PETSc operations
+ *
+ *  The same expressions are evaluated in one pass using lazy() and step by step using PETSc functions
+ *  (VecPointwiseMult, VecAXPBYPCZ, VecShift, ...) with temporary vectors. The results have to be the same.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include <iostream>
+#include <list>
+#include <algorithm>
+
+#include "pascinference.h"
+
+typedef petscvector::PetscVector PetscVector;
+
+using namespace pascinference;
+
+extern int pascinference::DEBUG_MODE;
+
+/* compare two vectors and print the result */
+bool test_expr_compare(std::string name, Vec x_lazy, Vec x_eager, double tol){
+	Vec diff_Vec;
+	double diff, norm;
+	TRYCXX( VecDuplicate(x_eager, &diff_Vec) );
+	TRYCXX( VecWAXPY(diff_Vec, -1.0, x_eager, x_lazy) );
+	TRYCXX( VecNorm(diff_Vec, NORM_INFINITY, &diff) );
+	TRYCXX( VecNorm(x_eager, NORM_INFINITY, &norm) );
+	TRYCXX( VecDestroy(&diff_Vec) );
+
+	bool passed = (diff <= tol*std::max(norm, 1.0));
+	coutMaster << " - " << std::setw(25) << name << ": diff = " << std::setw(15) << diff << (passed? "" : " FAILED") << std::endl;
+	return passed;
+}
+
+/* compare two scalars and print the result */
+bool test_expr_compare(std::string name, double value_lazy, double value_eager, double tol){
+	double diff = std::abs(value_lazy - value_eager);
+
+	bool passed = (diff <= tol*std::max(std::abs(value_eager), 1.0));
+	coutMaster << " - " << std::setw(25) << name << ": diff = " << std::setw(15) << diff << (passed? "" : " FAILED") << std::endl;
+	return passed;
+}
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_n", boost::program_options::value<int>(), "global length of vectors [int]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of relative difference [double]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	/* load console arguments */
+	int n;
+	double tol;
+	consoleArg.set_option_value("test_n", &n, 10000);
+	consoleArg.set_option_value("test_tol", &tol, 1e-12);
+
+	/* print settings */
+	coutMaster << " test_n                     = " << std::setw(30) << n << " (global length of vectors)" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of relative difference)" << std::endl;
+	coutMaster << std::endl;
+
+	/* deterministic values, v is far from zero because of division */
+	Vec x_Vec, u_Vec, v_Vec;
+	TRYCXX( VecCreate(PETSC_COMM_WORLD, &x_Vec) );
+#ifdef USE_CUDA
+	TRYCXX( VecSetType(x_Vec, VECMPICUDA) );
+#else
+	TRYCXX( VecSetType(x_Vec, VECMPI) );
+#endif
+	TRYCXX( VecSetSizes(x_Vec, PETSC_DECIDE, n) );
+	TRYCXX( VecSetFromOptions(x_Vec) );
+	TRYCXX( VecDuplicate(x_Vec, &u_Vec) );
+	TRYCXX( VecDuplicate(x_Vec, &v_Vec) );
+
+	int low, high;
+	TRYCXX( VecGetOwnershipRange(x_Vec, &low, &high) );
+	for(int i=low;i<high;i++){
+		TRYCXX( VecSetValue(x_Vec, i, sin(0.1*i), INSERT_VALUES) );
+		TRYCXX( VecSetValue(u_Vec, i, cos(0.03*i), INSERT_VALUES) );
+		TRYCXX( VecSetValue(v_Vec, i, 2.0 + sin(0.7*i), INSERT_VALUES) );
+	}
+	TRYCXX( VecAssemblyBegin(x_Vec) );
+	TRYCXX( VecAssemblyEnd(x_Vec) );
+	TRYCXX( VecAssemblyBegin(u_Vec) );
+	TRYCXX( VecAssemblyEnd(u_Vec) );
+	TRYCXX( VecAssemblyBegin(v_Vec) );
+	TRYCXX( VecAssemblyEnd(v_Vec) );
+
+	PetscVector x(x_Vec);
+	PetscVector u(u_Vec);
+	PetscVector v(v_Vec);
+
+	double a = 1.5;
+	double b = -0.7;
+	double c = 0.25;
+
+	/* eager result and temporary vector */
+	Vec y_eager_Vec, w_Vec;
+	TRYCXX( VecDuplicate(x_Vec, &y_eager_Vec) );
+	TRYCXX( VecDuplicate(x_Vec, &w_Vec) );
+
+	bool passed = true;
+
+	/* y = a*x + b*u.*v + c */
+	PetscVector y;
+	y = a*lazy(x) + b*lazy(u)*lazy(v) + c;
+
+	TRYCXX( VecPointwiseMult(w_Vec, u_Vec, v_Vec) );
+	TRYCXX( VecSet(y_eager_Vec, 0.0) );
+	TRYCXX( VecAXPBYPCZ(y_eager_Vec, a, b, 0.0, x_Vec, w_Vec) );
+	TRYCXX( VecShift(y_eager_Vec, c) );
+	passed = test_expr_compare("y = a*x + b*u*v + c", y.get_vector(), y_eager_Vec, tol) && passed;
+
+	/* y += (x - c)/v */
+	y += (lazy(x) - c)/lazy(v);
+
+	TRYCXX( VecCopy(x_Vec, w_Vec) );
+	TRYCXX( VecShift(w_Vec, -c) );
+	TRYCXX( VecPointwiseDivide(w_Vec, w_Vec, v_Vec) );
+	TRYCXX( VecAXPY(y_eager_Vec, 1.0, w_Vec) );
+	passed = test_expr_compare("y += (x - c)/v", y.get_vector(), y_eager_Vec, tol) && passed;
+
+	/* y -= a*u */
+	y -= a*lazy(u);
+
+	TRYCXX( VecAXPY(y_eager_Vec, -a, u_Vec) );
+	passed = test_expr_compare("y -= a*u", y.get_vector(), y_eager_Vec, tol) && passed;
+
+	/* result on the right-hand side, y = 2*y - x*y */
+	y = 2.0*lazy(y) - lazy(x)*lazy(y);
+
+	TRYCXX( VecPointwiseMult(w_Vec, x_Vec, y_eager_Vec) );
+	TRYCXX( VecAXPBY(y_eager_Vec, -1.0, 2.0, w_Vec) );
+	passed = test_expr_compare("y = 2*y - x*y", y.get_vector(), y_eager_Vec, tol) && passed;
+
+	/* reductions */
+	double sum_eager, dot_eager;
+	TRYCXX( VecSum(y_eager_Vec, &sum_eager) );
+	passed = test_expr_compare("sum(y)", sum(lazy(y)), sum_eager, tol) && passed;
+
+	TRYCXX( VecCopy(u_Vec, w_Vec) );
+	TRYCXX( VecShift(w_Vec, 1.0) );
+	TRYCXX( VecDot(x_Vec, w_Vec, &dot_eager) );
+	passed = test_expr_compare("dot(x, u + 1)", dot(lazy(x), lazy(u) + 1.0), dot_eager, tol) && passed;
+
+	/* printing of vector goes through expression */
+	std::ostringstream oss_vector;
+	std::ostringstream oss_expr;
+	oss_vector << y;
+	oss_expr << 1.0*lazy(y);
+	bool passed_print = (oss_vector.str() == oss_expr.str());
+	coutMaster << " - " << std::setw(25) << "print" << ": " << (passed_print? "equal" : "different FAILED") << std::endl;
+	passed = passed_print && passed;
+
+	coutMaster << std::endl;
+
+	TRYCXX( VecDestroy(&w_Vec) );
+	TRYCXX( VecDestroy(&y_eager_Vec) );
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
+	coutMaster << std::endl;
+
+	Finalize<PetscVector>();
+
+	return passed ? 0 : 1;
+}
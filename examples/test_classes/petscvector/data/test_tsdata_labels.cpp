@@ -0,0 +1,9 @@
+/** @file test_tsdata_labels.cpp
+ *  @brief test the labels of clusters in TSData and the recovered signal
+ *
+ *  This is file compilable with standard c++ compiler. It simply includes cuda .cu source file with same name.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "test_tsdata_labels.cu"
@@ -0,0 +1,230 @@
+/** @file test_tsdata_labels.cu
+ *  @brief test the labels of clusters in TSData and the recovered signal
+ *
+ *  One-hot gamma with known labels (given by original index of node and time step) is saved by TSData::save_gammalabels,
+ *  set to zero and loaded by TSData::load_gammalabels; the loaded gamma has to be the same. The test is performed for
+ *  K <= 256 (one byte labels) and K > 256 (two bytes labels) with decomposition in time and in space, run it on more processes.
+ *  Then TSData::compute_recovered is compared with the dense sum x = sum_k gamma_k theta_k for one-hot gamma and for gamma
+ *  with rows which are not one-hot.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include <iostream>
+#include <list>
+#include <algorithm>
+
+#include "pascinference.h"
+
+typedef petscvector::PetscVector PetscVector;
+
+using namespace pascinference;
+
+extern int pascinference::DEBUG_MODE;
+
+/* known label of node r_orig at time t */
+int test_labels_label(int t, int r_orig, int R, int K){
+	return ((t*R + r_orig)*97 + 5)%K;
+}
+
+/* set gamma in layout of decomposition to one-hot vector with known labels */
+void test_labels_set(Vec gamma_Vec, const Decomposition<PetscVector> &decomposition){
+	int R = decomposition.get_R();
+	int K = decomposition.get_K();
+
+	int low, high;
+	double *gamma_arr;
+	TRYCXX( VecGetOwnershipRange(gamma_Vec, &low, &high) );
+	TRYCXX( VecGetArray(gamma_Vec, &gamma_arr) );
+	for(int i=low;i<high;i++){
+		int t = i/(R*K);
+		int r_orig = decomposition.get_invPr((i/K)%R);
+		gamma_arr[i-low] = (i%K == test_labels_label(t, r_orig, R, K))? 1.0 : 0.0;
+	}
+	TRYCXX( VecRestoreArray(gamma_Vec, &gamma_arr) );
+}
+
+/* maximum difference of recovered signal from dense sum computed from the same gamma and theta */
+double test_labels_recovered_diff(TSData<PetscVector> &tsdata, GeneralVector<PetscVector> &recovered){
+	int K = tsdata.get_K();
+	int xdim = tsdata.get_xdim();
+
+	tsdata.compute_recovered(recovered);
+
+	int gamma_size;
+	const double *gamma_arr;
+	const double *theta_arr;
+	const double *recovered_arr;
+	TRYCXX( VecGetLocalSize(tsdata.get_gammavector()->get_vector(), &gamma_size) );
+	TRYCXX( VecGetArrayRead(tsdata.get_gammavector()->get_vector(), &gamma_arr) );
+	TRYCXX( VecGetArrayRead(tsdata.get_thetavector()->get_vector(), &theta_arr) );
+	TRYCXX( VecGetArrayRead(recovered.get_vector(), &recovered_arr) );
+
+	double diff = 0.0;
+	for(int row=0;row<gamma_size/K;row++){
+		for(int n=0;n<xdim;n++){
+			double value = 0.0;
+			for(int k=0;k<K;k++){
+				value += gamma_arr[row*K+k]*theta_arr[k*xdim+n];
+			}
+			diff = std::max(diff, std::abs(recovered_arr[row*xdim+n] - value));
+		}
+	}
+
+	TRYCXX( VecRestoreArrayRead(recovered.get_vector(), &recovered_arr) );
+	TRYCXX( VecRestoreArrayRead(tsdata.get_thetavector()->get_vector(), &theta_arr) );
+	TRYCXX( VecRestoreArrayRead(tsdata.get_gammavector()->get_vector(), &gamma_arr) );
+
+	MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+	return diff;
+}
+
+/* save and load labels, compare recovered signal with dense sum */
+bool test_labels(int T, int R, int K, int xdim, int DDT_size, int DDR_size, std::string filename, double tol){
+	coutMaster << "- T = " << T << ", R = " << R << ", K = " << K << ", DDT = " << DDT_size << ", DDR = " << DDR_size << std::endl;
+
+	BGMGraphGrid1D<PetscVector> graph(R);
+	graph.process_grid();
+	Decomposition<PetscVector> decomposition(T, graph, K, xdim, DDT_size, DDR_size);
+
+	Vec data_Vec, gamma_Vec, theta_Vec, recovered_Vec;
+	decomposition.createGlobalVec_data(&data_Vec);
+	decomposition.createGlobalVec_gamma(&gamma_Vec);
+	TRYCXX( VecDuplicate(data_Vec, &recovered_Vec) );
+
+	/* Theta is sequential, the same as in TSData */
+	TRYCXX( VecCreateSeq(PETSC_COMM_SELF, K*xdim, &theta_Vec) );
+	for(int i=0;i<K*xdim;i++){
+		TRYCXX( VecSetValue(theta_Vec, i, sin(0.3*i) + 0.1*i, INSERT_VALUES) );
+	}
+	TRYCXX( VecAssemblyBegin(theta_Vec) );
+	TRYCXX( VecAssemblyEnd(theta_Vec) );
+
+	GeneralVector<PetscVector> datavector(data_Vec);
+	GeneralVector<PetscVector> gammavector(gamma_Vec);
+	GeneralVector<PetscVector> thetavector(theta_Vec);
+	GeneralVector<PetscVector> recovered(recovered_Vec);
+
+	TSData<PetscVector> tsdata(decomposition, &datavector, &gammavector, &thetavector);
+
+	bool passed = true;
+
+	/* round trip of labels */
+	Vec gamma_expected_Vec;
+	TRYCXX( VecDuplicate(gamma_Vec, &gamma_expected_Vec) );
+	test_labels_set(gamma_expected_Vec, decomposition);
+	TRYCXX( VecCopy(gamma_expected_Vec, gamma_Vec) );
+
+	tsdata.save_gammalabels(filename);
+	TRYCXX( VecSet(gamma_Vec, 0.0) );
+
+	bool is_labels = TSData<PetscVector>::is_gammalabels_file(filename);
+	tsdata.load_gammalabels(filename);
+
+	double diff;
+	TRYCXX( VecAXPY(gamma_expected_Vec, -1.0, gamma_Vec) );
+	TRYCXX( VecNorm(gamma_expected_Vec, NORM_INFINITY, &diff) );
+	TRYCXX( VecDestroy(&gamma_expected_Vec) );
+
+	coutMaster << "  file with labels          : " << std::setw(15) << printbool(is_labels) << std::endl;
+	coutMaster << "  loaded gamma, max diff    : " << std::setw(15) << diff << std::endl;
+	if(!is_labels || diff > 0.0){
+		passed = false;
+	}
+
+	/* recovered signal from one-hot gamma */
+	diff = test_labels_recovered_diff(tsdata, recovered);
+	coutMaster << "  recovered one-hot, diff   : " << std::setw(15) << diff << std::endl;
+	if(diff > tol){
+		passed = false;
+	}
+
+	/* recovered signal from gamma with rows which are not one-hot */
+	int low, high;
+	double *gamma_arr;
+	TRYCXX( VecGetOwnershipRange(gamma_Vec, &low, &high) );
+	TRYCXX( VecGetArray(gamma_Vec, &gamma_arr) );
+	for(int row=low/K;row<high/K;row++){
+		if(row%3 == 1){
+			for(int k=0;k<K;k++){
+				gamma_arr[row*K+k-low] = 1.0/(double)K;
+			}
+		}
+		if(row%3 == 2){
+			for(int k=0;k<K;k++){
+				gamma_arr[row*K+k-low] *= 0.5;
+			}
+			gamma_arr[row*K-low] += 0.5;
+		}
+	}
+	TRYCXX( VecRestoreArray(gamma_Vec, &gamma_arr) );
+
+	diff = test_labels_recovered_diff(tsdata, recovered);
+	coutMaster << "  recovered dense, diff     : " << std::setw(15) << diff << std::endl;
+	if(diff > tol){
+		passed = false;
+	}
+
+	return passed;
+}
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_T", boost::program_options::value<int>(), "length of time-series [int]")
+		("test_R", boost::program_options::value<int>(), "number of nodes of 1D grid [int]")
+		("test_K_small", boost::program_options::value<int>(), "number of clusters with one byte labels (K <= 256) [int]")
+		("test_K_large", boost::program_options::value<int>(), "number of clusters with two bytes labels (K > 256) [int]")
+		("test_xdim", boost::program_options::value<int>(), "dimension of data [int]")
+		("test_filename", boost::program_options::value< std::string >(), "name of temporary file with labels [string]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of difference of recovered signal [double]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	/* load console arguments */
+	int T, R, K_small, K_large, xdim;
+	std::string filename;
+	double tol;
+	consoleArg.set_option_value("test_T", &T, 20);
+	consoleArg.set_option_value("test_R", &R, 6);
+	consoleArg.set_option_value("test_K_small", &K_small, 5);
+	consoleArg.set_option_value("test_K_large", &K_large, 300);
+	consoleArg.set_option_value("test_xdim", &xdim, 2);
+	consoleArg.set_option_value("test_filename", &filename, "test_tsdata_labels.lbl");
+	consoleArg.set_option_value("test_tol", &tol, 1e-12);
+
+	/* print settings */
+	coutMaster << " test_T                     = " << std::setw(30) << T << " (length of time-series)" << std::endl;
+	coutMaster << " test_R                     = " << std::setw(30) << R << " (number of nodes of 1D grid)" << std::endl;
+	coutMaster << " test_K_small               = " << std::setw(30) << K_small << " (number of clusters with one byte labels)" << std::endl;
+	coutMaster << " test_K_large               = " << std::setw(30) << K_large << " (number of clusters with two bytes labels)" << std::endl;
+	coutMaster << " test_xdim                  = " << std::setw(30) << xdim << " (dimension of data)" << std::endl;
+	coutMaster << " test_filename              = " << std::setw(30) << filename << " (name of temporary file with labels)" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of difference of recovered signal)" << std::endl;
+	coutMaster << std::endl;
+
+	int nproc = GlobalManager.get_size();
+	if(nproc == 1){
+		coutMaster << "WARNING: run the test on more processes to test parallel writing and reading of labels" << std::endl;
+	}
+
+	bool passed = true;
+	passed = test_labels(T, R, K_small, xdim, nproc, 1, filename, tol) && passed;
+	passed = test_labels(T, R, K_small, xdim, 1, nproc, filename, tol) && passed;
+	passed = test_labels(T, R, K_large, xdim, nproc, 1, filename, tol) && passed;
+	passed = test_labels(T, R, K_large, xdim, 1, nproc, filename, tol) && passed;
+	coutMaster << std::endl;
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
+	coutMaster << std::endl;
+
+	Finalize<PetscVector>();
+
+	return passed ? 0 : 1;
+}
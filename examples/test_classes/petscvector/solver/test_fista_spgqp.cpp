@@ -0,0 +1,9 @@
+/** @file test_fista_spgqp.cpp
+ *  @brief compare the minimizers of FISTAQPSolver and SPGQPSolver
+ *
+ *  This is file compilable with standard c++ compiler. It simply includes cuda .cu source file with same name.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "test_fista_spgqp.cu"
@@ -0,0 +1,183 @@
+/** @file test_fista_spgqp.cu
+ *  @brief compare the minimizers of FISTAQPSolver and SPGQPSolver
+ *
+ *  Small strictly convex QP on the product of simplexes is solved by FISTA and by SPG from the same initial approximation.
+ *  The Hessian matrix is tridiagonal (4 on diagonal, -1 off diagonal), therefore the minimizer is unique and both
+ *  solvers have to reach the same point and the same function value.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include <iostream>
+#include <list>
+#include <algorithm>
+
+#include "pascinference.h"
+
+typedef petscvector::PetscVector PetscVector;
+
+using namespace pascinference;
+
+extern int pascinference::DEBUG_MODE;
+
+/* symmetric positive definite matrix given by PETSc matrix */
+class TestQPMatrix : public GeneralMatrix<PetscVector> {
+	private:
+		Mat A_petsc;
+		double lambda_max;
+
+	public:
+		TestQPMatrix(Mat new_A_petsc, double new_lambda_max) : A_petsc(new_A_petsc), lambda_max(new_lambda_max) {};
+
+		std::string get_name() const {
+			return "TestQPMatrix";
+		}
+
+		void matmult(PetscVector &y, const PetscVector &x) const {
+			TRYCXX( MatMult(A_petsc, x.get_vector(), y.get_vector()) );
+		}
+
+		double get_lambda_max() const {
+			return lambda_max;
+		}
+};
+
+/* f(x) = 1/2 x'Ax - b'x */
+double test_fista_spgqp_fx(Mat A_petsc, Vec x_Vec, Vec b_Vec){
+	Vec Ax_Vec;
+	double xAx, bx;
+	TRYCXX( VecDuplicate(x_Vec, &Ax_Vec) );
+	TRYCXX( MatMult(A_petsc, x_Vec, Ax_Vec) );
+	TRYCXX( VecDot(Ax_Vec, x_Vec, &xAx) );
+	TRYCXX( VecDot(b_Vec, x_Vec, &bx) );
+	TRYCXX( VecDestroy(&Ax_Vec) );
+	return 0.5*xAx - bx;
+}
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_T", boost::program_options::value<int>(), "number of simplexes [int]")
+		("test_K", boost::program_options::value<int>(), "dimension of simplex [int]")
+		("test_eps", boost::program_options::value<double>(), "precision of solvers [double]")
+		("test_maxit", boost::program_options::value<int>(), "maximum number of iterations of solvers [int]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of difference of minimizers [double]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	/* load console arguments */
+	int T, K, maxit;
+	double eps, tol;
+	consoleArg.set_option_value("test_T", &T, 10);
+	consoleArg.set_option_value("test_K", &K, 3);
+	consoleArg.set_option_value("test_eps", &eps, 1e-12);
+	consoleArg.set_option_value("test_maxit", &maxit, 10000);
+	consoleArg.set_option_value("test_tol", &tol, 1e-5);
+
+	/* print settings */
+	coutMaster << " test_T                     = " << std::setw(30) << T << " (number of simplexes)" << std::endl;
+	coutMaster << " test_K                     = " << std::setw(30) << K << " (dimension of simplex)" << std::endl;
+	coutMaster << " test_eps                   = " << std::setw(30) << eps << " (precision of solvers)" << std::endl;
+	coutMaster << " test_maxit                 = " << std::setw(30) << maxit << " (maximum number of iterations of solvers)" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of difference of minimizers)" << std::endl;
+	coutMaster << std::endl;
+
+	/* layout of vectors, simplexes are not divided between processes */
+	Decomposition<PetscVector> decomposition(T, 1, K, 1, GlobalManager.get_size());
+	int n = T*K;
+
+	Vec b_Vec, x_fista_Vec, x_spg_Vec;
+	decomposition.createGlobalVec_gamma(&b_Vec);
+	TRYCXX( VecDuplicate(b_Vec, &x_fista_Vec) );
+	TRYCXX( VecDuplicate(b_Vec, &x_spg_Vec) );
+
+	/* deterministic linear term, feasible initial approximation */
+	int low, high;
+	TRYCXX( VecGetOwnershipRange(b_Vec, &low, &high) );
+	for(int i=low;i<high;i++){
+		TRYCXX( VecSetValue(b_Vec, i, 3.0*sin(0.9*i) + cos(2.3*i), INSERT_VALUES) );
+	}
+	TRYCXX( VecAssemblyBegin(b_Vec) );
+	TRYCXX( VecAssemblyEnd(b_Vec) );
+	TRYCXX( VecSet(x_fista_Vec, 1.0/(double)K) );
+	TRYCXX( VecSet(x_spg_Vec, 1.0/(double)K) );
+
+	/* tridiagonal Hessian matrix, Gershgorin bound of the largest eigenvalue is 6 */
+	Mat A_petsc;
+	TRYCXX( MatCreate(PETSC_COMM_WORLD, &A_petsc) );
+	TRYCXX( MatSetSizes(A_petsc, high-low, high-low, n, n) );
+#ifdef USE_CUDA
+	TRYCXX( MatSetType(A_petsc, MATAIJCUSPARSE) );
+#else
+	TRYCXX( MatSetType(A_petsc, MATMPIAIJ) );
+#endif
+	TRYCXX( MatMPIAIJSetPreallocation(A_petsc, 3, NULL, 2, NULL) );
+	TRYCXX( MatSeqAIJSetPreallocation(A_petsc, 3, NULL) );
+	for(int i=low;i<high;i++){
+		TRYCXX( MatSetValue(A_petsc, i, i, 4.0, INSERT_VALUES) );
+		if(i > 0) TRYCXX( MatSetValue(A_petsc, i, i-1, -1.0, INSERT_VALUES) );
+		if(i < n-1) TRYCXX( MatSetValue(A_petsc, i, i+1, -1.0, INSERT_VALUES) );
+	}
+	TRYCXX( MatAssemblyBegin(A_petsc, MAT_FINAL_ASSEMBLY) );
+	TRYCXX( MatAssemblyEnd(A_petsc, MAT_FINAL_ASSEMBLY) );
+	TestQPMatrix A(A_petsc, 6.0);
+
+	GeneralVector<PetscVector> b(b_Vec);
+	GeneralVector<PetscVector> x_fista(x_fista_Vec);
+	GeneralVector<PetscVector> x_spg(x_spg_Vec);
+
+	/* solve by FISTA */
+	QPData<PetscVector> qpdata_fista;
+	qpdata_fista.set_A(&A);
+	qpdata_fista.set_b(&b);
+	qpdata_fista.set_x0(&x_fista);
+	qpdata_fista.set_x(&x_fista);
+	qpdata_fista.set_feasibleset(new SimplexFeasibleSet_Local<PetscVector>(decomposition.get_Tlocal(), K));
+
+	FISTAQPSolver<PetscVector> solver_fista(qpdata_fista);
+	solver_fista.set_eps(eps);
+	solver_fista.set_maxit(maxit);
+	solver_fista.solve();
+
+	/* solve by SPG */
+	QPData<PetscVector> qpdata_spg;
+	qpdata_spg.set_A(&A);
+	qpdata_spg.set_b(&b);
+	qpdata_spg.set_x0(&x_spg);
+	qpdata_spg.set_x(&x_spg);
+	qpdata_spg.set_feasibleset(new SimplexFeasibleSet_Local<PetscVector>(decomposition.get_Tlocal(), K));
+
+	SPGQPSolver<PetscVector> solver_spg(qpdata_spg);
+	solver_spg.set_eps(eps);
+	solver_spg.set_maxit(maxit);
+	solver_spg.solve();
+
+	/* compare minimizers and function values */
+	double fx_fista = test_fista_spgqp_fx(A_petsc, x_fista_Vec, b_Vec);
+	double fx_spg = test_fista_spgqp_fx(A_petsc, x_spg_Vec, b_Vec);
+
+	double diff;
+	TRYCXX( VecAXPY(x_fista_Vec, -1.0, x_spg_Vec) );
+	TRYCXX( VecNorm(x_fista_Vec, NORM_INFINITY, &diff) );
+
+	coutMaster << "- FISTA: it = " << std::setw(6) << solver_fista.get_it() << ", fx = " << std::setw(15) << fx_fista << std::endl;
+	coutMaster << "- SPG  : it = " << std::setw(6) << solver_spg.get_it() << ", fx = " << std::setw(15) << fx_spg << std::endl;
+	coutMaster << "- max difference of minimizers : " << std::setw(15) << diff << std::endl;
+
+	bool passed = (diff <= tol && std::abs(fx_fista - fx_spg) <= tol*std::max(std::abs(fx_spg), 1.0));
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
+	coutMaster << std::endl;
+
+	TRYCXX( MatDestroy(&A_petsc) );
+
+	Finalize<PetscVector>();
+
+	return passed ? 0 : 1;
+}
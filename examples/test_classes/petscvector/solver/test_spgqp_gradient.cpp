@@ -0,0 +1,9 @@
+/** @file test_spgqp_gradient.cpp
+ *  @brief test the gradient published by SPGQPSolver
+ *
+ *  This is file compilable with standard c++ compiler. It simply includes cuda .cu source file with same name.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "test_spgqp_gradient.cu"
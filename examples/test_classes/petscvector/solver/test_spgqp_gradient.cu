@@ -0,0 +1,155 @@
+/** @file test_spgqp_gradient.cu
+ *  @brief test the gradient published by SPGQPSolver
+ *
+ *  GraphH1FEMModel derives A*gamma for the update of Theta from the gradient g = A*gamma - b published by gamma solver
+ *  instead of new multiplication. This test solves QP with BlockGraphSparseMatrix with Theta (different from 1) in penalty
+ *  and compares the result (g + b)_k*alpha/scaling_k with the multiplication by the matrix with Theta equal to 1.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include <iostream>
+#include <list>
+#include <algorithm>
+
+#include "pascinference.h"
+
+typedef petscvector::PetscVector PetscVector;
+
+using namespace pascinference;
+
+extern int pascinference::DEBUG_MODE;
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_T", boost::program_options::value<int>(), "length of time-series [int]")
+		("test_R", boost::program_options::value<int>(), "number of nodes of 1D grid [int]")
+		("test_K", boost::program_options::value<int>(), "number of clusters [int]")
+		("test_alpha", boost::program_options::value<double>(), "coefficient of the matrix [double]")
+		("test_theta", boost::program_options::value<double>(), "Theta_k = test_theta*(k+1) [double]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of relative difference [double]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	/* load console arguments */
+	int T, R, K;
+	double alpha, theta, tol;
+	consoleArg.set_option_value("test_T", &T, 20);
+	consoleArg.set_option_value("test_R", &R, 5);
+	consoleArg.set_option_value("test_K", &K, 3);
+	consoleArg.set_option_value("test_alpha", &alpha, 10.0);
+	consoleArg.set_option_value("test_theta", &theta, 0.7);
+	consoleArg.set_option_value("test_tol", &tol, 1e-10);
+
+	/* print settings */
+	coutMaster << " test_T                     = " << std::setw(30) << T << " (length of time-series)" << std::endl;
+	coutMaster << " test_R                     = " << std::setw(30) << R << " (number of nodes of 1D grid)" << std::endl;
+	coutMaster << " test_K                     = " << std::setw(30) << K << " (number of clusters)" << std::endl;
+	coutMaster << " test_alpha                 = " << std::setw(30) << alpha << " (coeficient of the matrix)" << std::endl;
+	coutMaster << " test_theta                 = " << std::setw(30) << theta << " (Theta_k = test_theta*(k+1))" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of relative difference)" << std::endl;
+	coutMaster << std::endl;
+
+	/* graph and decomposition in time */
+	BGMGraphGrid1D<PetscVector> graph(R);
+	graph.process_grid();
+	Decomposition<PetscVector> decomposition(T, graph, K, 1, GlobalManager.get_size(), 1);
+
+	/* Theta is sequential, the same as in TSData */
+	Vec theta_Vec;
+	TRYCXX( VecCreateSeq(PETSC_COMM_SELF, K, &theta_Vec) );
+	for(int k=0;k<K;k++){
+		TRYCXX( VecSetValue(theta_Vec, k, theta*(k+1), INSERT_VALUES) );
+	}
+	TRYCXX( VecAssemblyBegin(theta_Vec) );
+	TRYCXX( VecAssemblyEnd(theta_Vec) );
+	GeneralVector<PetscVector> thetavector(theta_Vec);
+
+	/* QP problem with Theta in penalty, the same as in GraphH1FEMModel */
+	Vec gamma_Vec;
+	decomposition.createGlobalVec_gamma(&gamma_Vec);
+	GeneralVector<PetscVector> gamma(gamma_Vec);
+	GeneralVector<PetscVector> b(gamma);
+	GeneralVector<PetscVector> Agamma(gamma);
+	gamma.set_random();
+	b.set_random();
+
+	BlockGraphSparseMatrix<PetscVector> A(decomposition, alpha, &thetavector);
+
+	QPData<PetscVector> qpdata;
+	qpdata.set_A(&A);
+	qpdata.set_b(&b);
+	qpdata.set_x0(&gamma);
+	qpdata.set_x(&gamma);
+	qpdata.set_feasibleset(new SimplexFeasibleSet_Local<PetscVector>(decomposition.get_Tlocal()*decomposition.get_Rlocal(), K));
+
+	SPGQPSolver<PetscVector> solver(qpdata);
+	solver.solve();
+
+	bool passed = true;
+
+	/* the gradient has to correspond to actual gamma */
+	PetscObjectState gamma_state;
+	TRYCXX( PetscObjectStateGet((PetscObject)gamma_Vec, &gamma_state) );
+	const std::vector<double> &scaling = qpdata.get_gradient_scaling();
+	if(qpdata.get_gradient() == NULL || gamma_state != qpdata.get_gradient_state() || (int)scaling.size() != K){
+		coutMaster << "- gradient is not published" << std::endl;
+		passed = false;
+	} else {
+		/* A*gamma with Theta equal to 1 by multiplication, this is the path without the gradient */
+		TRYCXX( VecSet(theta_Vec, 1.0) );
+		Agamma = A*gamma;
+		for(int k=0;k<K;k++){
+			TRYCXX( VecSetValue(theta_Vec, k, theta*(k+1), INSERT_VALUES) );
+		}
+		TRYCXX( VecAssemblyBegin(theta_Vec) );
+		TRYCXX( VecAssemblyEnd(theta_Vec) );
+
+		/* A*gamma derived from the gradient */
+		const double *g_arr;
+		const double *b_arr;
+		const double *Agamma_arr;
+		TRYCXX( VecGetArrayRead(qpdata.get_gradient()->get_vector(), &g_arr) );
+		TRYCXX( VecGetArrayRead(b.get_vector(), &b_arr) );
+		TRYCXX( VecGetArrayRead(Agamma.get_vector(), &Agamma_arr) );
+
+		double diff_local = 0.0;
+		double norm_local = 0.0;
+		int TRlocal = decomposition.get_Tlocal()*decomposition.get_Rlocal();
+		for(int row=0;row<TRlocal;row++){
+			for(int k=0;k<K;k++){
+				double value = (g_arr[row*K+k] + b_arr[row*K+k])*alpha/scaling[k];
+				diff_local = std::max(diff_local, std::abs(value - Agamma_arr[row*K+k]));
+				norm_local = std::max(norm_local, std::abs(Agamma_arr[row*K+k]));
+			}
+		}
+
+		TRYCXX( VecRestoreArrayRead(Agamma.get_vector(), &Agamma_arr) );
+		TRYCXX( VecRestoreArrayRead(b.get_vector(), &b_arr) );
+		TRYCXX( VecRestoreArrayRead(qpdata.get_gradient()->get_vector(), &g_arr) );
+
+		double diff, norm;
+		MPI_Allreduce(&diff_local, &diff, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+		MPI_Allreduce(&norm_local, &norm, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+		coutMaster << "- max|A*gamma|              : " << std::setw(15) << norm << std::endl;
+		coutMaster << "- max difference            : " << std::setw(15) << diff << std::endl;
+		if(diff > tol*std::max(norm, 1.0)){
+			passed = false;
+		}
+	}
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
+	coutMaster << std::endl;
+
+	Finalize<PetscVector>();
+
+	return passed ? 0 : 1;
+}
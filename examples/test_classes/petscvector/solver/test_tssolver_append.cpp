@@ -0,0 +1,9 @@
+/** @file test_tssolver_append.cpp
+ *  @brief test the sliding time window of TSData and the warm start of TSSolver
+ *
+ *  This is file compilable with standard c++ compiler. It simply includes cuda .cu source file with same name.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "test_tssolver_append.cu"
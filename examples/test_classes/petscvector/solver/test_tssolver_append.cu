@@ -0,0 +1,229 @@
+/** @file test_tssolver_append.cu
+ *  @brief test the sliding time window of TSData and the warm start of TSSolver
+ *
+ *  At first, the data and gamma on 1D grid (more nodes and more processes) are set to known values given by time step,
+ *  original index of node and component; after TSData::append_samples the shifted values and new samples have to be
+ *  at the right positions of the layout of decomposition.
+ *  Then 1D signal problem is solved in the first window (cold start), the window is moved and the problem is solved again from
+ *  shifted gamma (warm start). The recovered signal has to be close to the signal without noise.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include <iostream>
+#include <list>
+#include <algorithm>
+
+#include "pascinference.h"
+
+typedef petscvector::PetscVector PetscVector;
+
+using namespace pascinference;
+
+extern int pascinference::DEBUG_MODE;
+
+/* known values in node r_orig at time t */
+double test_append_value(int t, int r_orig, int n){
+	return 1000.0*t + 10.0*r_orig + n;
+}
+
+/* maximum difference of vector in layout of decomposition [t*R*blocksize + Pr(r)*blocksize + n] from expected values */
+double test_append_diff(Vec x_Vec, const Decomposition<PetscVector> &decomposition, int blocksize, int shift){
+	int R = decomposition.get_R();
+
+	int low, high;
+	const double *x_arr;
+	TRYCXX( VecGetOwnershipRange(x_Vec, &low, &high) );
+	TRYCXX( VecGetArrayRead(x_Vec, &x_arr) );
+
+	double diff = 0.0;
+	for(int i=low;i<high;i++){
+		int t = i/(R*blocksize);
+		int r_orig = decomposition.get_invPr((i/blocksize)%R);
+		int n = i%blocksize;
+		diff = std::max(diff, std::abs(x_arr[i-low] - test_append_value(t + shift, r_orig, n)));
+	}
+	TRYCXX( VecRestoreArrayRead(x_Vec, &x_arr) );
+
+	MPI_Allreduce(MPI_IN_PLACE, &diff, 1, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+	return diff;
+}
+
+/* set vector in layout of decomposition to known values */
+void test_append_set(Vec x_Vec, const Decomposition<PetscVector> &decomposition, int blocksize){
+	int R = decomposition.get_R();
+
+	int low, high;
+	double *x_arr;
+	TRYCXX( VecGetOwnershipRange(x_Vec, &low, &high) );
+	TRYCXX( VecGetArray(x_Vec, &x_arr) );
+	for(int i=low;i<high;i++){
+		x_arr[i-low] = test_append_value(i/(R*blocksize), decomposition.get_invPr((i/blocksize)%R), i%blocksize);
+	}
+	TRYCXX( VecRestoreArray(x_Vec, &x_arr) );
+}
+
+/* noiseless piecewise constant signal with two levels */
+double test_append_signal(int t){
+	return ((t/25)%2 == 0)? 0.0 : 1.0;
+}
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_T", boost::program_options::value<int>(), "length of time window [int]")
+		("test_R", boost::program_options::value<int>(), "number of nodes of 1D grid [int]")
+		("test_K", boost::program_options::value<int>(), "number of clusters in the test of layout [int]")
+		("test_xdim", boost::program_options::value<int>(), "dimension of data in the test of layout [int]")
+		("test_shift", boost::program_options::value<int>(), "number of new samples [int]")
+		("test_epssqr", boost::program_options::value<double>(), "penalty parameter of signal problem [double]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of mean error of recovered signal [double]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	/* load console arguments */
+	int T, R, K, xdim, shift;
+	double epssqr, tol;
+	consoleArg.set_option_value("test_T", &T, 200);
+	consoleArg.set_option_value("test_R", &R, 5);
+	consoleArg.set_option_value("test_K", &K, 3);
+	consoleArg.set_option_value("test_xdim", &xdim, 2);
+	consoleArg.set_option_value("test_shift", &shift, 30);
+	consoleArg.set_option_value("test_epssqr", &epssqr, 10.0);
+	consoleArg.set_option_value("test_tol", &tol, 0.05);
+
+	/* print settings */
+	coutMaster << " test_T                     = " << std::setw(30) << T << " (length of time window)" << std::endl;
+	coutMaster << " test_R                     = " << std::setw(30) << R << " (number of nodes of 1D grid)" << std::endl;
+	coutMaster << " test_K                     = " << std::setw(30) << K << " (number of clusters in the test of layout)" << std::endl;
+	coutMaster << " test_xdim                  = " << std::setw(30) << xdim << " (dimension of data in the test of layout)" << std::endl;
+	coutMaster << " test_shift                 = " << std::setw(30) << shift << " (number of new samples)" << std::endl;
+	coutMaster << " test_epssqr                = " << std::setw(30) << epssqr << " (penalty parameter of signal problem)" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of mean error of recovered signal)" << std::endl;
+	coutMaster << std::endl;
+
+	bool passed = true;
+
+	/* ----- layout of shifted data and gamma ----- */
+	{
+		BGMGraphGrid1D<PetscVector> graph(R);
+		graph.process_grid();
+		Decomposition<PetscVector> decomposition(T, graph, K, xdim, GlobalManager.get_size(), 1);
+
+		Vec data_Vec;
+		Vec gamma_Vec;
+		decomposition.createGlobalVec_data(&data_Vec);
+		decomposition.createGlobalVec_gamma(&gamma_Vec);
+		GeneralVector<PetscVector> datavector(data_Vec);
+		GeneralVector<PetscVector> gammavector(gamma_Vec);
+
+		TSData<PetscVector> tsdata(decomposition, &datavector, &gammavector, NULL);
+
+		test_append_set(data_Vec, decomposition, xdim);
+		test_append_set(gamma_Vec, decomposition, K);
+
+		/* new samples continue in time, original ordering of nodes */
+		std::vector<double> values(shift*R*xdim);
+		for(int t=0;t<shift;t++){
+			for(int r=0;r<R;r++){
+				for(int n=0;n<xdim;n++){
+					values[t*R*xdim + r*xdim + n] = test_append_value(T + t, r, n);
+				}
+			}
+		}
+
+		tsdata.append_samples(&values[0], shift);
+
+		double diff_data = test_append_diff(data_Vec, decomposition, xdim, shift);
+
+		/* gamma of new time steps is the gamma from the last time step before shift */
+		Vec gamma_expected_Vec;
+		TRYCXX( VecDuplicate(gamma_Vec, &gamma_expected_Vec) );
+		{
+			int low, high;
+			double *arr;
+			TRYCXX( VecGetOwnershipRange(gamma_expected_Vec, &low, &high) );
+			TRYCXX( VecGetArray(gamma_expected_Vec, &arr) );
+			for(int i=low;i<high;i++){
+				int t = std::min(i/(R*K) + shift, T-1);
+				arr[i-low] = test_append_value(t, decomposition.get_invPr((i/K)%R), i%K);
+			}
+			TRYCXX( VecRestoreArray(gamma_expected_Vec, &arr) );
+		}
+		TRYCXX( VecAXPY(gamma_expected_Vec, -1.0, gamma_Vec) );
+		double diff_gamma;
+		TRYCXX( VecNorm(gamma_expected_Vec, NORM_INFINITY, &diff_gamma) );
+		TRYCXX( VecDestroy(&gamma_expected_Vec) );
+
+		coutMaster << "- shifted data, max difference  : " << std::setw(15) << diff_data << std::endl;
+		coutMaster << "- shifted gamma, max difference : " << std::setw(15) << diff_gamma << std::endl;
+		if(diff_data > 0.0 || diff_gamma > 0.0){
+			passed = false;
+		}
+	}
+
+	/* ----- cold and warm solution of signal problem ----- */
+	{
+		/* whole signal with deterministic noise, the same on all processes */
+		std::vector<double> signal(T + shift);
+		for(int t=0;t<T+shift;t++){
+			signal[t] = test_append_signal(t) + 0.2*sin(1.7*t);
+		}
+
+		Decomposition<PetscVector> decomposition(T, 1, 2, 1, GlobalManager.get_size());
+
+		TSData<PetscVector> tsdata(decomposition);
+		tsdata.append_samples(&signal[0], T);
+
+		GraphH1FEMModel<PetscVector> model(tsdata, epssqr);
+		TSSolver<PetscVector> solver(tsdata);
+
+		Vec recovered_Vec;
+		TRYCXX( VecDuplicate(tsdata.get_datavector()->get_vector(), &recovered_Vec) );
+		GeneralVector<PetscVector> recovered(recovered_Vec);
+
+		for(int window=0;window<2;window++){
+			int t_begin = window*shift;
+
+			if(window > 0){
+				tsdata.append_samples(&signal[T], shift);
+				solver.set_init_permute(false);
+				solver.set_annealing(1);
+			}
+
+			solver.solve();
+			tsdata.compute_recovered(recovered);
+
+			/* mean error against the signal without noise, 1D signal is not permuted by decomposition */
+			int low, high;
+			const double *arr;
+			double abserr = 0.0;
+			TRYCXX( VecGetOwnershipRange(recovered_Vec, &low, &high) );
+			TRYCXX( VecGetArrayRead(recovered_Vec, &arr) );
+			for(int i=low;i<high;i++){
+				abserr += std::abs(arr[i-low] - test_append_signal(t_begin + i));
+			}
+			TRYCXX( VecRestoreArrayRead(recovered_Vec, &arr) );
+			MPI_Allreduce(MPI_IN_PLACE, &abserr, 1, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+			abserr = abserr/(double)T;
+
+			coutMaster << "- " << (window == 0 ? "cold" : "warm") << " start: it = " << std::setw(6) << solver.get_it() << ", abserr/T = " << std::setw(15) << abserr << std::endl;
+			if(abserr > tol){
+				passed = false;
+			}
+		}
+	}
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
+	coutMaster << std::endl;
+
+	Finalize<PetscVector>();
+
+	return passed ? 0 : 1;
+}
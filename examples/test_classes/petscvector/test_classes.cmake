@@ -31,6 +31,7 @@ option(TEST_PETSCVECTOR_ALGEBRA_BLOCKLAPLACESPARSEMATRIX "TEST_PETSCVECTOR_ALGEB
 option(TEST_PETSCVECTOR_ALGEBRA_DECOMPOSITION		  "TEST_PETSCVECTOR_ALGEBRA_DECOMPOSITION" OFF)
 option(TEST_PETSCVECTOR_ALGEBRA_FILECRSMATRIX		  "TEST_PETSCVECTOR_ALGEBRA_FILECRSMATRIX" OFF)
 option(TEST_PETSCVECTOR_ALGEBRA_LOCALDENSEMATRIX	  "TEST_PETSCVECTOR_ALGEBRA_LOCALDENSEMATRIX" OFF)
+option(TEST_PETSCVECTOR_ALGEBRA_PETSCVECTOREXPR		  "TEST_PETSCVECTOR_ALGEBRA_PETSCVECTOREXPR" OFF)
 option(TEST_PETSCVECTOR_ALGEBRA_SIMPLEXFEASIBLESETLOCAL "TEST_PETSCVECTOR_ALGEBRA_SIMPLEXFEASIBLESETLOCAL" OFF)
 if(${TEST_PETSCVECTOR_ALGEBRA})
 	# define shortcut to compile all tests of this group
@@ -50,6 +51,7 @@ option(TEST_PETSCVECTOR_DATA_QP						  "TEST_PETSCVECTOR_DATA_QP" OFF)
 option(TEST_PETSCVECTOR_DATA_SIGNAL1D				  "TEST_PETSCVECTOR_DATA_SIGNAL1D" OFF)
 option(TEST_PETSCVECTOR_DATA_SIMPLE					  "TEST_PETSCVECTOR_DATA_SIMPLE" OFF)
 option(TEST_PETSCVECTOR_DATA_TS						  "TEST_PETSCVECTOR_DATA_TS" OFF)
+option(TEST_PETSCVECTOR_DATA_TSLABELS				  "TEST_PETSCVECTOR_DATA_TSLABELS" OFF)
 if(${TEST_PETSCVECTOR_DATA})
 	# define shortcut to compile all tests of this group
 	getListOfVarsStartingWith("TEST_PETSCVECTOR_DATA_" matchedVars)
@@ -74,9 +76,12 @@ endif()
 option(TEST_PETSCVECTOR_SOLVER						"TEST_PETSCVECTOR_SOLVER" OFF)
 option(TEST_PETSCVECTOR_SOLVER_CGQP					  "TEST_PETSCVECTOR_SOLVER_CGQP" OFF)
 option(TEST_PETSCVECTOR_SOLVER_DIAG					  "TEST_PETSCVECTOR_SOLVER_DIAG" OFF)
+option(TEST_PETSCVECTOR_SOLVER_FISTASPGQP			  "TEST_PETSCVECTOR_SOLVER_FISTASPGQP" OFF)
 option(TEST_PETSCVECTOR_SOLVER_MULTICG				  "TEST_PETSCVECTOR_SOLVER_MULTICG" OFF)
 option(TEST_PETSCVECTOR_SOLVER_SIMPLE				  "TEST_PETSCVECTOR_SOLVER_SIMPLE" OFF)
 option(TEST_PETSCVECTOR_SOLVER_SPGQP				  "TEST_PETSCVECTOR_SOLVER_SPGQP" OFF)
+option(TEST_PETSCVECTOR_SOLVER_SPGQPGRADIENT		  "TEST_PETSCVECTOR_SOLVER_SPGQPGRADIENT" OFF)
+option(TEST_PETSCVECTOR_SOLVER_TSSOLVERAPPEND		  "TEST_PETSCVECTOR_SOLVER_TSSOLVERAPPEND" OFF)
 if(${TEST_PETSCVECTOR_SOLVER})
 	# define shortcut to compile all tests of this group
 	getListOfVarsStartingWith("TEST_PETSCVECTOR_SOLVER_" matchedVars)
@@ -132,6 +137,7 @@ printinfo_onoff("     TEST_PETSCVECTOR_ALGEBRA_DOT                          (dot
 #printinfo_onoff("     TEST_PETSCVECTOR_ALGEBRA_FILECRSMATRIX                (FileCRSMatrix)            " "${TEST_PETSCVECTOR_ALGEBRA_FILECRSMATRIX}")
 #printinfo_onoff("     TEST_PETSCVECTOR_ALGEBRA_PETSCVECTOR                  (PetscVector)              " "${TEST_PETSCVECTOR_ALGEBRA_PETSCVECTOR}")
 #printinfo_onoff("     TEST_PETSCVECTOR_ALGEBRA_LOCALDENSEMATRIX             (LocalDenseMatrix)         " "${TEST_PETSCVECTOR_ALGEBRA_LOCALDENSEMATRIX}")
+#printinfo_onoff("     TEST_PETSCVECTOR_ALGEBRA_PETSCVECTOREXPR              (lazy expressions)         " "${TEST_PETSCVECTOR_ALGEBRA_PETSCVECTOREXPR}")
 #printinfo_onoff("     TEST_PETSCVECTOR_ALGEBRA_SIMPLEXFEASIBLESETLOCAL      (SimplexFeasibleSet_Local) " "${TEST_PETSCVECTOR_ALGEBRA_SIMPLEXFEASIBLESETLOCAL}")
 printinfo_onoff("   TEST_PETSCVECTOR_DATA                                 (...)                        " "${TEST_PETSCVECTOR_DATA}")
 #printinfo_onoff("     TEST_PETSCVECTOR_DATA_DIAG                            (DiagData)                 " "${TEST_PETSCVECTOR_DATA_DIAG}")
@@ -142,15 +148,19 @@ printinfo_onoff("   TEST_PETSCVECTOR_DATA                                 (...)
 #printinfo_onoff("     TEST_PETSCVECTOR_DATA_SIGNAL1D                        (Signal1DData)             " "${TEST_PETSCVECTOR_DATA_SIGNAL1D}")
 #printinfo_onoff("     TEST_PETSCVECTOR_DATA_SIMPLE                          (SimpleData)               " "${TEST_PETSCVECTOR_DATA_SIMPLE}")
 #printinfo_onoff("     TEST_PETSCVECTOR_DATA_TS                              (TSData)                   " "${TEST_PETSCVECTOR_DATA_TS}")
+#printinfo_onoff("     TEST_PETSCVECTOR_DATA_TSLABELS                        (TSData labels)            " "${TEST_PETSCVECTOR_DATA_TSLABELS}")
 printinfo_onoff("   TEST_PETSCVECTOR_MODEL                                (...)                        " "${TEST_PETSCVECTOR_MODEL}")
 #printinfo_onoff("     TEST_PETSCVECTOR_MODEL_GRAPHH1FEM                     (GraphH1FEMModel)          " "${TEST_PETSCVECTOR_MODEL_GRAPHH1FEM}")
 #printinfo_onoff("     TEST_PETSCVECTOR_MODEL_KMEANSH1FEM                    (KmeansH1FEMModel)         " "${TEST_PETSCVECTOR_MODEL_KMEANSH1FEM}")
 printinfo_onoff("   TEST_PETSCVECTOR_SOLVER                               (...)                        " "${TEST_PETSCVECTOR_SOLVER}")
 #printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_CGQP                          (CGQPSolver)               " "${TEST_PETSCVECTOR_SOLVER_CGQP}")
 #printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_DIAG                          (DiagSolver)               " "${TEST_PETSCVECTOR_SOLVER_DIAG}")
+#printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_FISTASPGQP                    (FISTA and SPGQPSolver)    " "${TEST_PETSCVECTOR_SOLVER_FISTASPGQP}")
 #printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_MULTICG                       (MultiCGSolver)            " "${TEST_PETSCVECTOR_SOLVER_MULTICG}")
 #printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_SIMPLE                        (SimpleSolver)             " "${TEST_PETSCVECTOR_SOLVER_SIMPLE}")
 #printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_SPGQP                         (SPGQPSolver)              " "${TEST_PETSCVECTOR_SOLVER_SPGQP}")
+#printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_SPGQPGRADIENT                 (SPGQPSolver gradient)     " "${TEST_PETSCVECTOR_SOLVER_SPGQPGRADIENT}")
+#printinfo_onoff("     TEST_PETSCVECTOR_SOLVER_TSSOLVERAPPEND                (TSSolver sliding window)  " "${TEST_PETSCVECTOR_SOLVER_TSSOLVERAPPEND}")
 printinfo_onoff("   TEST_PETSCVECTOR_DLIB                                 (...)                        " "${TEST_PETSCVECTOR_DLIB}")
 #printinfo_onoff("     TEST_PETSCVECTOR_DLIB_ANNA                            (benchmark from Anna)      " "${TEST_PETSCVECTOR_DLIB_ANNA}")
 #printinfo_onoff("     TEST_PETSCVECTOR_DLIB_INTEGRAL                        (numerical integration)    " "${TEST_PETSCVECTOR_DLIB_INTEGRAL}")
@@ -211,6 +221,15 @@ if(${TEST_PETSCVECTOR_ALGEBRA_DOT})
 	
 endif()
 
+if(${TEST_PETSCVECTOR_ALGEBRA_PETSCVECTOREXPR})
+	# lazy expressions compared with eager operations
+	if(${USE_CUDA})
+		testadd_executable("test_classes/petscvector/algebra/test_petscvectorexpr.cu" "test_petscvector_petscvectorexpr")
+	else()
+		testadd_executable("test_classes/petscvector/algebra/test_petscvectorexpr.cpp" "test_petscvector_petscvectorexpr")
+	endif()
+endif()
+
 if(${TEST_PETSCVECTOR_ALGEBRA_BGMGRAPH})
 	# BGMGraph
 	if(${USE_CUDA})
@@ -256,10 +275,44 @@ if(${TEST_PETSCVECTOR_ALGEBRA_BLOCKGRAPHSPARSEMATRIX})
 endif()
 
 # ----- DATA -----
+if(${TEST_PETSCVECTOR_DATA_TSLABELS})
+	# labels of clusters in TSData and recovered signal
+	if(${USE_CUDA})
+		testadd_executable("test_classes/petscvector/data/test_tsdata_labels.cu" "test_petscvector_tsdata_labels")
+	else()
+		testadd_executable("test_classes/petscvector/data/test_tsdata_labels.cpp" "test_petscvector_tsdata_labels")
+	endif()
+endif()
 
 # ----- MODEL -----
 
 # ----- SOLVER -----
+if(${TEST_PETSCVECTOR_SOLVER_FISTASPGQP})
+	# FISTAQPSolver and SPGQPSolver reach the same minimizer
+	if(${USE_CUDA})
+		testadd_executable("test_classes/petscvector/solver/test_fista_spgqp.cu" "test_petscvector_fista_spgqp")
+	else()
+		testadd_executable("test_classes/petscvector/solver/test_fista_spgqp.cpp" "test_petscvector_fista_spgqp")
+	endif()
+endif()
+
+if(${TEST_PETSCVECTOR_SOLVER_SPGQPGRADIENT})
+	# gradient published by SPGQPSolver and A*gamma used in update of Theta
+	if(${USE_CUDA})
+		testadd_executable("test_classes/petscvector/solver/test_spgqp_gradient.cu" "test_petscvector_spgqp_gradient")
+	else()
+		testadd_executable("test_classes/petscvector/solver/test_spgqp_gradient.cpp" "test_petscvector_spgqp_gradient")
+	endif()
+endif()
+
+if(${TEST_PETSCVECTOR_SOLVER_TSSOLVERAPPEND})
+	# sliding time window of TSData and warm start of TSSolver
+	if(${USE_CUDA})
+		testadd_executable("test_classes/petscvector/solver/test_tssolver_append.cu" "test_petscvector_tssolver_append")
+	else()
+		testadd_executable("test_classes/petscvector/solver/test_tssolver_append.cpp" "test_petscvector_tssolver_append")
+	endif()
+endif()
 
 # ----- DLIB ------
 if(${TEST_PETSCVECTOR_DLIB_ANNA})
@@ -0,0 +1,246 @@
+/** @file test_kernels.cpp
+ *  @brief compare the kernels of SeqArrayVector with scalar reference
+ *
+ *  Vector operations, multiplication by BlockGraphSparseMatrix and the projection onto simplex
+ *  are computed with SeqArrayVector and with plain sequential loops from the same values and the results are compared.
+ *  The reference matrix is assembled entry by entry in the same way as the PETSc variant of BlockGraphSparseMatrix.
+ *  Use test_n larger than SEQARRAYVECTOR_PARALLEL_MIN to test threaded kernels.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include <iostream>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "pascinference.h"
+
+using namespace pascinference;
+
+/* maximum difference of arrays */
+double test_kernels_diff(const double *arr1, const double *arr2, int n){
+	double diff = 0.0;
+	for(int i=0;i<n;i++){
+		diff = std::max(diff, std::abs(arr1[i] - arr2[i]));
+	}
+	return diff;
+}
+
+/* compare array of SeqArrayVector with reference values and print the result */
+bool test_kernels_compare(std::string name, const SeqArrayVector &x, const std::vector<double> &x_ref, double tol){
+	double diff = test_kernels_diff(x.get_array(), &x_ref[0], x.size());
+
+	bool passed = (diff <= tol);
+	coutMaster << " - " << std::setw(12) << name << ": diff = " << std::setw(15) << diff << (passed? "" : " FAILED") << std::endl;
+	return passed;
+}
+
+/* compare scalars and print the result */
+bool test_kernels_compare(std::string name, double value, double value_ref, double tol){
+	double diff = std::abs(value - value_ref);
+	bool passed = (diff <= tol*std::max(std::abs(value_ref), 1.0));
+	coutMaster << " - " << std::setw(12) << name << ": diff = " << std::setw(15) << diff << (passed? "" : " FAILED") << std::endl;
+	return passed;
+}
+
+/* projection of one subset onto simplex, sort-based algorithm */
+void test_kernels_project(double *x, int K){
+	std::vector<double> u(x, x+K);
+	std::sort(u.begin(), u.end(), std::greater<double>());
+
+	double cumsum = 0.0;
+	double theta = 0.0;
+	for(int j=0;j<K;j++){
+		cumsum += u[j];
+		double theta_j = (cumsum - 1.0)/(double)(j+1);
+		if(u[j] - theta_j > 0.0){
+			theta = theta_j;
+		}
+	}
+
+	for(int k=0;k<K;k++){
+		x[k] = std::max(x[k] - theta, 0.0);
+	}
+}
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_n", boost::program_options::value<int>(), "length of vectors [int]")
+		("test_T", boost::program_options::value<int>(), "length of time-series for matrix and projection [int]")
+		("test_R", boost::program_options::value<int>(), "number of nodes of 1D grid [int]")
+		("test_K", boost::program_options::value<int>(), "number of clusters [int]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of differences [double]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<SeqArrayVector>(argc, argv)){
+		return 0;
+	}
+
+	/* load console arguments */
+	int n, T, R, K;
+	double tol;
+	consoleArg.set_option_value("test_n", &n, 100000);
+	consoleArg.set_option_value("test_T", &T, 1000);
+	consoleArg.set_option_value("test_R", &R, 10);
+	consoleArg.set_option_value("test_K", &K, 3);
+	consoleArg.set_option_value("test_tol", &tol, 1e-10);
+
+	/* print settings */
+	coutMaster << " test_n                     = " << std::setw(30) << n << " (length of vectors)" << std::endl;
+	coutMaster << " test_T                     = " << std::setw(30) << T << " (length of time-series)" << std::endl;
+	coutMaster << " test_R                     = " << std::setw(30) << R << " (number of nodes of 1D grid)" << std::endl;
+	coutMaster << " test_K                     = " << std::setw(30) << K << " (number of clusters)" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of differences)" << std::endl;
+	coutMaster << std::endl;
+
+	bool passed = true;
+
+	/* ----- vector kernels ----- */
+	coutMaster << "--- VECTOR KERNELS ---" << std::endl;
+
+	SeqArrayVector x(n);
+	SeqArrayVector y(n);
+	SeqArrayVector w(n);
+
+	/* the same deterministic values */
+	std::vector<double> x_ref(n), y_ref(n), w_ref(n);
+	for(int i=0;i<n;i++){
+		x_ref[i] = sin(0.1*i);
+		y_ref[i] = cos(0.05*i) + 2.0;
+		x.get_array()[i] = x_ref[i];
+		y.get_array()[i] = y_ref[i];
+	}
+
+	/* reductions */
+	double dot_ref = 0.0, sum_ref = 0.0, norm_ref = 0.0;
+	double max_ref = x_ref[0], min_ref = x_ref[0];
+	for(int i=0;i<n;i++){
+		dot_ref += x_ref[i]*y_ref[i];
+		sum_ref += x_ref[i];
+		norm_ref += x_ref[i]*x_ref[i];
+		max_ref = std::max(max_ref, x_ref[i]);
+		min_ref = std::min(min_ref, x_ref[i]);
+	}
+	norm_ref = sqrt(norm_ref);
+
+	passed = test_kernels_compare("dot", dot(x,y), dot_ref, tol) && passed;
+	passed = test_kernels_compare("sum", sum(x), sum_ref, tol) && passed;
+	passed = test_kernels_compare("max", max(x), max_ref, tol) && passed;
+	passed = test_kernels_compare("min", min(x), min_ref, tol) && passed;
+	passed = test_kernels_compare("norm", norm(x), norm_ref, tol) && passed;
+
+	/* updates */
+	axpy(y, 0.3, x);
+	for(int i=0;i<n;i++) y_ref[i] += 0.3*x_ref[i];
+	passed = test_kernels_compare("axpy", y, y_ref, tol) && passed;
+
+	waxpy(w, y, -1.7, x);
+	for(int i=0;i<n;i++) w_ref[i] = -1.7*x_ref[i] + y_ref[i];
+	passed = test_kernels_compare("waxpy", w, w_ref, tol) && passed;
+
+	w = mul(x, y);
+	for(int i=0;i<n;i++) w_ref[i] = x_ref[i]*y_ref[i];
+	passed = test_kernels_compare("mul", w, w_ref, tol) && passed;
+
+	w.scale(2.5);
+	for(int i=0;i<n;i++) w_ref[i] *= 2.5;
+	passed = test_kernels_compare("scale", w, w_ref, tol) && passed;
+
+	w = 3.0;
+	for(int i=0;i<n;i++) w_ref[i] = 3.0;
+	passed = test_kernels_compare("set", w, w_ref, tol) && passed;
+
+	/* subvector is a view, update of view changes the original vector */
+	int n_half = n/2;
+	SeqArrayVector w_sub = w(0, n_half);
+	w_sub += x(0, n_half);
+	for(int i=0;i<n_half;i++) w_ref[i] += x_ref[i];
+	passed = test_kernels_compare("subvector", w, w_ref, tol) && passed;
+
+	coutMaster << std::endl;
+
+	/* ----- matrix and projection ----- */
+	coutMaster << "--- MATRIX AND PROJECTION ---" << std::endl;
+
+	BGMGraphGrid1D<SeqArrayVector> graph(R);
+	graph.process_grid();
+	Decomposition<SeqArrayVector> decomposition(T, graph, K, 1, 1);
+
+	/* coefficients of blocks different from 1 */
+	double alpha = 10.0;
+	GeneralVector<SeqArrayVector> coeffs(K);
+	for(int k=0;k<K;k++){
+		coeffs.get_array()[k] = 0.5 + k;
+	}
+
+	BlockGraphSparseMatrix<SeqArrayVector> A(decomposition, alpha, &coeffs);
+
+	int ngamma = T*R*K;
+	GeneralVector<SeqArrayVector> gamma(ngamma);
+	GeneralVector<SeqArrayVector> Agamma(ngamma);
+
+	std::vector<double> gamma_ref(ngamma), Agamma_ref(ngamma, 0.0);
+	for(int i=0;i<ngamma;i++){
+		gamma_ref[i] = sin(0.37*i) + 0.2*cos(1.3*i);
+		gamma.get_array()[i] = gamma_ref[i];
+	}
+
+	/* reference multiplication, the entries of row are generated as in assembly of PETSc matrix */
+	int* neighbor_nmbs = graph.get_neighbor_nmbs();
+	int **neighbor_ids = graph.get_neighbor_ids();
+	for(int k=0;k<K;k++){
+		double coeff = alpha*(0.5 + k)*(0.5 + k);
+		for(int r=0;r<R;r++){
+			int r_orig = decomposition.get_invPr(r);
+			for(int t=0;t<T;t++){
+				int diag_idx = t*R*K + r*K + k;
+
+				int Wsum;
+				if(t == 0 || t == T-1){
+					Wsum = (T > 1)? 2*neighbor_nmbs[r_orig]+2 : neighbor_nmbs[r_orig];
+				} else {
+					Wsum = 3*neighbor_nmbs[r_orig]+4;
+				}
+
+				double value = Wsum*gamma_ref[diag_idx];
+				if(t > 0) value -= 2*gamma_ref[diag_idx-R*K];
+				if(t < T-1) value -= 2*gamma_ref[diag_idx+R*K];
+
+				for(int neighbor=0;neighbor<neighbor_nmbs[r_orig];neighbor++){
+					int idx2 = t*R*K + decomposition.get_Pr(neighbor_ids[r_orig][neighbor])*K + k;
+					value -= gamma_ref[idx2];
+					if(t > 0) value -= gamma_ref[idx2-R*K];
+					if(t < T-1) value -= gamma_ref[idx2+R*K];
+				}
+
+				Agamma_ref[diag_idx] = coeff*value;
+			}
+		}
+	}
+
+	A.matmult(Agamma, gamma);
+	passed = test_kernels_compare("matmult", Agamma, Agamma_ref, tol*A.get_lambda_max_bound()) && passed;
+
+	/* reference projection, each T*R row of K values is projected independently */
+	SimplexFeasibleSet_Local<SeqArrayVector> feasibleset(T*R, K);
+	feasibleset.project(gamma);
+	for(int i=0;i<T*R;i++){
+		test_kernels_project(&gamma_ref[i*K], K);
+	}
+	passed = test_kernels_compare("project", gamma, gamma_ref, tol) && passed;
+
+	coutMaster << std::endl;
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
+	coutMaster << std::endl;
+
+	Finalize<SeqArrayVector>();
+
+	return passed ? 0 : 1;
+}
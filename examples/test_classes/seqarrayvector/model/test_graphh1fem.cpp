@@ -0,0 +1,108 @@
+/** @file test_graphh1fem.cpp
+ *  @brief solve the clustering of 1D signal with GraphH1FEMModel on SeqArrayVector
+ *
+ *  The piecewise constant signal with noise is generated and stored in PETSc binary format,
+ *  then it is loaded by Signal1DData, the problem is solved by TSSolver and the recovered signal
+ *  is compared with the signal without noise.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include <iostream>
+#include <algorithm>
+
+#include "pascinference.h"
+
+using namespace pascinference;
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_T", boost::program_options::value<int>(), "length of time-series [int]")
+		("test_K", boost::program_options::value<int>(), "number of clusters, the signal has K levels [int]")
+		("test_nmb_switch", boost::program_options::value<int>(), "number of switches between levels [int]")
+		("test_noise", boost::program_options::value<double>(), "amplitude of uniform noise [double]")
+		("test_epssqr", boost::program_options::value<double>(), "penalty parameter [double]")
+		("test_annealing", boost::program_options::value<int>(), "number of annealing steps [int]")
+		("test_filename", boost::program_options::value< std::string >(), "name of file with generated signal (vector in PETSc format) [string]")
+		("test_tol", boost::program_options::value<double>(), "tolerance of mean absolute error of recovered signal [double]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<SeqArrayVector>(argc, argv)){
+		return 0;
+	}
+
+	/* load console arguments */
+	int T, K, nmb_switch, annealing;
+	double noise, epssqr, tol;
+	std::string filename;
+	consoleArg.set_option_value("test_T", &T, 1000);
+	consoleArg.set_option_value("test_K", &K, 2);
+	consoleArg.set_option_value("test_nmb_switch", &nmb_switch, 5);
+	consoleArg.set_option_value("test_noise", &noise, 0.1);
+	consoleArg.set_option_value("test_epssqr", &epssqr, 10.0);
+	consoleArg.set_option_value("test_annealing", &annealing, 3);
+	consoleArg.set_option_value("test_filename", &filename, "test_seqarrayvector_graphh1fem.bin");
+	consoleArg.set_option_value("test_tol", &tol, 0.05);
+
+	/* print settings */
+	coutMaster << " test_T                     = " << std::setw(30) << T << " (length of time-series)" << std::endl;
+	coutMaster << " test_K                     = " << std::setw(30) << K << " (number of clusters)" << std::endl;
+	coutMaster << " test_nmb_switch            = " << std::setw(30) << nmb_switch << " (number of switches between levels)" << std::endl;
+	coutMaster << " test_noise                 = " << std::setw(30) << noise << " (amplitude of noise)" << std::endl;
+	coutMaster << " test_epssqr                = " << std::setw(30) << epssqr << " (penalty parameter)" << std::endl;
+	coutMaster << " test_annealing             = " << std::setw(30) << annealing << " (number of annealing steps)" << std::endl;
+	coutMaster << " test_filename              = " << std::setw(30) << filename << " (name of file with generated signal)" << std::endl;
+	coutMaster << " test_tol                   = " << std::setw(30) << tol << " (tolerance of mean absolute error)" << std::endl;
+	coutMaster << std::endl;
+
+	/* generate piecewise constant signal with levels 0,1,...,K-1 */
+	GeneralVector<SeqArrayVector> solution(T);
+	GeneralVector<SeqArrayVector> signal(T);
+	int length_segment = std::max(T/(nmb_switch+1), 1);
+	for(int t=0;t<T;t++){
+		solution.get_array()[t] = (double)((t/length_segment)%K);
+		signal.get_array()[t] = solution.get_array()[t] + noise*(2.0*rand()/(double)RAND_MAX - 1.0);
+	}
+	signal.save_binary(filename);
+
+	/* load data */
+	coutMaster << "--- PREPARING DATA ---" << std::endl;
+	Signal1DData<SeqArrayVector> mydata(filename);
+
+	Decomposition<SeqArrayVector> decomposition(mydata.get_Tpreliminary(), 1, K, 1, 1);
+	mydata.set_decomposition(decomposition);
+
+	/* prepare model and solver */
+	coutMaster << "--- PREPARING MODEL AND SOLVER ---" << std::endl;
+	GraphH1FEMModel<SeqArrayVector> mymodel(mydata, epssqr);
+	TSSolver<SeqArrayVector> mysolver(mydata, annealing);
+
+	/* solve the problem */
+	coutMaster << "--- SOLVING THE PROBLEM ---" << std::endl;
+	mysolver.solve();
+
+	/* compare recovered signal with the signal without noise */
+	double abserr = mydata.compute_abserr_reconstructed(solution)/(double)T;
+
+	const double *theta_arr = mydata.get_thetavector()->get_array();
+	coutMaster << " - Theta  = [";
+	for(int k=0;k<K;k++){
+		coutMaster << theta_arr[k] << ((k < K-1)? ", " : "");
+	}
+	coutMaster << "]" << std::endl;
+	coutMaster << " - it     = " << mysolver.get_it() << std::endl;
+	coutMaster << " - abserr = " << abserr << " (mean absolute error of recovered signal)" << std::endl;
+
+	bool passed = (abserr <= tol);
+
+	coutMaster << "- test " << (passed ? "PASSED" : "FAILED") << std::endl;
+	coutMaster << std::endl;
+
+	Finalize<SeqArrayVector>();
+
+	return passed ? 0 : 1;
+}
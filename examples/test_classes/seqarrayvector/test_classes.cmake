@@ -22,6 +22,7 @@ endif()
 option(TEST_SEQARRAYVECTOR_ALGEBRA						"TEST_SEQARRAYVECTOR_ALGEBRA" OFF)
 option(TEST_SEQARRAYVECTOR_ALGEBRA_PRECISION					  "TEST_SEQARRAYVECTOR_ALGEBRA_PRECISION" OFF)
 option(TEST_SEQARRAYVECTOR_ALGEBRA_DOT					  "TEST_SEQARRAYVECTOR_ALGEBRA_DOT" OFF)
+option(TEST_SEQARRAYVECTOR_ALGEBRA_KERNELS				  "TEST_SEQARRAYVECTOR_ALGEBRA_KERNELS" OFF)
 option(TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPH			  "TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPH" OFF)
 option(TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID1D		  "TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID1D" OFF)
 option(TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID2D		  "TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID2D" OFF)
@@ -63,7 +64,7 @@ endif()
 option(TEST_SEQARRAYVECTOR_MODEL						"TEST_SEQARRAYVECTOR_MODEL" OFF)
 option(TEST_SEQARRAYVECTOR_MODEL_GRAPHH1FEM			  "TEST_SEQARRAYVECTOR_MODEL_GRAPHH1FEM" OFF)
 option(TEST_SEQARRAYVECTOR_MODEL_KMEANSH1FEM			  "TEST_SEQARRAYVECTOR_MODEL_KMEANSH1FEM" OFF)
-if(${TEST_MODEL})
+if(${TEST_SEQARRAYVECTOR_MODEL})
 	# define shortcut to compile all tests of this group
 	getListOfVarsStartingWith("TEST_SEQARRAYVECTOR_MODEL_" matchedVars)
 	foreach (_var IN LISTS matchedVars)
@@ -123,6 +124,7 @@ printinfo_onoff("   TEST_SEQARRAYVECTOR_COMMON                            (...)
 printinfo_onoff("   TEST_SEQARRAYVECTOR_ALGEBRA                           (...)                        " "${TEST_SEQARRAYVECTOR_ALGEBRA}")
 printinfo_onoff("     TEST_SEQARRAYVECTOR_ALGEBRA_PRECISION                 (test precision)           " "${TEST_SEQARRAYVECTOR_ALGEBRA_PRECISION}")
 printinfo_onoff("     TEST_SEQARRAYVECTOR_ALGEBRA_DOT                       (dot product)              " "${TEST_SEQARRAYVECTOR_ALGEBRA_DOT}")
+printinfo_onoff("     TEST_SEQARRAYVECTOR_ALGEBRA_KERNELS                   (kernels vs. reference)    " "${TEST_SEQARRAYVECTOR_ALGEBRA_KERNELS}")
 #printinfo_onoff("     TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPH                  (BGMGraph)                 " "${TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPH}")
 #printinfo_onoff("     TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID1D            (BGMGraphGrid1D)           " "${TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID1D}")
 #printinfo_onoff("     TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID2D            (BGMGraphGrid2D)           " "${TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPHGRID2D}")
@@ -145,7 +147,7 @@ printinfo_onoff("   TEST_SEQARRAYVECTOR_DATA                              (...)
 #printinfo_onoff("     TEST_SEQARRAYVECTOR_DATA_SIMPLE                       (SimpleData)               " "${TEST_SEQARRAYVECTOR_DATA_SIMPLE}")
 #printinfo_onoff("     TEST_SEQARRAYVECTOR_DATA_TS                           (TSData)                   " "${TEST_SEQARRAYVECTOR_DATA_TS}")
 printinfo_onoff("   TEST_SEQARRAYVECTOR_MODEL                             (...)                        " "${TEST_SEQARRAYVECTOR_MODEL}")
-#printinfo_onoff("     TEST_SEQARRAYVECTOR_MODEL_GRAPHH1FEM                  (GraphH1FEMModel)          " "${TEST_SEQARRAYVECTOR_MODEL_GRAPHH1FEM}")
+printinfo_onoff("     TEST_SEQARRAYVECTOR_MODEL_GRAPHH1FEM                  (GraphH1FEMModel)          " "${TEST_SEQARRAYVECTOR_MODEL_GRAPHH1FEM}")
 #printinfo_onoff("     TEST_SEQARRAYVECTOR_MODEL_KMEANSH1FEM                 (KmeansH1FEMModel)         " "${TEST_SEQARRAYVECTOR_MODEL_KMEANSH1FEM}")
 printinfo_onoff("   TEST_SEQARRAYVECTOR_SOLVER                            (...)                        " "${TEST_SEQARRAYVECTOR_SOLVER}")
 #printinfo_onoff("     TEST_SEQARRAYVECTOR_SOLVER_CGQP                       (CGQPSolver)               " "${TEST_SEQARRAYVECTOR_SOLVER_CGQP}")
@@ -212,6 +214,11 @@ if(${TEST_SEQARRAYVECTOR_ALGEBRA_DOT})
 	testadd_executable("test_classes/seqarrayvector/algebra/test_dot.cpp" "test_seqarrayvector_dot")
 endif()
 
+if(${TEST_SEQARRAYVECTOR_ALGEBRA_KERNELS})
+	# kernels compared with scalar reference
+	testadd_executable("test_classes/seqarrayvector/algebra/test_kernels.cpp" "test_seqarrayvector_kernels")
+endif()
+
 if(${TEST_SEQARRAYVECTOR_ALGEBRA_BGMGRAPH})
 	# BGMGraph
 	if(${USE_CUDA})
@@ -260,6 +267,11 @@ endif()
 
 # ----- MODEL -----
 
+if(${TEST_SEQARRAYVECTOR_MODEL_GRAPHH1FEM})
+	# GraphH1FEMModel solved by TSSolver on generated 1D signal
+	testadd_executable("test_classes/seqarrayvector/model/test_graphh1fem.cpp" "test_seqarrayvector_graphh1fem")
+endif()
+
 # ----- SOLVER -----
 
 # ----- DLIB ------
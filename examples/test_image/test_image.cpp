@@ -27,7 +27,9 @@ int main( int argc, char *argv[] )
 		("test_image_out", boost::program_options::value< std::string >(), "name of output file with image data (vector in PETSc format) [string]")
 		("test_width", boost::program_options::value<int>(), "width of image [int]")
 		("test_height", boost::program_options::value<int>(), "height of image [int]")
+		("test_batch", boost::program_options::value<int>(), "number of images with the same size stored one after another in input file, solved as a batch of independent problems [int]")
 		("test_graph_save", boost::program_options::value<bool>(), "save VTK with graph or not [bool]")
+		("test_resultfile", boost::program_options::value<bool>(), "save results for all epssqr into one result file instead of separate *.bin files [bool]")
 		("test_epssqr", boost::program_options::value<std::vector<double> >()->multitoken(), "penalty parameters [double]")
 		("test_annealing", boost::program_options::value<int>(), "number of annealing steps [int]")
 		("test_cutgamma", boost::program_options::value<bool>(), "cut gamma to set {0;1} [bool]")
@@ -57,9 +59,9 @@ int main( int argc, char *argv[] )
 		return 0;
 	}
 
-	int K, annealing, width, height, fem_type; 
+	int K, annealing, width, height, batch, fem_type; 
 	double fem_reduce;
-	bool cutgamma, scaledata, cutdata, printstats, shortinfo_write_or_not, graph_save;
+	bool cutgamma, scaledata, cutdata, printstats, shortinfo_write_or_not, graph_save, resultfile_or_not;
 
 	std::string image_filename;
 	std::string image_out;
@@ -72,7 +74,9 @@ int main( int argc, char *argv[] )
 	consoleArg.set_option_value("test_fem_reduce", &fem_reduce, 1.0);
 	consoleArg.set_option_value("test_width", &width, 250);
 	consoleArg.set_option_value("test_height", &height, 150);
+	consoleArg.set_option_value("test_batch", &batch, 1);
 	consoleArg.set_option_value("test_graph_save", &graph_save, false);
+	consoleArg.set_option_value("test_resultfile", &resultfile_or_not, false);
 	consoleArg.set_option_value("test_cutgamma", &cutgamma, false);
 	consoleArg.set_option_value("test_scaledata", &scaledata, false);
 	consoleArg.set_option_value("test_cutdata", &cutdata, true);
@@ -115,6 +119,7 @@ int main( int argc, char *argv[] )
 	coutMaster << " test_image_out          = " << std::setw(50) << image_out << " (part of name of output file)" << std::endl;
 	coutMaster << " test_width              = " << std::setw(50) << width << " (width of image)" << std::endl;
 	coutMaster << " test_height             = " << std::setw(50) << height << " (height of image)" << std::endl;
+	coutMaster << " test_batch              = " << std::setw(50) << batch << " (number of images in input file)" << std::endl;
 	coutMaster << " test_K                  = " << std::setw(50) << K << " (number of clusters)" << std::endl;
 	if(given_Theta){
 		coutMaster << " test_Theta              = " << std::setw(50) << print_array(Theta_solution,K) << std::endl;
@@ -122,6 +127,7 @@ int main( int argc, char *argv[] )
 	coutMaster << " test_fem_type           = " << std::setw(50) << fem_type << " (type of used FEM to reduce problem [3=FEM2D_SUM/4=FEM2D_HAT])" << std::endl;
 	coutMaster << " test_fem_reduce         = " << std::setw(50) << fem_reduce << " (parameter of the reduction of FEM node)" << std::endl;
 	coutMaster << " test_graph_save         = " << std::setw(50) << graph_save << " (save VTK with graph or not)" << std::endl;
+	coutMaster << " test_resultfile         = " << std::setw(50) << resultfile_or_not << " (save results into one result file)" << std::endl;
 	coutMaster << " test_epssqr             = " << std::setw(50) << print_vector(epssqr_list) << " (penalty)" << std::endl;
 	coutMaster << " test_annealing          = " << std::setw(50) << annealing << " (number of annealing steps)" << std::endl;
 	coutMaster << " test_cutgamma           = " << std::setw(50) << cutgamma << " (cut gamma to {0;1})" << std::endl;
@@ -153,10 +159,20 @@ int main( int argc, char *argv[] )
 /* 1.) prepare graph of image */
 	coutMaster << "--- PREPARING GRAPH ---" << std::endl;
 
-	BGMGraphGrid2D<PetscVector> *graph;
+	BGMGraph<PetscVector> *graph;
 	/* this is not general graph, it is "only" 2D grid */
-	graph = new BGMGraphGrid2D<PetscVector>(width, height);
-	graph->process_grid();
+	BGMGraphGrid2D<PetscVector> *graph_image = new BGMGraphGrid2D<PetscVector>(width, height);
+	graph_image->process_grid();
+
+	/* the batch of images is represented by the graph of disjoint copies of image grid */
+	if(batch > 1){
+		graph = new BGMGraph<PetscVector>(*graph_image, batch);
+
+		/* the copies are independent on original grid */
+		delete graph_image;
+	} else {
+		graph = graph_image;
+	}
 
 	/* print basic info about graph */
 	graph->print(coutMaster);
@@ -200,7 +216,13 @@ int main( int argc, char *argv[] )
 
 	/* prepare FEM reduction */
 	Fem<PetscVector> *fem;
-	if(fem_type == 3){
+	if(batch > 1){
+		/* the reduction of grid is not available for the batch of images */
+		if(fem_reduce != 1.0){
+			coutMaster << "WARNING: FEM reduction is not available for batch of images, using fem_reduce=1.0" << std::endl;
+		}
+		fem = new Fem<PetscVector>(1.0);
+	} else if(fem_type == 3){
 		fem = new Fem2D<PetscVector>(fem_reduce);
 	}
 	if(fem_type == 4){
@@ -209,7 +231,7 @@ int main( int argc, char *argv[] )
 
 	/* prepare model on the top of given data */
 //	GraphH1FEMModel<PetscVector> mymodel(mydata, epssqr_list[0]);
-	GraphH1FEMModel<PetscVector> mymodel(mydata, epssqr_list[0], fem);
+	GraphH1FEMModel<PetscVector> mymodel(mydata, epssqr_list[0], fem, false, batch);
 
 	/* print info about model */
 	mymodel.print(coutMaster,coutAll);
@@ -225,6 +247,14 @@ int main( int argc, char *argv[] )
 
 	/* set solution if obtained from console */
 	if(given_Theta)	mysolver.set_solution_theta(Theta_solution);
+
+	/* prepare one file for results of all epssqr */
+	ResultFile<PetscVector> *myresultfile = NULL;
+	if(resultfile_or_not){
+		oss << "results/" << image_out << ".pres";
+		myresultfile = new ResultFile<PetscVector>(mydata, oss.str());
+		oss.str("");
+	}
 	
 /* 6.) solve the problem with initial epssqr */
 	coutMaster << "--- SOLVING THE PROBLEM with epssqr = " << epssqr_list[0] << " ---" << std::endl;
@@ -237,9 +267,13 @@ int main( int argc, char *argv[] )
 	if(scaledata) mydata.scaledata(0,1,-1,1);
 
 	coutMaster << "--- SAVING OUTPUT ---" << std::endl;
-	oss << image_out << "_epssqr" << epssqr_list[0];
-	mydata.saveImage(oss.str(),true);
-	oss.str("");
+	if(myresultfile){
+		myresultfile->write(epssqr_list[0], 0);
+	} else {
+		oss << image_out << "_epssqr" << epssqr_list[0];
+		mydata.saveImage(oss.str(),true);
+		oss.str("");
+	}
 
 	/* write short output */
 	if(shortinfo_write_or_not){
@@ -294,9 +328,13 @@ int main( int argc, char *argv[] )
 		if(scaledata) mydata.scaledata(0,1,-1,1);
 
 		coutMaster << "--- SAVING OUTPUT ---" << std::endl;
-		oss << image_out << "_epssqr" << epssqr_list[depth];
-		mydata.saveImage(oss.str(),false);
-		oss.str("");
+		if(myresultfile){
+			myresultfile->write(epssqr_list[depth], depth);
+		} else {
+			oss << image_out << "_epssqr" << epssqr_list[depth];
+			mydata.saveImage(oss.str(),false);
+			oss.str("");
+		}
 		
 		/* write short output */
 		if(shortinfo_write_or_not){
@@ -327,6 +365,11 @@ int main( int argc, char *argv[] )
 	/* print timers */
 	coutMaster << "--- TIMERS INFO ---" << std::endl;
 	mysolver.printtimer(coutMaster);
+	if(myresultfile){
+		myresultfile->flush();
+		myresultfile->printtimer(coutMaster);
+		delete myresultfile;
+	}
 
 	/* print short info */
 	coutMaster << "--- FINAL SOLVER INFO ---" << std::endl;
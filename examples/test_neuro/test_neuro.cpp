@@ -21,6 +21,7 @@ int main( int argc, char *argv[] )
 	opt_problem.add_options()
 		("test_DDT", boost::program_options::value<int>(), "decomposition in time [int]")
 		("test_DDR", boost::program_options::value<int>(), "decomposition in space [int]")
+		("test_DDauto", boost::program_options::value<bool>(), "choose decomposition in time and space automatically from cost model [bool]")
 		("test_data_filename", boost::program_options::value< std::string >(), "name of input file [string]")
 		("test_max_record_nmb", boost::program_options::value<int>(), "maximum nuber of loaded records")
 		("test_graph_coordinates", boost::program_options::value< std::string >(), "name of input file with coordinates [string]")
@@ -62,7 +63,7 @@ int main( int argc, char *argv[] )
 	}
 
 	int K, max_record_nmb, annealing, DDT_size, DDR_size; 
-	bool cutgamma, savevtk, printstats, cutdata, scaledata, shiftdata, shortinfo_write_or_not, graph_save;
+	bool DDauto, cutgamma, savevtk, printstats, cutdata, scaledata, shiftdata, shortinfo_write_or_not, graph_save;
 	double cutdata_up, cutdata_down, shiftdata_coeff, graph_coeff;
 
 	std::string data_filename;
@@ -75,6 +76,7 @@ int main( int argc, char *argv[] )
 
 	consoleArg.set_option_value("test_DDT", &DDT_size, GlobalManager.get_size());
 	consoleArg.set_option_value("test_DDR", &DDR_size, 1);
+	consoleArg.set_option_value("test_DDauto", &DDauto, false);
 
 	consoleArg.set_option_value("test_data_filename", &data_filename, "data/S001R01.edf");
 	consoleArg.set_option_value("test_max_record_nmb", &max_record_nmb, -1);
@@ -128,6 +130,7 @@ int main( int argc, char *argv[] )
 	coutMaster << " nmb of proc             = " << std::setw(30) << GlobalManager.get_size() << " (number of MPI processes)" << std::endl;
 	coutMaster << " test_DDT                = " << std::setw(30) << DDT_size << " (decomposition in time)" << std::endl;
 	coutMaster << " test_DDR                = " << std::setw(30) << DDR_size << " (decomposition in space)" << std::endl;
+	coutMaster << " test_DDauto             = " << std::setw(30) << DDauto << " (choose decomposition automatically)" << std::endl;
 	coutMaster << "" << std::endl;
 	coutMaster << " test_data_filename      = " << std::setw(30) << data_filename << " (name of input file)" << std::endl;
 	coutMaster << " test_max_record_nmb     = " << std::setw(30) << max_record_nmb << " (max number of loaded time-steps)" << std::endl;
@@ -160,7 +163,7 @@ int main( int argc, char *argv[] )
 	coutMaster << "---------------------------------------------------------------------------------------" << std::endl << "" << std::endl;
 
 	/* control the decomposition */
-	if(DDT_size*DDR_size != GlobalManager.get_size()){
+	if(!DDauto && DDT_size*DDR_size != GlobalManager.get_size()){
 		coutMaster << "Sorry, DDT*DDR != nproc" << std::endl;
 		return 0;
 	}
@@ -190,6 +193,9 @@ int main( int argc, char *argv[] )
 	BGMGraph<PetscVector> graph(graph_coordinates);
 	graph.process(graph_coeff);
 	graph.print(coutMaster);
+	if(DDauto){
+		Decomposition<PetscVector>::compute_auto_sizes(mydata.get_Tpreliminary(), graph, K, GlobalManager.get_size(), &DDT_size, &DDR_size, coutMaster);
+	}
 	if(graph_save){
 		/* save decoposed graph to see if space (graph) decomposition is working */
 		oss << "results/" << data_out << "_DDR" << DDR_size << "_graph.vtk";
@@ -3,11 +3,13 @@ include_directories("${CMAKE_SOURCE_DIR}/test_signal1D/")
 # decide which example to compile
 option(TEST_SIGNAL1D "TEST_SIGNAL1D" OFF)
 option(TEST_SIGNAL1D_GENERATE "TEST_SIGNAL1D_GENERATE" OFF)
+option(TEST_SIGNAL1D_SLIDING "TEST_SIGNAL1D_SLIDING" OFF)
 
 # print info
 print("Signal1D tests")
 printinfo_onoff(" TEST_SIGNAL1D                                                                        " "${TEST_SIGNAL1D}")
 printinfo_onoff(" TEST_SIGNAL1D_GENERATE                                                               " "${TEST_SIGNAL1D_GENERATE}")
+printinfo_onoff(" TEST_SIGNAL1D_SLIDING                                                                " "${TEST_SIGNAL1D_SLIDING}")
 
 if(${TEST_SIGNAL1D})
 	# this is signal processing test
@@ -45,3 +47,11 @@ if(${TEST_SIGNAL1D_GENERATE})
 
 endif()
 
+if(${TEST_SIGNAL1D_SLIDING})
+	# this is signal processing test on sliding time window
+	testadd_executable("test_signal1D/test_signal1D_sliding.cpp" "test_signal1D_sliding")
+
+	# copy data
+	file(COPY "test_signal1D/data/" DESTINATION "data" FILES_MATCHING PATTERN "*")
+
+endif()
@@ -27,6 +27,7 @@ int main( int argc, char *argv[] )
 		("test_filename_solution", boost::program_options::value< std::string >(), "name of input file with original signal data without noise (vector in PETSc format) [string]")
 		("test_filename_gamma0", boost::program_options::value< std::string >(), "name of input file with initial gamma approximation (vector in PETSc format) [string]")
 		("test_save_all", boost::program_options::value<bool>(), "save results for all epssqr, not only for the best one [bool]")
+		("test_resultfile", boost::program_options::value<bool>(), "save results for all epssqr into one result file instead of separate *.bin files [bool]")
 		("test_epssqr", boost::program_options::value<std::vector<double> >()->multitoken(), "penalty parameters [double]")
 		("test_annealing", boost::program_options::value<int>(), "number of annealing steps [int]")
 		("test_cutgamma", boost::program_options::value<bool>(), "cut gamma to set {0;1} [bool]")
@@ -66,7 +67,7 @@ int main( int argc, char *argv[] )
 	}
 
 	int K, annealing, fem_type; 
-	bool cutgamma, scaledata, cutdata, printstats, printinfo, shortinfo_write_or_not, save_all, saveresult;
+	bool cutgamma, scaledata, cutdata, printstats, printinfo, shortinfo_write_or_not, save_all, saveresult, resultfile_or_not;
 	double fem_reduce;
 
 	std::string filename;
@@ -84,6 +85,7 @@ int main( int argc, char *argv[] )
 	consoleArg.set_option_value("test_filename_out", &filename_out, "samplesignal");
 	consoleArg.set_option_value("test_filename_solution", &filename_solution, "data/samplesignal_solution.bin");
 	consoleArg.set_option_value("test_save_all", &save_all, false);
+	consoleArg.set_option_value("test_resultfile", &resultfile_or_not, false);
 	consoleArg.set_option_value("test_annealing", &annealing, 1);
 	consoleArg.set_option_value("test_cutgamma", &cutgamma, false);
 	consoleArg.set_option_value("test_scaledata", &scaledata, false);
@@ -152,6 +154,7 @@ int main( int argc, char *argv[] )
 		coutMaster << " test_filename_gamma0        = " << std::setw(30) << "NO" << " (name of input file with initial gamma approximation)" << std::endl;
 	}
 	coutMaster << " test_save_all               = " << std::setw(30) << save_all << " (save results for all epssqr, not only for the best one)" << std::endl;
+	coutMaster << " test_resultfile             = " << std::setw(30) << resultfile_or_not << " (save results for all epssqr into one result file)" << std::endl;
 	coutMaster << " test_epssqr                 = " << std::setw(30) << print_vector(epssqr_list) << " (penalty parameters)" << std::endl;
 	coutMaster << " test_annealing              = " << std::setw(30) << annealing << " (number of annealing steps)" << std::endl;
 	coutMaster << " test_cutgamma               = " << std::setw(30) << cutgamma << " (cut gamma to {0;1})" << std::endl;
@@ -247,6 +250,14 @@ int main( int argc, char *argv[] )
 
 	/* set solution if obtained from console */
 	if(given_Theta)	mysolver.set_solution_theta(Theta_solution);
+
+	/* prepare one file for results of all epssqr */
+	ResultFile<PetscVector> *myresultfile = NULL;
+	if(save_all && saveresult && resultfile_or_not){
+		oss << "results/" << filename_out << ".pres";
+		myresultfile = new ResultFile<PetscVector>(mydata, oss.str());
+		oss.str("");
+	}
 	
 /* 6.) solve the problem with epssqrs and remember best solution */
 	double epssqr;
@@ -264,13 +275,23 @@ int main( int argc, char *argv[] )
 	double node_energy_it;
     	double node_energy_it_sum;
 	
+	/* continue with epssqr stored in checkpoint, already solved epssqr are skipped */
+	int depth_begin = mysolver.get_checkpoint_restart_id();
+	if(depth_begin < 0 || depth_begin >= epssqr_list.size()){
+		depth_begin = 0;
+	}
+	if(depth_begin > 0){
+		coutMaster << "--- RESTART FROM CHECKPOINT with epssqr = " << epssqr_list[depth_begin] << " ---" << std::endl;
+	}
+
 	/* go throught given list of epssqr */
-	for(int depth = 0; depth < epssqr_list.size();depth++){
+	for(int depth = depth_begin; depth < epssqr_list.size();depth++){
 		epssqr = epssqr_list[depth];
 		coutMaster << "--- SOLVING THE PROBLEM with epssqr = " << epssqr << " ---" << std::endl;
 
 		/* set new epssqr */
 		mymodel.set_epssqr(epssqr);
+		mysolver.set_checkpoint_id(depth);
 
 		/* cut data */
 		if(cutdata) mydata.cutdata(0,1);
@@ -310,9 +331,13 @@ int main( int argc, char *argv[] )
 		/* store obtained solution */
 		if(save_all && saveresult){
 			coutMaster << "--- SAVING OUTPUT ---" << std::endl;
-			oss << filename_out << "_epssqr" << epssqr;
-			mydata.saveSignal1D(oss.str(),false);
-			oss.str("");
+			if(myresultfile){
+				myresultfile->write(epssqr, depth);
+			} else {
+				oss << filename_out << "_epssqr" << epssqr;
+				mydata.saveSignal1D(oss.str(),false);
+				oss.str("");
+			}
 		}
 		
 
@@ -372,6 +397,11 @@ int main( int argc, char *argv[] )
 	/* print timers */
 	coutMaster << "--- TIMERS INFO ---" << std::endl;
 	mysolver.printtimer(coutMaster);
+	if(myresultfile){
+		myresultfile->flush();
+		myresultfile->printtimer(coutMaster);
+		delete myresultfile;
+	}
 
 	/* print short info */
 	coutMaster << "--- FINAL SOLVER INFO ---" << std::endl;
@@ -0,0 +1,183 @@
+/** @file test_signal1D_sliding.cpp
+ *  @brief solve 1D signal problem on sliding time window
+ *
+ *  The signal is processed in window of length test_T. After the solution of first window (cold start),
+ *  the window is moved by test_shift new samples using TSData::append_samples and the problem is solved again
+ *  from shifted gamma of previous window (warm start). The error is measured in every window against signal without noise.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "pascinference.h"
+
+#include <vector>
+
+#ifndef USE_PETSC
+ #error 'This example is for PETSC'
+#endif
+
+using namespace pascinference;
+
+/* load whole vector from PETSc binary file on every process */
+void test_sliding_load(std::string filename, std::vector<double> &values){
+	PetscViewer mviewer;
+	TRYCXX( PetscViewerBinaryOpen(PETSC_COMM_SELF, filename.c_str(), FILE_MODE_READ, &mviewer) );
+
+	Vec x_Vec;
+	TRYCXX( VecCreate(PETSC_COMM_SELF, &x_Vec) );
+	TRYCXX( VecSetType(x_Vec, VECSEQ) );
+	TRYCXX( VecLoad(x_Vec, mviewer) );
+	TRYCXX( PetscViewerDestroy(&mviewer) );
+
+	int n;
+	double *x_arr;
+	TRYCXX( VecGetSize(x_Vec, &n) );
+	TRYCXX( VecGetArray(x_Vec, &x_arr) );
+	values.assign(x_arr, x_arr + n);
+	TRYCXX( VecRestoreArray(x_Vec, &x_arr) );
+	TRYCXX( VecDestroy(&x_Vec) );
+}
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("PROBLEM EXAMPLE", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("test_K", boost::program_options::value<int>(), "number of clusters [int]")
+		("test_T", boost::program_options::value<int>(), "length of time window [int]")
+		("test_shift", boost::program_options::value<int>(), "number of new samples in one step of window [int]")
+		("test_nmb_windows", boost::program_options::value<int>(), "number of solved windows, -1 = to the end of signal [int]")
+		("test_filename", boost::program_options::value< std::string >(), "name of input file with signal data (vector in PETSc format) [string]")
+		("test_filename_solution", boost::program_options::value< std::string >(), "name of input file with original signal data without noise (vector in PETSc format) [string]")
+		("test_epssqr", boost::program_options::value<double>(), "penalty parameter [double]")
+		("test_annealing", boost::program_options::value<int>(), "number of annealing steps of first window [int]")
+		("test_printinfo", boost::program_options::value<bool>(), "print informations about created objects [bool]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	int K, T, shift, nmb_windows, annealing;
+	double epssqr;
+	bool printinfo;
+	std::string filename;
+	std::string filename_solution;
+
+	consoleArg.set_option_value("test_K", &K, 2);
+	consoleArg.set_option_value("test_T", &T, 1000);
+	consoleArg.set_option_value("test_shift", &shift, 100);
+	consoleArg.set_option_value("test_nmb_windows", &nmb_windows, -1);
+	consoleArg.set_option_value("test_filename", &filename, "data/samplesignal.bin");
+	consoleArg.set_option_value("test_filename_solution", &filename_solution, "data/samplesignal_solution.bin");
+	consoleArg.set_option_value("test_epssqr", &epssqr, 10.0);
+	consoleArg.set_option_value("test_annealing", &annealing, 1);
+	consoleArg.set_option_value("test_printinfo", &printinfo, false);
+
+	/* set decomposition in space */
+	int DDT_size = GlobalManager.get_size();
+
+	coutMaster << "- PROBLEM INFO ----------------------------" << std::endl;
+	coutMaster << " DDT_size                    = " << std::setw(30) << DDT_size << " (decomposition in space)" << std::endl;
+	coutMaster << " test_K                      = " << std::setw(30) << K << " (number of clusters)" << std::endl;
+	coutMaster << " test_T                      = " << std::setw(30) << T << " (length of time window)" << std::endl;
+	coutMaster << " test_shift                  = " << std::setw(30) << shift << " (number of new samples in one step of window)" << std::endl;
+	coutMaster << " test_nmb_windows            = " << std::setw(30) << nmb_windows << " (number of solved windows)" << std::endl;
+	coutMaster << " test_filename               = " << std::setw(30) << filename << " (name of input file with signal data)" << std::endl;
+	coutMaster << " test_filename_solution      = " << std::setw(30) << filename_solution << " (name of input file with original signal data without noise)" << std::endl;
+	coutMaster << " test_epssqr                 = " << std::setw(30) << epssqr << " (penalty parameter)" << std::endl;
+	coutMaster << " test_annealing              = " << std::setw(30) << annealing << " (number of annealing steps of first window)" << std::endl;
+	coutMaster << " test_printinfo              = " << std::setw(30) << printbool(printinfo) << " (print informations about created objects)" << std::endl;
+	coutMaster << "-------------------------------------------" << std::endl;
+
+	/* say hello */
+	coutMaster << "- start program" << std::endl;
+
+/* 1.) load whole signal, new samples are provided from this array */
+	std::vector<double> signal;
+	std::vector<double> signal_solution;
+	test_sliding_load(filename, signal);
+	test_sliding_load(filename_solution, signal_solution);
+
+	int T_signal = signal.size();
+	if(T > T_signal){
+		coutMaster << "length of window is larger than length of signal!" << std::endl;
+		Finalize<PetscVector>();
+		return 0;
+	}
+	int nmb_windows_max = 1 + (T_signal - T)/shift;
+	if(nmb_windows < 0 || nmb_windows > nmb_windows_max){
+		nmb_windows = nmb_windows_max;
+	}
+
+/* 2.) prepare decomposition and data of first window */
+	Decomposition<PetscVector> decomposition(T, 1, K, 1, DDT_size);
+	if(printinfo) decomposition.print(coutMaster);
+
+	TSData<PetscVector> mydata(decomposition);
+	mydata.append_samples(&signal[0], T);
+
+/* 3.) prepare model and solver, they are reused in all windows */
+	GraphH1FEMModel<PetscVector> mymodel(mydata, epssqr);
+	if(printinfo) mymodel.print(coutMaster,coutAll);
+
+	TSSolver<PetscVector> mysolver(mydata, annealing);
+	if(printinfo) mysolver.print(coutMaster,coutAll);
+
+	Vec recovered_Vec;
+	TRYCXX( VecDuplicate(mydata.get_datavector()->get_vector(), &recovered_Vec) );
+	GeneralVector<PetscVector> recovered(recovered_Vec);
+
+	int low, high;
+	TRYCXX( VecGetOwnershipRange(recovered_Vec, &low, &high) );
+
+/* 4.) go through windows */
+	Timer timer_window;
+	timer_window.restart();
+
+	for(int window=0; window < nmb_windows; window++){
+		int t_begin = window*shift; /* position of window in signal */
+
+		if(window > 0){
+			/* move window, gamma of previous window is shifted and used as initial approximation */
+			mydata.append_samples(&signal[t_begin + T - shift], shift);
+			mysolver.set_init_permute(false);
+			mysolver.set_annealing(1);
+		}
+
+		timer_window.start();
+		mysolver.solve();
+		timer_window.stop();
+
+		/* error of recovered signal in window, the layout of 1D signal in decomposition is not permuted */
+		mydata.compute_recovered(recovered);
+
+		double *recovered_arr;
+		double abserr = 0.0;
+		TRYCXX( VecGetArray(recovered_Vec, &recovered_arr) );
+		for(int i=low;i<high;i++){
+			abserr += std::abs(recovered_arr[i-low] - signal_solution[t_begin + i]);
+		}
+		TRYCXX( VecRestoreArray(recovered_Vec, &recovered_arr) );
+		MPI_Allreduce(MPI_IN_PLACE, &abserr, 1, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+		coutMaster << " - window " << std::setw(4) << window << ": t = [" << t_begin << "," << t_begin + T << "), ";
+		coutMaster << (window == 0 ? "cold" : "warm") << ", it = " << std::setw(6) << mysolver.get_it() << ", ";
+		coutMaster << "time = " << std::setw(10) << timer_window.get_value_last() << ", ";
+		coutMaster << "abserr/T = " << std::setw(12) << abserr/(double)T << ", ";
+		coutMaster << "Theta = " << mydata.print_thetavector() << std::endl;
+	}
+
+	/* print timers */
+	coutMaster << "--- TIMERS INFO ---" << std::endl;
+	coutMaster << " - all windows = " << timer_window.get_value_sum() << " s" << std::endl;
+	mysolver.printtimer(coutMaster);
+
+	/* say bye */
+	coutMaster << "- end program" << std::endl;
+
+	Finalize<PetscVector>();
+
+	return 0;
+}
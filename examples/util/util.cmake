@@ -6,6 +6,8 @@ option(UTIL_DIFF_NORM_VEC "UTIL_DIFF_NORM_VEC" OFF)
 option(UTIL_STAT_VEC "UTIL_STAT_VEC" OFF)
 option(UTIL_PRINT_VEC "UTIL_PRINT_VEC" OFF)
 option(UTIL_PROCESS_LOG "UTIL_PROCESS_LOG" OFF)
+option(UTIL_TASKFARM "UTIL_TASKFARM" OFF)
+option(UTIL_LOD_PYRAMID "UTIL_LOD_PYRAMID" OFF)
 
 if(${UTIL})
 	# define shortcut to compile all utils
@@ -23,6 +25,8 @@ printinfo_onoff("   UTIL_DIFF_NORM_VEC                                    (Conso
 printinfo_onoff("   UTIL_STAT_VEC                                         (ConsoleArg)                 " "${UTIL_STAT_VEC}")
 printinfo_onoff("   UTIL_PRINT_VEC                                        (ConsoleArg)                 " "${UTIL_PRINT_VEC}")
 printinfo_onoff("   UTIL_PROCESS_LOG                                      (ConsoleArg)                 " "${UTIL_PROCESS_LOG}")
+printinfo_onoff("   UTIL_TASKFARM                                         (TaskFarm)                   " "${UTIL_TASKFARM}")
+printinfo_onoff("   UTIL_LOD_PYRAMID                                      (LODPyramid)                 " "${UTIL_LOD_PYRAMID}")
 
 if(${UTIL_DIFF_NORM_VEC})
 	testadd_executable("util/util_diff_norm_vec.cpp" "util_diff_norm_vec")
@@ -40,4 +44,10 @@ if(${UTIL_PROCESS_LOG})
 	testadd_executable("util/util_process_log.cpp" "util_process_log")
 endif()
 
+if(${UTIL_TASKFARM})
+	testadd_executable("util/util_taskfarm.cpp" "util_taskfarm")
+endif()
 
+if(${UTIL_LOD_PYRAMID})
+	testadd_executable("util/util_lod_pyramid.cpp" "util_lod_pyramid")
+endif()
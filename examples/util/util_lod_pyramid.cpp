@@ -0,0 +1,83 @@
+/** @file util_lod_pyramid.cpp
+ *  @brief build the level-of-detail pyramid of given PETSc vector for gui_show_* viewers
+ *
+ *  The pyramid contains min, max and mean of each channel at power-of-two decimations. It is stored alongside
+ *  the vector (in_filename.lod), the viewers then read only the records which cover the visible window.
+ *  The vector is read sequentially, therefore it does not have to fit into memory.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "pascinference.h"
+
+#ifndef USE_PETSC
+ #error 'This util is for PETSC'
+#endif
+
+using namespace pascinference;
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("UTIL_LOD_PYRAMID", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("in_filename", boost::program_options::value< std::string >(), "input vector [string]")
+		("out_filename", boost::program_options::value< std::string >(), "output pyramid, default in_filename.lod [string]")
+		("lod_channels", boost::program_options::value<int>(), "number of channels in vector, i.e. K for gamma or number of electrodes for EEG data [int]")
+		("lod_interleaved", boost::program_options::value<bool>(), "channels are interleaved (t*C+c, data), otherwise stored one after another (c*T+t, gamma) [bool]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	} 
+
+	std::string in_filename;
+	std::string out_filename;
+	int channels;
+	bool interleaved;
+
+	if(!consoleArg.set_option_value("in_filename", &in_filename)){
+		std::cout << "in_filename has to be set! Call application with parameter -h to see all parameters\n";
+		return 0;
+	}
+
+	consoleArg.set_option_value("out_filename", &out_filename, LODPyramid::get_filename(in_filename));
+	consoleArg.set_option_value("lod_channels", &channels, 1);
+	consoleArg.set_option_value("lod_interleaved", &interleaved, false);
+
+	coutMaster << "- UTIL INFO ----------------------------\n";
+	coutMaster << " in_filename            = " << std::setw(30) << in_filename << " (PETSc vector)\n";
+	coutMaster << " out_filename           = " << std::setw(30) << out_filename << " (pyramid)\n";
+	coutMaster << " lod_channels           = " << std::setw(30) << channels << " (number of channels)\n";
+	coutMaster << " lod_interleaved        = " << std::setw(30) << interleaved << " (channels are interleaved)\n";
+	coutMaster << "-------------------------------------------\n" << "\n";
+
+	/* the pyramid is built by master, the vector is read sequentially */
+	if(GlobalManager.get_rank() == 0){
+		Timer timer_build;
+		timer_build.restart();
+		timer_build.start();
+
+		bool built = LODPyramid::build(in_filename, out_filename, channels, interleaved);
+
+		timer_build.stop();
+
+		if(built){
+			LODPyramid pyramid;
+			pyramid.open(out_filename, in_filename);
+
+			coutMaster << "pyramid of given vector:" << std::endl;
+			coutMaster << " T         = " << std::setw(30) << pyramid.get_T() << std::endl;
+			coutMaster << " channels  = " << std::setw(30) << pyramid.get_C() << std::endl;
+			coutMaster << " levels    = " << std::setw(30) << pyramid.get_nmb_levels() << std::endl;
+			coutMaster << " time      = " << std::setw(30) << timer_build.get_value_sum() << " s" << std::endl;
+		} else {
+			coutMaster << "pyramid was not created" << std::endl;
+		}
+	}
+
+	Finalize<PetscVector>();
+
+	return 0;
+}
@@ -0,0 +1,88 @@
+/** @file util_taskfarm.cpp
+ *  @brief run the list of independent problems inside one MPI job
+ *
+ *  Each line of manifest describes one task
+ *  \code
+ *  nprocs shortinfo_filename executable [arguments]
+ *  \endcode
+ *  The tasks are spawned on groups of idle processes, the results are collected into one shortinfo table.
+ *  Rank 0 is the scheduler, therefore run it at least with (the largest nprocs + 1) processes.
+ *  The workers hold their slots while the spawned tasks run, therefore start the farm with spare slots
+ *  (MPI_UNIVERSE_SIZE at least 2*nprocs-1, e.g. "mpiexec -n N -usize 2N") or with oversubscription allowed
+ *  (e.g. "mpirun --oversubscribe -n N"). The task which exceeded taskfarm_timeout is abandoned and its workers are retired;
+ *  the abandoned task stays connected, therefore the farm ends (MPI_Finalize) only after the task ends or it is killed by the resource manager.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#include "pascinference.h"
+
+#ifndef USE_PETSC
+ #error 'This util is for PETSC'
+#endif
+
+using namespace pascinference;
+
+int main( int argc, char *argv[] )
+{
+	/* add local program options */
+	boost::program_options::options_description opt_problem("UTIL_TASKFARM", consoleArg.get_console_nmb_cols());
+	opt_problem.add_options()
+		("taskfarm_manifest", boost::program_options::value< std::string >(), "list of tasks, each line: nprocs shortinfo_filename executable [arguments] [string]")
+		("taskfarm_shortinfo", boost::program_options::value< std::string >(), "name of output file with combined shortinfo of all tasks [string]")
+		("taskfarm_poll", boost::program_options::value<int>(), "sleep between tests of pending messages [us]")
+		("taskfarm_hosts", boost::program_options::value<bool>(), "spawn the task on the hosts of group [bool]")
+		("taskfarm_timeout", boost::program_options::value<double>(), "maximum wall time of one task, then it is reported as failed, 0 means no limit [s]");
+	consoleArg.get_description()->add(opt_problem);
+
+	/* call initialize */
+	if(!Initialize<PetscVector>(argc, argv)){
+		return 0;
+	}
+
+	std::string manifest_filename;
+	std::string shortinfo_filename;
+	int poll_time;
+	bool hosts;
+	double timeout;
+
+	if(!consoleArg.set_option_value("taskfarm_manifest", &manifest_filename)){
+		std::cout << "taskfarm_manifest has to be set! Call application with parameter -h to see all parameters\n";
+		return 0;
+	}
+
+	consoleArg.set_option_value("taskfarm_shortinfo", &shortinfo_filename, "shortinfo_final.txt");
+	consoleArg.set_option_value("taskfarm_poll", &poll_time, TASKFARM_DEFAULT_POLL);
+	consoleArg.set_option_value("taskfarm_hosts", &hosts, TASKFARM_DEFAULT_HOSTS);
+	consoleArg.set_option_value("taskfarm_timeout", &timeout, TASKFARM_DEFAULT_TIMEOUT);
+
+	coutMaster << "- UTIL INFO ----------------------------\n";
+	coutMaster << " taskfarm_manifest      = " << std::setw(30) << manifest_filename << " (list of tasks)\n";
+	coutMaster << " taskfarm_shortinfo     = " << std::setw(30) << shortinfo_filename << " (combined shortinfo)\n";
+	coutMaster << " taskfarm_poll          = " << std::setw(30) << poll_time << " (sleep between tests of messages [us])\n";
+	coutMaster << " taskfarm_hosts         = " << std::setw(30) << hosts << " (spawn on the hosts of group)\n";
+	coutMaster << " taskfarm_timeout       = " << std::setw(30) << timeout << " (maximum time of one task [s])\n";
+	coutMaster << "-------------------------------------------\n" << "\n";
+
+	TaskFarm taskfarm(manifest_filename, poll_time, hosts, timeout);
+	taskfarm.print(coutMaster);
+
+	Timer timer_taskfarm;
+	timer_taskfarm.restart();
+	timer_taskfarm.start();
+
+	taskfarm.run();
+
+	timer_taskfarm.stop();
+
+	/* write results */
+	taskfarm.write_shortinfo(shortinfo_filename);
+
+	coutMaster << std::endl;
+	taskfarm.print(coutMaster);
+	coutMaster << " - all tasks finished in " << timer_taskfarm.get_value_sum() << " s" << std::endl;
+
+	Finalize<PetscVector>();
+
+	return 0;
+}
@@ -24,6 +24,7 @@ template<> class BGMGraph<PetscVector>::ExternalContent {
 };
 
 template<> BGMGraph<PetscVector>::BGMGraph(const double *coordinates_array, int n, int dim);
+template<> BGMGraph<PetscVector>::BGMGraph(const BGMGraph<PetscVector> &graph, int nmb_copies);
 template<> BGMGraph<PetscVector>::~BGMGraph();
 
 template<> int *BGMGraph<PetscVector>::get_neighbor_nmbs_gpu() const;
@@ -6,7 +6,10 @@
 #include "external/petscvector/algebra/matrix/generalmatrix.h"
 #include "external/petscvector/common/decomposition.h"
 #include "external/petscvector/algebra/graph/bgmgraph.h"
+#include "external/petscvector/algebra/graph/bgmgraphgrid1D.h"
+#include "external/petscvector/algebra/graph/bgmgraphgrid2D.h"
 
+#include <vector>
 
 namespace pascinference {
 namespace algebra {
@@ -14,13 +17,63 @@ namespace algebra {
 /* external-specific stuff */
 template<> class BlockGraphSparseMatrix<PetscVector>::ExternalContent {
 	public:
-		Mat A_petsc; /**< internal PETSc matrix */
+		Mat A_petsc; /**< internal PETSc matrix (MATSHELL if the stencil is used) */
+
+		bool stencil; /**< the matrix is not assembled, the space-time stencil is applied on the local rectangle of grid */
+		int T; /**< global number of time steps */
+		int Tbegin; /**< first local time step */
+		int Tlocal; /**< number of local time steps */
+		int K; /**< number of clusters */
+		int grid_width; /**< width of local rectangle of grid */
+		int grid_height; /**< height of local rectangle of grid */
+		Vec halo_Vec; /**< local rectangle with one layer of neighbors in space and time, zeros outside the grid */
+		VecScatter halo_scatter; /**< scatter from global vector to halo_Vec */
+		std::vector<double> timesum; /**< x(t-1) + x(t) + x(t+1) on the local rectangle with neighbors in space */
+		std::vector<double> neighbor_nmbs; /**< number of neighbors of local nodes, repeated for each cluster */
+		double scale; /**< the stencil is multiplied by this value, set by MatScale of MATSHELL */
+
+		/** @brief assemble A_petsc as sparse AIJ matrix (unscaled)
+		*/
+		void assemble(Decomposition<PetscVector> *decomposition);
+
+		/** @brief prepare the stencil if the graph is a grid decomposed into rectangles
+		*
+		* @return true if the stencil could be used on all processes
+		*/
+		bool prepare_stencil(Decomposition<PetscVector> *decomposition);
+
+		/** @brief y = A*x using stencil (the same as assembled matrix multiplied by scale)
+		*/
+		void apply_stencil(Vec x, Vec y);
+
+		/** @brief diagonal of matrix given by stencil (multiplied by scale)
+		*/
+		void get_diagonal_stencil(Vec d) const;
+
+		/** @brief memory of local stencil arrays in bytes
+		*/
+		long long get_stencil_memory() const;
+
+		/** @brief MATOP_MULT of MATSHELL
+		*/
+		static PetscErrorCode stencil_mult(Mat A, Vec x, Vec y);
+
+		/** @brief MATOP_SCALE of MATSHELL (used by PERMON)
+		*/
+		static PetscErrorCode stencil_scale(Mat A, PetscScalar a);
+
+		/** @brief MATOP_GET_DIAGONAL of MATSHELL (used by PERMON)
+		*/
+		static PetscErrorCode stencil_get_diagonal(Mat A, Vec d);
 };
 
 template<> BlockGraphSparseMatrix<PetscVector>::BlockGraphSparseMatrix(Decomposition<PetscVector> &new_decomposition, double alpha, GeneralVector<PetscVector> *new_coeffs);
 template<> BlockGraphSparseMatrix<PetscVector>::~BlockGraphSparseMatrix();
 template<> void BlockGraphSparseMatrix<PetscVector>::printcontent(ConsoleOutput &output) const;
 template<> void BlockGraphSparseMatrix<PetscVector>::matmult(PetscVector &y, const PetscVector &x) const;
+template<> void BlockGraphSparseMatrix<PetscVector>::compute_lambda_max() const;
+template<> double BlockGraphSparseMatrix<PetscVector>::get_lambda_max_scale() const;
+template<> void BlockGraphSparseMatrix<PetscVector>::get_scaling(std::vector<double> &scaling) const;
 
 template<> BlockGraphSparseMatrix<PetscVector>::ExternalContent * BlockGraphSparseMatrix<PetscVector>::get_externalcontent() const;
 
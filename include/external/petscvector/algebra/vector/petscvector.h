@@ -55,6 +55,34 @@ namespace petscvector {
 
 extern int DEBUG_MODE_PETSCVECTOR; /**< defines the debug mode of the functions */
 extern bool PETSC_INITIALIZED; /**< to deal with PetscInitialize and PetscFinalize outside this class */
+extern bool FIRSTTOUCH_PETSCVECTOR; /**< create large vectors with first touch by OpenMP threads */
+
+#define PETSCVECTOR_DEFAULT_FIRSTTOUCH true	/**< default value of FIRSTTOUCH_PETSCVECTOR */
+#define PETSCVECTOR_ALIGNMENT 64				/**< alignment of arrays created with first touch in bytes */
+
+/** @brief create MPI vector with first touch by OpenMP threads
+*
+*  The array is allocated without touching and then it is set to zero by OpenMP threads with static schedule,
+*  therefore each page is placed on the NUMA node of the thread which will process it in the kernels with the same schedule.
+*  The array is freed together with the vector.
+*  If FIRSTTOUCH_PETSCVECTOR is false, then the vector is created in the standard way.
+*
+*  @param comm MPI communicator
+*  @param n_local local size of the vector
+*  @param n_global global size of the vector
+*  @param x_Vec new vector
+*/
+void VecCreateFirstTouch(MPI_Comm comm, int n_local, int n_global, Vec *x_Vec);
+
+/** @brief duplicate vector with first touch by OpenMP threads
+*
+*  Only MPI vectors on host are duplicated with first touch, other types are duplicated using VecDuplicate.
+*  The values are not copied.
+*
+*  @param x_Vec original vector
+*  @param y_Vec new vector
+*/
+void VecDuplicateFirstTouch(Vec x_Vec, Vec *y_Vec);
 
 /* define "all" stuff */
 class petscvector_all_type {};
@@ -72,6 +100,9 @@ class PetscVectorWrapperSub;
 /* wrapper to allow (vector or subvector) = mul(v1,v2) */
 class PetscVectorWrapperMul; 
 
+/* expression template for fused pointwise operations */
+template<class E> class PetscVectorExpr;
+
 
 /** \class PetscVector
  *  \brief General class for manipulation with vectors.
@@ -298,6 +329,17 @@ class PetscVector {
 
 		PetscVector &operator=(PetscVectorWrapperMul mul);
 
+		/** @brief Assignment operator.
+		*
+		*  Evaluate the expression in one pass through local arrays, see petscvectorexpr.h.
+		*  If the inner vector does not exist, then duplicate the vector at first.
+		*
+		*  @param expr pointwise expression
+		*/ 
+		template<class E> PetscVector &operator=(const PetscVectorExpr<E> &expr);
+		template<class E> PetscVector &operator+=(const PetscVectorExpr<E> &expr);
+		template<class E> PetscVector &operator-=(const PetscVectorExpr<E> &expr);
+
 		friend void operator*=(PetscVector &vec1, double alpha);
 		friend void operator+=(const PetscVector &vec1, const PetscVectorWrapperComb comb);
 		friend void operator-=(PetscVector &vec1, const PetscVectorWrapperComb comb);
@@ -752,5 +794,7 @@ class PetscVectorWrapperMul
 
 } /* end of petsc vector namespace */
 
+/* implementation of expression templates */
+#include "external/petscvector/algebra/vector/petscvectorexpr.h"
 
 #endif
@@ -0,0 +1,354 @@
+/** @file petscvectorexpr.h
+ *  @brief Expression templates for fused pointwise operations with PetscVector.
+ *
+ *  Expressions like
+ *  \code
+ *    y = a*lazy(x) + b*lazy(u)*lazy(v) + c;
+ *  \endcode
+ *  are built at compile time and evaluated in one pass through the local arrays
+ *  without any temporary Vec. Only the reductions (sum, dot) need communication,
+ *  they reduce the local result with one MPI_Allreduce.
+ *
+ *  The expression is entered explicitly by lazy(), therefore the original
+ *  operators with PetscVectorWrapperComb are not affected.
+ *  All vectors in expression must have the same local size, this is checked before evaluation.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#ifndef PETSCVECTOREXPR_H
+#define	PETSCVECTOREXPR_H
+
+namespace petscvector {
+
+/** \class PetscVectorExpr
+ *  \brief Base of all expressions, the type of expression is given by template parameter (CRTP).
+ *
+ *  Each expression provides
+ *  - operator[](i) - the value of i-th local component
+ *  - acquire(y,y_arr) - get local arrays of all vectors in expression, if the vector is the result y, then y_arr is used
+ *  - release() - restore local arrays
+ *  - check_size(local_size) - check if the local sizes of all vectors in expression are equal to given size
+ *  - get_vector() - one of the vectors in expression (to duplicate the layout and to get communicator), NULL if there is no vector
+*/
+template<class E>
+class PetscVectorExpr {
+	public:
+		const E &self() const {
+			return static_cast<const E&>(*this);
+		}
+};
+
+/** \class PetscVectorExprVec
+ *  \brief Leaf of the expression - local array of PetscVector.
+*/
+class PetscVectorExprVec : public PetscVectorExpr<PetscVectorExprVec> {
+	private:
+		Vec inner_vector; /**< vector in expression */
+		mutable const double *inner_arr; /**< local array of vector, valid between acquire() and release() */
+		mutable bool restore_arr; /**< the array was obtained using VecGetArrayRead */
+
+	public:
+		PetscVectorExprVec(Vec new_inner_vector);
+
+		void acquire(Vec y, double *y_arr) const;
+		void release() const;
+		void check_size(int local_size) const;
+		Vec get_vector() const;
+
+		double operator[](int i) const {
+			return inner_arr[i];
+		}
+};
+
+/** \class PetscVectorExprScalar
+ *  \brief Leaf of the expression - scalar value.
+*/
+class PetscVectorExprScalar : public PetscVectorExpr<PetscVectorExprScalar> {
+	private:
+		double value;
+
+	public:
+		PetscVectorExprScalar(double new_value) : value(new_value) {}
+
+		void acquire(Vec y, double *y_arr) const {}
+		void release() const {}
+		void check_size(int local_size) const {}
+		Vec get_vector() const {
+			return NULL;
+		}
+
+		double operator[](int i) const {
+			return value;
+		}
+};
+
+/* pointwise operations */
+struct PetscVectorExprAdd {
+	static double apply(double a, double b){ return a+b; }
+};
+struct PetscVectorExprSub {
+	static double apply(double a, double b){ return a-b; }
+};
+struct PetscVectorExprMul {
+	static double apply(double a, double b){ return a*b; }
+};
+struct PetscVectorExprDiv {
+	static double apply(double a, double b){ return a/b; }
+};
+
+/** \class PetscVectorExprBinary
+ *  \brief Node of the expression - pointwise binary operation of two subexpressions.
+*/
+template<class L, class R, class Op>
+class PetscVectorExprBinary : public PetscVectorExpr<PetscVectorExprBinary<L,R,Op> > {
+	private:
+		L left; /**< left operand, stored by value (leaves are small) */
+		R right; /**< right operand */
+
+	public:
+		PetscVectorExprBinary(const L &new_left, const R &new_right) : left(new_left), right(new_right) {}
+
+		void acquire(Vec y, double *y_arr) const {
+			left.acquire(y, y_arr);
+			right.acquire(y, y_arr);
+		}
+		void release() const {
+			left.release();
+			right.release();
+		}
+		void check_size(int local_size) const {
+			left.check_size(local_size);
+			right.check_size(local_size);
+		}
+		Vec get_vector() const {
+			Vec vector = left.get_vector();
+			return vector? vector : right.get_vector();
+		}
+
+		double operator[](int i) const {
+			return Op::apply(left[i], right[i]);
+		}
+};
+
+/** @brief Enter the expression layer with given vector.
+*
+*  @param x vector in expression
+*/
+inline PetscVectorExprVec lazy(const PetscVector &x){
+	return PetscVectorExprVec(x.get_vector());
+}
+
+/* expr op expr */
+template<class L, class R>
+PetscVectorExprBinary<L,R,PetscVectorExprAdd> operator+(const PetscVectorExpr<L> &left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<L,R,PetscVectorExprAdd>(left.self(), right.self());
+}
+
+template<class L, class R>
+PetscVectorExprBinary<L,R,PetscVectorExprSub> operator-(const PetscVectorExpr<L> &left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<L,R,PetscVectorExprSub>(left.self(), right.self());
+}
+
+template<class L, class R>
+PetscVectorExprBinary<L,R,PetscVectorExprMul> operator*(const PetscVectorExpr<L> &left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<L,R,PetscVectorExprMul>(left.self(), right.self());
+}
+
+template<class L, class R>
+PetscVectorExprBinary<L,R,PetscVectorExprDiv> operator/(const PetscVectorExpr<L> &left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<L,R,PetscVectorExprDiv>(left.self(), right.self());
+}
+
+/* expr op scalar */
+template<class L>
+PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprAdd> operator+(const PetscVectorExpr<L> &left, double right){
+	return PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprAdd>(left.self(), PetscVectorExprScalar(right));
+}
+
+template<class L>
+PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprSub> operator-(const PetscVectorExpr<L> &left, double right){
+	return PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprSub>(left.self(), PetscVectorExprScalar(right));
+}
+
+template<class L>
+PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprMul> operator*(const PetscVectorExpr<L> &left, double right){
+	return PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprMul>(left.self(), PetscVectorExprScalar(right));
+}
+
+template<class L>
+PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprDiv> operator/(const PetscVectorExpr<L> &left, double right){
+	return PetscVectorExprBinary<L,PetscVectorExprScalar,PetscVectorExprDiv>(left.self(), PetscVectorExprScalar(right));
+}
+
+/* scalar op expr */
+template<class R>
+PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprAdd> operator+(double left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprAdd>(PetscVectorExprScalar(left), right.self());
+}
+
+template<class R>
+PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprSub> operator-(double left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprSub>(PetscVectorExprScalar(left), right.self());
+}
+
+template<class R>
+PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprMul> operator*(double left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprMul>(PetscVectorExprScalar(left), right.self());
+}
+
+template<class R>
+PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprDiv> operator/(double left, const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprDiv>(PetscVectorExprScalar(left), right.self());
+}
+
+/* -expr */
+template<class R>
+PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprMul> operator-(const PetscVectorExpr<R> &right){
+	return PetscVectorExprBinary<PetscVectorExprScalar,R,PetscVectorExprMul>(PetscVectorExprScalar(-1.0), right.self());
+}
+
+/* raise PETSc error if the expression does not contain any vector, its size is not known */
+void PetscVectorExprCheckVector(Vec x);
+
+/* evaluate y = init_scale*y + expr in one pass through local arrays */
+template<class E>
+void PetscVectorExprEvaluate(Vec y, const PetscVectorExpr<E> &expr, double init_scale){
+	const E &e = expr.self();
+
+	int local_size;
+	double *y_arr;
+	TRYCXX( VecGetLocalSize(y, &local_size) );
+	e.check_size(local_size);
+
+	TRYCXX( VecGetArray(y, &y_arr) );
+
+	e.acquire(y, y_arr);
+
+	if(init_scale == 0.0){
+		for(int i=0;i<local_size;i++){
+			y_arr[i] = e[i];
+		}
+	} else {
+		for(int i=0;i<local_size;i++){
+			y_arr[i] = init_scale*y_arr[i] + e[i];
+		}
+	}
+
+	e.release();
+
+	TRYCXX( VecRestoreArray(y, &y_arr) );
+}
+
+/* vec = expr */
+template<class E>
+PetscVector &PetscVector::operator=(const PetscVectorExpr<E> &expr){
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)OPERATOR: (vec = expr)" << std::endl;
+
+	/* vec is not initialized yet */
+	if (!inner_vector){
+		if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << " - duplicate vector" << std::endl;
+		PetscVectorExprCheckVector(expr.self().get_vector());
+		TRYCXX( VecDuplicate(expr.self().get_vector(),&inner_vector) );
+	}
+
+	PetscVectorExprEvaluate(inner_vector, expr, 0.0);
+
+	return *this;
+}
+
+/* vec += expr */
+template<class E>
+PetscVector &PetscVector::operator+=(const PetscVectorExpr<E> &expr){
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)OPERATOR: (vec += expr)" << std::endl;
+
+	PetscVectorExprEvaluate(inner_vector, expr, 1.0);
+
+	return *this;
+}
+
+/* vec -= expr */
+template<class E>
+PetscVector &PetscVector::operator-=(const PetscVectorExpr<E> &expr){
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)OPERATOR: (vec -= expr)" << std::endl;
+
+	PetscVectorExprEvaluate(inner_vector, -expr, 1.0);
+
+	return *this;
+}
+
+/** @brief Sum of the components of expression.
+*
+*  Local sum is computed in one pass, then reduced using MPI_Allreduce.
+*  The expression has to contain at least one vector, otherwise its size is not known.
+*
+*  @param expr expression
+*/
+template<class E>
+double sum(const PetscVectorExpr<E> &expr){
+	const E &e = expr.self();
+	Vec x = e.get_vector();
+	PetscVectorExprCheckVector(x);
+
+	int local_size;
+	TRYCXX( VecGetLocalSize(x, &local_size) );
+	e.check_size(local_size);
+
+	e.acquire(NULL, NULL);
+	double local_sum = 0.0;
+	for(int i=0;i<local_size;i++){
+		local_sum += e[i];
+	}
+	e.release();
+
+	double global_sum;
+	MPI_Allreduce(&local_sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, PetscObjectComm((PetscObject)x));
+
+	return global_sum;
+}
+
+/** @brief Print local values of expression.
+*
+*  The values are computed in one pass through local arrays without temporary vector.
+*
+*  @param output where to print
+*  @param expr expression
+*/
+template<class E>
+std::ostream &operator<<(std::ostream &output, const PetscVectorExpr<E> &expr){
+	const E &e = expr.self();
+	Vec x = e.get_vector();
+	PetscVectorExprCheckVector(x);
+
+	int local_size;
+	TRYCXX( VecGetLocalSize(x, &local_size) );
+	e.check_size(local_size);
+
+	e.acquire(NULL, NULL);
+	output << "[";
+	for(int i=0;i<local_size;i++){
+		output << e[i];
+		if(i < local_size-1) output << ", ";
+	}
+	output << "]";
+	e.release();
+
+	return output;
+}
+
+/** @brief Dot product of two expressions.
+*
+*  Local dot product is computed in one pass, then reduced using MPI_Allreduce.
+*
+*  @param expr1 first expression
+*  @param expr2 second expression
+*/
+template<class L, class R>
+double dot(const PetscVectorExpr<L> &expr1, const PetscVectorExpr<R> &expr2){
+	return sum(expr1*expr2);
+}
+
+
+} /* end of petscvector namespace */
+
+#endif
@@ -13,6 +13,7 @@ template<> Decomposition<PetscVector>::Decomposition(int T, BGMGraph<PetscVector
 
 template<> Decomposition<PetscVector>::~Decomposition();
 template<> void Decomposition<PetscVector>::compute_rank();
+template<> void Decomposition<PetscVector>::measure_network(double *bandwidth, double *latency);
 template<> void Decomposition<PetscVector>::set_graph(BGMGraph<PetscVector> &new_graph, int DDR_size);
 
 template<> void Decomposition<PetscVector>::createGlobalVec_gamma(Vec *x_Vec) const;
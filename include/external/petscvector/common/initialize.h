@@ -10,6 +10,7 @@
 
 #include "external/petscvector/algebra/vector/generalvector.h"
 #include "general/common/initialize.h"
+#include "general/common/taskfarm.h"
 
 namespace pascinference {
 namespace common {
@@ -19,6 +19,7 @@
 #include "external/petscvector/data/imagedata.h"
 //#include "external/petscvector/data/qpdata.h"
 #include "external/petscvector/data/signal1Ddata.h"
+#include "external/petscvector/data/resultfile.h"
 //#include "external/petscvector/data/simpledata.h"
 
 
@@ -0,0 +1,57 @@
+#ifndef PASC_PETSCVECTOR_RESULTFILE_H
+#define	PASC_PETSCVECTOR_RESULTFILE_H
+
+#include "external/petscvector/algebra/vector/generalvector.h"
+#include "general/data/resultfile.h"
+#include "external/petscvector/data/tsdata.h"
+#include "external/petscvector/common/common.h"
+#include <list>
+#include <deque>
+
+namespace pascinference {
+namespace data {
+
+/** \struct ResultFileSnapshot
+ *  \brief encoded buffers of one record which are written in background
+ *
+ *  Buffers have to stay alive until all requests are finished.
+*/
+struct ResultFileSnapshot {
+	std::list<std::vector<char> > buffers;	/**< encoded data and the table of records, list does not move stored buffers */
+	std::vector<MPI_Request> requests;		/**< unfinished nonblocking writes */
+	int64_t header_table[2];				/**< position of the table of records written with this record and number of records, stored to header when finished */
+};
+
+/* external-specific stuff */
+template<> class ResultFile<PetscVector>::ExternalContent {
+	public:
+		MPI_File file; /**< file opened for parallel I/O */
+		std::deque<ResultFileSnapshot*> inflight; /**< records which are still being written, the oldest first */
+
+		/** @brief start nonblocking write of buffer, the buffer is moved into the snapshot
+		 *
+		 * @param snapshot owner of the buffer
+		 * @param offset position in file
+		 * @param buffer the content to write, it is empty after the call
+		 */
+		void iwrite(ResultFileSnapshot *snapshot, int64_t offset, std::vector<char> &buffer);
+
+		/** @brief wait until the oldest snapshot is written on all processes, publish its table in header and free it
+		 *
+		 * Collective, the number of snapshots is the same on all processes.
+		 */
+		void wait_oldest();
+};
+
+template<> ResultFile<PetscVector>::ResultFile(TSData<PetscVector> &tsdata, std::string filename);
+template<> ResultFile<PetscVector>::~ResultFile();
+template<> void ResultFile<PetscVector>::write_field(int type, const double *values, int64_t row_begin, int nrows_local, int blocksize, int64_t nrows_global, ResultFileField *fieldinfo);
+template<> void ResultFile<PetscVector>::write(double epssqr, int id);
+template<> void ResultFile<PetscVector>::flush();
+
+template<> ResultFile<PetscVector>::ExternalContent * ResultFile<PetscVector>::get_externalcontent() const;
+
+}
+} /* end namespace */
+
+#endif
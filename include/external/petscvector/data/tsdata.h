@@ -36,6 +36,12 @@ template<> void TSData<PetscVector>::scaledata(double a, double b, double scale_
 template<> void TSData<PetscVector>::load_gammavector(PetscVector &gamma0) const;
 template<> void TSData<PetscVector>::load_gammavector(std::string filename) const;
 template<> double TSData<PetscVector>::compute_gammavector_nbins();
+template<> void TSData<PetscVector>::append_samples(const double *values, int nsamples);
+template<> void TSData<PetscVector>::saveXDMF(std::string filename) const;
+template<> void TSData<PetscVector>::init_gammavector_kmeans(int seed, int nmb_lloyd, double softness) const;
+template<> void TSData<PetscVector>::save_gammalabels(std::string filename) const;
+template<> void TSData<PetscVector>::load_gammalabels(std::string filename) const;
+template<> void TSData<PetscVector>::compute_recovered(GeneralVector<PetscVector> &recovered) const;
 
 
 }
@@ -10,6 +10,7 @@
 //#include "external/petscvector/data/qpdata.h"
 #include "external/petscvector/algebra/feasibleset/simplex_local.h"
 #include "external/petscvector/solver/spgqpsolver.h"
+#include "external/petscvector/solver/fistaqpsolver.h"
 //#include "external/petscvector/solver/spgqpsolver_coeff.h"
 //#include "external/petscvector/solver/taosolver.h"
 
@@ -13,6 +13,7 @@
 #include "external/petscvector/algebra/feasibleset/simplex_lineqbound.h"
 
 #include "external/petscvector/solver/spgqpsolver.h"
+#include "external/petscvector/solver/fistaqpsolver.h"
 #include "external/petscvector/solver/permonsolver.h"
 
 //#include "external/petscvector/solver/spgqpsolver_coeff.h"
@@ -34,7 +35,7 @@
 namespace pascinference {
 namespace model {
 
-template<> GraphH1FEMModel<PetscVector>::GraphH1FEMModel(TSData<PetscVector> &new_tsdata, double epssqr, Fem<PetscVector> *new_fem, bool usethetainpenalty);
+template<> GraphH1FEMModel<PetscVector>::GraphH1FEMModel(TSData<PetscVector> &new_tsdata, double epssqr, Fem<PetscVector> *new_fem, bool usethetainpenalty, int nmb_batch);
 template<> void GraphH1FEMModel<PetscVector>::printsolution(ConsoleOutput &output_global, ConsoleOutput &output_local) const;
 
 template<> void GraphH1FEMModel<PetscVector>::initialize_gammasolver(GeneralSolver **gammasolver);
@@ -10,6 +10,8 @@
 /* petsc stuff */
 #include <petscksp.h>
 
+#include <vector>
+
 #ifdef USE_DLIB
 
 namespace pascinference {
@@ -27,6 +29,9 @@ template<> class EntropySolverNewton<PetscVector>::ExternalContent {
 		KSP ksp;							/**< linear solver context */
 		PC pc;           					/**< preconditioner context **/
 
+		std::vector<double> lambda_integrated;	/**< lambda of all clusters at the end of solve(), size K*Km */
+		std::vector<double> logZ;				/**< log of normalization integral of each cluster for lambda_integrated, size K */
+
 		/* functions for Dlib */
 		#ifdef USE_DLIB
 			double gg(double y, int order, column_vector& LM);
@@ -0,0 +1,21 @@
+#ifndef PASC_PETSCVECTOR_FISTAQPSOLVER_H
+#define	PASC_PETSCVECTOR_FISTAQPSOLVER_H
+
+#include "general/solver/fistaqpsolver.h"
+
+#include "external/petscvector/common/common.h"
+//#include "external/petscvector/solver/qpsolver.h"
+//#include "external/petscvector/data/qpdata.h"
+
+namespace pascinference {
+namespace solver {
+
+template<> std::string FISTAQPSolver<PetscVector>::get_name() const;
+template<> void FISTAQPSolver<PetscVector>::allocate_temp_vectors();
+template<> void FISTAQPSolver<PetscVector>::free_temp_vectors();
+
+}
+} /* end namespace */
+
+
+#endif
@@ -13,11 +13,12 @@
 
 //#include "external/petscvector/solver/generalsolver.h"
 
-//#include "external/petscvector/solver/tssolver.h"
+#include "external/petscvector/solver/tssolver.h"
 #include "external/petscvector/solver/cgqpsolver.h"
 //#include "external/petscvector/solver/diagsolver.h"
 #include "external/petscvector/solver/entropysolverdlib.h"
 #include "external/petscvector/solver/entropysolvernewton.h"
+#include "external/petscvector/solver/fistaqpsolver.h"
 //#include "external/petscvector/solver/multicg.h"
 #include "external/petscvector/solver/permonsolver.h"
 //#include "external/petscvector/solver/qpsolver.h"
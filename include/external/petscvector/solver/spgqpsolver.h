@@ -28,8 +28,10 @@ template<> std::string SPGQPSolver<PetscVector>::get_name() const;
 template<> void SPGQPSolver<PetscVector>::allocate_temp_vectors();
 template<> void SPGQPSolver<PetscVector>::free_temp_vectors();
 template<> void SPGQPSolver<PetscVector>::solve();
+template<> void SPGQPSolver<PetscVector>::solve_batch();
 template<> double SPGQPSolver<PetscVector>::get_fx() const;
 template<> void SPGQPSolver<PetscVector>::compute_dots(double *dd, double *dAd, double *gd) const;
+template<> double SPGQPSolver<PetscVector>::get_alphainit() const;
 
 template<> SPGQPSolver<PetscVector>::ExternalContent * SPGQPSolver<PetscVector>::get_externalcontent() const;
 
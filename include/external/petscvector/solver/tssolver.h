@@ -0,0 +1,23 @@
+#ifndef PASC_PETSCVECTOR_TSSOLVER_H
+#define	PASC_PETSCVECTOR_TSSOLVER_H
+
+#include "general/solver/tssolver.h"
+
+#include "external/petscvector/common/common.h"
+#include "external/petscvector/algebra/vector/generalvector.h"
+#include "external/petscvector/data/tsdata.h"
+
+namespace pascinference {
+namespace solver {
+
+template<> void TSSolver<PetscVector>::save_checkpoint(bool finished, int it_annealing, int it, double L, int it_gammasolver, int it_thetasolver);
+template<> bool TSSolver<PetscVector>::load_checkpoint();
+template<> bool TSSolver<PetscVector>::read_checkpoint_header(TSSolverCheckpointHeader *header) const;
+template<> int TSSolver<PetscVector>::get_checkpoint_restart_id() const;
+template<> double TSSolver<PetscVector>::extrapolate_gamma(GeneralVector<PetscVector> *gammavector_prev, double beta);
+
+}
+} /* end namespace */
+
+
+#endif
@@ -9,15 +9,15 @@
 /* matrix */
 //#include "external/seqarrayvector/algebra/matrix/generalmatrixrhs.h"
 //#include "external/seqarrayvector/algebra/matrix/generalmatrix.h"
-//#include "external/seqarrayvector/algebra/matrix/blockgraphsparse.h"
+#include "external/seqarrayvector/algebra/matrix/blockgraphsparse.h"
 
 /* feasibleset */
 //#include "external/seqarrayvector/algebra/feasibleset/generalfeasibleset.h"
 //#include "external/seqarrayvector/algebra/feasibleset/simplex_lineqbound.h"
-//#include "external/seqarrayvector/algebra/feasibleset/simplex_local.h"
+#include "external/seqarrayvector/algebra/feasibleset/simplex_local.h"
 
 /* graph */
-//#include "external/seqarrayvector/algebra/graph/bgmgraph.h"
+#include "external/seqarrayvector/algebra/graph/bgmgraph.h"
 //#include "external/seqarrayvector/algebra/graph/bgmgraphgrid1D.h"
 //#include "external/seqarrayvector/algebra/graph/bgmgraphgrid2D.h"
 
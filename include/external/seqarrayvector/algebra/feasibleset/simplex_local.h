@@ -0,0 +1,16 @@
+#ifndef PASC_SEQARRAYVECTOR_SIMPLEXFEASIBLESET_LOCAL_H
+#define	PASC_SEQARRAYVECTOR_SIMPLEXFEASIBLESET_LOCAL_H
+
+#include "external/seqarrayvector/algebra/vector/generalvector.h"
+#include "general/algebra/feasibleset/simplex_local.h"
+
+namespace pascinference {
+namespace algebra {
+
+template<> void SimplexFeasibleSet_Local<SeqArrayVector>::project(GeneralVector<SeqArrayVector> &x);
+
+}
+} /* end of namespace */
+
+
+#endif
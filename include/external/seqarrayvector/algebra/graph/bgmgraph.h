@@ -0,0 +1,16 @@
+#ifndef PASC_SEQARRAYVECTOR_COMMON_BGMGRAPH_H
+#define	PASC_SEQARRAYVECTOR_COMMON_BGMGRAPH_H
+
+#include "external/seqarrayvector/algebra/vector/generalvector.h"
+#include "general/algebra/graph/bgmgraph.h"
+
+namespace pascinference {
+namespace algebra {
+
+template<> BGMGraph<SeqArrayVector>::BGMGraph(const double *coordinates_array, int n, int dim);
+template<> void BGMGraph<SeqArrayVector>::process(double threshold);
+
+}
+} /* end of namespace */
+
+#endif
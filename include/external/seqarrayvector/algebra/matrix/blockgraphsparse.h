@@ -0,0 +1,30 @@
+#ifndef PASC_SEQARRAYVECTOR_BLOCKGRAPHSPARSEMATRIX_H
+#define	PASC_SEQARRAYVECTOR_BLOCKGRAPHSPARSEMATRIX_H
+
+#include "general/algebra/matrix/blockgraphsparse.h"
+#include "external/seqarrayvector/algebra/vector/generalvector.h"
+#include "external/seqarrayvector/common/decomposition.h"
+#include "external/seqarrayvector/algebra/graph/bgmgraph.h"
+
+
+namespace pascinference {
+namespace algebra {
+
+/* external-specific stuff */
+template<> class BlockGraphSparseMatrix<SeqArrayVector>::ExternalContent {
+	public:
+		std::vector<int> neighbor_begin;	/**< beginning of neighbors of node r in neighbor_ids, size R+1 */
+		std::vector<int> neighbor_ids;		/**< neighbors of nodes (in permuted numbering) stored one after another */
+};
+
+template<> BlockGraphSparseMatrix<SeqArrayVector>::BlockGraphSparseMatrix(Decomposition<SeqArrayVector> &new_decomposition, double alpha, GeneralVector<SeqArrayVector> *new_coeffs);
+template<> BlockGraphSparseMatrix<SeqArrayVector>::~BlockGraphSparseMatrix();
+template<> void BlockGraphSparseMatrix<SeqArrayVector>::matmult(SeqArrayVector &y, const SeqArrayVector &x) const;
+template<> double BlockGraphSparseMatrix<SeqArrayVector>::get_lambda_max_scale() const;
+
+template<> BlockGraphSparseMatrix<SeqArrayVector>::ExternalContent * BlockGraphSparseMatrix<SeqArrayVector>::get_externalcontent() const;
+
+}
+} /* end of namespace */
+
+#endif
@@ -18,6 +18,11 @@
 
 #include <limits>
 #include <math.h>
+#include <stdlib.h>
+
+#define SEQARRAYVECTOR_ALIGNMENT 64			/**< alignment of inner arrays in bytes (cache line, fits AVX-512) */
+#define SEQARRAYVECTOR_PARALLEL_MIN 20000	/**< shorter vectors are processed by one thread */
+#define SEQARRAYVECTOR_VEC_CLASSID 1211214	/**< VEC_FILE_CLASSID of PETSc binary file */
 
 /* we are using namespace petscvector */
 namespace seqarrayvector {
@@ -26,14 +31,28 @@ namespace seqarrayvector {
 class seqarrayvector_all_type {};
 extern seqarrayvector_all_type all; /**< brings an opportunity to call SeqArrayVector(all) */
 
+/** @brief allocate aligned array of doubles
+*
+*  The memory is touched by the same threads which will later process it in kernels.
+*  Free the array using free().
+*
+*  @param n number of components
+*  @return new aligned array
+*/
+double *allocate_aligned(int n);
+
 /** \class SeqArrayVector
  *  \brief General class for manipulation with vectors.
  *
+ *  Sequential vector stored in aligned array, the operations are threaded using OpenMP.
+ *  Subvectors are views into the array of the original vector (no values are copied).
+ *
 */
 class SeqArrayVector {
 	private:
 		double *inner_array; /**< content of values */
 		int inner_size;		 /**< length of array */
+		bool destroy_inner_array; /**< this vector is the owner of inner array */
 		
 	public:
 
@@ -46,7 +65,7 @@ class SeqArrayVector {
 
 		/** @brief Create constructor.
 		*
-		*  Create new vector of given size n.
+		*  Create new vector of given size n, the values are set to zero.
 		*
 		*  @param n global size of new vector
 		*/ 
@@ -55,6 +74,7 @@ class SeqArrayVector {
 		/** @brief Create constructor.
 		*
 		*  Create sequential vector of given values and size n.
+		*  The array is not copied, the owner of this array is somewhere else.
 		*
 		*  @param values array with values of array
 		*  @param n global size of new vector
@@ -69,6 +89,14 @@ class SeqArrayVector {
 		*/ 
 		SeqArrayVector(const SeqArrayVector &vec1);
 
+		/** @brief Move constructor.
+		*
+		*  Take over the inner array of temporary vector, the views stay views.
+		*
+		*  @param vec temporary vector
+		*/ 
+		SeqArrayVector(SeqArrayVector &&vec1);
+
 		/** @brief Destructor.
 		*
 		*  If inner array is present, then destroy it.
@@ -146,6 +174,21 @@ class SeqArrayVector {
 		*/ 
 		void save_csv(std::string filename);
 
+		/** @brief Load values from binary file in PETSc format.
+		*
+		*  The file contains VEC_FILE_CLASSID, size and values, all in big-endian,
+		*  therefore the same files as in PetscVector variant can be used.
+		*
+		*  @param filename name of file with values
+		*/ 
+		void load_binary(std::string filename);
+
+		/** @brief Save vector to binary file in PETSc format.
+		*
+		*  @param filename name of file
+		*/ 
+		void save_binary(std::string filename) const;
+
 		/** @brief Assignment operator.
 		*
 		*  Copy values from one vector to another.
@@ -165,12 +208,12 @@ class SeqArrayVector {
 		SeqArrayVector &operator=(double alpha);
 
 		friend void operator*=(SeqArrayVector &vec1, double alpha);
-		friend void operator+=(const SeqArrayVector &vec1, const SeqArrayVector comb);
-		friend void operator-=(SeqArrayVector &vec1, const SeqArrayVector comb);
+		friend void operator+=(const SeqArrayVector &vec1, const SeqArrayVector &vec2);
+		friend void operator-=(const SeqArrayVector &vec1, const SeqArrayVector &vec2);
 
 		/** @brief Get subvector.
 		*
-		*  Get the subvector with one element defined by given index.
+		*  Get the view of one element defined by given index.
 		*
 		*  @param index index of the element
 		*  @return subvector 
@@ -179,10 +222,11 @@ class SeqArrayVector {
 
 		/** @brief Get subvector.
 		*
-		*  Get the subvector with elements defined by given lower and upper index.
+		*  Get the view of elements with indexes index_begin, ..., index_end-1.
+		*  The values are not copied, the view writes directly to this vector.
 		*
 		*  @param index_begin first index of the subvector
-		*  @param index_end last index of the subvector
+		*  @param index_end last index of the subvector plus one
 		*  @return subvector 
 		*/ 
 		SeqArrayVector operator()(int index_begin,int index_end) const;
@@ -253,12 +297,11 @@ class SeqArrayVector {
 
 		/** @brief Pointwise divide of two vectors.
 		*
-		*  Divide values of the inner vector by components of input vector.
-		*  \f[ x_i = \frac{x_i}{y_i}, ~~\forall i = 0, \dots, size-1 \f]
+		*  Computes pointwise quotient of two given vectors.
+		*  \f[ z_i = \frac{x_i}{y_i}, ~~\forall i = 0, \dots, size-1 \f]
 		*
 		*  @param x vector
 		*  @param y vector
-		*  @todo this function is really strange 
 		*/ 
 		friend const SeqArrayVector operator/(const SeqArrayVector &x, const SeqArrayVector &y);
 
@@ -266,21 +309,38 @@ class SeqArrayVector {
 		*
 		*  Computes pointwise product of two given vectors.
 		*  \f[\mathrm{mul}_i = x_i y_i \f]
-		*  uses Petsc function VecPointwiseMult(Vec w, Vec x,Vec y) 
 		* 
 		*  @param x first vector
 		*  @param y second vector
-		*  @todo control if inner_vectors were allocated
 		*/ 
 		friend SeqArrayVector mul(const SeqArrayVector &x, const SeqArrayVector &y);
 
+		/** @brief Update vector by multiple of other vector.
+		*
+		*  \f[ y = y + \alpha x \f]
+		* 
+		*  @param y updated vector
+		*  @param alpha coefficient
+		*  @param x second vector
+		*/ 
+		friend void axpy(SeqArrayVector &y, double alpha, const SeqArrayVector &x);
+
+		/** @brief Linear combination of two vectors.
+		*
+		*  \f[ w = y + \alpha x \f]
+		* 
+		*  @param w result
+		*  @param y first vector
+		*  @param alpha coefficient
+		*  @param x second vector
+		*/ 
+		friend void waxpy(SeqArrayVector &w, const SeqArrayVector &y, double alpha, const SeqArrayVector &x);
+
 };
 
 extern void operator*=(SeqArrayVector &vec1, double alpha);
-extern std::ostream &operator<<(std::ostream &output, const SeqArrayVector &vector);
-extern void operator*=(SeqArrayVector &vec1, double alpha);
-extern void operator+=(const SeqArrayVector &vec1, const SeqArrayVector vec2);
-extern void operator-=(const SeqArrayVector &vec1, const SeqArrayVector vec2);
+extern void operator+=(const SeqArrayVector &vec1, const SeqArrayVector &vec2);
+extern void operator-=(const SeqArrayVector &vec1, const SeqArrayVector &vec2);
 extern std::ostream &operator<<(std::ostream &output, const SeqArrayVector &vector);
 extern double dot(const SeqArrayVector &x, const SeqArrayVector &y);
 extern double max(const SeqArrayVector &x);
@@ -289,6 +349,8 @@ extern double sum(const SeqArrayVector &x);
 extern double norm(const SeqArrayVector &x);
 extern const SeqArrayVector operator/(const SeqArrayVector &x, const SeqArrayVector &y);
 extern SeqArrayVector mul(const SeqArrayVector &x, const SeqArrayVector &y);
+extern void axpy(SeqArrayVector &y, double alpha, const SeqArrayVector &x);
+extern void waxpy(SeqArrayVector &w, const SeqArrayVector &y, double alpha, const SeqArrayVector &x);
 
 
 } /* end of petsc vector namespace */
@@ -14,6 +14,7 @@ template<> Decomposition<SeqArrayVector>::Decomposition(int T, BGMGraph<SeqArray
 template<> Decomposition<SeqArrayVector>::~Decomposition();
 template<> void Decomposition<SeqArrayVector>::compute_rank();
 template<> void Decomposition<SeqArrayVector>::set_graph(BGMGraph<SeqArrayVector> &new_graph, int DDR_size);
+template<> void Decomposition<SeqArrayVector>::permute_TRblocksize(double *orig_arr, double *new_arr, int blocksize, bool invert) const;
 /*
 template<> void Decomposition<SeqArrayVector>::createGlobalVec_gamma(Vec *x_Vec) const;
 template<> void Decomposition<SeqArrayVector>::createGlobalVec_data(Vec *x_Vec) const;
@@ -0,0 +1,18 @@
+#ifndef PASC_SEQARRAYVECTOR_IMAGEDATA_H
+#define	PASC_SEQARRAYVECTOR_IMAGEDATA_H
+
+#include "external/seqarrayvector/algebra/vector/generalvector.h"
+#include "general/data/imagedata.h"
+#include "external/seqarrayvector/data/tsdata.h"
+#include "external/seqarrayvector/common/common.h"
+
+namespace pascinference {
+namespace data {
+
+template<> ImageData<SeqArrayVector>::ImageData(Decomposition<SeqArrayVector> &new_decomposition, std::string filename_data, int width, int height);
+template<> void ImageData<SeqArrayVector>::saveImage(std::string filename, bool save_original) const;
+
+}
+} /* end namespace */
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef PASC_SEQARRAYVECTOR_SIGNAL1DDATA_H
+#define	PASC_SEQARRAYVECTOR_SIGNAL1DDATA_H
+
+#include "external/seqarrayvector/algebra/vector/generalvector.h"
+#include "general/data/signal1Ddata.h"
+#include "external/seqarrayvector/data/tsdata.h"
+#include "external/seqarrayvector/common/common.h"
+
+namespace pascinference {
+namespace data {
+
+template<> Signal1DData<SeqArrayVector>::Signal1DData(std::string filename_data);
+template<> void Signal1DData<SeqArrayVector>::set_decomposition(Decomposition<SeqArrayVector> &new_decomposition);
+template<> void Signal1DData<SeqArrayVector>::saveSignal1D(std::string filename, bool save_original) const;
+template<> double Signal1DData<SeqArrayVector>::compute_abserr_reconstructed(GeneralVector<SeqArrayVector> &solution) const;
+
+}
+} /* end namespace */
+
+#endif
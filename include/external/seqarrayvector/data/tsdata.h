@@ -0,0 +1,20 @@
+#ifndef PASC_SEQARRAYVECTOR_TSDATA_H
+#define	PASC_SEQARRAYVECTOR_TSDATA_H
+
+#include "general/data/tsdata.h"
+
+#include "external/seqarrayvector/algebra/vector/generalvector.h"
+#include "external/seqarrayvector/common/decomposition.h"
+
+namespace pascinference {
+namespace data {
+
+template<> TSData<SeqArrayVector>::TSData(Decomposition<SeqArrayVector> &new_decomposition);
+template<> TSData<SeqArrayVector>::~TSData();
+template<> void TSData<SeqArrayVector>::set_model(TSModel<SeqArrayVector> &tsmodel);
+template<> void TSData<SeqArrayVector>::compute_recovered(GeneralVector<SeqArrayVector> &recovered) const;
+
+}
+} /* end namespace */
+
+#endif
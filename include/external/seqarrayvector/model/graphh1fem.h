@@ -0,0 +1,36 @@
+#ifndef PASC_SEQARRAYVECTOR_GRAPHH1FEMMODEL_H
+#define PASC_SEQARRAYVECTOR_GRAPHH1FEMMODEL_H
+
+#include "general/model/graphh1fem.h"
+
+#include "external/seqarrayvector/common/common.h"
+
+/* gamma problem */
+#include "external/seqarrayvector/algebra/graph/bgmgraph.h"
+#include "external/seqarrayvector/algebra/matrix/blockgraphsparse.h"
+#include "external/seqarrayvector/algebra/feasibleset/simplex_local.h"
+#include "external/seqarrayvector/solver/spgqpsolver.h"
+
+/* theta problem */
+#include "external/seqarrayvector/data/tsdata.h"
+
+
+namespace pascinference {
+namespace model {
+
+template<> GraphH1FEMModel<SeqArrayVector>::GraphH1FEMModel(TSData<SeqArrayVector> &new_tsdata, double epssqr, Fem<SeqArrayVector> *new_fem, bool usethetainpenalty, int nmb_batch);
+template<> void GraphH1FEMModel<SeqArrayVector>::printsolution(ConsoleOutput &output_global, ConsoleOutput &output_local) const;
+
+template<> void GraphH1FEMModel<SeqArrayVector>::initialize_gammasolver(GeneralSolver **gammasolver);
+template<> void GraphH1FEMModel<SeqArrayVector>::initialize_thetasolver(GeneralSolver **thetasolver);
+
+template<> void GraphH1FEMModel<SeqArrayVector>::updatebeforesolve_gammasolver(GeneralSolver *gammasolver);
+template<> void GraphH1FEMModel<SeqArrayVector>::updateaftersolve_gammasolver(GeneralSolver *gammasolver);
+
+template<> void GraphH1FEMModel<SeqArrayVector>::updatebeforesolve_thetasolver(GeneralSolver *thetasolver);
+template<> void GraphH1FEMModel<SeqArrayVector>::updateaftersolve_thetasolver(GeneralSolver *thetasolver);
+
+}
+} /* end namespace */
+
+#endif
@@ -6,5 +6,11 @@
 /* the seqarrayvector variant of general.h */
 #include "external/seqarrayvector/common/common.h"
 #include "external/seqarrayvector/algebra/algebra.h"
+#include "external/seqarrayvector/data/tsdata.h"
+#include "external/seqarrayvector/data/signal1Ddata.h"
+#include "external/seqarrayvector/data/imagedata.h"
+#include "external/seqarrayvector/solver/spgqpsolver.h"
+#include "external/seqarrayvector/solver/tssolver.h"
+#include "external/seqarrayvector/model/graphh1fem.h"
 
 #endif
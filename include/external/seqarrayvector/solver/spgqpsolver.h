@@ -0,0 +1,24 @@
+#ifndef PASC_SEQARRAYVECTOR_SPGQPSOLVER_H
+#define	PASC_SEQARRAYVECTOR_SPGQPSOLVER_H
+
+#include "general/solver/spgqpsolver.h"
+
+#include "external/seqarrayvector/common/common.h"
+#include "external/seqarrayvector/algebra/matrix/blockgraphsparse.h"
+
+
+namespace pascinference {
+namespace solver {
+
+template<> std::string SPGQPSolver<SeqArrayVector>::get_name() const;
+template<> void SPGQPSolver<SeqArrayVector>::allocate_temp_vectors();
+template<> void SPGQPSolver<SeqArrayVector>::free_temp_vectors();
+template<> void SPGQPSolver<SeqArrayVector>::solve();
+template<> double SPGQPSolver<SeqArrayVector>::get_fx() const;
+template<> void SPGQPSolver<SeqArrayVector>::compute_dots(double *dd, double *dAd, double *gd) const;
+
+}
+} /* end namespace */
+
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef PASC_SEQARRAYVECTOR_TSSOLVER_H
+#define	PASC_SEQARRAYVECTOR_TSSOLVER_H
+
+#include "general/solver/tssolver.h"
+
+#include "external/seqarrayvector/common/common.h"
+#include "external/seqarrayvector/algebra/vector/generalvector.h"
+#include "external/seqarrayvector/data/tsdata.h"
+
+namespace pascinference {
+namespace solver {
+
+template<> void TSSolver<SeqArrayVector>::gammavector_permute() const;
+template<> void TSSolver<SeqArrayVector>::set_solution_theta(double *Theta);
+
+}
+} /* end namespace */
+
+
+#endif
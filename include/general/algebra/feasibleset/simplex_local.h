@@ -240,7 +240,7 @@ void SimplexFeasibleSet_Local<VectorBase>::project_sub(double *x, int t, int T,
 				}
 			}
 			
-			delete y;
+			delete[] y;
 		}
 		
 	}
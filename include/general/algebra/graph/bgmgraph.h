@@ -68,6 +68,17 @@ class BGMGraph {
 		BGMGraph(std::string filename, int dim=2);
 		BGMGraph(const double *coordinates_array, int n, int dim);
 
+		/** @brief graph of independent copies of given processed graph
+		*
+		*  Vertices of copy c are c*n,...,(c+1)*n-1, there are no edges between copies.
+		*  Used to solve batch of independent problems with the same geometry in one system.
+		*  The coordinates of copies are shifted in the first dimension to be able to see them in VTK.
+		*
+		*  @param graph processed graph
+		*  @param nmb_copies number of copies
+		*/
+		BGMGraph(const BGMGraph<VectorBase> &graph, int nmb_copies);
+
 		~BGMGraph();
 		
 		/** @brief print the name of graph
@@ -136,6 +147,14 @@ class BGMGraph {
 		*/
 		void decompose(int nmb_domains);
 
+		/** @brief compute affiliation of vertices to given number of domains using METIS without storing the decomposition
+		*
+		* @param nmb_domains number of domains
+		* @param affiliation array of size n, domain affiliation of vertices (output)
+		* @return edge cut of the partition
+		*/
+		virtual int partition(int nmb_domains, int *affiliation) const;
+
 		/** @brief print basic informations of graph
 		*/
 		void print(ConsoleOutput &output) const;
@@ -194,6 +213,12 @@ BGMGraph<VectorBase>::BGMGraph(const double *coordinates_array, int n, int dim){
 
 }
 
+template<class VectorBase>
+BGMGraph<VectorBase>::BGMGraph(const BGMGraph<VectorBase> &graph, int nmb_copies){
+	//TODO
+
+}
+
 template<class VectorBase>
 BGMGraph<VectorBase>::BGMGraph(){
 	this->n = 0;
@@ -334,36 +359,7 @@ void BGMGraph<VectorBase>::decompose(int nmb_domains){
 		DD_ranges = (int*)malloc((DD_size+1)*sizeof(int));
 
 		if(nmb_domains > 1){
-			/* ---- METIS STUFF ---- */
-			int *xadj; /* Indexes of starting points in adjacent array */
-			xadj = (int*)malloc((n+1)*sizeof(int));
-		
-			int *adjncy; /* Adjacent vertices in consecutive index order */
-			adjncy = (int*)malloc(2*m*sizeof(int));
-
-			/* fill aux metis stuff */
-			int counter = 0;
-			for(int i=0;i<n;i++){
-				xadj[i] = counter;
-				for(int j=0;j<neighbor_nmbs[i];j++){
-					adjncy[counter] = neighbor_ids[i][j];
-					counter++;
-				}
-			}	
-			xadj[n] = counter;
-
-			int objval;
-			int nWeights = 1; /* something with weights of graph, I really don't know, sorry */
-
-			/* run decomposition */
-			int metis_ret = METIS_PartGraphKway(&n,&nWeights, xadj, adjncy,
-							   NULL, NULL, NULL, &DD_size, NULL,
-							   NULL, NULL, &objval, DD_affiliation);
-
-			/* free aux stuff */
-			free(xadj);
-			free(adjncy);
-			/* --------------------- */
+			partition(DD_size, DD_affiliation);
 
 			/* compute local lengths and permutation of global indexes */
 			for(int i=0;i<DD_size;i++){ /* use DD_length as counters */
@@ -413,6 +409,54 @@ void BGMGraph<VectorBase>::decompose(int nmb_domains){
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+int BGMGraph<VectorBase>::partition(int nmb_domains, int *affiliation) const {
+	LOG_FUNC_BEGIN
+
+	int objval = 0;
+
+	if(nmb_domains > 1){
+		/* ---- METIS STUFF ---- */
+		int *xadj; /* Indexes of starting points in adjacent array */
+		xadj = (int*)malloc((n+1)*sizeof(int));
+	
+		int *adjncy; /* Adjacent vertices in consecutive index order */
+		adjncy = (int*)malloc(2*m*sizeof(int));
+
+		/* fill aux metis stuff */
+		int counter = 0;
+		for(int i=0;i<n;i++){
+			xadj[i] = counter;
+			for(int j=0;j<neighbor_nmbs[i];j++){
+				adjncy[counter] = neighbor_ids[i][j];
+				counter++;
+			}
+		}	
+		xadj[n] = counter;
+
+		int nWeights = 1; /* something with weights of graph, I really don't know, sorry */
+		int n_metis = n; /* METIS does not take const arguments */
+
+		/* run decomposition */
+		int metis_ret = METIS_PartGraphKway(&n_metis,&nWeights, xadj, adjncy,
+						   NULL, NULL, NULL, &nmb_domains, NULL,
+						   NULL, NULL, &objval, affiliation);
+
+		/* free aux stuff */
+		free(xadj);
+		free(adjncy);
+		/* --------------------- */
+	} else {
+		for(int i=0;i<n;i++){
+			affiliation[i] = 0;
+		}
+	}
+
+	LOG_FUNC_END
+
+	return objval;
+}
+
 template<class VectorBase>
 void BGMGraph<VectorBase>::process(double threshold) {
 	LOG_FUNC_BEGIN
@@ -32,8 +32,8 @@ class BGMGraphGrid1D: public BGMGraph<VectorBase> {
 		
 	public:
 		BGMGraphGrid1D(int width);
-		BGMGraphGrid1D(std::string filename, int dim=2) : BGMGraph<VectorBase>(filename, dim) {};
-		BGMGraphGrid1D(const double *coordinates_array, int n, int dim) : BGMGraph<VectorBase>(coordinates_array, n, dim) {};
+		BGMGraphGrid1D(std::string filename, int dim=2) : BGMGraph<VectorBase>(filename, dim), width(0) {};
+		BGMGraphGrid1D(const double *coordinates_array, int n, int dim) : BGMGraph<VectorBase>(coordinates_array, n, dim), width(0) {};
 
 		~BGMGraphGrid1D();
 		
@@ -41,6 +41,14 @@ class BGMGraphGrid1D: public BGMGraph<VectorBase> {
 		virtual void process_grid();
 
 		int get_width() const;
+
+		/** @brief decompose grid into intervals
+		*
+		* @param nmb_domains number of domains
+		* @param affiliation array of size n, domain affiliation of vertices (output)
+		* @return edge cut of the partition
+		*/
+		virtual int partition(int nmb_domains, int *affiliation) const;
 		
 		ExternalContent *get_externalcontent() const;
 };
@@ -120,6 +128,25 @@ int BGMGraphGrid1D<VectorBase>::get_width() const {
 	return this->width;
 }
 
+template<class VectorBase>
+int BGMGraphGrid1D<VectorBase>::partition(int nmb_domains, int *affiliation) const {
+	LOG_FUNC_BEGIN
+
+	int objval;
+	if(width == this->n && nmb_domains <= width){
+		for(int i=0;i<width;i++){
+			affiliation[i] = (i*nmb_domains)/width;
+		}
+		objval = nmb_domains-1;
+	} else {
+		objval = BGMGraph<VectorBase>::partition(nmb_domains, affiliation);
+	}
+
+	LOG_FUNC_END
+
+	return objval;
+}
+
 
 
 }
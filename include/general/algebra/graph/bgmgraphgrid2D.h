@@ -36,8 +36,8 @@ class BGMGraphGrid2D: public BGMGraph<VectorBase> {
 	public:
 	
 		BGMGraphGrid2D(int width, int height);
-		BGMGraphGrid2D(std::string filename, int dim=2) : BGMGraph<VectorBase>(filename, dim) {};
-		BGMGraphGrid2D(const double *coordinates_array, int n, int dim) : BGMGraph<VectorBase>(coordinates_array, n, dim) {};
+		BGMGraphGrid2D(std::string filename, int dim=2) : BGMGraph<VectorBase>(filename, dim), width(0), height(0) {};
+		BGMGraphGrid2D(const double *coordinates_array, int n, int dim) : BGMGraph<VectorBase>(coordinates_array, n, dim), width(0), height(0) {};
 
 		~BGMGraphGrid2D();
 		
@@ -49,6 +49,18 @@ class BGMGraphGrid2D: public BGMGraph<VectorBase> {
 
 		void decompose(BGMGraphGrid2D<VectorBase> *finer_grid, int *bounding_box1, int *bounding_box2);
 
+		/** @brief decompose grid into px x py rectangles
+		*
+		* The numbers of rectangles in each direction are chosen to minimize the edge cut.
+		* Then each domain is a rectangle and the vertices of domain are ordered by rows, therefore the regularization
+		* could be applied as a stencil. If the dimensions of grid are not known, METIS is used.
+		*
+		* @param nmb_domains number of domains
+		* @param affiliation array of size n, domain affiliation of vertices (output)
+		* @return edge cut of the partition
+		*/
+		virtual int partition(int nmb_domains, int *affiliation) const;
+
 		ExternalContent *get_externalcontent() const;
 };
 
@@ -158,6 +170,46 @@ int BGMGraphGrid2D<VectorBase>::get_height() const {
 	return this->height;
 }
 
+template<class VectorBase>
+int BGMGraphGrid2D<VectorBase>::partition(int nmb_domains, int *affiliation) const {
+	LOG_FUNC_BEGIN
+
+	/* find the best factorization nmb_domains = px*py */
+	int px_best = -1;
+	int objval = std::numeric_limits<int>::max();
+	if(width*height == this->n){
+		for(int px=1;px<=nmb_domains;px++){
+			int py = nmb_domains/px;
+			if(px*py == nmb_domains && px <= width && py <= height){
+				int edgecut = (px-1)*height + (py-1)*width;
+				if(edgecut < objval){
+					objval = edgecut;
+					px_best = px;
+				}
+			}
+		}
+	}
+
+	if(px_best < 0){
+		/* grid cannot be decomposed into rectangles */
+		objval = BGMGraph<VectorBase>::partition(nmb_domains, affiliation);
+	} else {
+		int px = px_best;
+		int py = nmb_domains/px;
+
+		for(int idx=0;idx<width*height;idx++){
+			int i = idx/width; /* index of row */
+			int j = idx - i*width; /* index of column */
+
+			affiliation[idx] = ((i*py)/height)*px + (j*px)/width;
+		}
+	}
+
+	LOG_FUNC_END
+
+	return objval;
+}
+
 template<class VectorBase>
 void BGMGraphGrid2D<VectorBase>::decompose(BGMGraphGrid2D<VectorBase> *finer_grid, int *bounding_box1, int *bounding_box2) {
 	LOG_FUNC_BEGIN
@@ -10,6 +10,16 @@
 #include "general/common/decomposition.h"
 #include "general/algebra/graph/bgmgraph.h"
 
+#include <vector>
+
+/* if the graph is a grid, then apply the regularization as a stencil instead of assembled sparse matrix */
+#define BLOCKGRAPHSPARSEMATRIX_DEFAULT_STENCIL true
+
+/* the largest eigenvalue is estimated by Lanczos method, otherwise only Gershgorin bound is used */
+#define BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_LANCZOS true
+#define BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_MAXIT 30
+#define BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_EPS 1e-6
+
 namespace pascinference {
 using namespace common;
 
@@ -18,6 +28,9 @@ namespace algebra {
 /** \class BlockGraphSparseMatrix
  *  \brief sparse graph-based matrix for FEM-H1 model regularisation
  *
+ *  The matrix is alpha*diag(coeffs_k^2)*M, where M depends only on the graph and T and it is the same for all clusters.
+ *  Therefore the largest eigenvalue of M is computed only once and the estimation for new alpha or coeffs
+ *  is obtained by scaling.
 */
 template<class VectorBase>
 class BlockGraphSparseMatrix: public GeneralMatrix<VectorBase> {
@@ -34,6 +47,23 @@ class BlockGraphSparseMatrix: public GeneralMatrix<VectorBase> {
 
 		GeneralVector<VectorBase> *coeffs; /**< vector of coefficient for each block */
 
+		bool lambda_max_lanczos;			/**< estimate the largest eigenvalue by Lanczos method */
+		int lambda_max_maxit;				/**< maximum number of Lanczos iterations */
+		double lambda_max_eps;				/**< relative precision of Lanczos estimation */
+		mutable double lambda_max_unscaled;	/**< the largest eigenvalue of M, negative if it was not computed yet */
+
+		/** @brief Gershgorin bound of the largest eigenvalue of M computed from the maximum degree of graph
+		*/
+		double get_lambda_max_gershgorin() const;
+
+		/** @brief estimate the largest eigenvalue of M, the result is stored in lambda_max_unscaled
+		*/
+		void compute_lambda_max() const;
+
+		/** @brief scaling of M, i.e. alpha*max(coeffs_k^2)
+		*/
+		double get_lambda_max_scale() const;
+
 	public:
 		BlockGraphSparseMatrix(Decomposition<VectorBase> &decomposition, double alpha=1.0, GeneralVector<VectorBase> *new_coeffs=NULL);
 		~BlockGraphSparseMatrix(); /* destructor - destroy inner matrix */
@@ -54,6 +84,38 @@ class BlockGraphSparseMatrix: public GeneralMatrix<VectorBase> {
 		double get_coeff() const;
 		void set_coeff(double coeff);
 
+		/** @brief estimation of the largest eigenvalue of matrix
+		*
+		* The estimation of M is computed during the first call, then only the scaling is applied.
+		* If the estimation is not available, then Gershgorin bound is returned.
+		*/
+		double get_lambda_max() const;
+
+		/** @brief Gershgorin bound of the largest eigenvalue of matrix, available without any computation
+		*/
+		double get_lambda_max_bound() const;
+
+		/** @brief estimation of the largest eigenvalue of M without any scaling
+		*
+		* For solvers which multiply by M and apply only alpha (coeffs of blocks are not used), i.e. the largest
+		* eigenvalue of their operator is get_coeff()*get_lambda_max_unscaled().
+		* If the estimation is not available, then Gershgorin bound is returned.
+		*/
+		double get_lambda_max_unscaled() const;
+
+		/** @brief Gershgorin bound of the largest eigenvalue of M without any scaling
+		*/
+		double get_lambda_max_bound_unscaled() const;
+
+		/** @brief actual scaling of blocks, i.e. alpha*coeffs_k^2
+		*
+		* Block k of the result of matmult is alpha*coeffs_k^2*M*x_k, therefore the result computed with
+		* one scaling can be rescaled to another one without new multiplication.
+		*
+		* @param scaling vector of K scaling coefficients
+		*/
+		void get_scaling(std::vector<double> &scaling) const;
+
 		ExternalContent *get_externalcontent() const;
 
 };
@@ -93,6 +155,13 @@ void BlockGraphSparseMatrix<VectorBase>::print(ConsoleOutput &output) const
 	output << " - K:     " << get_K() << std::endl;
 	output << " - size:  " << get_T()*get_R()*get_K() << std::endl;
 	output << " - alpha: " << alpha << std::endl;
+	output << " - lambda_max of unscaled: ";
+	if(lambda_max_unscaled >= 0.0){
+		output << lambda_max_unscaled;
+	} else {
+		output << "not computed yet";
+	}
+	output << " (Gershgorin bound " << get_lambda_max_gershgorin() << ")" << std::endl;
 
 	if(coeffs){
 		output << " - coeffs: " << *coeffs << std::endl;
@@ -126,6 +195,13 @@ void BlockGraphSparseMatrix<VectorBase>::print(ConsoleOutput &output_global, Con
 	output_global.pop();
 
 	output_global << " - alpha: " << alpha << std::endl;
+	output_global << " - lambda_max of unscaled: ";
+	if(lambda_max_unscaled >= 0.0){
+		output_global << lambda_max_unscaled;
+	} else {
+		output_global << "not computed yet";
+	}
+	output_global << " (Gershgorin bound " << get_lambda_max_gershgorin() << ")" << std::endl;
 
 	if(coeffs){
 		output_local << " - coeffs: " << *coeffs << std::endl;
@@ -187,6 +263,83 @@ void BlockGraphSparseMatrix<VectorBase>::set_coeff(double coeff) {
 	this->alpha = coeff;
 }
 
+template<class VectorBase>
+double BlockGraphSparseMatrix<VectorBase>::get_lambda_max_gershgorin() const {
+	/* the largest row sum of absolute values, the row of inner time step has 3*m+4 on diagonal and 2 + 3*m outside */
+	int m_max = decomposition->get_graph()->get_m_max();
+	int T = get_T();
+
+	double bound;
+	if(T == 1){
+		bound = 2.0*m_max;
+	} else if(T == 2){
+		bound = 4.0*m_max + 4.0;
+	} else {
+		bound = 6.0*m_max + 8.0;
+	}
+
+	return bound;
+}
+
+template<class VectorBase>
+void BlockGraphSparseMatrix<VectorBase>::compute_lambda_max() const {
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+double BlockGraphSparseMatrix<VectorBase>::get_lambda_max_scale() const {
+	//TODO: coeffs
+	return this->alpha;
+}
+
+template<class VectorBase>
+double BlockGraphSparseMatrix<VectorBase>::get_lambda_max() const {
+	return get_lambda_max_scale()*get_lambda_max_unscaled();
+}
+
+template<class VectorBase>
+double BlockGraphSparseMatrix<VectorBase>::get_lambda_max_bound() const {
+	return get_lambda_max_scale()*get_lambda_max_gershgorin();
+}
+
+template<class VectorBase>
+double BlockGraphSparseMatrix<VectorBase>::get_lambda_max_unscaled() const {
+	LOG_FUNC_BEGIN
+
+	if(this->lambda_max_lanczos && this->lambda_max_unscaled < 0.0){
+		compute_lambda_max();
+	}
+
+	double lambda_max;
+	if(this->lambda_max_unscaled > 0.0){
+		lambda_max = this->lambda_max_unscaled;
+	} else {
+		lambda_max = get_lambda_max_gershgorin();
+	}
+
+	LOG_FUNC_END
+
+	return lambda_max;
+}
+
+template<class VectorBase>
+double BlockGraphSparseMatrix<VectorBase>::get_lambda_max_bound_unscaled() const {
+	return get_lambda_max_gershgorin();
+}
+
+template<class VectorBase>
+void BlockGraphSparseMatrix<VectorBase>::get_scaling(std::vector<double> &scaling) const {
+	//TODO: coeffs, the scaling is not known
+	scaling.clear();
+	if(!coeffs){
+		scaling.assign(get_K(), this->alpha);
+	}
+}
+
 }
 } /* end of namespace */
 
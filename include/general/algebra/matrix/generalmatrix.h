@@ -88,6 +88,16 @@ class GeneralMatrix {
 			// TODO: write here something really funny
 		}
 
+		/** @brief estimation of the largest eigenvalue of matrix
+		 *
+		 *  Used by solvers to initialize the step-size.
+		 *
+		 * @return the estimation or 0 if it is not available
+		 */
+		virtual double get_lambda_max() const {
+			return 0.0;
+		}
+
 };
 
 /* print general matrix, call virtual print() */
@@ -88,6 +88,13 @@ namespace algebra {
 			*/
 			GeneralVector<VectorBase> &operator=(GeneralMatrixRHS<VectorBase> rhs);
 
+			/** @brief use assignment operators of original vector type
+			*
+			*  Without this, the assignment of linear combination (or expression) is performed
+			*  through the temporary GeneralVector created by converting constructor.
+			*/
+			using VectorBase::operator=;
+
 			/** @brief set random values
 			*
 			*/
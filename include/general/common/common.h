@@ -35,6 +35,10 @@
 #include "general/common/logging.h"
 #include "general/common/mvnrnd.h"
 #include "general/common/shortinfo.h"
+#include "general/common/lodpyramid.h"
+#ifdef USE_PETSC
+	#include "general/common/taskfarm.h"
+#endif
 #include "general/common/decomposition.h"
 
 #include "general/common/fem.h"
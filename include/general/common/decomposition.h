@@ -7,11 +7,32 @@
 #ifndef PASC_COMMON_DECOMPOSITION_H
 #define	PASC_COMMON_DECOMPOSITION_H
 
+#include <vector>
+#include <algorithm>
 #include "general/algebra/graph/bgmgraph.h"
 
+#define DECOMPOSITION_DEFAULT_AUTO_BANDWIDTH 0.0		/* [bytes/s], 0 = measure */
+#define DECOMPOSITION_DEFAULT_AUTO_LATENCY 0.0		/* [s], 0 = measure */
+#define DECOMPOSITION_DEFAULT_AUTO_FLOPRATE 1e9		/* [nonzero entries/s] in multiplication with BlockGraphSparseMatrix */
+
 namespace pascinference {
 namespace algebra {
 
+/** \struct DecompositionCost
+ *  \brief predicted cost of one multiplication with BlockGraphSparseMatrix for given DDT x DDR
+*/
+struct DecompositionCost {
+	int DDT_size;			/**< number of domains in time */
+	int DDR_size;			/**< number of domains in space */
+	int edgecut;			/**< number of graph edges between different domains */
+	double halo_max;		/**< maximum number of values received by one process */
+	int messages_max;		/**< maximum number of messages received by one process */
+	double time_compute;	/**< predicted computation time of the slowest process */
+	double time_comm;		/**< predicted communication time of the slowest process */
+	double time;			/**< predicted time of the slowest process */
+	double imbalance;		/**< maximum local number of nonzero entries divided by the average */
+};
+
 /** \class Decomposition
  *  \brief Manipulation with problem layout.
  *
@@ -67,6 +88,46 @@ class Decomposition {
 		/** @brief destructor
 		*/
 		~Decomposition();
+
+		/** @brief predict the cost of one multiplication with BlockGraphSparseMatrix for given decomposition
+		 * 
+		 * Local work is the number of nonzero entries (time stencil and graph edges), communication consists of
+		 * the halo in time (one time step of local nodes to every neighbour in time)
+		 * and the halo in space (ghost nodes of METIS partition in all local time steps).
+		 * 
+		 * @param T global length of time
+		 * @param graph graph of space decomposition (it is not modified)
+		 * @param K number of clusters
+		 * @param DDT_size number of domains in time
+		 * @param DDR_size number of domains in space
+		 * @param bandwidth bandwidth of network [bytes/s]
+		 * @param latency latency of one message [s]
+		 * @param floprate number of processed nonzero entries per second
+		 * @param cost predicted cost (output)
+		 */
+		static void estimate_cost(int T, BGMGraph<VectorBase> &graph, int K, int DDT_size, int DDR_size, double bandwidth, double latency, double floprate, DecompositionCost *cost);
+
+		/** @brief measure bandwidth and latency of the network between pairs of processes
+		 * 
+		 * @param bandwidth measured bandwidth [bytes/s] (output)
+		 * @param latency measured latency [s] (output)
+		 */
+		static void measure_network(double *bandwidth, double *latency);
+
+		/** @brief choose DDT_size x DDR_size = nproc with the smallest predicted cost
+		 * 
+		 * Bandwidth, latency and floprate are given by console arguments, the network is measured if they are not provided.
+		 * All candidates together with the predicted load imbalance are printed.
+		 * 
+		 * @param T global length of time
+		 * @param graph graph of space decomposition (it is not modified)
+		 * @param K number of clusters
+		 * @param nproc number of processes
+		 * @param DDT_size chosen number of domains in time (output)
+		 * @param DDR_size chosen number of domains in space (output)
+		 * @param output where to print the report
+		 */
+		static void compute_auto_sizes(int T, BGMGraph<VectorBase> &graph, int K, int nproc, int *DDT_size, int *DDR_size, ConsoleOutput &output);
 		
 		/** @brief get global time length
 		 * 
@@ -223,6 +284,17 @@ class Decomposition {
 		 */
 		int get_Pr(int r_global) const;
 
+		/** @brief permute array in TRblocksize layout from original numbering of nodes to numbering of decomposition
+		 * 
+		 * The variant for backends without distributed vectors, the whole arrays are stored on the process.
+		 * 
+		 * @param orig_arr values in original numbering of nodes
+		 * @param new_arr values in numbering of decomposition
+		 * @param blocksize number of values in one node (xdim or K)
+		 * @param invert if true, then new_arr is permuted back to orig_arr
+		 */
+		void permute_TRblocksize(double *orig_arr, double *new_arr, int blocksize, bool invert) const;
+
 #ifdef USE_PETSC
 		void permute_TRxdim(Vec orig_Vec, Vec new_Vec, bool invert=false) const;
 		void permute_TRK(Vec orig_Vec, Vec new_Vec, bool invert=false) const;
@@ -265,6 +337,163 @@ Decomposition<VectorBase>::~Decomposition(){
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+void Decomposition<VectorBase>::estimate_cost(int T, BGMGraph<VectorBase> &graph, int K, int DDT_size, int DDR_size, double bandwidth, double latency, double floprate, DecompositionCost *cost){
+	LOG_FUNC_STATIC_BEGIN
+
+	int R = graph.get_n();
+	const int *neighbor_nmbs = graph.get_neighbor_nmbs();
+	int **neighbor_ids = graph.get_neighbor_ids();
+
+	/* partition of graph */
+	std::vector<int> affiliation(R);
+	cost->edgecut = graph.partition(DDR_size, &affiliation[0]);
+
+	/* properties of spatial domains: nodes, nonzeros per time step, ghost nodes and neighbour domains */
+	std::vector<int> Rlengths(DDR_size, 0);
+	std::vector<double> nnz_R(DDR_size, 0.0);
+	std::vector<int> ghosts(DDR_size, 0);
+	std::vector<int> neighbor_domains(DDR_size, 0);
+	std::vector<std::pair<int,int> > ghost_pairs; /* [domain, ghost node] */
+	std::vector<std::pair<int,int> > domain_pairs; /* [domain, neighbour domain] */
+	for(int r=0; r < R; r++){
+		int d = affiliation[r];
+		Rlengths[d] += 1;
+		nnz_R[d] += 3 + neighbor_nmbs[r]; /* t-1, t, t+1 and graph neighbours */
+		for(int j=0; j < neighbor_nmbs[r]; j++){
+			int r2 = neighbor_ids[r][j];
+			if(affiliation[r2] != d){
+				ghost_pairs.push_back(std::make_pair(d, r2));
+				domain_pairs.push_back(std::make_pair(d, affiliation[r2]));
+			}
+		}
+	}
+
+	/* count every ghost node and neighbour domain only once */
+	std::sort(ghost_pairs.begin(), ghost_pairs.end());
+	std::sort(domain_pairs.begin(), domain_pairs.end());
+	for(size_t i=0; i < ghost_pairs.size(); i++){
+		if(i == 0 || ghost_pairs[i] != ghost_pairs[i-1]){
+			ghosts[ghost_pairs[i].first] += 1;
+		}
+	}
+	for(size_t i=0; i < domain_pairs.size(); i++){
+		if(i == 0 || domain_pairs[i] != domain_pairs[i-1]){
+			neighbor_domains[domain_pairs[i].first] += 1;
+		}
+	}
+
+	/* go through all processes [DDT_rank, DDR_rank], time is split in the same way as in constructor */
+	int Tlocal_min = T/DDT_size;
+	int Tlocal_residue = T - Tlocal_min*DDT_size;
+
+	double nnz_sum = 0.0;
+	double nnz_max = 0.0;
+	cost->halo_max = 0.0;
+	cost->messages_max = 0;
+	cost->time_compute = 0.0;
+	cost->time_comm = 0.0;
+	cost->time = 0.0;
+	for(int dt=0; dt < DDT_size; dt++){
+		int Tlocal = Tlocal_min + ((dt < Tlocal_residue)? 1 : 0);
+		int time_sides = ((dt > 0)? 1 : 0) + ((dt < DDT_size-1)? 1 : 0);
+		for(int dr=0; dr < DDR_size; dr++){
+			double nnz = (double)Tlocal*nnz_R[dr]*K;
+			double halo = (double)time_sides*Rlengths[dr]*K + (double)ghosts[dr]*Tlocal*K;
+			int messages = time_sides + neighbor_domains[dr];
+
+			double time_compute = nnz/floprate;
+			double time_comm = messages*latency + halo*sizeof(double)/bandwidth;
+
+			nnz_sum += nnz;
+			nnz_max = std::max(nnz_max, nnz);
+			cost->halo_max = std::max(cost->halo_max, halo);
+			cost->messages_max = std::max(cost->messages_max, messages);
+			if(time_compute + time_comm > cost->time){
+				cost->time = time_compute + time_comm;
+				cost->time_compute = time_compute;
+				cost->time_comm = time_comm;
+			}
+		}
+	}
+
+	cost->DDT_size = DDT_size;
+	cost->DDR_size = DDR_size;
+	cost->imbalance = (nnz_sum > 0.0)? nnz_max/(nnz_sum/(DDT_size*DDR_size)) : 1.0;
+
+	LOG_FUNC_STATIC_END
+}
+
+template<class VectorBase>
+void Decomposition<VectorBase>::measure_network(double *bandwidth, double *latency){
+	LOG_FUNC_STATIC_BEGIN
+
+	//TODO: write something for general case
+	*bandwidth = 1e9;
+	*latency = 1e-6;
+
+	LOG_FUNC_STATIC_END
+}
+
+template<class VectorBase>
+void Decomposition<VectorBase>::compute_auto_sizes(int T, BGMGraph<VectorBase> &graph, int K, int nproc, int *DDT_size, int *DDR_size, ConsoleOutput &output){
+	LOG_FUNC_STATIC_BEGIN
+
+	double bandwidth, latency, floprate;
+	consoleArg.set_option_value("decomposition_auto_bandwidth", &bandwidth, DECOMPOSITION_DEFAULT_AUTO_BANDWIDTH);
+	consoleArg.set_option_value("decomposition_auto_latency", &latency, DECOMPOSITION_DEFAULT_AUTO_LATENCY);
+	consoleArg.set_option_value("decomposition_auto_floprate", &floprate, DECOMPOSITION_DEFAULT_AUTO_FLOPRATE);
+
+	/* measure what was not provided */
+	if(bandwidth <= 0.0 || latency <= 0.0){
+		double bandwidth_measured, latency_measured;
+		measure_network(&bandwidth_measured, &latency_measured);
+		if(bandwidth <= 0.0) bandwidth = bandwidth_measured;
+		if(latency <= 0.0) latency = latency_measured;
+	}
+
+	output << "Automatic decomposition" << std::endl;
+	output.push();
+	output << " - bandwidth [B/s] : " << bandwidth << std::endl;
+	output << " - latency [s]     : " << latency << std::endl;
+	output << " - floprate [nnz/s]: " << floprate << std::endl;
+	output << " - candidates      : DDT x DDR, edgecut, max halo, max messages, t_compute, t_comm, t_predicted, imbalance" << std::endl;
+
+	/* go through all factorizations nproc = DDT_size*DDR_size */
+	DecompositionCost cost;
+	DecompositionCost cost_best;
+	cost_best.time = -1.0;
+	for(int DDR=1; DDR <= nproc; DDR++){
+		if(nproc % DDR != 0 || DDR > graph.get_n() || nproc/DDR > T){
+			continue;
+		}
+
+		estimate_cost(T, graph, K, nproc/DDR, DDR, bandwidth, latency, floprate, &cost);
+
+		output << "   " << cost.DDT_size << " x " << cost.DDR_size << ", " << cost.edgecut << ", " << cost.halo_max << ", " << cost.messages_max << ", ";
+		output << cost.time_compute << ", " << cost.time_comm << ", " << cost.time << ", " << cost.imbalance << std::endl;
+
+		if(cost_best.time < 0.0 || cost.time < cost_best.time){
+			cost_best = cost;
+		}
+	}
+
+	/* there is no feasible candidate, use decomposition in time */
+	if(cost_best.time < 0.0){
+		cost_best.DDT_size = nproc;
+		cost_best.DDR_size = 1;
+		cost_best.imbalance = 1.0;
+	}
+
+	*DDT_size = cost_best.DDT_size;
+	*DDR_size = cost_best.DDR_size;
+
+	output << " - chosen          : " << *DDT_size << " x " << *DDR_size << " (predicted load imbalance " << cost_best.imbalance << ")" << std::endl;
+	output.pop();
+
+	LOG_FUNC_STATIC_END
+}
+
 template<class VectorBase>
 void Decomposition<VectorBase>::compute_rank(){
 	LOG_FUNC_BEGIN
@@ -15,6 +15,20 @@
 	#include "external/petscvector/algebra/vector/petscvector.h"
 #endif
 
+#include <string>
+#include <sstream>
+#include <vector>
+#include <sched.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <stdlib.h>
+
+#ifdef _OPENMP
+	#include <omp.h>
+#endif
+
+#define GLOBAL_DEFAULT_BINDING_REPORT false
+
 
 namespace pascinference {
 namespace common {
@@ -82,6 +96,133 @@ class GlobalManagerClass {
 			this->init();
 			return this->size;
 		}
+
+		/** @brief return the binding of processes and threads to cores and NUMA nodes
+		 * 
+		 * Each OpenMP thread of each process reports the core on which it runs, the NUMA node of this core
+		 * and the list of cores it is allowed to run on (affinity mask). If the list is larger than one core
+		 * (or one NUMA node), then the thread is not pinned and the data touched by it can migrate.
+		 * Collective, the report is gathered on master, other processes obtain empty string.
+		 * 
+		 */
+		std::string get_binding_report(){
+			this->init();
+
+			char hostname[256] = "";
+			gethostname(hostname, sizeof(hostname)-1);
+
+			int nmb_threads = 1;
+			#ifdef _OPENMP
+				nmb_threads = omp_get_max_threads();
+			#endif
+			std::vector<std::string> binding_threads(nmb_threads);
+
+			#pragma omp parallel num_threads(nmb_threads)
+			{
+				int thread = 0;
+				#ifdef _OPENMP
+					thread = omp_get_thread_num();
+				#endif
+
+				int cpu = sched_getcpu();
+
+				std::ostringstream binding_thread;
+				binding_thread << "  - thread " << thread << ": core " << cpu << ", NUMA node " << get_numa_node(cpu) << ", allowed cores " << get_affinity();
+				binding_threads[thread] = binding_thread.str();
+			}
+
+			std::ostringstream binding_local;
+			binding_local << " - rank " << this->rank << " on " << hostname << ", " << nmb_threads << " threads" << std::endl;
+			for(int thread=0; thread < nmb_threads; thread++){
+				binding_local << binding_threads[thread] << std::endl;
+			}
+
+			std::string binding = binding_local.str();
+
+			#ifdef USE_PETSC
+			if(petscvector::PETSC_INITIALIZED && this->size > 1){
+				/* gather reports of all processes on master */
+				int length_local = binding.size();
+				std::vector<int> lengths(this->size);
+				std::vector<int> displs(this->size,0);
+				MPI_Gather(&length_local, 1, MPI_INT, &lengths[0], 1, MPI_INT, 0, PETSC_COMM_WORLD);
+
+				int length = 0;
+				for(int i=0; i < this->size; i++){
+					displs[i] = length;
+					length += lengths[i];
+				}
+
+				std::vector<char> binding_all(length+1,0);
+				MPI_Gatherv((void*)binding.c_str(), length_local, MPI_CHAR, &binding_all[0], &lengths[0], &displs[0], MPI_CHAR, 0, PETSC_COMM_WORLD);
+
+				binding = std::string(&binding_all[0], length);
+			}
+			#endif
+
+			return (this->rank == 0)? binding : "";
+		}
+
+	private:
+		/** @brief return NUMA node of given core, -1 if it is not known
+		 * 
+		 * Uses /sys/devices/system/cpu/cpuN/nodeM (Linux).
+		 * 
+		 */
+		static int get_numa_node(int cpu){
+			int node = -1;
+
+			std::ostringstream dirname;
+			dirname << "/sys/devices/system/cpu/cpu" << cpu;
+
+			DIR *dir = opendir(dirname.str().c_str());
+			if(dir){
+				struct dirent *entry;
+				while((entry = readdir(dir)) != NULL){
+					std::string name = entry->d_name;
+					if(name.compare(0, 4, "node") == 0 && name.size() > 4){
+						node = atoi(name.c_str()+4);
+						break;
+					}
+				}
+				closedir(dir);
+			}
+
+			return node;
+		}
+
+		/** @brief return the affinity mask of calling thread in the form "0-3,8"
+		 * 
+		 */
+		static std::string get_affinity(){
+			cpu_set_t mask;
+			CPU_ZERO(&mask);
+			if(sched_getaffinity(0, sizeof(mask), &mask) != 0){
+				return "unknown";
+			}
+
+			std::ostringstream affinity;
+			int cpu = 0;
+			while(cpu < CPU_SETSIZE){
+				if(CPU_ISSET(cpu, &mask)){
+					/* find the end of the range */
+					int cpu_end = cpu;
+					while(cpu_end+1 < CPU_SETSIZE && CPU_ISSET(cpu_end+1, &mask)){
+						cpu_end++;
+					}
+
+					if(affinity.tellp() > 0) affinity << ",";
+					affinity << cpu;
+					if(cpu_end > cpu) affinity << "-" << cpu_end;
+
+					cpu = cpu_end+1;
+				} else {
+					cpu++;
+				}
+			}
+
+			return affinity.str();
+		}
 };
 
 static GlobalManagerClass GlobalManager; /**< for manipulation with rank and size of MPI */
@@ -0,0 +1,164 @@
+/** @file lodpyramid.h
+ *  @brief Multi-resolution min/max/mean pyramid of long vectors for visualisation.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#ifndef PASC_COMMON_LODPYRAMID_H
+#define	PASC_COMMON_LODPYRAMID_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+#define LODPYRAMID_EXTENSION ".lod"		/**< the pyramid is stored alongside the vector, i.e. vector_filename.lod */
+
+namespace pascinference {
+namespace common {
+
+/** \class LODPyramid
+ *  \brief Level-of-detail pyramid of the vector stored in PETSc binary file.
+ *
+ *  The vector consists of C channels of length T, the channels are stored one after another (i.e. gamma, k*T+t)
+ *  or interleaved (i.e. data, t*C+c). Level l contains min, max and mean of 2^(l+1) consecutive values of each channel,
+ *  the coarsest level has one record per channel. The records of one level are stored channel after channel,
+ *  therefore the records which cover the time window of one channel are contiguous.
+ *
+ *  The pyramid and the original vector are mapped into memory, only the pages which cover the visible window
+ *  are read by the system. The original values are used only if there is less than two values per pixel.
+ *
+ *  The pyramid file is native-endian:
+ *  \code
+ *  char magic[8]; int64 T; int32 C; int32 interleaved; int32 nmb_levels; int32 reserved; int64 offsets[nmb_levels]; records
+ *  \endcode
+*/
+class LODPyramid {
+	public:
+		/** \struct Record
+		 *  \brief summary of values in one bin
+		 */
+		struct Record {
+			float min;			/**< minimal value in bin */
+			float max;			/**< maximal value in bin */
+			float mean;			/**< mean value in bin */
+		};
+
+	private:
+		/** \struct Header
+		 *  \brief the beginning of pyramid file
+		 */
+		struct Header {
+			char magic[8];			/**< "PASCLOD1" */
+			int64_t T;				/**< length of channel */
+			int32_t C;				/**< number of channels */
+			int32_t interleaved;	/**< the channels are interleaved in original vector */
+			int32_t nmb_levels;		/**< number of levels */
+			int32_t reserved;		/**< alignment */
+		};
+
+		Header header;					/**< header of opened pyramid */
+		const int64_t *offsets;			/**< offsets of levels in pyramid file */
+
+		void *map;						/**< mapped pyramid file */
+		size_t map_size;				/**< size of mapped pyramid file */
+
+		void *raw_map;					/**< mapped original vector, NULL if it is not available */
+		size_t raw_map_size;			/**< size of mapped original vector */
+		size_t raw_header_size;			/**< size of header of PETSc binary file */
+
+		/** @brief read the header of PETSc binary vector file
+		*
+		* The size of PetscInt (32 or 64 bit) is recognized from the size of file.
+		*
+		* @param file_size size of file in bytes
+		* @param bytes the beginning of file (at least 12 bytes)
+		* @param n number of values
+		* @param header_size size of header in bytes
+		* @return false if the file is not PETSc binary vector
+		*/
+		static bool read_vector_header(size_t file_size, const char *bytes, int64_t *n, size_t *header_size);
+
+		/** @brief convert big-endian double (PETSc binary format) to native
+		*/
+		static double from_bigendian(const char *bytes);
+
+	public:
+		/** @brief constructor of empty pyramid
+		*/
+		LODPyramid();
+
+		/** @brief destructor, unmap files
+		*/
+		~LODPyramid();
+
+		/** @brief return the name of pyramid file of given vector
+		*/
+		static std::string get_filename(const std::string &vector_filename);
+
+		/** @brief build the pyramid of vector in PETSc binary file
+		*
+		* The vector is read sequentially in chunks, therefore it does not have to fit into memory.
+		*
+		* @param vector_filename name of PETSc binary file with vector
+		* @param pyramid_filename name of output pyramid file
+		* @param C number of channels
+		* @param interleaved the channels are interleaved (t*C+c), otherwise they are stored one after another (c*T+t)
+		* @return false if the pyramid cannot be created
+		*/
+		static bool build(const std::string &vector_filename, const std::string &pyramid_filename, int C, bool interleaved);
+
+		/** @brief map the pyramid and the original vector into memory
+		*
+		* @param pyramid_filename name of pyramid file
+		* @param vector_filename name of original vector, if it cannot be mapped, then only the pyramid is available
+		* @return false if the pyramid cannot be opened
+		*/
+		bool open(const std::string &pyramid_filename, const std::string &vector_filename);
+
+		/** @brief unmap files
+		*/
+		void close();
+
+		bool is_open() const;
+		bool is_raw_available() const;
+		int64_t get_T() const;
+		int get_C() const;
+		bool get_interleaved() const;
+		int get_nmb_levels() const;
+
+		/** @brief number of original values in one record of level, level -1 denotes original values
+		*/
+		int64_t get_decimation(int level) const;
+
+		/** @brief number of records of one channel in level
+		*/
+		int64_t get_size(int level) const;
+
+		/** @brief the coarsest level with at most given number of values in one record
+		*
+		* @param values_per_record number of original values which are drawn into one pixel
+		* @return level, -1 if the original values should be used
+		*/
+		int get_level(double values_per_record) const;
+
+		/** @brief get records of channel in given range
+		*
+		* @param level level, -1 for original values (min = max = mean)
+		* @param c channel
+		* @param begin the first record
+		* @param end the record after the last one, the range is cut to the size of level
+		* @param records output records
+		*/
+		void get_records(int level, int c, int64_t begin, int64_t end, std::vector<Record> &records) const;
+
+		/** @brief min, max and mean of whole channel
+		*/
+		Record get_summary(int c) const;
+
+};
+
+}
+} /* end of namespace */
+
+#endif
@@ -2,6 +2,8 @@
 #define	PASC_COMMON_MEMORYCHECK_H
 
 #include <sys/sysinfo.h>
+#include <string>
+#include <ostream>
 
 namespace pascinference {
 namespace common {
@@ -35,6 +37,77 @@ class MemoryCheck {
 		 * 
 		 */ 
 		static long long get_physical();
+
+		/** @brief get the value from /proc/self/status in bytes
+		 * 
+		 * @param key name of the field, for example "VmRSS" or "VmHWM"
+		 * @return value in bytes, -1 if the value is not available
+		 */ 
+		static long long get_process_status(const std::string &key);
+
+		/** @brief get the resident set size of this process in bytes (VmRSS)
+		 * 
+		 */ 
+		static long long get_process_rss();
+
+		/** @brief get the peak resident set size of this process in bytes (VmHWM)
+		 * 
+		 */ 
+		static long long get_process_hwm();
+
+		/** @brief reset the peak resident set size of this process
+		 * 
+		 * Write "5" to /proc/self/clear_refs (Linux >= 4.0), VmHWM is then equal to actual VmRSS.
+		 * @return false if the reset is not permitted
+		 */ 
+		static bool reset_process_hwm();
+
+		/** @brief begin the measurement of the peak memory of the phase
+		 * 
+		 * The peak of already opened phases is updated, then VmHWM is reset.
+		 * Phases could be nested.
+		 * If the reset is not permitted, then the peak of the phase is unknown and -1 is stored (also in all following updates).
+		 * 
+		 * @param peak where to store the peak of the phase (the maximum with previous value is stored)
+		 * @return false if VmHWM could not be reset
+		 */ 
+		static bool phase_begin(long long *peak);
+
+		/** @brief end the measurement of the peak memory of the phase
+		 * 
+		 * @param peak the same pointer as in phase_begin
+		 */ 
+		static void phase_end(long long *peak);
+
+		/** @brief register memory allocated by given owner
+		 * 
+		 * @param owner name of the owner (for example "TSData" or "SPGQPSolver")
+		 * @param bytes number of allocated bytes
+		 */ 
+		static void owned_add(const std::string &owner, long long bytes);
+
+		/** @brief unregister memory deallocated by given owner
+		 * 
+		 * @param owner name of the owner
+		 * @param bytes number of deallocated bytes
+		 */ 
+		static void owned_remove(const std::string &owner, long long bytes);
+
+		/** @brief get actual memory registered by owner in bytes
+		 * 
+		 */ 
+		static long long get_owned(const std::string &owner);
+
+		/** @brief get peak of memory registered by owner in bytes
+		 * 
+		 */ 
+		static long long get_owned_peak(const std::string &owner);
+
+		/** @brief print actual and peak memory of all owners
+		 * 
+		 * @param output where to print
+		 */ 
+		static void print_owned(std::ostream &output);
 	
 };
 
@@ -0,0 +1,155 @@
+/** @file taskfarm.h
+ *  @brief Dynamic scheduling of independent problems on groups of processes inside one MPI job.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#ifndef PASC_COMMON_TASKFARM_H
+#define	PASC_COMMON_TASKFARM_H
+
+#include <string>
+#include <vector>
+#include "mpi.h"
+
+#include "general/common/consoleoutput.h"
+
+#define TASKFARM_DEFAULT_POLL 1000
+#define TASKFARM_DEFAULT_HOSTS true
+#define TASKFARM_DEFAULT_TIMEOUT 0.0
+
+namespace pascinference {
+namespace common {
+
+/** \class TaskFarm
+ *  \brief Run the list of independent problems inside one MPI job.
+ *
+ *  The list of problems (manifest) is a text file, each line describes one task
+ *  \code
+ *  nprocs shortinfo_filename executable [arguments]
+ *  \endcode
+ *  Empty lines and lines starting with # are ignored, shortinfo_filename "-" means that the task does not produce shortinfo.
+ *
+ *  Rank 0 is the scheduler, other ranks are workers. When the task is dispatched, the scheduler chooses nprocs idle workers,
+ *  they create a group communicator and start the task using MPI_Comm_spawn on the hosts of the group. The spawned processes
+ *  have their own MPI_COMM_WORLD, therefore the library runs unchanged. The workers only hold the slots (they sleep) until the task ends.
+ *  The end of task is reported in Finalize, therefore the task has to be the application of this library which calls Finalize.
+ *  If the task crashes, then the end is never reported. The leader of group detects the error on the connection to the task
+ *  (if MPI implementation reports it) or the exceeded timeout and the task is reported as failed.
+ *
+ *  The queue is ordered from the largest task. If the largest task does not fit into idle workers, then smaller tasks
+ *  from the queue are dispatched instead, therefore idle workers do not wait for the large ones.
+ *
+ *  Launch mode: the sleeping workers keep their slots, therefore the spawned tasks need additional slots
+ *  (up to the number of workers). The farm has to be started with spare slots (MPI_UNIVERSE_SIZE at least 2*nprocs-1,
+ *  e.g. "mpiexec -n N -usize 2N" or the batch allocation larger than the number of started processes)
+ *  or with oversubscription allowed (e.g. "mpirun --oversubscribe"). Otherwise MPI_Comm_spawn fails and the tasks are reported
+ *  as not started. The universe size is checked in the constructor and reported by print.
+ *
+ *  Failed task: MPI does not provide the way how to kill the spawned processes without aborting the farm, therefore the task
+ *  which exceeded timeout (or lost the connection) is only abandoned, its processes still run and stay connected to the group.
+ *  The workers of such group are retired, they are not reused for other tasks (their slots are still occupied by the abandoned task)
+ *  and the tasks which do not fit into remaining workers are skipped. MPI_Finalize is collective over all connected processes,
+ *  therefore the farm returns from MPI_Finalize only after all abandoned tasks end - a hanging task has to be killed
+ *  by the resource manager (job time limit, scancel, ...).
+*/
+class TaskFarm {
+	public:
+		/** \struct Task
+		 *  \brief One problem from manifest.
+		 */
+		struct Task {
+			int id;								/**< index of task in manifest */
+			int nprocs;							/**< number of processes */
+			std::string shortinfo;				/**< shortinfo file produced by task, empty if there is no such file */
+			std::vector<std::string> command;	/**< executable and arguments */
+			double time;						/**< wall time of the task */
+			int status;							/**< 0 if the task was finished, -1 if it was not started, -2 if it failed or exceeded timeout */
+		};
+
+	private:
+		std::vector<Task> tasks;		/**< list of tasks, known only on scheduler */
+		int poll_time;					/**< sleep between tests of pending messages [us] */
+		bool hosts;						/**< spawn the task on the hosts of group */
+		double timeout;					/**< maximum wall time of one task [s], 0 means no limit */
+		int universe_size;				/**< value of MPI_UNIVERSE_SIZE, -1 if it is not provided by MPI implementation */
+
+		/** @brief dispatch tasks to idle workers until all of them are finished
+		*/
+		void run_scheduler();
+
+		/** @brief receive tasks from scheduler and run them until stop message
+		*
+		* If the task failed, then the worker reports itself as retired and stops receiving tasks.
+		*/
+		void run_worker();
+
+		/** @brief spawn given command on processes of group and wait until it ends
+		*
+		* @param command executable and arguments, significant only on rank 0 of group
+		* @param nprocs number of processes of the task
+		* @param group_comm communicator of group
+		* @return 0 if the task was finished, -1 if it was not possible to start it, -2 if it failed or exceeded timeout (the task is abandoned)
+		*/
+		int execute(const std::vector<std::string> &command, int nprocs, MPI_Comm group_comm) const;
+
+		/** @brief wait for the message without busy-waiting
+		*/
+		void wait_message(int source, int tag, MPI_Comm comm, MPI_Status *status) const;
+
+		/** @brief wait for the message without busy-waiting, at most given time
+		*
+		* @param timeout maximum waiting time [s], 0 means no limit
+		* @return 0 if the message arrived, 1 if the timeout was exceeded, 2 if the communication failed
+		*/
+		int wait_message(int source, int tag, MPI_Comm comm, MPI_Status *status, double timeout) const;
+
+		/** @brief wait for the request without busy-waiting
+		*/
+		void wait_request(MPI_Request *request) const;
+
+	public:
+		/** @brief constructor from manifest
+		*
+		* The manifest is read by the scheduler (rank 0), the universe size is checked and the warning is printed if there are no spare slots for spawned tasks.
+		*
+		* @param manifest_filename name of file with the list of tasks
+		* @param poll_time sleep between tests of pending messages [us]
+		* @param hosts spawn the task on the hosts of group
+		* @param timeout maximum wall time of one task [s], 0 means no limit
+		*/
+		TaskFarm(std::string manifest_filename, int poll_time = TASKFARM_DEFAULT_POLL, bool hosts = TASKFARM_DEFAULT_HOSTS, double timeout = TASKFARM_DEFAULT_TIMEOUT);
+
+		/** @brief run all tasks, collective on MPI_COMM_WORLD
+		*/
+		void run();
+
+		/** @brief write the combined shortinfo table of all tasks
+		*
+		* Each row starts with the index of task, number of processes, wall time and status, then the values
+		* from shortinfo file of the task follow.
+		*
+		* @param filename name of output file
+		*/
+		void write_shortinfo(std::string filename) const;
+
+		/** @brief print the list of tasks
+		*/
+		void print(ConsoleOutput &output) const;
+
+		/** @brief return number of tasks in manifest
+		*/
+		int get_nmb_tasks() const;
+
+		/** @brief report the end of task to the task farm
+		*
+		* Called in Finalize, if the process was not started by TaskFarm, then nothing happens.
+		*/
+		static void finalize_child();
+
+};
+
+
+}
+} /* end of namespace */
+
+#endif
@@ -11,6 +11,14 @@
 
 #include <stack>
 #include <limits>
+#include <string>
+
+/** number of hardware counters measured by Timer (cycles, instructions, LLC misses) */
+#define TIMER_COUNTERS_NMB 3
+
+#define TIMER_DEFAULT_COUNTERS false /**< measure hardware counters using perf_event_open */
+#define TIMER_CACHELINE_SIZE 64 /**< bytes transferred from memory per one LLC miss, used to estimate the traffic */
+#define TIMER_DEFAULT_MEMORY false /**< measure peak memory (VmHWM) of timers with turned on memory tracking */
 
 //TODO: !!!
 #include "external/petscvector/algebra/vector/generalvector.h"
@@ -83,7 +91,49 @@ class Timer {
 		double getUnixTime(void);
 
 		bool run_or_not; /**< is the timer running? */
+
+		static int counters_enabled; /**< hardware counters are turned on (option timer_counters), -1 if not read yet */
+
+		static int counters_fd[TIMER_COUNTERS_NMB]; /**< file descriptors of the group of perf events shared by all timers, -1 if the event is not available */
+		static int counters_position[TIMER_COUNTERS_NMB]; /**< position of the event in the values read from the group, -1 if the event is not available */
+		static bool counters_opened; /**< the group was already opened (successfully or not) */
+
+		long long counters_start[TIMER_COUNTERS_NMB]; /**< values of counters in start() */
+		long long counters_sum[TIMER_COUNTERS_NMB]; /**< sum of counted events between all start() and stop() */
+
+		static int memory_enabled; /**< peak memory is measured (option timer_memory), -1 if not read yet */
+		bool memory_tracking; /**< this timer measures the peak memory between start() and stop() */
+		long long memory_peak; /**< peak resident memory of process between all start() and stop() in bytes */
+
+		/** @brief open one group of perf events shared by all timers
+		* 
+		*  Called during the first start() of any timer if the counters are turned on.
+		*  The events count only the calling thread (the master thread), the work of other OpenMP threads is not included.
+		*  If the events are not permitted (see /proc/sys/kernel/perf_event_paranoid), then
+		*  the descriptors stay -1 and only the time is measured.
+		*  The group stays opened until the end of the process.
+		*
+		*/
+		static void counters_open();
+
+		/** @brief read actual values of counters
+		* 
+		*  The whole group is read at once, the values are scaled by time_enabled/time_running if the
+		*  group was multiplexed with other events.
+		*/
+		static void counters_read(long long *values);
+
 	public:
+		enum CounterType {
+			COUNTER_CYCLES = 0,			/**< CPU cycles */
+			COUNTER_INSTRUCTIONS = 1,	/**< retired instructions */
+			COUNTER_LLC_MISSES = 2		/**< last level cache misses */
+		};
+
+		Timer();
+		Timer(const Timer &timer);
+		Timer &operator=(const Timer &timer);
+		~Timer();
 
 		/** @brief restart the timer
 		* 
@@ -130,6 +180,64 @@ class Timer {
 		*
 		*/
 		bool status() const;
+
+		/** @brief are hardware counters measured?
+		* 
+		*  Return true if the counters are turned on and at least the group leader (cycles) could be opened.
+		*
+		*/
+		bool counters_available() const;
+
+		/** @brief sum of counted events
+		* 
+		*  Return the sum of events between all start() and stop() calls, -1 if the counter is not available.
+		* 
+		*  @param type type of counter
+		*/
+		long long get_counter_sum(CounterType type) const;
+
+		/** @brief instructions per cycle
+		* 
+		*  Return -1 if counters are not available.
+		*/
+		double get_ipc() const;
+
+		/** @brief estimated memory traffic per instruction
+		* 
+		*  The traffic is estimated as number of LLC misses times TIMER_CACHELINE_SIZE.
+		*  Return -1 if counters are not available.
+		*/
+		double get_bytes_per_instruction() const;
+
+		/** @brief get info about counters to be printed after time
+		* 
+		*  Return empty string if counters are not available.
+		*/
+		std::string get_counters_info() const;
+
+		/** @brief hardware counters are turned on
+		* 
+		*  Read the option timer_counters.
+		*/
+		static bool get_counters_enabled();
+
+		/** @brief measure the peak memory of this timer
+		* 
+		*  The peak is measured only if the option timer_memory is turned on, see MemoryCheck::phase_begin().
+		*/
+		void set_memory_tracking(bool memory_tracking);
+
+		/** @brief peak resident memory of process during all start() and stop() in bytes
+		* 
+		*  Return -1 if the memory is not measured or VmHWM could not be reset at the beginning of some phase.
+		*/
+		long long get_memory_peak() const;
+
+		/** @brief peak memory measurement is turned on
+		* 
+		*  Read the option timer_memory.
+		*/
+		static bool get_memory_enabled();
 };
 
 }
@@ -59,6 +59,10 @@ class EdfData: public TSData<VectorBase> {
 		virtual void printcontent(ConsoleOutput &output_global, ConsoleOutput &output_local) const;
 		virtual std::string get_name() const;
 
+		/** @brief save results for ParaView into results/filename.xmf and results/filename.bin
+		 *
+		 * @param filename the name of output files without extension
+		 */
 		void saveVTK(std::string filename) const;
 		void saveVector(std::string filename, bool save_original) const;
 
@@ -10,6 +10,9 @@
 #include "general/common/common.h"
 #include "general/algebra/feasibleset/generalfeasibleset.h"
 
+#include <vector>
+#include <stdint.h>
+
 namespace pascinference {
 namespace data {
 
@@ -30,6 +33,10 @@ class QPData: public GeneralData {
 		GeneralVector<VectorBase> *x_sol; /**< solution vector - for tracking the descend of absolute error */
 		GeneralFeasibleSet<VectorBase> *feasibleset; /**< feasible set */
 
+		GeneralVector<VectorBase> *gradient; /**< gradient A*x-b in the last solution published by QP solver, NULL if it is not available */
+		std::vector<double> gradient_scaling; /**< scaling of blocks of A at the time of computation of gradient */
+		int64_t gradient_state; /**< state of x at the time of computation of gradient */
+
 	public:
 	
 		/** @brief default constructor
@@ -111,6 +118,30 @@ class QPData: public GeneralData {
 		 */ 
 		GeneralFeasibleSet<VectorBase> *get_feasibleset() const;
 
+		/** @brief publish the gradient A*x-b in the last solution
+		 * 
+		 * The result of the operator can be reused outside the QP solver, i.e. A*x = g + b.
+		 * The scaling of blocks of A and the state of x at the time of computation are stored to recognize
+		 * whether the gradient still corresponds to actual x and how to rescale it for different coefficients of A.
+		 * 
+		 * @param gradient the gradient, the owner is the solver, NULL if it is not available
+		 * @param scaling scaling of blocks of A
+		 * @param state state of x (defined by implementation of vector)
+		 */ 
+		void set_gradient(GeneralVector<VectorBase> *gradient, const std::vector<double> &scaling, int64_t state);
+
+		/** @brief get the gradient published by QP solver, NULL if it is not available
+		 */ 
+		GeneralVector<VectorBase> *get_gradient() const;
+
+		/** @brief get the scaling of blocks of A at the time of computation of gradient
+		 */ 
+		const std::vector<double> &get_gradient_scaling() const;
+
+		/** @brief get the state of x at the time of computation of gradient
+		 */ 
+		int64_t get_gradient_state() const;
+
 
 };
 
@@ -138,6 +169,9 @@ QPData<VectorBase>::QPData(){
 	this->x = NULL;
 	this->feasibleset = NULL;
 
+	this->gradient = NULL;
+	this->gradient_state = 0;
+
 	LOG_FUNC_END
 }
 
@@ -416,6 +450,28 @@ GeneralFeasibleSet<VectorBase> *QPData<VectorBase>::get_feasibleset() const{
 	return this->feasibleset;
 }
 
+template<class VectorBase>
+void QPData<VectorBase>::set_gradient(GeneralVector<VectorBase> *gradient, const std::vector<double> &scaling, int64_t state){
+	this->gradient = gradient;
+	this->gradient_scaling = scaling;
+	this->gradient_state = state;
+}
+
+template<class VectorBase>
+GeneralVector<VectorBase> *QPData<VectorBase>::get_gradient() const{
+	return this->gradient;
+}
+
+template<class VectorBase>
+const std::vector<double> &QPData<VectorBase>::get_gradient_scaling() const{
+	return this->gradient_scaling;
+}
+
+template<class VectorBase>
+int64_t QPData<VectorBase>::get_gradient_state() const{
+	return this->gradient_state;
+}
+
 
 }
 } /* end namespace */
@@ -0,0 +1,415 @@
+/** @file resultfile.h
+ *  @brief one indexed binary file with results for all epssqr
+ *
+ *  Instead of writing separate *.bin PETSc files for every epssqr, all results
+ *  (data, gamma, theta and recovered signal) of one run are stored in one file.
+ *  Fields are stored in the original (non-decomposed) layout and split into chunks
+ *  of rows (one row = one node in one time step), every chunk is compressed
+ *  independently and the file can be read by (record, component, time window).
+ *
+ *  Layout of the file:
+ *   - ResultFileHeader with the position of the actual table of records
+ *   - for every record: for every field: chunks, then the index of chunks (ResultFileChunk),
+ *     then the table of all records written so far (ResultFileRecord)
+ *
+ *  Nothing which was already written is overwritten, new record is appended behind the previous table.
+ *  The pointer to the table in the header is updated only after the record and its table are written
+ *  on all processes, therefore the file could be read at any time and it contains all finished records
+ *  (older tables stay in the file unused).
+ *
+ *  Records are written by nonblocking MPI-IO; the solver continues while at most
+ *  resultfile_max_inflight records are being written in background. Only the I/O runs in background,
+ *  the permutation to original layout and the compression are done in write() by the solver.
+ *
+ *  @author Lukas Pospisil
+ */
+
+#ifndef PASC_RESULTFILE_H
+#define	PASC_RESULTFILE_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+
+#include "general/common/common.h"
+#include "general/data/tsdata.h"
+
+#define RESULTFILE_DEFAULT_CHUNK_ROWS 4096
+#define RESULTFILE_DEFAULT_GAMMA_TOL 0.0
+#define RESULTFILE_DEFAULT_SAVE_DATA true
+#define RESULTFILE_DEFAULT_MAX_INFLIGHT 2
+#define RESULTFILE_MAX_WRITE_BYTES 1073741824 /**< maximum size of one MPI write, larger buffers are split (count in MPI is int) */
+
+#define RESULTFILE_MAGIC "PASCRES1"
+#define RESULTFILE_VERSION 2
+
+/* stored fields */
+#define RESULTFILE_FIELD_DATA 0
+#define RESULTFILE_FIELD_GAMMA 1
+#define RESULTFILE_FIELD_THETA 2
+#define RESULTFILE_FIELD_RECOVERED 3
+#define RESULTFILE_NFIELDS 4
+
+/* encoding of chunks */
+#define RESULTFILE_ENCODING_RAW 0 	/* dense rows of doubles */
+#define RESULTFILE_ENCODING_LABEL 1	/* one label per row, rows which are not one-hot are stored dense after labels */
+
+namespace pascinference {
+namespace data {
+
+/** @brief the header at the begining of the file
+ */
+struct ResultFileHeader {
+	char magic[8];			/**< RESULTFILE_MAGIC */
+	int32_t version;		/**< RESULTFILE_VERSION */
+	int32_t T;				/**< global length of time */
+	int32_t R;				/**< number of nodes */
+	int32_t K;				/**< number of clusters */
+	int32_t xdim;			/**< data dimension */
+	int32_t chunk_rows;		/**< maximum number of rows in one chunk */
+	int64_t table_offset;	/**< position of the array of ResultFileRecord, updated after the records are written */
+	int64_t nrecords;		/**< number of finished records */
+};
+
+/** @brief description of one stored field in one record
+ */
+struct ResultFileField {
+	int32_t type;			/**< RESULTFILE_FIELD_* */
+	int32_t blocksize;		/**< number of values in one row (xdim or K) */
+	int64_t nrows;			/**< global number of rows */
+	int64_t nchunks;		/**< number of chunks, 0 if field is not stored */
+	int64_t index_offset;	/**< position of the array of ResultFileChunk */
+};
+
+/** @brief one record - one solution (for one epssqr)
+ */
+struct ResultFileRecord {
+	double epssqr;			/**< penalty parameter of the solution */
+	int32_t id;				/**< user identification of the record (i.e. annealing step) */
+	int32_t nfields;		/**< RESULTFILE_NFIELDS */
+	ResultFileField fields[RESULTFILE_NFIELDS];
+};
+
+/** @brief description of one chunk
+ */
+struct ResultFileChunk {
+	int64_t row_begin;		/**< first row in chunk */
+	int64_t offset;			/**< position of the chunk in the file */
+	int64_t nbytes;			/**< size of the (compressed) chunk */
+	int32_t nrows;			/**< number of rows in chunk */
+	int32_t encoding;		/**< RESULTFILE_ENCODING_* */
+};
+
+/** \class ResultFileCodec
+ *  \brief compression of chunks
+ *
+ *  Gamma is almost one-hot, therefore the row is stored as the index of the maximal value.
+ *  Rows which are not one-hot (with given tolerance) are stored as dense rows after the labels.
+*/
+class ResultFileCodec {
+	public:
+		/** @brief compress the chunk of gamma
+		 *
+		 * @param values dense rows (nrows*K)
+		 * @param nrows number of rows
+		 * @param K number of values in one row
+		 * @param tol tolerance of one-hot test, 0.0 means lossless compression
+		 * @param buffer output bytes (appended)
+		 * @return used encoding RESULTFILE_ENCODING_*
+		 */
+		static int encode_gamma(const double *values, int nrows, int K, double tol, std::vector<char> &buffer);
+
+		/** @brief store the chunk without compression
+		 *
+		 * @return RESULTFILE_ENCODING_RAW
+		 */
+		static int encode_raw(const double *values, int nrows, int blocksize, std::vector<char> &buffer);
+
+		/** @brief decompress the chunk into dense rows
+		 *
+		 * @param encoding used encoding RESULTFILE_ENCODING_*
+		 * @param buffer stored bytes
+		 * @param nbytes size of buffer
+		 * @param nrows number of rows in chunk
+		 * @param blocksize number of values in one row
+		 * @param values output dense rows (nrows*blocksize)
+		 */
+		static void decode(int encoding, const char *buffer, int64_t nbytes, int nrows, int blocksize, double *values);
+
+		/** @brief the size of one label in bytes
+		 */
+		static int get_labelsize(int K);
+};
+
+/** \class ResultFileReader
+ *  \brief sequential random access to result file for post-processing
+ *
+*/
+class ResultFileReader {
+	private:
+		std::string filename;
+		std::ifstream file;
+		ResultFileHeader header;
+		std::vector<ResultFileRecord> records;
+
+		void read_chunks(int record, int field, std::vector<ResultFileChunk> &chunks);
+
+	public:
+		/** @brief open the file and read the table of records
+		 */
+		ResultFileReader(std::string filename);
+		~ResultFileReader();
+
+		void print(ConsoleOutput &output) const;
+
+		int get_T() const;
+		int get_R() const;
+		int get_K() const;
+		int get_xdim() const;
+
+		int get_nrecords() const;
+		double get_epssqr(int record) const;
+		int get_id(int record) const;
+
+		/** @brief find the record with given epssqr
+		 *
+		 * @return index of record or -1 if there is no such record
+		 */
+		int find_record(double epssqr) const;
+
+		/** @brief read one component of the field in time window
+		 *
+		 * @param record index of record
+		 * @param field RESULTFILE_FIELD_DATA, RESULTFILE_FIELD_GAMMA or RESULTFILE_FIELD_RECOVERED
+		 * @param component k for gamma, index of dimension for data
+		 * @param tbegin first time step
+		 * @param tend last time step plus one
+		 * @param values output array of size (tend-tbegin)*R, values are in order t*R+r
+		 * @return false if field is not stored in the record
+		 */
+		bool read(int record, int field, int component, int tbegin, int tend, double *values);
+
+		/** @brief read theta of the record
+		 *
+		 * @param values output array of size K*xdim
+		 * @return false if theta is not stored in the record
+		 */
+		bool read_theta(int record, double *values);
+};
+
+/** \class ResultFile
+ *  \brief writer of the results of time-series problem for all epssqr into one file
+ *
+ *  All processes write their chunks together using collective parallel I/O.
+*/
+template<class VectorBase>
+class ResultFile {
+	public:
+		class ExternalContent;
+
+	protected:
+		friend class ExternalContent;
+		ExternalContent *externalcontent;			/**< for manipulation with external-specific stuff */
+
+		std::string filename;
+		TSData<VectorBase> *tsdata;				/**< data with solution */
+
+		int chunk_rows;							/**< maximum number of rows in one chunk */
+		double gamma_tol;						/**< tolerance of one-hot compression of gamma */
+		bool save_data;							/**< store also the original data */
+		bool data_saved;						/**< data were already stored in some record */
+		int max_inflight;						/**< maximum number of records which are still being written in background, 0 = blocking write */
+
+		std::vector<ResultFileRecord> records;	/**< table of records (same on all processes) */
+		int64_t end_offset;						/**< where the next record starts (behind the last table of records) */
+
+		int64_t bytes_written;					/**< number of written bytes */
+		int64_t bytes_dense;					/**< number of bytes without compression */
+		Timer timer_write;						/**< total time of writing */
+		Timer timer_wait;						/**< time spent by waiting for unfinished writes */
+
+		/** @brief set settings from arguments in console
+		*
+		*/
+		void set_settings_from_console();
+
+		/** @brief compress local rows of one field and write them together with the index of chunks
+		*
+		* @param type RESULTFILE_FIELD_*
+		* @param values local rows in original layout
+		* @param row_begin global index of the first local row
+		* @param nrows_local number of local rows
+		* @param blocksize number of values in one row
+		* @param nrows_global global number of rows
+		* @param fieldinfo description of the field in the record (output)
+		*/
+		void write_field(int type, const double *values, int64_t row_begin, int nrows_local, int blocksize, int64_t nrows_global, ResultFileField *fieldinfo);
+
+	public:
+
+		/** @brief create new result file
+		 *
+		 * @param tsdata data with the solution
+		 * @param filename the name of result file
+		 */
+		ResultFile(TSData<VectorBase> &tsdata, std::string filename);
+		~ResultFile();
+
+		/** @brief append actual solution stored in tsdata to the file
+		 *
+		 * @param epssqr penalty parameter of the solution
+		 * @param id additional identification of the record
+		 */
+		void write(double epssqr, int id=0);
+
+		/** @brief wait until all records are written into the file
+		 *
+		 * Collective, the pointer to the table of records in header is updated.
+		 */
+		void flush();
+
+		void print(ConsoleOutput &output) const;
+		void printtimer(ConsoleOutput &output) const;
+		std::string get_name() const;
+
+		int get_nrecords() const;
+		double get_compression_ratio() const;
+
+		ExternalContent *get_externalcontent() const;
+};
+
+}
+} /* end of namespace */
+
+
+/* ------------- implementation ----------- */
+//TODO: move to impls
+
+namespace pascinference {
+namespace data {
+
+template<class VectorBase>
+void ResultFile<VectorBase>::set_settings_from_console() {
+	consoleArg.set_option_value("resultfile_chunk_rows", &this->chunk_rows, RESULTFILE_DEFAULT_CHUNK_ROWS);
+	consoleArg.set_option_value("resultfile_gamma_tol", &this->gamma_tol, RESULTFILE_DEFAULT_GAMMA_TOL);
+	consoleArg.set_option_value("resultfile_save_data", &this->save_data, RESULTFILE_DEFAULT_SAVE_DATA);
+	consoleArg.set_option_value("resultfile_max_inflight", &this->max_inflight, RESULTFILE_DEFAULT_MAX_INFLIGHT);
+}
+
+template<class VectorBase>
+ResultFile<VectorBase>::ResultFile(TSData<VectorBase> &tsdata, std::string filename){
+	LOG_FUNC_BEGIN
+
+	this->tsdata = &tsdata;
+	this->filename = filename;
+
+	set_settings_from_console();
+
+	this->data_saved = false;
+	this->end_offset = sizeof(ResultFileHeader);
+	this->bytes_written = 0;
+	this->bytes_dense = 0;
+	this->timer_write.restart();
+	this->timer_wait.restart();
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+ResultFile<VectorBase>::~ResultFile(){
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void ResultFile<VectorBase>::write(double epssqr, int id){
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void ResultFile<VectorBase>::flush(){
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void ResultFile<VectorBase>::write_field(int type, const double *values, int64_t row_begin, int nrows_local, int blocksize, int64_t nrows_global, ResultFileField *fieldinfo){
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+std::string ResultFile<VectorBase>::get_name() const {
+	return "ResultFile";
+}
+
+template<class VectorBase>
+void ResultFile<VectorBase>::print(ConsoleOutput &output) const {
+	LOG_FUNC_BEGIN
+
+	output << this->get_name() << std::endl;
+	output << " - filename:          " << this->filename << std::endl;
+	output << " - chunk_rows:        " << this->chunk_rows << std::endl;
+	output << " - gamma_tol:         " << this->gamma_tol << std::endl;
+	output << " - save_data:         " << print_bool(this->save_data) << std::endl;
+	output << " - max_inflight:      " << this->max_inflight << std::endl;
+	output << " - nrecords:          " << get_nrecords() << std::endl;
+	output << " - compression ratio: " << get_compression_ratio() << std::endl;
+
+	output.synchronize();
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void ResultFile<VectorBase>::printtimer(ConsoleOutput &output) const {
+	LOG_FUNC_BEGIN
+
+	output <<  this->get_name() << std::endl;
+	output <<  " - written bytes:     " << this->bytes_written << std::endl;
+	output <<  " - dense bytes:       " << this->bytes_dense << std::endl;
+	output <<  " - timers" << std::endl;
+	output <<  "  - t_write =         " << this->timer_write.get_value_sum() << std::endl;
+	output <<  "  - t_wait =          " << this->timer_wait.get_value_sum() << std::endl;
+
+	output.synchronize();
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+int ResultFile<VectorBase>::get_nrecords() const {
+	return this->records.size();
+}
+
+template<class VectorBase>
+double ResultFile<VectorBase>::get_compression_ratio() const {
+	if(this->bytes_written > 0){
+		return this->bytes_dense/(double)this->bytes_written;
+	} else {
+		return 1.0;
+	}
+}
+
+
+}
+} /* end namespace */
+
+#endif
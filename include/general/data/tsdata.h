@@ -8,9 +8,14 @@
 #define	PASC_TSDATA_H
 
 #include <iostream>
+#include <string.h>
 #include "general/data/generaldata.h"
 #include "general/common/common.h"
 
+#define TSDATA_DEFAULT_SAVE_LABELS false
+#define TSDATA_LABELS_MAGIC "PASCLBL1"
+#define TSDATA_LABELS_EXTENSION ".lbl"
+
 namespace pascinference {
 
 /* Maybe these classes are not defined yet */ 
@@ -48,6 +53,14 @@ class TSData: public GeneralData {
 		/* scaling variables */
 		double scale_max;
 		double scale_min;
+
+		/** @brief take the ownership of the data vector
+		* 
+		* The vector is destroyed in destructor, its memory is registered in MemoryCheck here and unregistered there.
+		* 
+		* @param new_datavector data vector created by the data object
+		*/
+		void set_datavector_owned(GeneralVector<VectorBase> *new_datavector);
 		
 	public:
 		TSData(Decomposition<VectorBase> &decomposition, GeneralVector<VectorBase> *datavector_new, GeneralVector<VectorBase> *gammavector_new, GeneralVector<VectorBase> *thetavector_new);
@@ -136,10 +149,87 @@ class TSData: public GeneralData {
 		virtual void load_gammavector(std::string filename) const;
 		virtual void load_gammavector(VectorBase &gamma0) const;
 
+		/** @brief set gamma from k-means clustering of data
+		* 
+		* Centers are chosen by distributed k-means++ seeding and improved by Lloyd iterations,
+		* gamma is one-hot (or softened) affiliation of data to centers. Different seeds give different (but good) initial approximations.
+		* Gamma is computed in the layout of decomposition, therefore it should not be permuted.
+		* 
+		* @param seed seed of random generator, the same on all processes
+		* @param nmb_lloyd number of Lloyd iterations
+		* @param softness 0 = one-hot gamma, otherwise gamma_k is proportional to exp(-dist_k/(softness*average_dist))
+		*/
+		void init_gammavector_kmeans(int seed, int nmb_lloyd, double softness) const;
+
 		/** @brief compute nbins of actual gammavector 
 		 */ 
 		double compute_gammavector_nbins();
 
+		/** @brief slide the time window by given number of new samples
+		* 
+		* The oldest nsamples time steps are removed, remaining data are shifted to the begining and new samples are appended to the end.
+		* Gamma is shifted in the same way, therefore it can be used as an initial approximation (warm start) of next solution.
+		* Gamma of new time steps is initialized by the last known gamma of corresponding node.
+		* The size of problem is not changed, decomposition, graph, model and solvers can be reused.
+		* Vectors are shifted in the layout of decomposition, only the node of new sample is permuted.
+		* The next solution is computed on the whole window, see TSSolver::set_init_permute.
+		* 
+		* @param values new samples in original layout [t*R*xdim + r*xdim + n] (already scaled if data are scaled), the same on all processes
+		* @param nsamples number of new time steps
+		*/
+		void append_samples(const double *values, int nsamples);
+
+		/** @brief save data, gamma and recovered signal of all time steps for visualisation
+		* 
+		* Writes light XDMF file filename.xmf and one binary heavy-data file filename.bin.
+		* The geometry (coordinates of model) and the topology (edges of graph) are stored only once,
+		* fields are stored in original layout [t][r][component] and every process writes its own part in parallel.
+		* 
+		* @param filename the name of output files without extension
+		*/
+		void saveXDMF(std::string filename) const;
+
+		/** @brief save gamma as the labels of clusters
+		* 
+		* After cutgamma every row (node in time step) of gamma is one-hot, therefore only the index of cluster is stored
+		* (one byte if K <= 256, otherwise two bytes) together with theta. The file is K*8 (K*4) times smaller than dense gamma.
+		* If the row is not one-hot, then the index of maximal value is stored.
+		* The file is native-endian:
+		* \code
+		* char magic[8]; int32 T; int32 R; int32 K; int32 labelsize; int32 theta_size; int32 reserved; double theta[theta_size]; labels[T*R]
+		* \endcode
+		* The labels are in original layout [t*R + r] and every process writes its own part in parallel.
+		* 
+		* @param filename the name of output file
+		*/
+		void save_gammalabels(std::string filename) const;
+
+		/** @brief set one-hot gamma from file with labels
+		* 
+		* The file is created by save_gammalabels, theta stored in the file is not used.
+		* load_gammavector(filename) recognizes the file with labels automatically.
+		* 
+		* @param filename the name of file with labels
+		*/
+		void load_gammalabels(std::string filename) const;
+
+		/** @brief test if the file contains labels of clusters (see save_gammalabels)
+		*/
+		static bool is_gammalabels_file(std::string filename);
+
+		/** @brief compute recovered signal x = sum_k gamma_k theta_k
+		* 
+		* The value of one-hot row of gamma is gathered from theta of its cluster, other rows are computed as the sum.
+		* If there is a batch of independent problems (theta of size nmb_batch*K*xdim), then every problem uses its own theta.
+		* 
+		* @param recovered output vector with the layout of datavector
+		*/
+		void compute_recovered(GeneralVector<VectorBase> &recovered) const;
+
+		/** @brief return true if gamma should be saved as labels instead of dense vector (option tsdata_save_labels)
+		*/
+		bool get_save_labels() const;
+
 };
 
 
@@ -238,6 +328,17 @@ TSData<VectorBase>::TSData(Decomposition<VectorBase> &new_decomposition, std::st
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+void TSData<VectorBase>::set_datavector_owned(GeneralVector<VectorBase> *new_datavector){
+	LOG_FUNC_BEGIN
+
+	this->datavector = new_datavector;
+	this->destroy_datavector = true;
+	MemoryCheck::owned_add("TSData", datavector->local_size()*sizeof(double));
+
+	LOG_FUNC_END
+}
+
 template<class VectorBase>
 void TSData<VectorBase>::set_model(TSModel<VectorBase> &tsmodel){
 	LOG_FUNC_BEGIN
@@ -258,14 +359,17 @@ TSData<VectorBase>::~TSData(){
 	
 	/* if I created a datavector, then I should also be able to destroy it */
 	if(this->destroy_datavector){
+		MemoryCheck::owned_remove("TSData", datavector->local_size()*sizeof(double));
 		free(this->datavector);
 	}
 	
 	if(this->destroy_gammavector){
+		MemoryCheck::owned_remove("TSData", gammavector->local_size()*sizeof(double));
 		free(this->gammavector);
 	}
 
 	if(this->destroy_thetavector){
+		MemoryCheck::owned_remove("TSData", thetavector->local_size()*sizeof(double));
 		free(this->thetavector);
 	}
 
@@ -618,6 +722,33 @@ void TSData<VectorBase>::cutdata(double a, double b){
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+void TSData<VectorBase>::append_samples(const double *values, int nsamples){
+	LOG_FUNC_BEGIN
+
+	//TODO
+	
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void TSData<VectorBase>::init_gammavector_kmeans(int seed, int nmb_lloyd, double softness) const{
+	LOG_FUNC_BEGIN
+
+	//TODO
+	
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void TSData<VectorBase>::saveXDMF(std::string filename) const{
+	LOG_FUNC_BEGIN
+
+	//TODO
+	
+	LOG_FUNC_END
+}
+
 template<class VectorBase>
 void TSData<VectorBase>::shiftdata(double a){
 	LOG_FUNC_BEGIN
@@ -654,6 +785,50 @@ void TSData<VectorBase>::load_gammavector(std::string filename) const {
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+void TSData<VectorBase>::save_gammalabels(std::string filename) const {
+	LOG_FUNC_BEGIN
+	
+	//TODO
+	
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void TSData<VectorBase>::load_gammalabels(std::string filename) const {
+	LOG_FUNC_BEGIN
+	
+	//TODO
+	
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+bool TSData<VectorBase>::is_gammalabels_file(std::string filename) {
+	char magic[8];
+	std::ifstream file(filename.c_str(), std::ios::binary);
+	if(!file.read(magic, 8)){
+		return false;
+	}
+	return (strncmp(magic, TSDATA_LABELS_MAGIC, 8) == 0);
+}
+
+template<class VectorBase>
+void TSData<VectorBase>::compute_recovered(GeneralVector<VectorBase> &recovered) const {
+	LOG_FUNC_BEGIN
+	
+	//TODO
+	
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+bool TSData<VectorBase>::get_save_labels() const {
+	bool save_labels;
+	consoleArg.set_option_value("tsdata_save_labels", &save_labels, TSDATA_DEFAULT_SAVE_LABELS);
+	return save_labels;
+}
+
 template<class VectorBase>
 double TSData<VectorBase>::compute_gammavector_nbins() {
 	LOG_FUNC_BEGIN
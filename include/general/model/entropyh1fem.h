@@ -9,6 +9,7 @@
 #include "general/algebra/feasibleset/simplex_local.h"
 #include "general/solver/spgqpsolver.h"
 #include "general/solver/spgqpsolver_coeff.h"
+#include "general/solver/fistaqpsolver.h"
 //#include "general/solver/taosolver.h"
 
 #ifdef USE_PERMON
@@ -46,7 +47,8 @@ class EntropyH1FEMModel: public TSModel<VectorBase> {
 			GSOLVER_SPGQP=1,			/**< CPU/GPU implementation of Spectral Projected Gradient method */
 			GSOLVER_SPGQP_COEFF=2,		/**< CPU/GPU implementation of Spectral Projected Gradient method with special coefficient threatment */
 			GSOLVER_PERMON=3,			/**< PERMONQP solver (augumented lagrangians combined with active-set method) */
-			GSOLVER_TAO=4				/**< TAO solver */
+			GSOLVER_TAO=4,				/**< TAO solver */
+			GSOLVER_FISTAQP=5			/**< CPU/GPU implementation of accelerated projected gradient method with adaptive restart */
 		} GammaSolverType;
 
 		/** @brief return name of gamma solver in string format
@@ -163,6 +165,7 @@ std::string EntropyH1FEMModel<VectorBase>::print_gammasolvertype(GammaSolverType
 		case(GSOLVER_SPGQP_COEFF):	 	return_value = "SPG-QP-COEFF solver"; break;
 		case(GSOLVER_PERMON): 			return_value = "PERMON QP solver"; break;
 		case(GSOLVER_TAO): 				return_value = "TAO QP solver"; break;
+		case(GSOLVER_FISTAQP): 			return_value = "FISTA-QP solver"; break;
 	}
 	return return_value;
 }
@@ -10,6 +10,7 @@
 #include "general/algebra/feasibleset/simplex_lineqbound.h"
 #include "general/solver/spgqpsolver.h"
 #include "general/solver/spgqpsolver_coeff.h"
+#include "general/solver/fistaqpsolver.h"
 #include "general/solver/permonsolver.h"
 //#include "general/solver/taosolver.h"
 #include "general/data/qpdata.h"
@@ -44,7 +45,8 @@ class GraphH1FEMModel: public TSModel<VectorBase> {
 			SOLVER_SPGQP=1, /**< CPU/GPU implementation of Spectral Projected Gradient method */
 			SOLVER_SPGQP_COEFF=2, /**< CPU/GPU implementation of Spectral Projected Gradient method with special coefficient threatment */
 			SOLVER_PERMON=3, /**< PERMONQP solver (augumented lagrangians combined with active-set method) */
-			SOLVER_TAO=4 /**< TAO solver */
+			SOLVER_TAO=4, /**< TAO solver */
+			SOLVER_FISTAQP=5 /**< CPU/GPU implementation of accelerated projected gradient method with adaptive restart */
 		} GammaSolverType;
 
 	protected:
@@ -60,6 +62,7 @@ class GraphH1FEMModel: public TSModel<VectorBase> {
 		
 		bool usethetainpenalty; /**< use the value of Theta in penalty parameter to scale blocks */
 		bool scalef;			/**< divide whole function by T */
+		int nmb_batch;			/**< number of independent problems, vertices of graph are divided into nmb_batch blocks of the same size */
 		
 		GammaSolverType gammasolvertype; /**< the type of used solver */
 		
@@ -68,11 +71,18 @@ class GraphH1FEMModel: public TSModel<VectorBase> {
 	public:
 
 		/** @brief constructor from data and regularisation constant
+		 * 
+		 * If nmb_batch > 1, then the data contains batch of independent problems with the same geometry,
+		 * the problem b consists of vertices b*R/nmb_batch,...,(b+1)*R/nmb_batch-1 of graph (there are no edges between problems),
+		 * and each problem has its own Theta. The thetavector is then ordered [b][k].
 		 * 
 		 * @param tsdata time-series data on which model operates
 		 * @param epssqr regularisation constant
+		 * @param new_fem reduction of the problem, NULL if the problem is not reduced
+		 * @param usethetainpenalty use the value of Theta in penalty parameter to scale blocks
+		 * @param nmb_batch number of independent problems in data
 		 */ 	
-		GraphH1FEMModel(TSData<VectorBase> &tsdata, double epssqr, Fem<VectorBase> *new_fem = NULL, bool usethetainpenalty = false);
+		GraphH1FEMModel(TSData<VectorBase> &tsdata, double epssqr, Fem<VectorBase> *new_fem = NULL, bool usethetainpenalty = false, int nmb_batch = 1);
 
 		/** @brief destructor 
 		 */ 
@@ -124,6 +134,7 @@ class GraphH1FEMModel: public TSModel<VectorBase> {
 		
 		void set_epssqr(double epssqr);
 		bool get_usethetainpenalty() const;
+		int get_nmb_batch() const;
 		
 		int get_T_reduced() const;
 		int get_T() const;
@@ -145,7 +156,7 @@ namespace model {
 
 /* constructor */
 template<class VectorBase>
-GraphH1FEMModel<VectorBase>::GraphH1FEMModel(TSData<VectorBase> &new_tsdata, double epssqr, Fem<VectorBase> *new_fem, bool usethetainpenalty) {
+GraphH1FEMModel<VectorBase>::GraphH1FEMModel(TSData<VectorBase> &new_tsdata, double epssqr, Fem<VectorBase> *new_fem, bool usethetainpenalty, int nmb_batch) {
 	LOG_FUNC_BEGIN
 
 	//TODO
@@ -187,6 +198,7 @@ void GraphH1FEMModel<VectorBase>::print(ConsoleOutput &output) const {
 	output <<  " - R                 : " << this->tsdata->get_R() << std::endl;
 	output <<  " - epssqr            : " << this->epssqr << std::endl;
 	output <<  " - usethetainpenalty : " << printbool(this->usethetainpenalty) << std::endl; 
+	output <<  " - nmb_batch         : " << this->nmb_batch << std::endl;
 
 	output <<  " - Graph             : " << std::endl;
 	output.push();
@@ -202,6 +214,7 @@ void GraphH1FEMModel<VectorBase>::print(ConsoleOutput &output) const {
 		case(SOLVER_SPGQP_COEFF): output << "SPG-QP-COEFF solver"; break;
 		case(SOLVER_PERMON): output << "PERMON QP solver"; break;
 		case(SOLVER_TAO): output << "TAO QP solver"; break;
+		case(SOLVER_FISTAQP): output << "FISTA-QP solver"; break;
 	}
 	output << std::endl;
 	
@@ -233,6 +246,7 @@ void GraphH1FEMModel<VectorBase>::print(ConsoleOutput &output_global, ConsoleOut
 	output_global <<  "  - R                 : " << this->tsdata->get_R() << std::endl;
 	output_global <<  "  - epssqr            : " << this->epssqr << std::endl;
 	output_global <<  "  - usethetainpenalty : " << printbool(this->usethetainpenalty) << std::endl; 
+	output_global <<  "  - nmb_batch         : " << this->nmb_batch << std::endl;
 	output_global <<  "  - gammasolvertype   : ";
 	switch(this->gammasolvertype){
 		case(SOLVER_AUTO): output_global << "AUTO"; break;
@@ -240,6 +254,7 @@ void GraphH1FEMModel<VectorBase>::print(ConsoleOutput &output_global, ConsoleOut
 		case(SOLVER_SPGQP_COEFF): output_global << "SPG-QP-COEFF solver"; break;
 		case(SOLVER_PERMON): output_global << "PERMON QP solver"; break;
 		case(SOLVER_TAO): output_global << "TAO QP solver"; break;
+		case(SOLVER_FISTAQP): output_global << "FISTA-QP solver"; break;
 	}
 	output_global << std::endl;
 
@@ -332,11 +347,13 @@ void GraphH1FEMModel<VectorBase>::finalize_gammasolver(GeneralSolver **gammasolv
 
 	/* I created this objects, I should destroy them */
 	if(fem->is_reduced()){
-		free(gammadata->get_x());
+		MemoryCheck::owned_remove("Fem reduced problem", (2*gammadata->get_x()->local_size() + residuum->local_size())*sizeof(double));
+		delete gammadata->get_x();
+		delete residuum;
 	}
 
-	/* destroy data */
-	free(gammadata->get_b());
+	/* destroy data, the vectors have to be deleted to destroy their inner vectors */
+	delete gammadata->get_b();
 	free(gammadata->get_A());
 	free(gammadata->get_feasibleset());
 	free(gammadata);
@@ -442,7 +459,7 @@ int GraphH1FEMModel<VectorBase>::get_coordinatesVTK_dim() const{
 
 template<class VectorBase>
 double GraphH1FEMModel<VectorBase>::get_aic(double L) const{
-	return 2*log(L) + this->tsdata->get_K();
+	return 2*log(L) + this->tsdata->get_K()*this->nmb_batch;
 
 }
 
@@ -452,6 +469,11 @@ bool GraphH1FEMModel<VectorBase>::get_usethetainpenalty() const{
 
 }
 
+template<class VectorBase>
+int GraphH1FEMModel<VectorBase>::get_nmb_batch() const{
+	return this->nmb_batch;
+}
+
 template<class VectorBase>
 int GraphH1FEMModel<VectorBase>::get_T_reduced() const {
 	return fem->get_decomposition_reduced()->get_T();
@@ -90,9 +90,9 @@ class EntropySolverNewton: public GeneralSolver {
 
 		/* aux vectors */
 		GeneralVector<VectorBase> *moments_data; /**< vector of computed moments from data, size K*Km */
-		GeneralVector<VectorBase> *integrals; /**< vector of computed integrals, size K*(Km+1) */
-		GeneralVector<VectorBase> *x_power; /**< global temp vector for storing power of x */
-		GeneralVector<VectorBase> *x_power_gammak; /**< global temp vector for storing power of x * gamma_k */
+		GeneralVector<VectorBase> *integrals; /**< vector of computed integrals, size K*(2*Km+1) */
+		GeneralVector<VectorBase> *x_power; /**< global temp vector for storing power of x (not used if moments are computed in one sweep) */
+		GeneralVector<VectorBase> *x_power_gammak; /**< global temp vector for storing power of x * gamma_k (not used if moments are computed in one sweep) */
 
 		/** @brief set settings of algorithm from arguments in console
 		* 
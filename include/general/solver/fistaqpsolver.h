@@ -0,0 +1,801 @@
+/** @file fistaqpsolver.h
+ *  @brief Accelerated Projected Gradient method (FISTA) for solving Quadratic Programs
+ *
+ *  @author Lukas Pospisil
+ */
+
+#ifndef PASC_FISTAQPSOLVER_H
+#define	PASC_FISTAQPSOLVER_H
+
+#include <iostream>
+
+#include "general/common/common.h"
+#include "general/solver/qpsolver.h"
+#include "general/data/qpdata.h"
+
+#define FISTAQPSOLVER_DEFAULT_MAXIT 1000
+#define FISTAQPSOLVER_DEFAULT_EPS 1e-9
+#define FISTAQPSOLVER_DEFAULT_DEBUGMODE 0
+
+#define FISTAQPSOLVER_DEFAULT_RESTART 2
+#define FISTAQPSOLVER_DEFAULT_POWER_MAXIT 20
+#define FISTAQPSOLVER_DEFAULT_POWER_EPS 1e-3
+#define FISTAQPSOLVER_DEFAULT_LSAFETY 1.05
+
+#define FISTAQPSOLVER_STOP_NORMGP false
+#define FISTAQPSOLVER_STOP_DIFFF true
+
+namespace pascinference {
+namespace solver {
+
+/** \class FISTAQPSolver
+ *  \brief Accelerated Projected Gradient method (FISTA) with adaptive restart for Quadratic Programs
+ *
+ *  For solving QP on closed convex set using projections.
+ *  The step-size is 1/L, where L is the estimation of the largest eigenvalue of Hessian matrix. The estimation provided
+ *  by matrix is used, if it is not available, then it is computed by power method. The eigenvector from previous solution
+ *  is used as initial vector, therefore only a few iterations of power method are necessary during outer iterations.
+ *
+ *  The momentum is restarted if the function value increases (function restart) or if the momentum direction
+ *  does not agree with the direction of the projected gradient step (gradient restart).
+ *  Only one multiplication by Hessian matrix is performed in each iteration, the gradient in extrapolated point is
+ *  computed from the gradients in last two approximations.
+*/
+template<class VectorBase>
+class FISTAQPSolver: public QPSolver<VectorBase> {
+	public:
+		/** @brief type of momentum restart
+		*/
+		typedef enum {
+			RESTART_NONE=0,		/**< classical FISTA without restart */
+			RESTART_FUNCTION=1,	/**< restart if the function value increases */
+			RESTART_GRADIENT=2	/**< restart if the momentum is not descent direction */
+		} RestartType;
+
+	private:
+		Timer timer_solve; 			/**< total solution time of algorithm */
+		Timer timer_projection;		/**< the sum of time necessary to perform projections */
+		Timer timer_matmult; 		/**< the sum of time necessary to perform matrix multiplication */
+		Timer timer_dot; 			/**< the sum of time necessary to compute dot_products */
+		Timer timer_update; 		/**< total time of vector updates */
+		Timer timer_stepsize;	 	/**< total time of step-size computation (power method) */
+
+		bool stop_normgp; 			/**< stopping criteria based on norm of gradient mapping */
+		bool stop_difff;			/**< stopping criteria based on size of decrease of f */
+
+		RestartType restart;		/**< type of momentum restart */
+		int power_maxit;			/**< maximum number of iterations of power method */
+		double power_eps;			/**< relative precision of power method */
+		double Lsafety;				/**< the estimation of largest eigenvalue is multiplied by this coefficient */
+
+		double L;					/**< the estimation of largest eigenvalue of Hessian matrix from last solution */
+		bool power_init;			/**< the eigenvector from last solution is available */
+		int nmb_restart_last;		/**< number of restarts during last solution */
+
+		double gP; 					/**< norm of gradient mapping */
+
+		/** @brief allocate storage for auxiliary vectors used in computation
+		*
+		*/
+		void allocate_temp_vectors();
+
+		/** @brief deallocate storage for auxiliary vectors used in computation
+		*
+		*/
+		void free_temp_vectors();
+
+		GeneralVector<VectorBase> *g; 		/**< gradient in x */
+		GeneralVector<VectorBase> *g_old; 	/**< gradient in previous x */
+		GeneralVector<VectorBase> *x_old; 	/**< previous approximation */
+		GeneralVector<VectorBase> *y; 		/**< extrapolated point */
+		GeneralVector<VectorBase> *gy; 		/**< gradient in y */
+		GeneralVector<VectorBase> *v; 		/**< eigenvector of power method */
+		GeneralVector<VectorBase> *temp;	/**< general temp vector */
+
+		/** @brief estimate the largest eigenvalue of Hessian matrix using power method
+		*
+		* @return number of multiplications by Hessian matrix
+		*/
+		int compute_L();
+
+		/** @brief set settings of algorithm from arguments in console
+		*
+		*/
+		void set_settings_from_console();
+
+		bool debug_print_it;		/**< print simple info about outer iterations */
+
+	public:
+		/** @brief general constructor
+		*
+		*/
+		FISTAQPSolver();
+
+		/** @brief constructor based on provided data of problem
+		*
+		* @param new_qpdata data of quadratic program
+		*/
+		FISTAQPSolver(QPData<VectorBase> &new_qpdata);
+
+		/** @brief destructor
+		*
+		*/
+		~FISTAQPSolver();
+
+		void solve();
+
+		double get_fx() const;
+
+		/** @brief return the estimation of largest eigenvalue of Hessian matrix used in last solution
+		*
+		*/
+		double get_L() const;
+
+		void print(ConsoleOutput &output) const;
+		void print(ConsoleOutput &output_global, ConsoleOutput &output_local) const;
+		void printstatus(ConsoleOutput &output) const;
+		void printstatus(std::ostringstream &output) const;
+		void printtimer(ConsoleOutput &output) const;
+		void printshort(std::ostringstream &header, std::ostringstream &values) const;
+		void printshort_sum(std::ostringstream &header, std::ostringstream &values) const;
+		std::string get_name() const;
+
+};
+
+}
+} /* end of namespace */
+
+/* ------------- implementation ----------- */
+
+namespace pascinference {
+namespace solver {
+
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::set_settings_from_console() {
+	consoleArg.set_option_value("fistaqpsolver_maxit", &this->maxit, FISTAQPSOLVER_DEFAULT_MAXIT);
+	consoleArg.set_option_value("fistaqpsolver_eps", &this->eps, FISTAQPSOLVER_DEFAULT_EPS);
+
+	int restart_int;
+	consoleArg.set_option_value("fistaqpsolver_restart", &restart_int, FISTAQPSOLVER_DEFAULT_RESTART);
+	this->restart = static_cast<RestartType>(restart_int);
+
+	consoleArg.set_option_value("fistaqpsolver_power_maxit", &this->power_maxit, FISTAQPSOLVER_DEFAULT_POWER_MAXIT);
+	consoleArg.set_option_value("fistaqpsolver_power_eps", &this->power_eps, FISTAQPSOLVER_DEFAULT_POWER_EPS);
+	consoleArg.set_option_value("fistaqpsolver_Lsafety", &this->Lsafety, FISTAQPSOLVER_DEFAULT_LSAFETY);
+
+	consoleArg.set_option_value("fistaqpsolver_stop_normgp", &this->stop_normgp, FISTAQPSOLVER_STOP_NORMGP);
+	consoleArg.set_option_value("fistaqpsolver_stop_difff", &this->stop_difff, FISTAQPSOLVER_STOP_DIFFF);
+
+	/* set debug mode */
+	consoleArg.set_option_value("fistaqpsolver_debugmode", &this->debugmode, FISTAQPSOLVER_DEFAULT_DEBUGMODE);
+	consoleArg.set_option_value("fistaqpsolver_debug_print_it", &debug_print_it, (this->debugmode >= 1));
+
+}
+
+/* constructor */
+template<class VectorBase>
+FISTAQPSolver<VectorBase>::FISTAQPSolver(){
+	LOG_FUNC_BEGIN
+
+	this->qpdata = NULL;
+
+	/* temp vectors */
+	this->g = NULL;
+	this->g_old = NULL;
+	this->x_old = NULL;
+	this->y = NULL;
+	this->gy = NULL;
+	this->v = NULL;
+	this->temp = NULL;
+
+	this->it_sum = 0;
+	this->hessmult_sum = 0;
+	this->it_last = 0;
+	this->hessmult_last = 0;
+	this->nmb_restart_last = 0;
+
+	this->fx = std::numeric_limits<double>::max();
+	this->gP = std::numeric_limits<double>::max();
+
+	/* settings */
+	set_settings_from_console();
+
+	/* eigenvalue is not known yet */
+	this->L = 0.0;
+	this->power_init = false;
+
+	/* prepare timers */
+	this->timer_solve.restart();
+	this->timer_projection.restart();
+	this->timer_matmult.restart();
+	this->timer_dot.restart();
+	this->timer_update.restart();
+	this->timer_stepsize.restart();
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+FISTAQPSolver<VectorBase>::FISTAQPSolver(QPData<VectorBase> &new_qpdata){
+	LOG_FUNC_BEGIN
+
+	this->qpdata = &new_qpdata;
+
+	/* allocate temp vectors */
+	allocate_temp_vectors();
+
+	this->it_sum = 0;
+	this->hessmult_sum = 0;
+	this->it_last = 0;
+	this->hessmult_last = 0;
+	this->nmb_restart_last = 0;
+
+	this->fx = std::numeric_limits<double>::max();
+	this->gP = std::numeric_limits<double>::max();
+
+	/* settings */
+	set_settings_from_console();
+
+	/* eigenvalue is not known yet */
+	this->L = 0.0;
+	this->power_init = false;
+
+	/* prepare timers */
+	this->timer_solve.restart();
+	this->timer_projection.restart();
+	this->timer_matmult.restart();
+	this->timer_dot.restart();
+	this->timer_update.restart();
+	this->timer_stepsize.restart();
+
+	LOG_FUNC_END
+}
+
+
+/* destructor */
+template<class VectorBase>
+FISTAQPSolver<VectorBase>::~FISTAQPSolver(){
+	LOG_FUNC_BEGIN
+
+	/* free temp vectors */
+	free_temp_vectors();
+
+	LOG_FUNC_END
+}
+
+/* prepare temp_vectors */
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::allocate_temp_vectors(){
+	LOG_FUNC_BEGIN
+
+	GeneralVector<VectorBase> *pattern = this->qpdata->get_b(); /* I will allocate temp vectors subject to linear term */
+
+	g = new GeneralVector<VectorBase>(*pattern);
+	g_old = new GeneralVector<VectorBase>(*pattern);
+	x_old = new GeneralVector<VectorBase>(*pattern);
+	y = new GeneralVector<VectorBase>(*pattern);
+	gy = new GeneralVector<VectorBase>(*pattern);
+	v = new GeneralVector<VectorBase>(*pattern);
+	temp = new GeneralVector<VectorBase>(*pattern);
+
+	LOG_FUNC_END
+}
+
+/* destroy temp_vectors */
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::free_temp_vectors(){
+	LOG_FUNC_BEGIN
+
+	free(g);
+	free(g_old);
+	free(x_old);
+	free(y);
+	free(gy);
+	free(v);
+	free(temp);
+
+	LOG_FUNC_END
+}
+
+
+/* print info about problem */
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::print(ConsoleOutput &output) const {
+	LOG_FUNC_BEGIN
+
+	output << this->get_name() << std::endl;
+
+	/* print settings */
+	output <<  " - maxit:       " << this->maxit << std::endl;
+	output <<  " - eps:         " << this->eps << std::endl;
+	output <<  " - debugmode:   " << this->debugmode << std::endl;
+
+	output <<  " - restart:     " << this->restart << std::endl;
+	output <<  " - power_maxit: " << this->power_maxit << std::endl;
+	output <<  " - power_eps:   " << this->power_eps << std::endl;
+	output <<  " - Lsafety:     " << this->Lsafety << std::endl;
+
+	/* print data */
+	if(this->qpdata){
+		coutMaster.push();
+		this->qpdata->print(output);
+		coutMaster.pop();
+	}
+
+	output.synchronize();
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::print(ConsoleOutput &output_global, ConsoleOutput &output_local) const {
+	LOG_FUNC_BEGIN
+
+	output_global <<  this->get_name() << std::endl;
+
+	/* print settings */
+	output_local <<  " - maxit:       " << this->maxit << std::endl;
+	output_local <<  " - eps:         " << this->eps << std::endl;
+	output_local <<  " - debugmode:   " << this->debugmode << std::endl;
+
+	output_local <<  " - restart:     " << this->restart << std::endl;
+	output_local <<  " - power_maxit: " << this->power_maxit << std::endl;
+	output_local <<  " - power_eps:   " << this->power_eps << std::endl;
+	output_local <<  " - Lsafety:     " << this->Lsafety << std::endl;
+
+	output_local.synchronize();
+
+	/* print data */
+	if(this->qpdata){
+		coutMaster.push();
+		this->qpdata->print(output_global, output_local);
+		coutMaster.pop();
+	}
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::printstatus(ConsoleOutput &output) const {
+	LOG_FUNC_BEGIN
+
+	output <<  " - it: " << std::setw(6) << this->it_last << ", ";
+	output <<  "hess mult: " << std::setw(6) << this->hessmult_last << ", ";
+	output <<  "restarts: " << std::setw(6) << this->nmb_restart_last << ", ";
+	output <<  "fx: " << std::setw(10) << this->fx << ", ";
+	output <<  "norm(gP): " << std::setw(10) << this->gP << ", ";
+	output <<  "L: " << std::setw(10) << this->L << std::endl;
+
+	output << " - ";
+	output <<  "t_project = " << std::setw(10) << this->timer_projection.get_value_last() << ", ";
+	output <<  "t_matmult = " << std::setw(10) << this->timer_matmult.get_value_last() << ", ";
+	output <<  "t_stepsize = " << std::setw(10) << this->timer_stepsize.get_value_last() << ", ";
+	output <<  "t_other = " << std::setw(10) << this->timer_solve.get_value_last() - (this->timer_projection.get_value_last() + this->timer_matmult.get_value_last() + this->timer_dot.get_value_last() + this->timer_update.get_value_last() + this->timer_stepsize.get_value_last()) << std::endl;
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::printstatus(std::ostringstream &output) const {
+	LOG_FUNC_BEGIN
+
+	std::streamsize ss = std::cout.precision();
+
+	output << std::setprecision(17);
+	output <<  "      - fx:           " << std::setw(25) << this->fx << std::endl;
+	output <<  "      - norm(gP):     " << std::setw(25) << this->gP << ", log: " << std::setw(25) << log(this->gP)/log(10) << std::endl;
+	output <<  "      - L:            " << std::setw(25) << this->L << std::endl;
+	output << std::setprecision(ss);
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::printtimer(ConsoleOutput &output) const {
+	LOG_FUNC_BEGIN
+
+	output <<  this->get_name() << std::endl;
+	output <<  " - it all =        " << this->it_sum << std::endl;
+	output <<  " - hessmult all =  " << this->hessmult_sum << std::endl;
+	output <<  " - timers" << std::endl;
+	output <<  "  - t_solve =      " << this->timer_solve.get_value_sum() << std::endl;
+	output <<  "  - t_project =    " << this->timer_projection.get_value_sum() << std::endl;
+	output <<  "  - t_matmult =    " << this->timer_matmult.get_value_sum() << std::endl;
+	output <<  "  - t_dot =        " << this->timer_dot.get_value_sum() << std::endl;
+	output <<  "  - t_update =     " << this->timer_update.get_value_sum() << std::endl;
+	output <<  "  - t_stepsize =   " << this->timer_stepsize.get_value_sum() << std::endl;
+	output <<  "  - t_other =      " << this->timer_solve.get_value_sum() - (this->timer_projection.get_value_sum() + this->timer_matmult.get_value_sum() + this->timer_dot.get_value_sum() + this->timer_update.get_value_sum() + this->timer_stepsize.get_value_sum()) << std::endl;
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::printshort(std::ostringstream &header, std::ostringstream &values) const {
+	LOG_FUNC_BEGIN
+
+	std::streamsize ss = std::cout.precision();
+
+	values << std::setprecision(17);
+
+	header << "FISTAQP it, ";
+	values << this->it_last << ", ";
+
+	header << "FISTAQP hessmult, ";
+	values << this->hessmult_last << ", ";
+
+	header << "FISTAQP restarts, ";
+	values << this->nmb_restart_last << ", ";
+
+	header << "FISTAQP L, ";
+	values << this->L << ", ";
+
+	header << "FISTAQP t all, ";
+	values << this->timer_solve.get_value_last() << ", ";
+
+	header << "FISTAQP t project, ";
+	values << this->timer_projection.get_value_last() << ", ";
+
+	header << "FISTAQP t matmult, ";
+	values << this->timer_matmult.get_value_last() << ", ";
+
+	header << "FISTAQP t dot, ";
+	values << this->timer_dot.get_value_last() << ", ";
+
+	header << "FISTAQP t update, ";
+	values << this->timer_update.get_value_last() << ", ";
+
+	header << "FISTAQP t stepsize, ";
+	values << this->timer_stepsize.get_value_last() << ", ";
+
+	header << "FISTAQP t other, ";
+	values << this->timer_solve.get_value_last() - (this->timer_projection.get_value_last() + this->timer_matmult.get_value_last() + this->timer_dot.get_value_last() + this->timer_update.get_value_last() + this->timer_stepsize.get_value_last()) << ", ";
+
+	header << "FISTAQP fx, ";
+	values << this->fx << ", ";
+
+	values << std::setprecision(ss);
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::printshort_sum(std::ostringstream &header, std::ostringstream &values) const {
+	LOG_FUNC_BEGIN
+
+	header << "FISTAQP_sum it, ";
+	values << this->it_sum << ", ";
+
+	header << "FISTAQP_sum hessmult, ";
+	values << this->hessmult_sum << ", ";
+
+	header << "FISTAQP_sum t all, ";
+	values << this->timer_solve.get_value_sum() << ", ";
+
+	header << "FISTAQP_sum t project, ";
+	values << this->timer_projection.get_value_sum() << ", ";
+
+	header << "FISTAQP_sum t matmult, ";
+	values << this->timer_matmult.get_value_sum() << ", ";
+
+	header << "FISTAQP_sum t dot, ";
+	values << this->timer_dot.get_value_sum() << ", ";
+
+	header << "FISTAQP_sum t update, ";
+	values << this->timer_update.get_value_sum() << ", ";
+
+	header << "FISTAQP_sum t stepsize, ";
+	values << this->timer_stepsize.get_value_sum() << ", ";
+
+	header << "FISTAQP_sum t other, ";
+	values << this->timer_solve.get_value_sum() - (this->timer_projection.get_value_sum() + this->timer_matmult.get_value_sum() + this->timer_dot.get_value_sum() + this->timer_update.get_value_sum() + this->timer_stepsize.get_value_sum()) << ", ";
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+std::string FISTAQPSolver<VectorBase>::get_name() const {
+	std::string return_value = "FISTAQPSolver<" + GeneralVector<VectorBase>::get_name() + ">";
+	return return_value;
+}
+
+/* power method, v is normalized eigenvector, temp = A*v */
+template<class VectorBase>
+int FISTAQPSolver<VectorBase>::compute_L() {
+	LOG_FUNC_BEGIN
+
+	/* I don't want to write (*x) as a vector, therefore I define following pointer types */
+	typedef GeneralVector<VectorBase> (&pVector);
+	typedef GeneralMatrix<VectorBase> (&pMatrix);
+
+	pMatrix A = *(this->qpdata->get_A());
+	pVector v = *(this->v);
+	pVector temp = *(this->temp);
+
+	int hessmult = 0;
+	double normv;
+
+	/* use the estimation provided by matrix if it is available */
+	double lambda_max = A.get_lambda_max();
+	if(lambda_max > 0.0){
+		this->L = this->Lsafety*lambda_max;
+
+		LOG_FUNC_END
+		return hessmult;
+	}
+
+	/* start from random vector, later from the eigenvector of last solution (the matrix changes only slightly) */
+	if(!this->power_init){
+		v.set_random();
+		this->power_init = true;
+	}
+
+	normv = norm(v);
+	if(normv <= 0.0){
+		LOG_FUNC_END
+		return hessmult;
+	}
+	v *= 1.0/normv;
+
+	double lambda = 0.0;
+	double lambda_old;
+	for(int it=0; it < this->power_maxit; it++){
+		this->timer_matmult.start();
+		 temp = A*v;
+		 hessmult += 1;
+		this->timer_matmult.stop();
+
+		/* for symmetric positive semidefinite matrix, norm(A*v) with unit v converges to the largest eigenvalue from below */
+		lambda_old = lambda;
+		lambda = norm(temp);
+		if(lambda <= 0.0){
+			break;
+		}
+
+		v = temp;
+		v *= 1.0/lambda;
+
+		if(std::abs(lambda - lambda_old) < this->power_eps*lambda){
+			break;
+		}
+	}
+
+	if(lambda > 0.0){
+		this->L = this->Lsafety*lambda;
+	}
+
+	LOG_FUNC_END
+	return hessmult;
+}
+
+/* solve the problem */
+template<class VectorBase>
+void FISTAQPSolver<VectorBase>::solve() {
+	LOG_FUNC_BEGIN
+
+	this->timer_solve.start(); /* stop this timer in the end of solution */
+
+	/* I don't want to write (*x) as a vector, therefore I define following pointer types */
+	typedef GeneralVector<VectorBase> (&pVector);
+	typedef GeneralMatrix<VectorBase> (&pMatrix);
+
+	/* pointers to qpdata */
+	pMatrix A = *(this->qpdata->get_A());
+	pVector b = *(this->qpdata->get_b());
+	pVector x0 = *(this->qpdata->get_x0());
+
+	/* pointer to solution */
+	pVector x = *(this->qpdata->get_x());
+
+	/* auxiliary vectors */
+	pVector g = *(this->g); /* gradient in x */
+	pVector g_old = *(this->g_old); /* gradient in x_old */
+	pVector x_old = *(this->x_old); /* previous approximation */
+	pVector y = *(this->y); /* extrapolated point */
+	pVector gy = *(this->gy); /* gradient in y */
+	pVector temp = *(this->temp);
+
+	int it = 0; /* number of iterations */
+	int hessmult = 0; /* number of hessian multiplications */
+	int nmb_restart = 0; /* number of restarts of momentum */
+
+	double fx; /* function value */
+	double fx_old; /* f(x_{it - 1}) */
+	double t, t_new, beta; /* momentum */
+	double step; /* step-size 1/L */
+	double gm; /* squared norm of gradient mapping times step-size, dot(y-x,y-x) */
+	bool restart_now;
+
+	/* step-size from the estimation of the largest eigenvalue */
+	this->timer_stepsize.start();
+	 hessmult += compute_L();
+	this->timer_stepsize.stop();
+
+	if(this->L <= 0.0){
+		/* A = 0, the projected gradient step with unit step-size solves the problem */
+		step = 1.0;
+	} else {
+		step = 1.0/this->L;
+	}
+
+	x = x0; /* set approximation as initial */
+
+	this->timer_projection.start();
+	 this->qpdata->get_feasibleset()->project(x); /* project initial approximation to feasible set */
+	this->timer_projection.stop();
+
+	/* compute gradient, g = A*x-b */
+	this->timer_matmult.start();
+	 g = A*x;
+	 hessmult += 1; /* there was muliplication by A */
+	this->timer_matmult.stop();
+
+	g -= b;
+
+	this->timer_dot.start();
+	 fx = get_fx();
+	this->timer_dot.stop();
+	fx_old = std::numeric_limits<double>::max();
+	gm = std::numeric_limits<double>::max();
+
+	/* extrapolated point is the initial approximation */
+	this->timer_update.start();
+	 y = x;
+	 gy = g;
+	this->timer_update.stop();
+	t = 1.0;
+
+	/* main cycle */
+	while(it < this->maxit){
+		/* increase iteration counter */
+		it += 1;
+
+		/* store previous approximation */
+		this->timer_update.start();
+		 x_old = x;
+		 g_old = g;
+
+		 /* projected gradient step from extrapolated point, x = P(y - step*gy) */
+		 x = y - step*gy;
+		this->timer_update.stop();
+
+		this->timer_projection.start();
+		 this->qpdata->get_feasibleset()->project(x);
+		this->timer_projection.stop();
+
+		/* g = A*x - b */
+		this->timer_matmult.start();
+		 g = A*x;
+		 hessmult += 1;
+		this->timer_matmult.stop();
+
+		this->timer_update.start();
+		 g -= b;
+		this->timer_update.stop();
+
+		this->timer_dot.start();
+		 fx_old = fx;
+		 fx = get_fx();
+		this->timer_dot.stop();
+
+		/* gradient mapping (scaled by step-size), temp = y - x */
+		this->timer_update.start();
+		 temp = y - x;
+		this->timer_update.stop();
+
+		this->timer_dot.start();
+		 gm = dot(temp,temp);
+		this->timer_dot.stop();
+
+		/* adaptive restart of momentum */
+		restart_now = false;
+		if(this->restart == RESTART_FUNCTION && fx > fx_old){
+			restart_now = true;
+		}
+		if(this->restart == RESTART_GRADIENT){
+			/* the momentum x - x_old is not descent direction, gy is not needed anymore, it is used as temp */
+			this->timer_update.start();
+			 gy = x - x_old;
+			this->timer_update.stop();
+
+			this->timer_dot.start();
+			 restart_now = (dot(temp,gy) > 0.0);
+			this->timer_dot.stop();
+		}
+
+		/* compute momentum coefficient */
+		this->timer_stepsize.start();
+		 if(restart_now){
+			t = 1.0;
+			beta = 0.0;
+			nmb_restart += 1;
+		 } else {
+			t_new = 0.5*(1.0 + std::sqrt(1.0 + 4.0*t*t));
+			beta = (t - 1.0)/t_new;
+			t = t_new;
+		 }
+		this->timer_stepsize.stop();
+
+		/* extrapolation, y = x + beta*(x - x_old), A*y - b = (1+beta)*g - beta*g_old */
+		this->timer_update.start();
+		 y = (1.0 + beta)*x - beta*x_old;
+		 gy = (1.0 + beta)*g - beta*g_old;
+		this->timer_update.stop();
+
+		this->gP = gm/(step*step);
+
+		/* print progress of algorithm */
+		if(debug_print_it){
+			coutMaster << "\033[33m   it = \033[0m" << it;
+
+			std::streamsize ss = std::cout.precision();
+			coutMaster << ", \t\033[36mfx = \033[0m" << std::setprecision(17) << fx << std::setprecision(ss);
+
+			coutMaster << ", \t\033[36mgP = \033[0m" << this->gP;
+			coutMaster << ", \t\033[36mbeta = \033[0m" << beta;
+			coutMaster << ", \t\033[36mrestart = \033[0m" << restart_now << std::endl;
+
+			/* log function value */
+			LOG_FX(fx)
+		}
+
+		/* stopping criteria */
+		if( this->stop_difff && std::abs(fx - fx_old) < this->eps){
+			break;
+		}
+		if(this->stop_normgp && this->gP < this->eps){
+			break;
+		}
+
+	} /* main cycle end */
+
+	this->it_sum += it;
+	this->hessmult_sum += hessmult;
+	this->it_last = it;
+	this->hessmult_last = hessmult;
+	this->nmb_restart_last = nmb_restart;
+
+	this->fx = fx;
+	this->timer_solve.stop();
+
+	/* write info to log file */
+	LOG_IT(it)
+	LOG_FX(fx)
+
+	LOG_FUNC_END
+}
+
+/* compute function value using inner *x and already computed *g */
+template<class VectorBase>
+double FISTAQPSolver<VectorBase>::get_fx() const {
+	LOG_FUNC_BEGIN
+
+	double fx = std::numeric_limits<double>::max();
+
+	/* I don't want to write (*x) as a vector, therefore I define following pointer types */
+	typedef GeneralVector<VectorBase> (&pVector);
+
+	/* pointers to qpdata */
+	pVector g = *(this->g);
+	pVector x = *(this->qpdata->get_x());
+	pVector b = *(this->qpdata->get_b());
+	pVector temp = *(this->temp);
+
+	/* use computed gradient in this->g to compute function value */
+	temp = g - b;
+	fx = 0.5*dot(temp,x);
+
+	LOG_FUNC_END
+	return fx;
+}
+
+template<class VectorBase>
+double FISTAQPSolver<VectorBase>::get_L() const {
+	return this->L;
+}
+
+
+}
+} /* end namespace */
+
+
+#endif
@@ -136,6 +136,26 @@ class GeneralSolver {
 		virtual double get_eps() const;
 		virtual void set_eps(double eps);
 
+		/** @brief return the number of values which describe the inner state of solver
+		 * 
+		 *  The inner state (for example step-size from the last solution) is stored in checkpoint file together with the solution.
+		 *  Solvers without inner state return 0.
+		 * 
+		 */ 
+		virtual int get_state_size() const;
+
+		/** @brief store the inner state of solver into given array
+		 * 
+		 * @param state array of length get_state_size()
+		 */ 
+		virtual void get_state(double *state) const;
+
+		/** @brief restore the inner state of solver from given array
+		 * 
+		 * @param state array of length get_state_size()
+		 */ 
+		virtual void set_state(const double *state);
+
 		ExternalContent *get_externalcontent() const;		
 
 };
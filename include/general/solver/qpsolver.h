@@ -38,6 +38,17 @@ class QPSolver: public GeneralSolver {
 		int hessmult_sum; /**< number of all Hessian multiplication */
 		int hessmult_last; /**< number of Hessian multiplication */
 
+		/** @brief print hardware counters of given timers on each rank
+		 * 
+		 * Used in printtimer() of solvers, nothing is printed if the counters are turned off.
+		 * 
+		 * @param output where to print the header
+		 * @param timers_nmb number of timers
+		 * @param timers_name names of timers
+		 * @param timers timers with counters
+		 */ 
+		void printtimer_counters(ConsoleOutput &output, int timers_nmb, const char * const *timers_name, const Timer * const *timers) const;
+
 	public:
 		/** @brief default constructor
 		 * 
@@ -224,6 +235,27 @@ void QPSolver<VectorBase>::printtimer(ConsoleOutput &output) const {
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+void QPSolver<VectorBase>::printtimer_counters(ConsoleOutput &output, int timers_nmb, const char * const *timers_name, const Timer * const *timers) const {
+	LOG_FUNC_BEGIN
+
+	/* hardware counters are measured on each rank separately, only in master thread */
+	if(Timer::get_counters_enabled()){
+		output <<  " - counters (per rank, master thread)" << std::endl;
+		if(timers_nmb > 0 && timers[0]->counters_available()){
+			coutAll <<  "  - rank " << GlobalManager.get_rank() << std::endl;
+			for(int i=0;i<timers_nmb;i++){
+				coutAll <<  "   - " << std::setw(10) << std::left << timers_name[i] << std::right << " " << timers[i]->get_counters_info() << std::endl;
+			}
+		} else {
+			coutAll <<  "  - rank " << GlobalManager.get_rank() << ": not available (perf_event_open not permitted?)" << std::endl;
+		}
+		coutAll.synchronize();
+	}
+
+	LOG_FUNC_END
+}
+
 template<class VectorBase>
 void QPSolver<VectorBase>::printshort(std::ostringstream &header, std::ostringstream &values) const {
 	LOG_FUNC_BEGIN
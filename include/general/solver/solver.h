@@ -14,6 +14,7 @@
 //#include "general/solver/diagsolver.h"
 #include "general/solver/entropysolverdlib.h"
 #include "general/solver/entropysolvernewton.h"
+#include "general/solver/fistaqpsolver.h"
 //#include "general/solver/multicg.h"
 #include "general/solver/permonsolver.h"
 #include "general/solver/qpsolver.h"
@@ -58,6 +58,20 @@ class SPG_fs {
 		*
 		*/
 		void update(double new_fx);
+
+		/** @brief copy the content of the list into given array
+		*
+		* Values are ordered from the oldest one to the newest one.
+		* 
+		* @param values array of length get_size()
+		*/
+		void get_values(double *values) const;
+
+		/** @brief set the content of the list from given array
+		*
+		* @param values array of length get_size() ordered from the oldest value to the newest one
+		*/
+		void set_values(const double *values);
 		
 		/** @brief print content of the lists
 		*
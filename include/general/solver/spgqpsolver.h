@@ -8,6 +8,7 @@
 #define	PASC_SPGQPSOLVER_H
 
 #include <iostream>
+#include <vector>
 
 #include "general/common/common.h"
 #include "general/solver/qpsolver.h"
@@ -25,6 +26,7 @@
 #define SPGQPSOLVER_DEFAULT_SIGMA1 0.000
 #define SPGQPSOLVER_DEFAULT_SIGMA2 1.0
 #define SPGQPSOLVER_DEFAULT_ALPHAINIT 2.0
+#define SPGQPSOLVER_DEFAULT_WARMSTART false
 
 #define SPGQPSOLVER_STOP_NORMGP false
 #define SPGQPSOLVER_STOP_ANORMGP false
@@ -76,6 +78,15 @@ class SPGQPSolver: public QPSolver<VectorBase> {
 		double sigma1;				/**< to enforce progress */
 		double sigma2;				/**< to enforce progress */
 		double alphainit;			/** initial step-size */
+		bool alphainit_auto;		/**< initial step-size was not given, use 1/lambda_max of Hessian matrix */
+		bool warmstart;				/**< start with BB step-size from the end of previous solution */
+
+		double alpha_bb_last;		/**< BB step-size from the end of last solution */
+		std::vector<double> fs_last; /**< content of SPG_fs from the end of last solution */
+
+		int nmb_batch;						/**< number of independent problems in QP, solved in lockstep */
+		std::vector<int> batch_local;		/**< index of problem for each local component of x */
+		std::vector<double> alpha_bb_batch_last; /**< BB step-sizes of problems from the end of last solution */
 
 		QPData<VectorBase> *qpdata; /**< data on which the solver operates */
 		double gP; 					/**< norm of projected gradient */
@@ -109,6 +120,20 @@ class SPGQPSolver: public QPSolver<VectorBase> {
 		* 
 		*/
 		void set_settings_from_console();
+
+		/** @brief initial BB step-size
+		* 
+		* If the step-size was not given in console, then 1/lambda_max is used,
+		* where lambda_max is the estimation of the largest eigenvalue of Hessian matrix provided by matrix.
+		*/
+		double get_alphainit() const;
+
+		/** @brief solve the batch of independent problems
+		* 
+		* Each problem has its own step-size, generalized Armijo condition and stopping criteria,
+		* the iterations of all problems are performed together until all of them converge.
+		*/
+		void solve_batch();
 		
 		int debugmode;				/**< basic debug mode schema [0/1/2] */
 		bool debug_print_it;		/**< print simple info about outer iterations */
@@ -134,9 +159,23 @@ class SPGQPSolver: public QPSolver<VectorBase> {
 
 		void solve();
 
+		/** @brief set the batch of independent problems
+		* 
+		* The Hessian is block-diagonal with respect to the problems and the feasible set
+		* does not couple them. Then each problem can be solved with its own step-size.
+		* 
+		* @param nmb_batch number of problems
+		* @param batch_local index of problem for each local component of x
+		*/
+		void set_batch(int nmb_batch, const std::vector<int> &batch_local);
+
 		double get_fx() const;
 		double get_fx(double fx_old, double beta, double gd, double dAd) const;
 
+		int get_state_size() const;
+		void get_state(double *state) const;
+		void set_state(const double *state);
+
 		void print(ConsoleOutput &output) const;
 		void print(ConsoleOutput &output_global, ConsoleOutput &output_local) const;
 		void printstatus(ConsoleOutput &output) const;
@@ -167,7 +206,11 @@ void SPGQPSolver<VectorBase>::set_settings_from_console() {
 	consoleArg.set_option_value("spgqpsolver_gamma", &this->gamma, SPGQPSOLVER_DEFAULT_GAMMA);	
 	consoleArg.set_option_value("spgqpsolver_sigma1", &this->sigma1, SPGQPSOLVER_DEFAULT_SIGMA1);	
 	consoleArg.set_option_value("spgqpsolver_sigma2", &this->sigma2, SPGQPSOLVER_DEFAULT_SIGMA2);	
-	consoleArg.set_option_value("spgqpsolver_alphainit", &this->alphainit, SPGQPSOLVER_DEFAULT_ALPHAINIT);	
+	this->alphainit_auto = !consoleArg.set_option_value("spgqpsolver_alphainit", &this->alphainit);
+	if(this->alphainit_auto){
+		this->alphainit = SPGQPSOLVER_DEFAULT_ALPHAINIT;
+	}
+	consoleArg.set_option_value("spgqpsolver_warmstart", &this->warmstart, SPGQPSOLVER_DEFAULT_WARMSTART);	
 
 	consoleArg.set_option_value("spgqpsolver_stop_normgp", &this->stop_normgp, SPGQPSOLVER_STOP_NORMGP);
 	consoleArg.set_option_value("spgqpsolver_stop_Anormgp", &this->stop_Anormgp, SPGQPSOLVER_STOP_ANORMGP);
@@ -227,6 +270,13 @@ SPGQPSolver<VectorBase>::SPGQPSolver(){
 	/* settings */
 	set_settings_from_console();
 
+	/* state from the end of last solution */
+	this->alpha_bb_last = this->alphainit;
+	this->fs_last.assign(this->m, std::numeric_limits<double>::max());
+
+	/* there is only one problem */
+	this->nmb_batch = 1;
+
 	/* prepare timers */
 	this->timer_solve.restart();	
 	this->timer_projection.restart();
@@ -259,6 +309,13 @@ SPGQPSolver<VectorBase>::SPGQPSolver(QPData<VectorBase> &new_qpdata){
 	/* settings */
 	set_settings_from_console();
 
+	/* state from the end of last solution */
+	this->alpha_bb_last = this->alphainit;
+	this->fs_last.assign(this->m, std::numeric_limits<double>::max());
+
+	/* there is only one problem */
+	this->nmb_batch = 1;
+
 	/* prepare timers */
 	this->timer_projection.restart();
 	this->timer_matmult.restart();
@@ -332,7 +389,9 @@ void SPGQPSolver<VectorBase>::print(ConsoleOutput &output) const {
 	output <<  " - gamma:      " << gamma << std::endl;
 	output <<  " - sigma1:     " << sigma1 << std::endl;
 	output <<  " - sigma2:     " << sigma2 << std::endl;
-	output <<  " - alphainit:  " << alphainit << std::endl;
+	output <<  " - alphainit:  " << alphainit << (alphainit_auto? " (1/lambda_max if available)" : "") << std::endl;
+	output <<  " - warmstart:  " << warmstart << std::endl;
+	output <<  " - nmb_batch:  " << nmb_batch << std::endl;
 	
 	/* print data */
 	if(qpdata){
@@ -361,7 +420,9 @@ void SPGQPSolver<VectorBase>::print(ConsoleOutput &output_global, ConsoleOutput
 	output_local <<  " - gamma:      " << gamma << std::endl;
 	output_local <<  " - sigma1:     " << sigma1 << std::endl;
 	output_local <<  " - sigma2:     " << sigma2 << std::endl;
-	output_local <<  " - alphainit:  " << alphainit << std::endl;
+	output_local <<  " - alphainit:  " << alphainit << (alphainit_auto? " (1/lambda_max if available)" : "") << std::endl;
+	output_local <<  " - warmstart:  " << warmstart << std::endl;
+	output_local <<  " - nmb_batch:  " << nmb_batch << std::endl;
 
 	output_local.synchronize();
 	
@@ -452,6 +513,11 @@ void SPGQPSolver<VectorBase>::printtimer(ConsoleOutput &output) const {
 	output <<  "  - t_fs =         " << this->timer_fs.get_value_sum() << std::endl;
 	output <<  "  - t_other =      " << this->timer_solve.get_value_sum() - (this->timer_projection.get_value_sum() + this->timer_matmult.get_value_sum() + this->timer_dot.get_value_sum() + this->timer_update.get_value_sum() + this->timer_stepsize.get_value_sum() + this->timer_fs.get_value_sum()) << std::endl;
 
+	/* hardware counters */
+	const char *timers_name[5] = {"t_solve:", "t_project:", "t_matmult:", "t_dot:", "t_update:"};
+	const Timer *timers[5] = {&this->timer_solve, &this->timer_projection, &this->timer_matmult, &this->timer_dot, &this->timer_update};
+	this->printtimer_counters(output, 5, timers_name, timers);
+
 	LOG_FUNC_END
 }
 
@@ -608,8 +674,11 @@ void SPGQPSolver<VectorBase>::solve() {
 	double alpha_bb; /* BB step-size */
 	double normb = norm(b); /* norm of linear term used in stopping criteria */
 
-	/* initial step-size */
-	alpha_bb = this->alphainit;
+	/* initial step-size, continue with the last one if it is possible */
+	alpha_bb = get_alphainit();
+	if(this->warmstart && this->alpha_bb_last > 0 && this->alpha_bb_last < std::numeric_limits<double>::max()){
+		alpha_bb = this->alpha_bb_last;
+	}
 
 	//TODO: temp!
 	x = x0; /* set approximation as initial */
@@ -794,6 +863,10 @@ void SPGQPSolver<VectorBase>::solve() {
 	this->it_last = it;
 	this->hessmult_last = hessmult;
 
+	/* store the state for next solution and checkpoints */
+	this->alpha_bb_last = alpha_bb;
+	fs.get_values(&(this->fs_last[0]));
+
 	this->fx = fx;
 	this->timer_solve.stop();
 
@@ -804,6 +877,40 @@ void SPGQPSolver<VectorBase>::solve() {
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+double SPGQPSolver<VectorBase>::get_alphainit() const {
+	double alpha = this->alphainit;
+
+	if(this->alphainit_auto){
+		double lambda_max = qpdata->get_A()->get_lambda_max();
+		if(lambda_max > 0.0){
+			alpha = 1.0/lambda_max;
+		}
+	}
+
+	return alpha;
+}
+
+template<class VectorBase>
+void SPGQPSolver<VectorBase>::set_batch(int nmb_batch, const std::vector<int> &batch_local) {
+	LOG_FUNC_BEGIN
+
+	this->nmb_batch = nmb_batch;
+	this->batch_local = batch_local;
+	this->alpha_bb_batch_last.assign(nmb_batch, this->alphainit);
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void SPGQPSolver<VectorBase>::solve_batch() {
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
 /* compute function value using inner *x and already computed *g */
 template<class VectorBase>
 double SPGQPSolver<VectorBase>::get_fx() const {
@@ -841,6 +948,46 @@ double SPGQPSolver<VectorBase>::get_fx(double fx_old, double beta, double gd, do
 	return fx;	
 }
 
+/* state: [it_sum, hessmult_sum, alpha_bb_last, fs_last, alpha_bb_batch_last] */
+template<class VectorBase>
+int SPGQPSolver<VectorBase>::get_state_size() const {
+	return 3 + this->m + this->alpha_bb_batch_last.size();
+}
+
+template<class VectorBase>
+void SPGQPSolver<VectorBase>::get_state(double *state) const {
+	LOG_FUNC_BEGIN
+
+	state[0] = this->it_sum;
+	state[1] = this->hessmult_sum;
+	state[2] = this->alpha_bb_last;
+	for(int i=0;i<this->m;i++){
+		state[3+i] = this->fs_last[i];
+	}
+	for(int b=0;b<(int)this->alpha_bb_batch_last.size();b++){
+		state[3+this->m+b] = this->alpha_bb_batch_last[b];
+	}
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+void SPGQPSolver<VectorBase>::set_state(const double *state) {
+	LOG_FUNC_BEGIN
+
+	this->it_sum = (int)state[0];
+	this->hessmult_sum = (int)state[1];
+	this->alpha_bb_last = state[2];
+	for(int i=0;i<this->m;i++){
+		this->fs_last[i] = state[3+i];
+	}
+	for(int b=0;b<(int)this->alpha_bb_batch_last.size();b++){
+		this->alpha_bb_batch_last[b] = state[3+this->m+b];
+	}
+
+	LOG_FUNC_END
+}
+
 /* compute dot products */
 template<class VectorBase>
 void SPGQPSolver<VectorBase>::compute_dots(double *dd, double *dAd, double *gd) const {
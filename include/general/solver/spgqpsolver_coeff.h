@@ -118,6 +118,7 @@ class SPGQPSolverC: public QPSolver<VectorBase> {
 		double sigma1;				/**< to enforce progress */
 		double sigma2;				/**< to enforce progress */
 		double alphainit;			/** initial step-size */
+		bool alphainit_auto;		/**< initial step-size was not given, use 1/lambda_max of Hessian matrix */
 
 		QPData<VectorBase> *qpdata; /**< data on which the solver operates */
 		double gP; 					/**< norm of projected gradient */
@@ -212,7 +213,10 @@ void SPGQPSolverC<VectorBase>::set_settings_from_console() {
 	consoleArg.set_option_value("spgqpsolver_gamma", &this->gamma, SPGQPSOLVER_COEFF_DEFAULT_GAMMA);	
 	consoleArg.set_option_value("spgqpsolver_sigma1", &this->sigma1, SPGQPSOLVER_COEFF_DEFAULT_SIGMA1);	
 	consoleArg.set_option_value("spgqpsolver_sigma2", &this->sigma2, SPGQPSOLVER_COEFF_DEFAULT_SIGMA2);	
-	consoleArg.set_option_value("spgqpsolver_alphainit", &this->alphainit, SPGQPSOLVER_COEFF_DEFAULT_ALPHAINIT);	
+	this->alphainit_auto = !consoleArg.set_option_value("spgqpsolver_alphainit", &this->alphainit);
+	if(this->alphainit_auto){
+		this->alphainit = SPGQPSOLVER_COEFF_DEFAULT_ALPHAINIT;
+	}
 
 	consoleArg.set_option_value("spgqpsolver_stop_normgp", &this->stop_normgp, SPGQPSOLVER_COEFF_STOP_NORMGP);
 	consoleArg.set_option_value("spgqpsolver_stop_Anormgp", &this->stop_Anormgp, SPGQPSOLVER_COEFF_STOP_ANORMGP);
@@ -489,6 +493,11 @@ void SPGQPSolverC<VectorBase>::printtimer(ConsoleOutput &output) const {
 	output <<  "  - t_fs =         " << this->timer_fs.get_value_sum() << std::endl;
 	output <<  "  - t_other =      " << this->timer_solve.get_value_sum() - (this->timer_projection.get_value_sum() + this->timer_matmult.get_value_sum() + this->timer_dot.get_value_sum() + this->timer_update.get_value_sum() + this->timer_stepsize.get_value_sum() + this->timer_fs.get_value_sum()) << std::endl;
 
+	/* hardware counters */
+	const char *timers_name[5] = {"t_solve:", "t_project:", "t_matmult:", "t_dot:", "t_update:"};
+	const Timer *timers[5] = {&this->timer_solve, &this->timer_projection, &this->timer_matmult, &this->timer_dot, &this->timer_update};
+	this->printtimer_counters(output, 5, timers_name, timers);
+
 	LOG_FUNC_END
 }
 
@@ -655,8 +664,11 @@ void SPGQPSolverC<VectorBase>::solve() {
 	double alpha_bb; /* BB step-size */
 	double normb = norm(b); /* norm of linear term used in stopping criteria */
 
-	/* initial step-size */
+	/* initial step-size, 1/lambda_max if it was not given */
 	alpha_bb = this->alphainit;
+	if(this->alphainit_auto && A.get_lambda_max() > 0.0){
+		alpha_bb = 1.0/A.get_lambda_max();
+	}
 
 	x = x0; /* set approximation as initial */
 
@@ -7,6 +7,8 @@
 #ifndef PASC_TSSOLVER_H
 #define	PASC_TSSOLVER_H
 
+#include <stdint.h>
+
 #include "general/data/tsdata.h"
 #include "general/model/tsmodel.h"
 
@@ -14,6 +16,28 @@
 #define TSSOLVER_DEFAULT_EPS 1e-6
 #define TSSOLVER_DEFAULT_INIT_PERMUTE true
 
+#define TSSOLVER_DEFAULT_INIT_KMEANS false
+#define TSSOLVER_DEFAULT_INIT_KMEANS_LLOYD 5
+#define TSSOLVER_DEFAULT_INIT_KMEANS_SOFTNESS 0.1
+#define TSSOLVER_DEFAULT_INIT_KMEANS_SEED 0
+
+#define TSSOLVER_DEFAULT_ACCELERATE false
+#define TSSOLVER_DEFAULT_ACCELERATE_BETA 0.5
+#define TSSOLVER_DEFAULT_ACCELERATE_BETA_MAX 2.0
+
+#define TSSOLVER_DEFAULT_INEXACT false
+#define TSSOLVER_DEFAULT_INEXACT_SCALE 1e3
+#define TSSOLVER_DEFAULT_INEXACT_RATE 0.5 /**< with INEXACT_SCALE 1e3 the inner solves are inexact at most ~10 outer iterations */
+#define TSSOLVER_DEFAULT_INEXACT_COEFF 1.0
+#define TSSOLVER_DEFAULT_INEXACT_MAXIT 100
+
+#define TSSOLVER_DEFAULT_CHECKPOINT_FILENAME ""
+#define TSSOLVER_DEFAULT_CHECKPOINT_EVERY 10
+#define TSSOLVER_DEFAULT_CHECKPOINT_RESTART false
+
+#define TSSOLVER_CHECKPOINT_MAGIC "PASCCHK1"
+#define TSSOLVER_CHECKPOINT_VERSION 1
+
 #define TSSOLVER_DEFAULT_DEBUGMODE 0
 
 #define TSSOLVER_DUMP false
@@ -22,6 +46,34 @@
 namespace pascinference {
 namespace solver {
 
+/** \struct TSSolverCheckpointHeader
+ *  \brief header of checkpoint file
+ *
+ *  The header is followed by gamma, gamma_temp (only if annealing is used), theta, theta_temp (only if annealing is used),
+ *  the state of gammasolver and the state of thetasolver. Gamma is stored in the layout of decomposition.
+*/
+struct TSSolverCheckpointHeader {
+	char magic[8];				/**< TSSOLVER_CHECKPOINT_MAGIC */
+	int32_t version;			/**< TSSOLVER_CHECKPOINT_VERSION */
+	int32_t nproc;				/**< number of processes, the layout of gamma depends on it */
+	int32_t id;					/**< identification of solved problem provided by user (for example index of epssqr) */
+	int32_t finished;			/**< the solution of this problem is finished */
+	int32_t it_annealing;		/**< actual annealing step */
+	int32_t it;					/**< the number of finished outer iterations in actual annealing step */
+	int32_t it_sum;				/**< sum of iterations from previous annealing steps */
+	int32_t it_gammasolver;		/**< iterations of gammasolver in actual annealing step */
+	int32_t it_thetasolver;		/**< iterations of thetasolver in actual annealing step */
+	int32_t has_temp;			/**< the best annealing state is stored */
+	int32_t gammastate_size;	/**< the length of gammasolver state */
+	int32_t thetastate_size;	/**< the length of thetasolver state */
+	int64_t gamma_size;			/**< global length of gamma vector */
+	int64_t theta_size;			/**< length of theta vector */
+	double L;					/**< function value in actual annealing step */
+	double L_best;				/**< function value of the best annealing state */
+	double deltaL_best;			/**< stopping criteria of the best annealing state */
+	double aic;					/**< AIC of the best annealing state */
+};
+
 /** \class TSSolver
  *  \brief for solving time-series problems
  *
@@ -57,8 +109,15 @@ class TSSolver: public GeneralSolver {
 		Timer timer_theta_solve; /**< timer for solving theta problem */
 		Timer timer_gamma_update; /**< timer for updating gamma problem */
 		Timer timer_theta_update; /**< timer for updating theta problem */
+		Timer timer_checkpoint; /**< timer for storing checkpoints */
+		Timer timer_accelerate; /**< timer for extrapolation of outer iterations */
 
 		bool init_permute;					/**< permute initial approximation or not */
+		bool init_kmeans;					/**< initial gamma and gamma in annealing steps from k-means of data instead of random */
+		int init_kmeans_lloyd;				/**< number of Lloyd iterations in k-means initialization */
+		double init_kmeans_softness;		/**< softening of one-hot gamma from k-means */
+		int init_kmeans_seed;				/**< seed of k-means++, annealing step is added to obtain different initial approximations */
+		bool init_kmeans_done;				/**< k-means initialization was already used in some solve(), the next solve() starts from the previous solution */
 		int debugmode;						/**< basic debug mode schema [0/1/2/3] */
 		bool debug_print_annealing;			/**< print info about annealing steps */
 		bool debug_print_it;				/**< print simple info about outer iterations */
@@ -67,10 +126,62 @@ class TSSolver: public GeneralSolver {
 		bool debug_print_gamma;				/**< print gamma solver info */
 		bool debug_print_gamma_solution;	/**< print solution of gamma problem in each iteration */
 
+		/* acceleration of outer iterations */
+		bool accelerate;					/**< extrapolate gamma between outer iterations */
+		double accelerate_beta_init;		/**< initial extrapolation coefficient */
+		double accelerate_beta_max;			/**< maximum extrapolation coefficient */
+		int accelerate_nmb_accepted;		/**< number of accepted extrapolated steps */
+		int accelerate_nmb_rejected;		/**< number of extrapolated steps replaced by plain step */
+
+		/** @brief extrapolate gamma from previous iterate, gamma = gamma + beta*(gamma - gamma_prev)
+		*
+		* The coefficient is reduced to keep gamma nonnegative, the sum of components in every row is not changed.
+		* @param gammavector_prev previous iterate
+		* @param beta required extrapolation coefficient
+		* @return used extrapolation coefficient
+		*/
+		double extrapolate_gamma(GeneralVector<VectorBase> *gammavector_prev, double beta);
+
+		/* inexact solution of inner problems */
+		bool inexact;						/**< loosen tolerances of inner solvers while outer iterations are far from solution */
+		double inexact_scale_max;			/**< the maximum ratio of inner tolerance and required inner tolerance */
+		double inexact_rate;				/**< the ratio decreases at least by this factor in every outer iteration */
+		double inexact_coeff;				/**< the ratio is at most inexact_coeff*deltaL/eps */
+		int inexact_maxit;					/**< maximum number of inner iterations in the first inexact solution, it is doubled in every outer iteration */
+		int inexact_nmb_tightened;			/**< number of outer iterations where function increased and exact inner solves were enforced */
+
 		/* temp vectors for annealing */
 		GeneralVector<VectorBase> *gammavector_temp;
 		GeneralVector<VectorBase> *thetavector_temp;
 
+		/* checkpoints */
+		std::string checkpoint_filename;	/**< name of checkpoint file, empty if checkpoints are not stored */
+		int checkpoint_every;				/**< store checkpoint every N outer iterations */
+		bool checkpoint_restart;			/**< restore the state from checkpoint at the begining of solution with the same id */
+		int checkpoint_id;					/**< identification of solved problem stored into checkpoint */
+		int checkpoint_nsaved;				/**< number of stored checkpoints */
+
+		TSSolverCheckpointHeader checkpoint_loaded; /**< header of restored checkpoint */
+
+		/** @brief store the state of solver into checkpoint file
+		*
+		* The file is written into temporary file, which replaces the old checkpoint after it is complete.
+		*/
+		void save_checkpoint(bool finished, int it_annealing, int it, double L, int it_gammasolver, int it_thetasolver);
+
+		/** @brief restore the state of solver from checkpoint file
+		*
+		* The values of iteration counters from checkpoint are stored in checkpoint_loaded.
+		* @return false if there is no valid checkpoint for actual checkpoint_id
+		*/
+		bool load_checkpoint();
+
+		/** @brief read and check the header of checkpoint file
+		*
+		* @return false if the file does not exist or it does not match actual problem
+		*/
+		bool read_checkpoint_header(TSSolverCheckpointHeader *header) const;
+
 		void prepare_temp_annealing();
 		void destroy_temp_annealing();
 		void set_settings_from_console();
@@ -92,6 +203,7 @@ class TSSolver: public GeneralSolver {
 		virtual void printshort(std::ostringstream &header, std::ostringstream &values) const;
 		virtual void printshort_sum(std::ostringstream &header, std::ostringstream &values) const;
 		virtual std::string get_name() const;
+		virtual int get_it() const;
 
 		virtual TSData<VectorBase> *get_data() const;
 
@@ -100,8 +212,27 @@ class TSSolver: public GeneralSolver {
 
 		void set_solution_theta(double *Theta);
 		void set_annealing(int annealing);
+
+		/** @brief set if the initial approximation of gamma should be permuted subject to decomposition
+		*
+		* Gamma from previous solution is already permuted, therefore the permutation has to be switched off for warm start.
+		*/
+		void set_init_permute(bool init_permute);
 		
 		double get_L() const;
+
+		/** @brief set the identification of solved problem, it is stored into checkpoint
+		*
+		* @param id for example the index of actual epssqr
+		*/
+		void set_checkpoint_id(int id);
+		int get_checkpoint_id() const;
+
+		/** @brief get the identification of problem stored in checkpoint file
+		*
+		* @return -1 if restart is not required or checkpoint file is not valid
+		*/
+		int get_checkpoint_restart_id() const;
 };
 
 
@@ -122,6 +253,24 @@ void TSSolver<VectorBase>::set_settings_from_console(){
 	consoleArg.set_option_value("tssolver_maxit", &this->maxit, TSSOLVER_DEFAULT_MAXIT);
 	consoleArg.set_option_value("tssolver_eps", &this->eps, TSSOLVER_DEFAULT_EPS);
 	consoleArg.set_option_value("tssolver_init_permute", &this->init_permute, TSSOLVER_DEFAULT_INIT_PERMUTE);
+	consoleArg.set_option_value("tssolver_init_kmeans", &this->init_kmeans, TSSOLVER_DEFAULT_INIT_KMEANS);
+	consoleArg.set_option_value("tssolver_init_kmeans_lloyd", &this->init_kmeans_lloyd, TSSOLVER_DEFAULT_INIT_KMEANS_LLOYD);
+	consoleArg.set_option_value("tssolver_init_kmeans_softness", &this->init_kmeans_softness, TSSOLVER_DEFAULT_INIT_KMEANS_SOFTNESS);
+	consoleArg.set_option_value("tssolver_init_kmeans_seed", &this->init_kmeans_seed, TSSOLVER_DEFAULT_INIT_KMEANS_SEED);
+
+	consoleArg.set_option_value("tssolver_accelerate", &this->accelerate, TSSOLVER_DEFAULT_ACCELERATE);
+	consoleArg.set_option_value("tssolver_accelerate_beta", &this->accelerate_beta_init, TSSOLVER_DEFAULT_ACCELERATE_BETA);
+	consoleArg.set_option_value("tssolver_accelerate_beta_max", &this->accelerate_beta_max, TSSOLVER_DEFAULT_ACCELERATE_BETA_MAX);
+
+	consoleArg.set_option_value("tssolver_inexact", &this->inexact, TSSOLVER_DEFAULT_INEXACT);
+	consoleArg.set_option_value("tssolver_inexact_scale", &this->inexact_scale_max, TSSOLVER_DEFAULT_INEXACT_SCALE);
+	consoleArg.set_option_value("tssolver_inexact_rate", &this->inexact_rate, TSSOLVER_DEFAULT_INEXACT_RATE);
+	consoleArg.set_option_value("tssolver_inexact_coeff", &this->inexact_coeff, TSSOLVER_DEFAULT_INEXACT_COEFF);
+	consoleArg.set_option_value("tssolver_inexact_maxit", &this->inexact_maxit, TSSOLVER_DEFAULT_INEXACT_MAXIT);
+
+	consoleArg.set_option_value("tssolver_checkpoint_filename", &this->checkpoint_filename, TSSOLVER_DEFAULT_CHECKPOINT_FILENAME);
+	consoleArg.set_option_value("tssolver_checkpoint_every", &this->checkpoint_every, TSSOLVER_DEFAULT_CHECKPOINT_EVERY);
+	consoleArg.set_option_value("tssolver_checkpoint_restart", &this->checkpoint_restart, TSSOLVER_DEFAULT_CHECKPOINT_RESTART);
 
 	consoleArg.set_option_value("tssolver_dump", &this->dump_or_not, TSSOLVER_DUMP);	
 
@@ -191,9 +340,28 @@ TSSolver<VectorBase>::TSSolver(){
 	this->timer_theta_solve.restart();
 	this->timer_gamma_update.restart();
 	this->timer_theta_update.restart();
+	this->timer_checkpoint.restart();
+	this->timer_accelerate.restart();
+
+	/* peak memory of phases (only with timer_memory) */
+	this->timer_solve.set_memory_tracking(true);
+	this->timer_gamma_solve.set_memory_tracking(true);
+	this->timer_theta_solve.set_memory_tracking(true);
+	this->timer_gamma_update.set_memory_tracking(true);
+	this->timer_theta_update.set_memory_tracking(true);
+	this->timer_checkpoint.set_memory_tracking(true);
+	this->timer_accelerate.set_memory_tracking(true);
+
+	this->accelerate_nmb_accepted = 0;
+	this->accelerate_nmb_rejected = 0;
+	this->inexact_nmb_tightened = 0;
+
+	this->checkpoint_id = 0;
+	this->checkpoint_nsaved = 0;
 
 	this->gammasolved = false;
 	this->thetasolved = false;
+	this->init_kmeans_done = false;
 
 	LOG_FUNC_END
 }
@@ -238,9 +406,28 @@ TSSolver<VectorBase>::TSSolver(TSData<VectorBase> &new_tsdata, int annealing){
 	this->timer_theta_solve.restart();
 	this->timer_gamma_update.restart();
 	this->timer_theta_update.restart();
+	this->timer_checkpoint.restart();
+	this->timer_accelerate.restart();
+
+	/* peak memory of phases (only with timer_memory) */
+	this->timer_solve.set_memory_tracking(true);
+	this->timer_gamma_solve.set_memory_tracking(true);
+	this->timer_theta_solve.set_memory_tracking(true);
+	this->timer_gamma_update.set_memory_tracking(true);
+	this->timer_theta_update.set_memory_tracking(true);
+	this->timer_checkpoint.set_memory_tracking(true);
+	this->timer_accelerate.set_memory_tracking(true);
+
+	this->accelerate_nmb_accepted = 0;
+	this->accelerate_nmb_rejected = 0;
+	this->inexact_nmb_tightened = 0;
+
+	this->checkpoint_id = 0;
+	this->checkpoint_nsaved = 0;
 
 	this->gammasolved = false;
 	this->thetasolved = false;
+	this->init_kmeans_done = false;
 
 	LOG_FUNC_END
 }
@@ -275,6 +462,10 @@ void TSSolver<VectorBase>::print(ConsoleOutput &output) const {
 	output <<  " - eps:          " << this->eps << std::endl;
 	output <<  " - debugmode:   " << this->debugmode << std::endl;
 	output <<  " - init_permute: " << this->init_permute << std::endl;
+	output <<  " - init_kmeans:  " << this->init_kmeans << " (lloyd " << this->init_kmeans_lloyd << ", softness " << this->init_kmeans_softness << ", seed " << this->init_kmeans_seed << ")" << std::endl;
+	output <<  " - accelerate:   " << this->accelerate << " (beta " << this->accelerate_beta_init << ", beta_max " << this->accelerate_beta_max << ")" << std::endl;
+	output <<  " - inexact:      " << this->inexact << " (scale " << this->inexact_scale_max << ", rate " << this->inexact_rate << ", coeff " << this->inexact_coeff << ", maxit " << this->inexact_maxit << ")" << std::endl;
+	output <<  " - checkpoint:   " << this->checkpoint_filename << " (every " << this->checkpoint_every << ", restart " << this->checkpoint_restart << ")" << std::endl;
 
 	/* print data */
 	if(tsdata){
@@ -317,7 +508,11 @@ void TSSolver<VectorBase>::print(ConsoleOutput &output_global, ConsoleOutput &ou
 	output_global <<  " - eps:          " << this->eps << std::endl;
 	output_global <<  " - debugmode:   " << this->debugmode << std::endl;
 	output_global <<  " - init_permute: " << this->init_permute << std::endl;
+	output_global <<  " - init_kmeans:  " << this->init_kmeans << " (lloyd " << this->init_kmeans_lloyd << ", softness " << this->init_kmeans_softness << ", seed " << this->init_kmeans_seed << ")" << std::endl;
 	output_global <<  " - annealing:    " << this->annealing << std::endl;
+	output_global <<  " - accelerate:   " << this->accelerate << " (beta " << this->accelerate_beta_init << ", beta_max " << this->accelerate_beta_max << ")" << std::endl;
+	output_global <<  " - inexact:      " << this->inexact << " (scale " << this->inexact_scale_max << ", rate " << this->inexact_rate << ", coeff " << this->inexact_coeff << ", maxit " << this->inexact_maxit << ")" << std::endl;
+	output_global <<  " - checkpoint:   " << this->checkpoint_filename << " (every " << this->checkpoint_every << ", restart " << this->checkpoint_restart << ")" << std::endl;
 
 	/* print data */
 	if(tsdata){
@@ -409,8 +604,46 @@ void TSSolver<VectorBase>::printtimer(ConsoleOutput &output) const {
 	output <<  "  - t_gamma_solve =  " << std::setw(25)  << this->timer_gamma_solve.get_value_sum() << std::endl;
 	output <<  "  - t_theta_update = " << std::setw(25) << this->timer_theta_update.get_value_sum() << std::endl;
 	output <<  "  - t_theta_solve =  " << std::setw(25) << this->timer_theta_solve.get_value_sum() << std::endl;
+	output <<  "  - t_checkpoint =   " << std::setw(25) << this->timer_checkpoint.get_value_sum() << " (" << this->checkpoint_nsaved << " checkpoints)" << std::endl;
+	output <<  "  - t_accelerate =   " << std::setw(25) << this->timer_accelerate.get_value_sum() << " (" << this->accelerate_nmb_accepted << " accepted, " << this->accelerate_nmb_rejected << " rejected)" << std::endl;
+	output <<  " - inexact tight =   " << std::setw(25) << this->inexact_nmb_tightened << std::endl;
 	output << std::setprecision(ss);
 
+	/* peak resident memory of phases, maximum and sum over ranks */
+	if(Timer::get_memory_enabled()){
+		const int phases_nmb = 7;
+		const Timer *phases_timer[phases_nmb] = {&timer_solve, &timer_gamma_update, &timer_gamma_solve, &timer_theta_update, &timer_theta_solve, &timer_checkpoint, &timer_accelerate};
+		const char *phases_name[phases_nmb] = {"t_solve", "t_gamma_update", "t_gamma_solve", "t_theta_update", "t_theta_solve", "t_checkpoint", "t_accelerate"};
+
+		double phases_peak[phases_nmb];
+		double phases_peak_max[phases_nmb];
+		double phases_peak_min[phases_nmb];
+		double phases_peak_sum[phases_nmb];
+		for(int i=0;i<phases_nmb;i++){
+			phases_peak[i] = phases_timer[i]->get_memory_peak()/(1024.0*1024.0);
+		}
+		MPI_Allreduce(phases_peak, phases_peak_max, phases_nmb, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+		MPI_Allreduce(phases_peak, phases_peak_min, phases_nmb, MPI_DOUBLE, MPI_MIN, PETSC_COMM_WORLD);
+		MPI_Allreduce(phases_peak, phases_peak_sum, phases_nmb, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+		/* negative peak on some rank: VmHWM could not be reset (/proc/self/clear_refs), the peak of phase is not known */
+		output <<  " - peak memory [MB] (max over ranks, sum over ranks)" << std::endl;
+		for(int i=0;i<phases_nmb;i++){
+			output <<  "  - " << std::setw(16) << std::left << phases_name[i] << std::right << " ";
+			if(phases_peak_min[i] < 0){
+				output << std::setw(12) << "n/a" << ", " << std::setw(12) << "n/a" << std::endl;
+			} else {
+				output << std::setw(12) << phases_peak_max[i] << ", " << std::setw(12) << phases_peak_sum[i] << std::endl;
+			}
+		}
+
+		/* memory registered by objects on each rank */
+		output <<  " - registered memory" << std::endl;
+		coutAll <<  "  - rank " << GlobalManager.get_rank() << ": VmRSS = " << MemoryCheck::get_process_rss()/(1024.0*1024.0) << " MB" << std::endl;
+		MemoryCheck::print_owned(coutAll);
+		coutAll.synchronize();
+	}
+
 	output <<  " Gamma Solver" << std::endl;
 	if(gammasolver){
 		coutMaster.push();
@@ -462,6 +695,11 @@ void TSSolver<VectorBase>::printshort_sum(std::ostringstream &header, std::ostri
 
 	header << "t theta solve, ";
 	values << this->timer_theta_solve.get_value_sum() << ", ";
+
+	if(this->accelerate){
+		header << "t accelerate, accelerate accepted, accelerate rejected, ";
+		values << this->timer_accelerate.get_value_sum() << ", " << this->accelerate_nmb_accepted << ", " << this->accelerate_nmb_rejected << ", ";
+	}
 	
 	/* from best annealing step: */
 	header << gammasolver_shortinfo_header.str();
@@ -481,11 +719,21 @@ std::string TSSolver<VectorBase>::get_name() const {
 	return return_value;
 }
 
+template<class VectorBase>
+int TSSolver<VectorBase>::get_it() const {
+	return this->it_last;
+}
+
 template<class VectorBase>
 void TSSolver<VectorBase>::set_annealing(int annealing) {
 	this->annealing = annealing;
 }
 
+template<class VectorBase>
+void TSSolver<VectorBase>::set_init_permute(bool init_permute) {
+	this->init_permute = init_permute;
+}
+
 
 /* solve the problem */
 template<class VectorBase>
@@ -517,15 +765,72 @@ void TSSolver<VectorBase>::solve() {
 		prepare_temp_annealing();
 	}
 
+	/* vectors for extrapolation of outer iterations */
+	GeneralVector<VectorBase> *gammavector_prev = NULL;
+	GeneralVector<VectorBase> *gammavector_plain = NULL;
+	GeneralVector<VectorBase> *thetavector_plain = NULL; /* theta computed together with gammavector_plain */
+	bool use_accelerate = (this->accelerate && !gammasolved);
+	if(use_accelerate){
+		gammavector_prev = new GeneralVector<VectorBase>(*(tsdata->get_gammavector()));
+		gammavector_plain = new GeneralVector<VectorBase>(*(tsdata->get_gammavector()));
+		thetavector_plain = new GeneralVector<VectorBase>(*(tsdata->get_thetavector()));
+	}
+	double accelerate_beta;
+	double L_plain;
+
+	/* the last iterate computed with decrease of L, the step with inexact inner solves which increased L is repeated from it with exact solves */
+	GeneralVector<VectorBase> *gammavector_accepted = NULL;
+	GeneralVector<VectorBase> *thetavector_accepted = NULL;
+	bool use_rollback = (this->inexact && !gammasolved && !thetasolved);
+	if(use_rollback){
+		gammavector_accepted = new GeneralVector<VectorBase>(*(tsdata->get_gammavector()));
+		thetavector_accepted = new GeneralVector<VectorBase>(*(tsdata->get_thetavector()));
+	}
+	bool have_accepted;
+
+	/* tolerances of inner solvers required by user, inexact solutions use scaled tolerances */
+	double gamma_eps_exact = gammasolver->get_eps();
+	int gamma_maxit_exact = gammasolver->get_maxit();
+	double theta_eps_exact = thetasolver->get_eps();
+	int theta_maxit_exact = thetasolver->get_maxit();
+	double inexact_scale;
+	int inexact_maxit_it;
+	bool have_prev;
+	bool extrapolated;
+
+	/* restore the state from checkpoint, the annealing step from checkpoint will continue */
+	bool resumed = false;
+	int it_annealing_begin = 0;
+	if(this->checkpoint_restart){
+		if(load_checkpoint()){
+			resumed = true;
+			it_annealing_begin = (this->checkpoint_loaded.finished)? this->annealing : this->checkpoint_loaded.it_annealing;
+			this->checkpoint_restart = false;
+
+			coutMaster << "- solver state restored from " << this->checkpoint_filename << ": id = " << this->checkpoint_id << ", annealing = " << this->checkpoint_loaded.it_annealing << ", it = " << this->checkpoint_loaded.it << std::endl;
+		}
+	}
+
 	/* annealing cycle */
 	coutMaster.push();
-	for(it_annealing=0;it_annealing < this->annealing;it_annealing++){
+	for(it_annealing=it_annealing_begin;it_annealing < this->annealing;it_annealing++){
 		if(debug_print_annealing){
 			coutMaster <<  "- annealing = " << it_annealing << std::endl;
 		}
-		
-		/* permute initial approximation subject to decomposition */
-		if(this->init_permute){
+
+		bool resumed_annealing = (resumed && it_annealing == it_annealing_begin);
+
+		/* initial approximation from k-means is computed directly in layout of decomposition, different seed in every annealing step;
+		 * the first annealing step of next solve() (next epssqr) starts from the previous solution */
+		if(this->init_kmeans && !gammasolved && !resumed_annealing && (it_annealing > 0 || !this->init_kmeans_done)){
+			this->timer_gamma_update.start();
+			tsdata->init_gammavector_kmeans(this->init_kmeans_seed + it_annealing, this->init_kmeans_lloyd, this->init_kmeans_softness);
+			this->timer_gamma_update.stop();
+			this->init_kmeans_done = true;
+		}
+
+		/* permute initial approximation subject to decomposition, restored gamma and gamma from k-means are already permuted */
+		if(this->init_permute && (gammasolved || !this->init_kmeans) && !resumed_annealing){
 			gammavector_permute();
 		}
 		
@@ -535,15 +840,60 @@ void TSSolver<VectorBase>::solve() {
 
 		/* initialize value of object function */
 		L = std::numeric_limits<double>::max(); // TODO: the computation of L should be done in the different way
+
+		/* continue with restored iterations */
+		int it_begin = 0;
+		if(resumed_annealing){
+			it_gammasolver = this->checkpoint_loaded.it_gammasolver;
+			it_thetasolver = this->checkpoint_loaded.it_thetasolver;
+			L = this->checkpoint_loaded.L;
+			it_begin = this->checkpoint_loaded.it;
+		}
 		deltaL = L;
 
+		/* restart the extrapolation in every annealing step */
+		accelerate_beta = this->accelerate_beta_init;
+		have_prev = false;
+		extrapolated = false;
+		have_accepted = false;
+
+		/* start with the loosest inner tolerances */
+		inexact_scale = (this->inexact)? this->inexact_scale_max : 1.0;
+		inexact_maxit_it = this->inexact_maxit;
+
 		/* main cycle */
 		coutMaster.push();
-		for(it=0;it < this->maxit;it++){
+		for(it=it_begin;it < this->maxit;it++){
 			if(debug_print_it){
 				coutMaster <<  "it = " << it << std::endl;
 			}
 
+			/* tolerances of inner solvers are tightened geometrically and with the decrease of deltaL */
+			if(this->inexact){
+				if(it > it_begin){
+					inexact_scale = std::min(inexact_scale*this->inexact_rate, this->inexact_coeff*deltaL/this->eps);
+					/* the limit is doubled only up to maxit of exact solvers to avoid overflow */
+					inexact_maxit_it = std::min(2*inexact_maxit_it, std::max(gamma_maxit_exact, theta_maxit_exact));
+				}
+				inexact_scale = std::max(inexact_scale, 1.0);
+
+				if(inexact_scale > 1.0){
+					gammasolver->set_eps(inexact_scale*gamma_eps_exact);
+					gammasolver->set_maxit(std::min(inexact_maxit_it, gamma_maxit_exact));
+					thetasolver->set_eps(inexact_scale*theta_eps_exact);
+					thetasolver->set_maxit(std::min(inexact_maxit_it, theta_maxit_exact));
+				} else {
+					gammasolver->set_eps(gamma_eps_exact);
+					gammasolver->set_maxit(gamma_maxit_exact);
+					thetasolver->set_eps(theta_eps_exact);
+					thetasolver->set_maxit(theta_maxit_exact);
+				}
+
+				if(debug_print_it){
+					coutMaster <<  " - inner tolerance scale = " << inexact_scale << std::endl;
+				}
+			}
+
 			/* --- COMPUTE Theta --- */
 			if(!thetasolved){
 				this->timer_theta_update.start();
@@ -633,23 +983,107 @@ void TSSolver<VectorBase>::solve() {
 				coutMaster << "L - L_old = " << std::setw(12) << L - L_old << std::endl;
 			}
 
-			//TODO: temp, throw exception!
-			if(L - L_old > 0){
-				coutMaster << "ERROR: objective function increased" << std::endl;
+			/* the step was rejected, the solver returned to the previous iterate and the next iteration repeats the step */
+			bool rejected = false;
+
+			/* safeguard of extrapolation: if the function value increased, return to the plain step */
+			if(extrapolated){
+				extrapolated = false;
+
+				if(L > L_plain){
+					this->timer_accelerate.start();
+					 *(tsdata->get_gammavector()) = *gammavector_plain;
+					 *(tsdata->get_thetavector()) = *thetavector_plain;
+					this->timer_accelerate.stop();
+
+					if(debug_print_it){
+						coutMaster << "  - extrapolation rejected, beta = " << accelerate_beta << std::endl;
+					}
+
+					L = L_plain;
+					accelerate_beta *= 0.5;
+					this->accelerate_nmb_rejected++;
+					rejected = true;
+				} else {
+					accelerate_beta = std::min(1.5*accelerate_beta, this->accelerate_beta_max);
+					this->accelerate_nmb_accepted++;
+				}
+			}
+
+			if(!rejected){
+				/* inexact inner solution was not good enough to decrease the function, return to the last accepted iterate and repeat the step with exact solves */
+				if(L - L_old > 0 && inexact_scale > 1.0){
+					if(have_accepted){
+						*(tsdata->get_gammavector()) = *gammavector_accepted;
+						*(tsdata->get_thetavector()) = *thetavector_accepted;
+						L = L_old;
+						rejected = true;
+
+						if(debug_print_it){
+							coutMaster << "  - inexact step rejected, repeated with exact inner solves" << std::endl;
+						}
+					}
+					inexact_scale = 1.0;
+					this->inexact_nmb_tightened++;
+				} else {
+					//TODO: temp, throw exception!
+					if(L - L_old > 0){
+						coutMaster << "ERROR: objective function increased" << std::endl;
+					}
+				}
+
+				/* global stopping criteria, the solution has to be computed with exact inner solves */
+				if(!rejected && deltaL < this->eps){
+					if(inexact_scale > 1.0){
+						inexact_scale = 1.0;
+					} else {
+						break;
+					}
+				}
 			}
 
-			/* global stopping criteria */
-			if(deltaL < this->eps){
-				break;
+			/* remember the accepted iterate while the inner solves could be inexact */
+			if(use_rollback && !rejected && inexact_scale > 1.0){
+				*gammavector_accepted = *(tsdata->get_gammavector());
+				*thetavector_accepted = *(tsdata->get_thetavector());
+				have_accepted = true;
 			}
 
 			/* update counter for outer annealing iterations */
 			it_gammasolver += gammasolver->get_it();
 			it_thetasolver += thetasolver->get_it();
 
+			/* store the state of solver, also after rejected step */
+			if(!this->checkpoint_filename.empty() && this->checkpoint_every > 0 && (it+1) % this->checkpoint_every == 0){
+				save_checkpoint(false, it_annealing, it+1, L, it_gammasolver, it_thetasolver);
+			}
+
+			/* extrapolate gamma, next outer iteration starts from extrapolated point; after rejected step the plain step is computed */
+			if(use_accelerate && !rejected){
+				this->timer_accelerate.start();
+				if(have_prev){
+					*gammavector_plain = *(tsdata->get_gammavector());
+					*thetavector_plain = *(tsdata->get_thetavector());
+					L_plain = L;
+					double beta = extrapolate_gamma(gammavector_prev, accelerate_beta);
+					*gammavector_prev = *gammavector_plain;
+					extrapolated = (beta > 0.0);
+				} else {
+					*gammavector_prev = *(tsdata->get_gammavector());
+					have_prev = true;
+				}
+				this->timer_accelerate.stop();
+			}
 		}
 		coutMaster.pop();
 
+		/* the last extrapolated step was not evaluated */
+		if(extrapolated){
+			*(tsdata->get_gammavector()) = *gammavector_plain;
+			*(tsdata->get_thetavector()) = *thetavector_plain;
+			L = L_plain;
+		}
+
 		this->it_sum += it;
 		this->it_last = it;
 
@@ -692,7 +1126,7 @@ void TSSolver<VectorBase>::solve() {
 		}
 
 		/* if there are more annealing steps, then prepare new initial guess */
-		if(it_annealing < this->annealing-1){
+		if(it_annealing < this->annealing-1 && !this->init_kmeans){
 				tsdata->get_gammavector()->set_random();
 		}
 	}
@@ -702,10 +1136,36 @@ void TSSolver<VectorBase>::solve() {
 	if(annealing > 1){
 		*(tsdata->get_gammavector()) = *gammavector_temp;
 		*(tsdata->get_thetavector()) = *thetavector_temp;
+	}
 
+	/* the problem is solved, restart will not repeat it */
+	if(!this->checkpoint_filename.empty()){
+		save_checkpoint(true, this->annealing, this->it_last, this->L, 0, 0);
+	}
+
+	if(annealing > 1){
 		destroy_temp_annealing();
 	}
 
+	if(use_accelerate){
+		delete gammavector_prev;
+		delete gammavector_plain;
+		delete thetavector_plain;
+	}
+
+	if(use_rollback){
+		delete gammavector_accepted;
+		delete thetavector_accepted;
+	}
+
+	/* restore tolerances of inner solvers */
+	if(this->inexact){
+		gammasolver->set_eps(gamma_eps_exact);
+		gammasolver->set_maxit(gamma_maxit_exact);
+		thetasolver->set_eps(theta_eps_exact);
+		thetasolver->set_maxit(theta_maxit_exact);
+	}
+
 	this->timer_solve.stop(); /* stop this timer in the end of solution */
 
 	LOG_IT(this->it_last)
@@ -774,6 +1234,17 @@ void TSSolver<VectorBase>::gammavector_permute() const{
 	LOG_FUNC_END
 }
 
+template<class VectorBase>
+double TSSolver<VectorBase>::extrapolate_gamma(GeneralVector<VectorBase> *gammavector_prev, double beta) {
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+
+	return 0.0;
+}
+
 template<class VectorBase>
 void TSSolver<VectorBase>::set_solution_theta(double *Theta) {
 	LOG_FUNC_BEGIN
@@ -794,6 +1265,58 @@ double TSSolver<VectorBase>::get_L() const {
 	return this->L;
 }
 
+template<class VectorBase>
+void TSSolver<VectorBase>::set_checkpoint_id(int id) {
+	this->checkpoint_id = id;
+}
+
+template<class VectorBase>
+int TSSolver<VectorBase>::get_checkpoint_id() const {
+	return this->checkpoint_id;
+}
+
+template<class VectorBase>
+void TSSolver<VectorBase>::save_checkpoint(bool finished, int it_annealing, int it, double L, int it_gammasolver, int it_thetasolver) {
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+}
+
+template<class VectorBase>
+bool TSSolver<VectorBase>::load_checkpoint() {
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+
+	return false;
+}
+
+template<class VectorBase>
+bool TSSolver<VectorBase>::read_checkpoint_header(TSSolverCheckpointHeader *header) const {
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+
+	return false;
+}
+
+template<class VectorBase>
+int TSSolver<VectorBase>::get_checkpoint_restart_id() const {
+	LOG_FUNC_BEGIN
+
+	//TODO
+
+	LOG_FUNC_END
+
+	return -1;
+}
+
 
 }
 } /* end namespace */
@@ -12,6 +12,12 @@ namespace pascinference {
 
 void add_options(boost::program_options::options_description *description, int console_nmb_cols){
 
+	/* ----- GLOBAL ---- */
+	boost::program_options::options_description opt_global("#### GLOBAL ########################", console_nmb_cols);
+	opt_global.add_options()
+		("global_binding_report", boost::program_options::value<bool>(), "print the core and NUMA node of each process and OpenMP thread after initialization [bool]");
+	description->add(opt_global);
+
 	/* ----- LOG ---- */
 	boost::program_options::options_description opt_log("#### LOG ########################", console_nmb_cols);
 	opt_log.add_options()
@@ -22,6 +28,22 @@ void add_options(boost::program_options::options_description *description, int c
 		("log_or_not_memory", boost::program_options::value<bool>(), "log also the state of the memory [bool]");
 	description->add(opt_log);
 
+	/* ----- TIMER ---- */
+	boost::program_options::options_description opt_timer("#### TIMER ########################", console_nmb_cols);
+	opt_timer.add_options()
+		("timer_counters", boost::program_options::value<bool>(), "measure cycles, instructions and LLC misses of master thread in timers using perf_event_open (Linux), printed per rank in printtimer [bool]")
+		("timer_memory", boost::program_options::value<bool>(), "measure peak resident memory (/proc/self/status) of TSSolver phases and print memory registered by objects [bool]");
+	description->add(opt_timer);
+
+	/* ----- ALGEBRA ---- */
+	boost::program_options::options_description opt_algebra("#### ALGEBRA ########################", console_nmb_cols);
+	opt_algebra.add_options()
+		("blockgraphsparsematrix_stencil", boost::program_options::value<bool>(), "if the graph is a grid decomposed into rectangles, apply regularization as a space-time stencil instead of assembled sparse matrix [bool]")
+		("blockgraphsparsematrix_lambdamax_lanczos", boost::program_options::value<bool>(), "estimate the largest eigenvalue by Lanczos method, otherwise Gershgorin bound is used [bool]")
+		("blockgraphsparsematrix_lambdamax_maxit", boost::program_options::value<int>(), "maximum number of Lanczos iterations for the largest eigenvalue [int]")
+		("blockgraphsparsematrix_lambdamax_eps", boost::program_options::value<double>(), "relative precision of the largest eigenvalue [double]");
+	description->add(opt_algebra);
+
 	/* ----- SOLVERS ------ */
 	boost::program_options::options_description opt_solvers("#### SOLVERS ########################", console_nmb_cols);
 
@@ -31,6 +53,10 @@ void add_options(boost::program_options::options_description *description, int c
 			("tssolver_maxit", boost::program_options::value<int>(), "maximum number of iterations [int]")
 			("tssolver_eps", boost::program_options::value<double>(), "precision [double]")
 			("tssolver_init_permute", boost::program_options::value<bool>(), "permute initial approximation subject to decomposition [bool]")
+			("tssolver_init_kmeans", boost::program_options::value<bool>(), "initial gamma (also in annealing steps) from k-means++ and Lloyd iterations on data instead of random, only in the first solve(), next solve() starts from the previous solution [bool]")
+			("tssolver_init_kmeans_lloyd", boost::program_options::value<int>(), "number of Lloyd iterations in k-means initialization [int]")
+			("tssolver_init_kmeans_softness", boost::program_options::value<double>(), "softening of one-hot initial gamma, 0 = one-hot [double]")
+			("tssolver_init_kmeans_seed", boost::program_options::value<int>(), "seed of k-means++, annealing step is added [int]")
 			("tssolver_debugmode", boost::program_options::value<int>(), "basic debug mode schema [0/1/2/3]")
 			("tssolver_debug_print_annealing", boost::program_options::value<bool>(), "print info about annealing steps [bool]")
 			("tssolver_debug_print_it", boost::program_options::value<bool>(), "print simple info about outer iterations [bool]")
@@ -38,6 +64,17 @@ void add_options(boost::program_options::options_description *description, int c
 			("tssolver_debug_print_theta_solution", boost::program_options::value<bool>(), "print solution of theta problem in each iteration [bool]")
 			("tssolver_debug_print_gamma", boost::program_options::value<bool>(), "print gamma solver info [bool]")
 			("tssolver_debug_print_gamma_solution", boost::program_options::value<bool>(), "print solution of gamma problem in each iteration [bool]")
+			("tssolver_accelerate", boost::program_options::value<bool>(), "extrapolate gamma between outer iterations, the plain step is used if the function value increases [bool]")
+			("tssolver_accelerate_beta", boost::program_options::value<double>(), "initial extrapolation coefficient [double]")
+			("tssolver_accelerate_beta_max", boost::program_options::value<double>(), "maximum extrapolation coefficient [double]")
+			("tssolver_inexact", boost::program_options::value<bool>(), "solve inner problems inexactly while the outer iterations are far from solution [bool]")
+			("tssolver_inexact_scale", boost::program_options::value<double>(), "the maximum ratio of inner tolerance and required inner tolerance [double]")
+			("tssolver_inexact_rate", boost::program_options::value<double>(), "the ratio of tolerances decreases at least by this factor in every outer iteration [double]")
+			("tssolver_inexact_coeff", boost::program_options::value<double>(), "the ratio of tolerances is at most coeff*deltaL/eps [double]")
+			("tssolver_inexact_maxit", boost::program_options::value<int>(), "maximum number of inner iterations in first inexact solution, doubled in every outer iteration [int]")
+			("tssolver_checkpoint_filename", boost::program_options::value<std::string>(), "name of checkpoint file, checkpoints are not stored if empty [string]")
+			("tssolver_checkpoint_every", boost::program_options::value<int>(), "store checkpoint every N outer iterations [int]")
+			("tssolver_checkpoint_restart", boost::program_options::value<bool>(), "restore the state of solver from checkpoint file [bool]")
 			("tssolver_dump", boost::program_options::value<bool>(), "dump solver data [bool]");
 		opt_solvers.add(opt_tssolver);
 
@@ -78,6 +115,7 @@ void add_options(boost::program_options::options_description *description, int c
 			("spgqpsolver_sigma1", boost::program_options::value<double>(), "parameter of generalized Armijo condition [double]")
 			("spgqpsolver_sigma2", boost::program_options::value<double>(), "parameter of generalized Armijo condition [double]")
 			("spgqpsolver_alphainit", boost::program_options::value<double>(), "initial BB step-size [double]")
+			("spgqpsolver_warmstart", boost::program_options::value<bool>(), "start with BB step-size from the end of previous solution [bool]")
 			("spgqpsolver_stop_normgp", boost::program_options::value<bool>(), "stopping criteria based on norm(gp) [bool]")
 			("spgqpsolver_stop_Anormgp", boost::program_options::value<bool>(), "stopping criteria based on A-norm(gp) [bool]")
 			("spgqpsolver_stop_normgp_normb", boost::program_options::value<bool>(), "stopping criteria based on norm(gp) and norm(b) [bool]")
@@ -91,6 +129,21 @@ void add_options(boost::program_options::options_description *description, int c
 			("spgqpsolver_dump", boost::program_options::value<bool>(), "dump solver data [bool]");
 		opt_solvers.add(opt_spgqpsolver);
 
+		/* FISTAQPSOLVER */
+		boost::program_options::options_description opt_fistaqpsolver("FISTAQPSOLVER", console_nmb_cols);
+		opt_fistaqpsolver.add_options()
+			("fistaqpsolver_maxit", boost::program_options::value<int>(), "maximum number of iterations [int]")
+			("fistaqpsolver_eps", boost::program_options::value<double>(), "precision [double]")
+			("fistaqpsolver_restart", boost::program_options::value<int>(), "adaptive restart of momentum [0=none/1=function/2=gradient]")
+			("fistaqpsolver_power_maxit", boost::program_options::value<int>(), "maximum number of iterations of power method for the largest eigenvalue [int]")
+			("fistaqpsolver_power_eps", boost::program_options::value<double>(), "relative precision of power method for the largest eigenvalue [double]")
+			("fistaqpsolver_Lsafety", boost::program_options::value<double>(), "the estimation of the largest eigenvalue is multiplied by this coefficient [double]")
+			("fistaqpsolver_stop_normgp", boost::program_options::value<bool>(), "stopping criteria based on norm of gradient mapping [bool]")
+			("fistaqpsolver_stop_difff", boost::program_options::value<bool>(), "stopping criteria based on difference of object function [bool]")
+			("fistaqpsolver_debugmode", boost::program_options::value<int>(), "basic debug mode schema [0/1]")
+			("fistaqpsolver_debug_print_it", boost::program_options::value<bool>(), "print simple info about outer iterations");
+		opt_solvers.add(opt_fistaqpsolver);
+
 		/* PERMONSOLVER */
 		boost::program_options::options_description opt_permonsolver("PERMONSOLVER", console_nmb_cols);
 		opt_permonsolver.add_options()
@@ -150,7 +203,7 @@ void add_options(boost::program_options::options_description *description, int c
 		boost::program_options::options_description opt_graphh1femmodel("GRAPHH1FEMMODEL", console_nmb_cols);
 		opt_graphh1femmodel.add_options()
 			("graphh1femmodel_scalef", boost::program_options::value<bool>(), "scale function by 1/T [bool]")
-			("graphh1femmodel_gammasolvertype", boost::program_options::value<int>(), "type of used inner QP solver [0=SOLVER_AUTO/1=SOLVER_SPGQP/2=SOLVER_SPGQPCOEFF/3=SOLVER_PERMON/4=SOLVER_TAO]");
+			("graphh1femmodel_gammasolvertype", boost::program_options::value<int>(), "type of used inner QP solver [0=SOLVER_AUTO/1=SOLVER_SPGQP/2=SOLVER_SPGQPCOEFF/3=SOLVER_PERMON/4=SOLVER_TAO/5=SOLVER_FISTAQP]");
 		opt_models.add(opt_graphh1femmodel);
 
 		/* KMEANSH1FEMMODEL */
@@ -164,18 +217,48 @@ void add_options(boost::program_options::options_description *description, int c
 		opt_entropyh1femmodel.add_options()
 			("entropyh1femmodel_scalef", boost::program_options::value<bool>(), "scale function by 1/T [bool]")
 			("entropyh1femmodel_thetasolvertype", boost::program_options::value<int>(), "type of used inner Entropy solver [0=SOLVER_AUTO/1=SOLVER_ENTROPY_DLIB/2=SOLVER_ENTROPY_NEWTON]")			
-			("entropyh1femmodel_gammasolvertype", boost::program_options::value<int>(), "type of used inner QP solver [0=SOLVER_AUTO/1=SOLVER_SPGQP/2=SOLVER_SPGQPCOEFF/3=SOLVER_PERMON/4=SOLVER_TAO]");
+			("entropyh1femmodel_gammasolvertype", boost::program_options::value<int>(), "type of used inner QP solver [0=SOLVER_AUTO/1=SOLVER_SPGQP/2=SOLVER_SPGQPCOEFF/3=SOLVER_PERMON/4=SOLVER_TAO/5=SOLVER_FISTAQP]");
 		opt_models.add(opt_entropyh1femmodel);
 
 
 	description->add(opt_models);
 
 
+	/* ----- DATA ------ */
+	boost::program_options::options_description opt_data("#### DATA ########################", console_nmb_cols);
+
+		/* TSDATA */
+		boost::program_options::options_description opt_tsdata("TSDATA", console_nmb_cols);
+		opt_tsdata.add_options()
+			("tsdata_save_labels", boost::program_options::value<bool>(), "save gamma as labels of clusters (one byte per node in time step, use after cutgamma) instead of dense vector [bool]");
+		opt_data.add(opt_tsdata);
+
+		/* RESULTFILE */
+		boost::program_options::options_description opt_resultfile("RESULTFILE", console_nmb_cols);
+		opt_resultfile.add_options()
+			("resultfile_chunk_rows", boost::program_options::value<int>(), "maximum number of rows (node in time step) in one chunk [int]")
+			("resultfile_gamma_tol", boost::program_options::value<double>(), "tolerance of one-hot compression of gamma, 0.0 is lossless [double]")
+			("resultfile_save_data", boost::program_options::value<bool>(), "store also original data into result file [bool]")
+			("resultfile_max_inflight", boost::program_options::value<int>(), "maximum number of records written in background while solver continues, 0 = blocking write [int]");
+		opt_data.add(opt_resultfile);
+
+		/* DECOMPOSITION */
+		boost::program_options::options_description opt_decomposition("DECOMPOSITION", console_nmb_cols);
+		opt_decomposition.add_options()
+			("decomposition_auto_bandwidth", boost::program_options::value<double>(), "bandwidth of network used in automatic decomposition [bytes/s], 0 = measure [double]")
+			("decomposition_auto_latency", boost::program_options::value<double>(), "latency of network used in automatic decomposition [s], 0 = measure [double]")
+			("decomposition_auto_floprate", boost::program_options::value<double>(), "number of nonzero entries processed per second in automatic decomposition [double]");
+		opt_data.add(opt_decomposition);
+
+	description->add(opt_data);
+
+
 	/* ----- PETSC ---- */
 #ifdef USE_PETSC
 	boost::program_options::options_description opt_petsc("#### PETSC ######################", console_nmb_cols);
 	opt_petsc.add_options()
-		("petsc_options", boost::program_options::value< std::string >(), "all PETSc options [string]");
+		("petsc_options", boost::program_options::value< std::string >(), "all PETSc options [string]")
+		("petsc_firsttouch", boost::program_options::value<bool>(), "create large vectors (gamma, data and their duplicates) by first touch of OpenMP threads to place them on NUMA nodes of threads [bool]");
 	description->add(opt_petsc);
 #endif
 
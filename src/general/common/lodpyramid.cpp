@@ -0,0 +1,398 @@
+/** @file lodpyramid.cpp
+ *  @brief Implementation of level-of-detail pyramid.
+ *
+ *  @author Lukas Pospisil
+ */
+#include "general/common/lodpyramid.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define LODPYRAMID_MAGIC "PASCLOD1"
+#define LODPYRAMID_CHUNK 1048576		/**< number of values read from vector at once during build */
+#define LODPYRAMID_VEC_CLASSID 1211214	/**< VEC_FILE_CLASSID of PETSc binary file */
+
+namespace pascinference {
+namespace common {
+
+/* accumulator of one bin during build, the bin of level l is composed of two bins of level l-1 */
+struct LODPyramidBin {
+	double min;
+	double max;
+	double sum;
+	int64_t count;		/* number of original values */
+	int nmb_inputs;		/* number of added values (level 0) or bins (other levels) */
+	int64_t idx;		/* index of next record */
+};
+
+LODPyramid::LODPyramid(){
+	this->offsets = NULL;
+	this->map = NULL;
+	this->map_size = 0;
+	this->raw_map = NULL;
+	this->raw_map_size = 0;
+	this->raw_header_size = 0;
+	std::memset(&this->header, 0, sizeof(Header));
+}
+
+LODPyramid::~LODPyramid(){
+	close();
+}
+
+std::string LODPyramid::get_filename(const std::string &vector_filename){
+	return vector_filename + LODPYRAMID_EXTENSION;
+}
+
+double LODPyramid::from_bigendian(const char *bytes){
+	unsigned char swapped[8];
+	const uint16_t one = 1;
+	if(*((const unsigned char *)&one) == 1){
+		/* little-endian host */
+		for(int i=0;i<8;i++){
+			swapped[i] = bytes[7-i];
+		}
+	} else {
+		std::memcpy(swapped, bytes, 8);
+	}
+
+	double value;
+	std::memcpy(&value, swapped, 8);
+	return value;
+}
+
+bool LODPyramid::read_vector_header(size_t file_size, const char *bytes, int64_t *n, size_t *header_size){
+	/* all integers are big-endian */
+	const unsigned char *ubytes = (const unsigned char *)bytes;
+	int64_t classid = ((int64_t)ubytes[0] << 24) | ((int64_t)ubytes[1] << 16) | ((int64_t)ubytes[2] << 8) | (int64_t)ubytes[3];
+	if(classid != LODPYRAMID_VEC_CLASSID){
+		return false;
+	}
+
+	/* 32-bit PetscInt */
+	int64_t n32 = ((int64_t)ubytes[4] << 24) | ((int64_t)ubytes[5] << 16) | ((int64_t)ubytes[6] << 8) | (int64_t)ubytes[7];
+	if(file_size == 8 + 8*(size_t)n32){
+		*n = n32;
+		*header_size = 8;
+		return true;
+	}
+
+	/* 64-bit PetscInt */
+	int64_t n64 = 0;
+	for(int i=4;i<12;i++){
+		n64 = (n64 << 8) | (int64_t)ubytes[i];
+	}
+	if(file_size >= 12 && file_size == 12 + 8*(size_t)n64){
+		*n = n64;
+		*header_size = 12;
+		return true;
+	}
+
+	return false;
+}
+
+bool LODPyramid::build(const std::string &vector_filename, const std::string &pyramid_filename, int C, bool interleaved){
+	/* read header of vector */
+	FILE *vector_file = fopen(vector_filename.c_str(), "rb");
+	if(!vector_file){
+		std::cerr << "WARNING: LODPyramid cannot open " << vector_filename << std::endl;
+		return false;
+	}
+
+	struct stat vector_stat;
+	fstat(fileno(vector_file), &vector_stat);
+
+	char vector_header[12] = {0};
+	int64_t n;
+	size_t vector_header_size;
+	size_t nmb_read = fread(vector_header, 1, 12, vector_file);
+	if(C <= 0 || nmb_read < 8 || !read_vector_header(vector_stat.st_size, vector_header, &n, &vector_header_size) || n % C != 0 || n == 0){
+		std::cerr << "WARNING: " << vector_filename << " is not PETSc binary vector with " << C << " channels" << std::endl;
+		fclose(vector_file);
+		return false;
+	}
+	fseek(vector_file, vector_header_size, SEEK_SET);
+
+	/* prepare header and offsets of levels */
+	Header header;
+	std::memset(&header, 0, sizeof(Header));
+	std::memcpy(header.magic, LODPYRAMID_MAGIC, 8);
+	header.T = n/C;
+	header.C = C;
+	header.interleaved = interleaved;
+
+	std::vector<int64_t> sizes;
+	int64_t decimation = 2;
+	do {
+		sizes.push_back((header.T + decimation - 1)/decimation);
+		decimation *= 2;
+	} while(sizes.back() > 1);
+	header.nmb_levels = sizes.size();
+
+	std::vector<int64_t> offsets(header.nmb_levels);
+	size_t file_size = sizeof(Header) + header.nmb_levels*sizeof(int64_t);
+	for(int l=0;l<header.nmb_levels;l++){
+		offsets[l] = file_size;
+		file_size += (size_t)C*sizes[l]*sizeof(Record);
+	}
+
+	/* the records are written directly into mapped file */
+	int fd = ::open(pyramid_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0 || ftruncate(fd, file_size) != 0){
+		std::cerr << "WARNING: LODPyramid cannot create " << pyramid_filename << std::endl;
+		if(fd >= 0) ::close(fd);
+		fclose(vector_file);
+		return false;
+	}
+
+	char *pyramid = (char *)mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(pyramid == MAP_FAILED){
+		std::cerr << "WARNING: LODPyramid cannot map " << pyramid_filename << std::endl;
+		::close(fd);
+		fclose(vector_file);
+		return false;
+	}
+
+	std::memcpy(pyramid, &header, sizeof(Header));
+	std::memcpy(pyramid + sizeof(Header), &offsets[0], header.nmb_levels*sizeof(int64_t));
+
+	/* one open bin of each level for each channel */
+	int L = header.nmb_levels;
+	std::vector<LODPyramidBin> bins((size_t)C*L);
+	for(size_t i=0;i<bins.size();i++){
+		bins[i].min = std::numeric_limits<double>::max();
+		bins[i].max = -std::numeric_limits<double>::max();
+		bins[i].sum = 0.0;
+		bins[i].count = 0;
+		bins[i].nmb_inputs = 0;
+		bins[i].idx = 0;
+	}
+
+	/* close the bin of level l and add it to the bin of level l+1 */
+	struct Cascade {
+		static void emit(char *pyramid, const std::vector<int64_t> &offsets, const std::vector<int64_t> &sizes, std::vector<LODPyramidBin> &bins, int L, int c, int l){
+			LODPyramidBin &bin = bins[(size_t)c*L + l];
+
+			Record record;
+			record.min = bin.min;
+			record.max = bin.max;
+			record.mean = bin.sum/(double)bin.count;
+			std::memcpy(pyramid + offsets[l] + ((size_t)c*sizes[l] + bin.idx)*sizeof(Record), &record, sizeof(Record));
+
+			if(l+1 < L){
+				LODPyramidBin &parent = bins[(size_t)c*L + l + 1];
+				parent.min = std::min(parent.min, bin.min);
+				parent.max = std::max(parent.max, bin.max);
+				parent.sum += bin.sum;
+				parent.count += bin.count;
+				parent.nmb_inputs++;
+				if(parent.nmb_inputs == 2){
+					emit(pyramid, offsets, sizes, bins, L, c, l+1);
+				}
+			}
+
+			bin.min = std::numeric_limits<double>::max();
+			bin.max = -std::numeric_limits<double>::max();
+			bin.sum = 0.0;
+			bin.count = 0;
+			bin.nmb_inputs = 0;
+			bin.idx++;
+		}
+	};
+
+	/* read the vector in chunks, the values of each channel come in the order of time in both layouts */
+	std::vector<char> chunk(LODPYRAMID_CHUNK*8);
+	int64_t i = 0;
+	while(i < n){
+		size_t nmb_values = std::min((int64_t)LODPYRAMID_CHUNK, n - i);
+		if(fread(&chunk[0], 8, nmb_values, vector_file) != nmb_values){
+			std::cerr << "WARNING: LODPyramid cannot read " << vector_filename << std::endl;
+			break;
+		}
+
+		for(size_t j=0;j<nmb_values;j++,i++){
+			double value = from_bigendian(&chunk[j*8]);
+			int c = interleaved ? (int)(i % C) : (int)(i / header.T);
+
+			LODPyramidBin &bin = bins[(size_t)c*L];
+			bin.min = std::min(bin.min, value);
+			bin.max = std::max(bin.max, value);
+			bin.sum += value;
+			bin.count++;
+			bin.nmb_inputs++;
+			if(bin.nmb_inputs == 2){
+				Cascade::emit(pyramid, offsets, sizes, bins, L, c, 0);
+			}
+		}
+	}
+
+	/* close the partial bins at the end of channels, from the finest level */
+	for(int c=0;c<C;c++){
+		for(int l=0;l<L;l++){
+			if(bins[(size_t)c*L + l].nmb_inputs > 0){
+				Cascade::emit(pyramid, offsets, sizes, bins, L, c, l);
+			}
+		}
+	}
+
+	munmap(pyramid, file_size);
+	::close(fd);
+	fclose(vector_file);
+
+	return i == n;
+}
+
+bool LODPyramid::open(const std::string &pyramid_filename, const std::string &vector_filename){
+	close();
+
+	/* map pyramid */
+	int fd = ::open(pyramid_filename.c_str(), O_RDONLY);
+	if(fd < 0){
+		return false;
+	}
+
+	struct stat file_stat;
+	fstat(fd, &file_stat);
+	if((size_t)file_stat.st_size < sizeof(Header)){
+		::close(fd);
+		return false;
+	}
+
+	this->map_size = file_stat.st_size;
+	this->map = mmap(NULL, this->map_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if(this->map == MAP_FAILED){
+		this->map = NULL;
+		return false;
+	}
+
+	std::memcpy(&this->header, this->map, sizeof(Header));
+	if(std::memcmp(this->header.magic, LODPYRAMID_MAGIC, 8) != 0 || this->header.nmb_levels <= 0
+		|| this->map_size < sizeof(Header) + this->header.nmb_levels*sizeof(int64_t)){
+		std::cerr << "WARNING: " << pyramid_filename << " is not LODPyramid file" << std::endl;
+		close();
+		return false;
+	}
+	this->offsets = (const int64_t *)((const char *)this->map + sizeof(Header));
+
+	/* map original vector, it is used only for the finest zoom */
+	fd = ::open(vector_filename.c_str(), O_RDONLY);
+	if(fd >= 0){
+		fstat(fd, &file_stat);
+		size_t raw_size = file_stat.st_size;
+
+		void *raw = (raw_size >= 12)? mmap(NULL, raw_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+		::close(fd);
+
+		int64_t n;
+		if(raw != MAP_FAILED){
+			if(read_vector_header(raw_size, (const char *)raw, &n, &this->raw_header_size) && n == this->header.T*this->header.C){
+				this->raw_map = raw;
+				this->raw_map_size = raw_size;
+			} else {
+				munmap(raw, raw_size);
+			}
+		}
+	}
+
+	return true;
+}
+
+void LODPyramid::close(){
+	if(this->map){
+		munmap(this->map, this->map_size);
+	}
+	if(this->raw_map){
+		munmap(this->raw_map, this->raw_map_size);
+	}
+
+	this->offsets = NULL;
+	this->map = NULL;
+	this->map_size = 0;
+	this->raw_map = NULL;
+	this->raw_map_size = 0;
+	std::memset(&this->header, 0, sizeof(Header));
+}
+
+bool LODPyramid::is_open() const {
+	return (this->map != NULL);
+}
+
+bool LODPyramid::is_raw_available() const {
+	return (this->raw_map != NULL);
+}
+
+int64_t LODPyramid::get_T() const {
+	return this->header.T;
+}
+
+int LODPyramid::get_C() const {
+	return this->header.C;
+}
+
+bool LODPyramid::get_interleaved() const {
+	return (this->header.interleaved != 0);
+}
+
+int LODPyramid::get_nmb_levels() const {
+	return this->header.nmb_levels;
+}
+
+int64_t LODPyramid::get_decimation(int level) const {
+	return ((int64_t)1) << (level+1);
+}
+
+int64_t LODPyramid::get_size(int level) const {
+	int64_t decimation = get_decimation(level);
+	return (this->header.T + decimation - 1)/decimation;
+}
+
+int LODPyramid::get_level(double values_per_record) const {
+	int level = -1;
+	while(level+1 < this->header.nmb_levels && get_decimation(level+1) <= values_per_record){
+		level++;
+	}
+
+	/* the finest level is used if original values are not available */
+	if(level == -1 && !is_raw_available()){
+		level = 0;
+	}
+
+	return level;
+}
+
+void LODPyramid::get_records(int level, int c, int64_t begin, int64_t end, std::vector<Record> &records) const {
+	begin = std::max(begin, (int64_t)0);
+	end = std::min(end, get_size(level));
+	records.resize(std::max(end - begin, (int64_t)0));
+
+	if(level < 0){
+		/* original values */
+		const char *values = (const char *)this->raw_map + this->raw_header_size;
+		for(int64_t t=begin;t<end;t++){
+			int64_t idx = this->header.interleaved ? t*this->header.C + c : c*this->header.T + t;
+			float value = from_bigendian(values + 8*idx);
+			records[t-begin].min = value;
+			records[t-begin].max = value;
+			records[t-begin].mean = value;
+		}
+	} else if(end > begin){
+		const char *level_records = (const char *)this->map + this->offsets[level];
+		std::memcpy(&records[0], level_records + ((size_t)c*get_size(level) + begin)*sizeof(Record), (end - begin)*sizeof(Record));
+	}
+}
+
+LODPyramid::Record LODPyramid::get_summary(int c) const {
+	std::vector<Record> records;
+	get_records(this->header.nmb_levels-1, c, 0, 1, records);
+	return records[0];
+}
+
+}
+} /* end of namespace */
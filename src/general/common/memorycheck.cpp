@@ -1,5 +1,12 @@
 #include "general/common/memorycheck.h"
 
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <map>
+#include <list>
+#include <algorithm>
+
 namespace pascinference {
 namespace common {
 
@@ -39,6 +46,127 @@ long long MemoryCheck::get_physical() {
 			
 	return totalPhysMem;
 }
+
+long long MemoryCheck::get_process_status(const std::string &key){
+	std::ifstream myfile("/proc/self/status");
+	if(!myfile.is_open()){
+		return -1;
+	}
+
+	/* lines in form "VmRSS:	    1234 kB" */
+	std::string line;
+	std::string prefix = key + ":";
+	while(std::getline(myfile, line)){
+		if(line.compare(0, prefix.size(), prefix) == 0){
+			std::istringstream line_stream(line.substr(prefix.size()));
+			long long value;
+			std::string unit;
+			line_stream >> value >> unit;
+			if(unit == "kB"){
+				value *= 1024;
+			}
+			return value;
+		}
+	}
+
+	return -1;
+}
+
+long long MemoryCheck::get_process_rss(){
+	return get_process_status("VmRSS");
+}
+
+long long MemoryCheck::get_process_hwm(){
+	return get_process_status("VmHWM");
+}
+
+bool MemoryCheck::reset_process_hwm(){
+	std::ofstream myfile("/proc/self/clear_refs");
+	if(!myfile.is_open()){
+		return false;
+	}
+	myfile << "5";
+	myfile.close();
+
+	return !myfile.fail();
+}
+
+/* list of opened phases (pointers to their peaks) */
+static std::list<long long *> &get_phases(){
+	static std::list<long long *> phases;
+	return phases;
+}
+
+/* store the peak to opened phases, the phases with unknown peak (-1) stay unknown */
+static void update_phases(std::list<long long *> &phases, long long hwm){
+	for(std::list<long long *>::iterator it = phases.begin(); it != phases.end(); ++it){
+		if(**it >= 0){
+			**it = std::max(**it, hwm);
+		}
+	}
+}
+
+bool MemoryCheck::phase_begin(long long *peak){
+	std::list<long long *> &phases = get_phases();
+
+	/* VmHWM will be reset, store the peak to already opened phases */
+	update_phases(phases, get_process_hwm());
+
+	/* without the reset VmHWM is the peak of the whole process, it is not the peak of the new phase */
+	bool reset = reset_process_hwm();
+	if(reset && *peak >= 0){
+		/* the peak of new phase is at least the actual memory */
+		*peak = std::max(*peak, get_process_rss());
+	} else {
+		*peak = -1;
+	}
+	phases.push_back(peak);
+
+	return reset;
+}
+
+void MemoryCheck::phase_end(long long *peak){
+	std::list<long long *> &phases = get_phases();
+
+	update_phases(phases, get_process_hwm());
+
+	phases.remove(peak);
+}
+
+/* registered memory of owners, actual and peak value */
+static std::map<std::string, std::pair<long long, long long> > &get_owned_map(){
+	static std::map<std::string, std::pair<long long, long long> > owned_map;
+	return owned_map;
+}
+
+void MemoryCheck::owned_add(const std::string &owner, long long bytes){
+	std::pair<long long, long long> &owned = get_owned_map()[owner];
+	owned.first += bytes;
+	owned.second = std::max(owned.second, owned.first);
+}
+
+void MemoryCheck::owned_remove(const std::string &owner, long long bytes){
+	std::pair<long long, long long> &owned = get_owned_map()[owner];
+	owned.first -= bytes;
+}
+
+long long MemoryCheck::get_owned(const std::string &owner){
+	return get_owned_map()[owner].first;
+}
+
+long long MemoryCheck::get_owned_peak(const std::string &owner){
+	return get_owned_map()[owner].second;
+}
+
+void MemoryCheck::print_owned(std::ostream &output){
+	std::map<std::string, std::pair<long long, long long> > &owned_map = get_owned_map();
+
+	for(std::map<std::string, std::pair<long long, long long> >::iterator it = owned_map.begin(); it != owned_map.end(); ++it){
+		output << "  - " << std::setw(35) << std::left << it->first << std::right;
+		output << " actual = " << std::setw(12) << it->second.first/(1024.0*1024.0) << " MB,";
+		output << " peak = " << std::setw(12) << it->second.second/(1024.0*1024.0) << " MB" << std::endl;
+	}
+}
 	
 
 }
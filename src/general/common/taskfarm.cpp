@@ -0,0 +1,518 @@
+/* task farm needs MPI */
+#ifdef USE_PETSC
+
+#include "general/common/taskfarm.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <list>
+#include <set>
+#include <cstring>
+#include <unistd.h>
+
+/* tags of messages between scheduler, workers and spawned tasks */
+#define TASKFARM_TAG_IDLE 1001
+#define TASKFARM_TAG_TASK 1002
+#define TASKFARM_TAG_COMMAND 1003
+#define TASKFARM_TAG_DONE 1004
+
+namespace pascinference {
+namespace common {
+
+/* order of tasks in queue, the largest first */
+struct LargerTask {
+	const std::vector<TaskFarm::Task> &tasks;
+	LargerTask(const std::vector<TaskFarm::Task> &new_tasks) : tasks(new_tasks) {}
+	bool operator()(int a, int b) const {
+		return tasks[a].nprocs > tasks[b].nprocs;
+	}
+};
+
+TaskFarm::TaskFarm(std::string manifest_filename, int poll_time, bool hosts, double timeout){
+	this->poll_time = poll_time;
+	this->hosts = hosts;
+	this->timeout = timeout;
+
+	/* only scheduler knows the list of tasks */
+	if(GlobalManager.get_rank() == 0){
+		std::ifstream myfile(manifest_filename.c_str());
+		if(!myfile.is_open()){
+			coutMaster << "WARNING: cannot open manifest " << manifest_filename << std::endl;
+		}
+
+		std::string line;
+		while(std::getline(myfile, line)){
+			std::istringstream iss(line);
+
+			Task task;
+			if(!(iss >> task.nprocs)){
+				/* empty line or comment */
+				continue;
+			}
+
+			iss >> task.shortinfo;
+			if(task.shortinfo == "-"){
+				task.shortinfo = "";
+			}
+
+			std::string token;
+			while(iss >> token){
+				task.command.push_back(token);
+			}
+
+			if(task.command.empty()){
+				coutMaster << "WARNING: task without executable in manifest, line: " << line << std::endl;
+				continue;
+			}
+
+			task.id = tasks.size();
+			task.time = 0.0;
+			task.status = -1;
+			tasks.push_back(task);
+		}
+
+		myfile.close();
+	}
+
+	/* spawned tasks need slots in addition to the slots held by workers */
+	universe_size = -1;
+	int *universe_size_attr;
+	int flag;
+	MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_UNIVERSE_SIZE, &universe_size_attr, &flag);
+	if(flag){
+		universe_size = *universe_size_attr;
+	}
+
+	int nmb_procs = GlobalManager.get_size();
+	int slots_needed = (nmb_procs > 1)? 2*nmb_procs - 1 : 2;
+	if(universe_size < 0){
+		coutMaster << "WARNING: MPI_UNIVERSE_SIZE is not provided, the task farm needs " << slots_needed << " slots, start it with spare slots or with oversubscription allowed" << std::endl;
+	} else if(universe_size < slots_needed){
+		coutMaster << "WARNING: MPI_UNIVERSE_SIZE = " << universe_size << ", but the task farm needs " << slots_needed << " slots (workers hold their slots while tasks run), start it with spare slots or with oversubscription allowed (e.g. mpirun --oversubscribe)" << std::endl;
+	}
+}
+
+int TaskFarm::get_nmb_tasks() const {
+	return tasks.size();
+}
+
+void TaskFarm::print(ConsoleOutput &output) const {
+	output << "TaskFarm" << std::endl;
+	output << " - nmb_tasks : " << tasks.size() << std::endl;
+	output << " - nmb_procs : " << GlobalManager.get_size() << " (rank 0 is scheduler)" << std::endl;
+	output << " - poll      : " << poll_time << " us" << std::endl;
+	output << " - hosts     : " << print_bool(hosts) << std::endl;
+	output << " - timeout   : " << timeout << " s" << std::endl;
+	output << " - universe  : ";
+	if(universe_size < 0){
+		output << "n/a";
+	} else {
+		output << universe_size;
+	}
+	output << " slots" << std::endl;
+
+	output.push();
+	for(size_t i=0;i<tasks.size();i++){
+		output << std::setw(4) << tasks[i].id << ": nprocs=" << std::setw(3) << tasks[i].nprocs << ", ";
+		for(size_t j=0;j<tasks[i].command.size();j++){
+			output << tasks[i].command[j] << " ";
+		}
+		if(tasks[i].status == 0){
+			output << "(" << tasks[i].time << " s)";
+		}
+		output << std::endl;
+	}
+	output.pop();
+}
+
+void TaskFarm::run(){
+	if(GlobalManager.get_rank() == 0){
+		run_scheduler();
+	} else {
+		run_worker();
+	}
+
+	MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void TaskFarm::wait_message(int source, int tag, MPI_Comm comm, MPI_Status *status) const {
+	int flag = 0;
+	MPI_Iprobe(source, tag, comm, &flag, status);
+	while(!flag){
+		usleep(poll_time);
+		MPI_Iprobe(source, tag, comm, &flag, status);
+	}
+}
+
+int TaskFarm::wait_message(int source, int tag, MPI_Comm comm, MPI_Status *status, double timeout) const {
+	double time_begin = MPI_Wtime();
+	int flag = 0;
+	int ierr = MPI_Iprobe(source, tag, comm, &flag, status);
+	while(!flag && ierr == MPI_SUCCESS){
+		if(timeout > 0.0 && MPI_Wtime() - time_begin > timeout){
+			return 1;
+		}
+		usleep(poll_time);
+		ierr = MPI_Iprobe(source, tag, comm, &flag, status);
+	}
+	return (ierr == MPI_SUCCESS)? 0 : 2;
+}
+
+void TaskFarm::wait_request(MPI_Request *request) const {
+	int flag = 0;
+	MPI_Test(request, &flag, MPI_STATUS_IGNORE);
+	while(!flag){
+		usleep(poll_time);
+		MPI_Test(request, &flag, MPI_STATUS_IGNORE);
+	}
+}
+
+void TaskFarm::run_scheduler(){
+	int nmb_workers = GlobalManager.get_size() - 1;
+
+	/* queue of tasks ordered from the largest one */
+	std::vector<int> order;
+	for(size_t i=0;i<tasks.size();i++){
+		if(tasks[i].nprocs < 1 || (nmb_workers > 0 && tasks[i].nprocs > nmb_workers)){
+			coutMaster << "WARNING: task " << i << " needs " << tasks[i].nprocs << " processes, there are " << nmb_workers << " workers, the task is skipped" << std::endl;
+			continue;
+		}
+		order.push_back(i);
+	}
+	std::stable_sort(order.begin(), order.end(), LargerTask(tasks));
+	std::list<int> queue(order.begin(), order.end());
+
+	/* there are no workers, the scheduler runs tasks one after another */
+	if(nmb_workers == 0){
+		for(std::list<int>::iterator it = queue.begin(); it != queue.end(); ++it){
+			double time_begin = MPI_Wtime();
+			tasks[*it].status = execute(tasks[*it].command, tasks[*it].nprocs, MPI_COMM_SELF);
+			tasks[*it].time = MPI_Wtime() - time_begin;
+
+			/* the abandoned task still occupies the slot of scheduler */
+			if(tasks[*it].status == -2){
+				coutMaster << "WARNING: task " << tasks[*it].id << " FAILED and it is abandoned, remaining tasks are skipped" << std::endl;
+				break;
+			}
+		}
+		return;
+	}
+
+	std::set<int> idle; /* ranks of idle workers, ordered to keep groups on neighbouring ranks */
+	int nmb_alive = nmb_workers; /* workers which are not retired after failed task */
+	double report[4];
+	MPI_Status status;
+
+	/* wait for all workers, otherwise the first small tasks would be dispatched before the largest ones */
+	for(int i=0;i<nmb_workers;i++){
+		wait_message(MPI_ANY_SOURCE, TASKFARM_TAG_IDLE, MPI_COMM_WORLD, &status);
+		MPI_Recv(report, 4, MPI_DOUBLE, status.MPI_SOURCE, TASKFARM_TAG_IDLE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		idle.insert(status.MPI_SOURCE);
+	}
+
+	while(!queue.empty() || (int)idle.size() < nmb_alive){
+		/* dispatch the largest task which fits into idle workers */
+		std::list<int>::iterator it = queue.begin();
+		while(it != queue.end()){
+			Task &task = tasks[*it];
+			if(task.nprocs > (int)idle.size()){
+				++it;
+				continue;
+			}
+
+			/* message: [id, nprocs, ranks of group] */
+			std::vector<int> message(2 + task.nprocs);
+			message[0] = task.id;
+			message[1] = task.nprocs;
+			std::set<int>::iterator idle_it = idle.begin();
+			for(int i=0;i<task.nprocs;i++){
+				message[2+i] = *idle_it;
+				idle.erase(idle_it++);
+			}
+
+			for(int i=0;i<task.nprocs;i++){
+				MPI_Send(&message[0], message.size(), MPI_INT, message[2+i], TASKFARM_TAG_TASK, MPI_COMM_WORLD);
+			}
+
+			/* command is needed only by the leader of group */
+			std::string command;
+			for(size_t j=0;j<task.command.size();j++){
+				command += task.command[j] + '\n';
+			}
+			MPI_Send(command.c_str(), command.size()+1, MPI_CHAR, message[2], TASKFARM_TAG_COMMAND, MPI_COMM_WORLD);
+
+			coutMaster << "- task " << task.id << " started on " << task.nprocs << " processes, " << queue.size()-1 << " tasks in queue" << std::endl;
+
+			it = queue.erase(it);
+		}
+
+		if(queue.empty() && (int)idle.size() == nmb_alive){
+			break;
+		}
+
+		/* wait for any worker to finish */
+		wait_message(MPI_ANY_SOURCE, TASKFARM_TAG_IDLE, MPI_COMM_WORLD, &status);
+		MPI_Recv(report, 4, MPI_DOUBLE, status.MPI_SOURCE, TASKFARM_TAG_IDLE, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+		/* the worker of failed task is retired, its slot is still occupied by the abandoned task */
+		if(report[3] > 0.0){
+			nmb_alive--;
+		} else {
+			idle.insert(status.MPI_SOURCE);
+		}
+
+		/* the leader of group reports the result of task */
+		int id = (int)report[0];
+		if(id >= 0){
+			tasks[id].time = report[1];
+			tasks[id].status = (int)report[2];
+			coutMaster << "- task " << id << " finished in " << tasks[id].time << " s";
+			if(tasks[id].status == -1) coutMaster << " (FAILED to start)";
+			if(tasks[id].status == -2) coutMaster << " (FAILED)";
+			coutMaster << std::endl;
+		}
+
+		/* tasks larger than remaining workers will never be started */
+		std::list<int>::iterator skip_it = queue.begin();
+		while(skip_it != queue.end()){
+			if(tasks[*skip_it].nprocs > nmb_alive){
+				coutMaster << "WARNING: task " << *skip_it << " needs " << tasks[*skip_it].nprocs << " processes, there are " << nmb_alive << " workers which are not retired, the task is skipped" << std::endl;
+				skip_it = queue.erase(skip_it);
+			} else {
+				++skip_it;
+			}
+		}
+	}
+
+	/* stop workers, the retired ones do not wait for tasks anymore */
+	int stop_message[2] = {-1, 0};
+	for(std::set<int>::iterator idle_it = idle.begin(); idle_it != idle.end(); ++idle_it){
+		MPI_Send(stop_message, 2, MPI_INT, *idle_it, TASKFARM_TAG_TASK, MPI_COMM_WORLD);
+	}
+}
+
+void TaskFarm::run_worker(){
+	double report[4] = {-1.0, 0.0, 0.0, 0.0}; /* [id or -1, time, status, retired] */
+	MPI_Status status;
+
+	MPI_Group world_group;
+	MPI_Comm_group(MPI_COMM_WORLD, &world_group);
+
+	while(true){
+		/* I am idle */
+		MPI_Send(report, 4, MPI_DOUBLE, 0, TASKFARM_TAG_IDLE, MPI_COMM_WORLD);
+
+		/* get new task */
+		wait_message(0, TASKFARM_TAG_TASK, MPI_COMM_WORLD, &status);
+		int count;
+		MPI_Get_count(&status, MPI_INT, &count);
+		std::vector<int> message(count);
+		MPI_Recv(&message[0], count, MPI_INT, 0, TASKFARM_TAG_TASK, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+		if(message[0] < 0){
+			break;
+		}
+
+		int id = message[0];
+		int nprocs = message[1];
+
+		/* create communicator of group, only the processes of group participate */
+		MPI_Group group;
+		MPI_Comm group_comm;
+		MPI_Group_incl(world_group, nprocs, &message[2], &group);
+		MPI_Comm_create_group(MPI_COMM_WORLD, group, id, &group_comm);
+
+		/* the leader gets the command */
+		std::vector<std::string> command;
+		if(message[2] == GlobalManager.get_rank()){
+			wait_message(0, TASKFARM_TAG_COMMAND, MPI_COMM_WORLD, &status);
+			MPI_Get_count(&status, MPI_CHAR, &count);
+			std::vector<char> command_chars(count);
+			MPI_Recv(&command_chars[0], count, MPI_CHAR, 0, TASKFARM_TAG_COMMAND, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+			std::string command_string(&command_chars[0]);
+			std::istringstream iss(command_string);
+			std::string token;
+			while(std::getline(iss, token)){
+				command.push_back(token);
+			}
+		}
+
+		double time_begin = MPI_Wtime();
+		int task_status = execute(command, nprocs, group_comm);
+
+		/* only the leader reports the task */
+		report[0] = (message[2] == GlobalManager.get_rank())? id : -1.0;
+		report[1] = MPI_Wtime() - time_begin;
+		report[2] = task_status;
+
+		MPI_Comm_free(&group_comm);
+		MPI_Group_free(&group);
+
+		/* the abandoned task still runs on my slot, do not accept new tasks */
+		if(task_status == -2){
+			report[3] = 1.0;
+			MPI_Send(report, 4, MPI_DOUBLE, 0, TASKFARM_TAG_IDLE, MPI_COMM_WORLD);
+			break;
+		}
+	}
+
+	MPI_Group_free(&world_group);
+}
+
+int TaskFarm::execute(const std::vector<std::string> &command, int nprocs, MPI_Comm group_comm) const {
+	int group_rank;
+	int group_size;
+	MPI_Comm_rank(group_comm, &group_rank);
+	MPI_Comm_size(group_comm, &group_size);
+
+	/* the task runs on the hosts of group */
+	char name[MPI_MAX_PROCESSOR_NAME];
+	memset(name, 0, MPI_MAX_PROCESSOR_NAME);
+	int name_length;
+	MPI_Get_processor_name(name, &name_length);
+
+	std::vector<char> names(group_size*MPI_MAX_PROCESSOR_NAME);
+	MPI_Gather(name, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, &names[0], MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, group_comm);
+
+	MPI_Info info = MPI_INFO_NULL;
+	std::vector<char*> spawn_argv;
+	std::string host_list;
+	if(group_rank == 0){
+		std::set<std::string> host_set;
+		for(int i=0;i<group_size;i++){
+			std::string host(&names[i*MPI_MAX_PROCESSOR_NAME]);
+			if(host_set.insert(host).second){
+				host_list += (host_list.empty()? "" : ",") + host;
+			}
+		}
+
+		if(hosts){
+			MPI_Info_create(&info);
+			MPI_Info_set(info, (char*)"host", (char*)host_list.c_str());
+		}
+
+		for(size_t i=1;i<command.size();i++){
+			spawn_argv.push_back((char*)command[i].c_str());
+		}
+	}
+	spawn_argv.push_back(NULL);
+
+	/* spawn the task, the error is returned instead of abort */
+	MPI_Comm intercomm;
+	std::vector<int> errcodes(nprocs);
+	MPI_Comm_set_errhandler(group_comm, MPI_ERRORS_RETURN);
+	int ierr = MPI_Comm_spawn((group_rank == 0)? (char*)command[0].c_str() : NULL, &spawn_argv[0], nprocs, info, 0, group_comm, &intercomm, &errcodes[0]);
+
+	if(info != MPI_INFO_NULL){
+		MPI_Info_free(&info);
+	}
+
+	if(ierr != MPI_SUCCESS){
+		if(group_rank == 0){
+			std::cerr << "WARNING: TaskFarm cannot spawn " << command[0] << std::endl;
+		}
+		return -1;
+	}
+
+	/* the leader waits for the end of task, the others wait for the result from leader, nobody is spinning */
+	int result = 0;
+	MPI_Request request;
+	if(group_rank == 0){
+		/* the crash of task is returned as the error of communication, if MPI implementation is able to detect it */
+		MPI_Comm_set_errhandler(intercomm, MPI_ERRORS_RETURN);
+
+		MPI_Status status;
+		int done;
+		result = wait_message(0, TASKFARM_TAG_DONE, intercomm, &status, timeout);
+		if(result == 0){
+			MPI_Recv(&done, 1, MPI_INT, 0, TASKFARM_TAG_DONE, intercomm, MPI_STATUS_IGNORE);
+		} else {
+			std::cerr << "WARNING: TaskFarm task " << command[0] << ((result == 1)? " exceeded timeout" : " lost connection") << ", the task is reported as failed" << std::endl;
+		}
+	}
+	MPI_Ibcast(&result, 1, MPI_INT, 0, group_comm, &request);
+	wait_request(&request);
+
+	/* disconnect waits for the task, the failed task is only abandoned (it stays connected, MPI_Finalize will wait for it) */
+	if(result == 0){
+		MPI_Comm_disconnect(&intercomm);
+	} else {
+		MPI_Comm_free(&intercomm);
+	}
+
+	return (result == 0)? 0 : -2;
+}
+
+void TaskFarm::finalize_child(){
+	MPI_Comm parent;
+	MPI_Comm_get_parent(&parent);
+
+	if(parent == MPI_COMM_NULL){
+		return;
+	}
+
+	/* all processes of task are finished, then master tells it to the task farm */
+	MPI_Barrier(MPI_COMM_WORLD);
+
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	if(rank == 0){
+		int done = 0;
+		MPI_Send(&done, 1, MPI_INT, 0, TASKFARM_TAG_DONE, parent);
+	}
+
+	MPI_Comm_disconnect(&parent);
+}
+
+void TaskFarm::write_shortinfo(std::string filename) const {
+	if(GlobalManager.get_rank() != 0){
+		return;
+	}
+
+	/* header is taken from the first available shortinfo */
+	std::string header;
+	for(size_t i=0;i<tasks.size() && header.empty();i++){
+		if(!tasks[i].shortinfo.empty()){
+			std::ifstream infile(tasks[i].shortinfo.c_str());
+			std::getline(infile, header);
+		}
+	}
+
+	std::ofstream myfile(filename.c_str());
+	myfile << "task, nprocs, time, status, " << header << std::endl;
+
+	for(size_t i=0;i<tasks.size();i++){
+		std::ostringstream prefix;
+		prefix << std::setprecision(17);
+		prefix << tasks[i].id << ", " << tasks[i].nprocs << ", " << tasks[i].time << ", " << tasks[i].status << ", ";
+
+		/* one row for each row of values in shortinfo of task */
+		int nmb_rows = 0;
+		if(!tasks[i].shortinfo.empty()){
+			std::ifstream infile(tasks[i].shortinfo.c_str());
+			std::string line;
+			std::getline(infile, line); /* skip header */
+			while(std::getline(infile, line)){
+				if(!line.empty()){
+					myfile << prefix.str() << line << std::endl;
+					nmb_rows++;
+				}
+			}
+		}
+
+		if(nmb_rows == 0){
+			myfile << prefix.str() << std::endl;
+		}
+	}
+
+	myfile.close();
+}
+
+
+}
+} /* end of namespace */
+
+#endif
@@ -1,4 +1,15 @@
 #include "general/common/timer.h"
+#include "general/common/consoleinput.h"
+#include "general/common/memorycheck.h"
+
+#include <sstream>
+#include <string.h>
+
+#ifdef __linux__
+	#include <unistd.h>
+	#include <sys/syscall.h>
+	#include <linux/perf_event.h>
+#endif
 
 namespace pascinference {
 namespace common {
@@ -36,6 +47,153 @@ int StackTimer::status(){
 }
 
 /* ------------ SIMPLE TIMER ------------ */
+int Timer::counters_enabled = -1;
+int Timer::memory_enabled = -1;
+int Timer::counters_fd[TIMER_COUNTERS_NMB] = {-1, -1, -1};
+int Timer::counters_position[TIMER_COUNTERS_NMB] = {-1, -1, -1};
+bool Timer::counters_opened = false;
+
+Timer::Timer(){
+	this->memory_tracking = false;
+	this->memory_peak = 0;
+	this->run_or_not = false;
+	for(int i=0;i<TIMER_COUNTERS_NMB;i++){
+		this->counters_start[i] = 0;
+		this->counters_sum[i] = 0;
+	}
+
+	this->restart();
+}
+
+Timer::Timer(const Timer &timer){
+	this->memory_tracking = false;
+
+	*this = timer;
+}
+
+Timer &Timer::operator=(const Timer &timer){
+	if(this != &timer){
+		this->time_sum = timer.time_sum;
+		this->time_start = timer.time_start;
+		this->time_last = timer.time_last;
+		this->run_or_not = false; /* the copy is not running (the phase of memory measurement is not opened) */
+		this->memory_tracking = timer.memory_tracking;
+		this->memory_peak = timer.memory_peak;
+
+		for(int i=0;i<TIMER_COUNTERS_NMB;i++){
+			this->counters_start[i] = timer.counters_start[i];
+			this->counters_sum[i] = timer.counters_sum[i];
+		}
+	}
+
+	return *this;
+}
+
+Timer::~Timer(){
+	/* close the phase of memory measurement, the pointer to memory_peak would be invalid */
+	if(this->run_or_not && this->memory_tracking && get_memory_enabled()){
+		MemoryCheck::phase_end(&(this->memory_peak));
+	}
+}
+
+bool Timer::get_counters_enabled(){
+	if(counters_enabled < 0){
+		bool counters_enabled_bool;
+		consoleArg.set_option_value("timer_counters", &counters_enabled_bool, TIMER_DEFAULT_COUNTERS);
+		counters_enabled = counters_enabled_bool? 1 : 0;
+	}
+
+	return (counters_enabled == 1);
+}
+
+bool Timer::get_memory_enabled(){
+	if(memory_enabled < 0){
+		bool memory_enabled_bool;
+		consoleArg.set_option_value("timer_memory", &memory_enabled_bool, TIMER_DEFAULT_MEMORY);
+		memory_enabled = memory_enabled_bool? 1 : 0;
+	}
+
+	return (memory_enabled == 1);
+}
+
+void Timer::set_memory_tracking(bool memory_tracking){
+	this->memory_tracking = memory_tracking;
+}
+
+long long Timer::get_memory_peak() const {
+	if(!this->memory_tracking || !get_memory_enabled()){
+		return -1;
+	}
+	return this->memory_peak;
+}
+
+void Timer::counters_open(){
+	counters_opened = true;
+
+#ifdef __linux__
+	unsigned long long configs[TIMER_COUNTERS_NMB];
+	configs[COUNTER_CYCLES] = PERF_COUNT_HW_CPU_CYCLES;
+	configs[COUNTER_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS;
+	configs[COUNTER_LLC_MISSES] = PERF_COUNT_HW_CACHE_MISSES;
+
+	/* the first event is the leader, the group is scheduled on the cpu at once */
+	int nmb_opened = 0;
+	for(int i=0;i<TIMER_COUNTERS_NMB;i++){
+		struct perf_event_attr attr;
+		memset(&attr, 0, sizeof(struct perf_event_attr));
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof(struct perf_event_attr);
+		attr.config = configs[i];
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		/* calling thread, any cpu; if not permitted, then the counter stays unavailable */
+		counters_fd[i] = syscall(__NR_perf_event_open, &attr, 0, -1, (i == 0)? -1 : counters_fd[0], 0);
+		if(counters_fd[i] >= 0){
+			counters_position[i] = nmb_opened;
+			nmb_opened++;
+		}
+
+		/* without the leader there is no group */
+		if(i == 0 && counters_fd[0] < 0){
+			break;
+		}
+	}
+#endif
+}
+
+void Timer::counters_read(long long *values) {
+	for(int i=0;i<TIMER_COUNTERS_NMB;i++){
+		values[i] = 0;
+	}
+
+#ifdef __linux__
+	if(counters_fd[0] < 0){
+		return;
+	}
+
+	/* nr, time_enabled, time_running, values of events in the group */
+	unsigned long long buffer[3 + TIMER_COUNTERS_NMB];
+	ssize_t size = read(counters_fd[0], buffer, sizeof(buffer));
+	if(size < (ssize_t)(3*sizeof(unsigned long long)) || buffer[0] > TIMER_COUNTERS_NMB){
+		return;
+	}
+
+	/* the group was not on the cpu all the time, estimate the counts by scaling */
+	double scale = 1.0;
+	if(buffer[2] > 0 && buffer[2] < buffer[1]){
+		scale = buffer[1]/(double)buffer[2];
+	}
+
+	for(int i=0;i<TIMER_COUNTERS_NMB;i++){
+		if(counters_position[i] >= 0 && counters_position[i] < (int)buffer[0]){
+			values[i] = (long long)(scale*buffer[3 + counters_position[i]]);
+		}
+	}
+#endif
+}
+
 double Timer::getUnixTime(void){
 //	struct timespec tv;
 //	if(clock_gettime(CLOCK_REALTIME, &tv) != 0) return 0;
@@ -45,22 +203,55 @@ double Timer::getUnixTime(void){
 }
 
 void Timer::restart(){
+	if(this->memory_tracking && this->run_or_not && get_memory_enabled()){
+		MemoryCheck::phase_end(&(this->memory_peak));
+	}
+
 	this->time_sum = 0.0;
 	this->time_last = 0.0;
 	this->run_or_not = false;
 	this->time_start = std::numeric_limits<double>::max();
+
+	for(int i=0;i<TIMER_COUNTERS_NMB;i++){
+		this->counters_sum[i] = 0;
+	}
+
+	this->memory_peak = 0;
 }
 
 void Timer::start(){
+	if(!counters_opened && get_counters_enabled()){
+		counters_open();
+	}
+	if(counters_opened){
+		counters_read(this->counters_start);
+	}
+
+	if(this->memory_tracking && !this->run_or_not && get_memory_enabled()){
+		MemoryCheck::phase_begin(&(this->memory_peak));
+	}
+
 	this->time_start = this->getUnixTime();
 	this->run_or_not = true;
 }
 
 void Timer::stop(){
+	if(this->memory_tracking && this->run_or_not && get_memory_enabled()){
+		MemoryCheck::phase_end(&(this->memory_peak));
+	}
+
 	this->time_last = this->getUnixTime() - this->time_start;
 	this->time_sum += this->time_last;
 	this->run_or_not = false;
 	this->time_start = std::numeric_limits<double>::max();
+
+	if(counters_opened){
+		long long counters_stop[TIMER_COUNTERS_NMB];
+		counters_read(counters_stop);
+		for(int i=0;i<TIMER_COUNTERS_NMB;i++){
+			this->counters_sum[i] += counters_stop[i] - this->counters_start[i];
+		}
+	}
 }
 
 double Timer::get_value_sum() const {
@@ -75,6 +266,54 @@ bool Timer::status() const {
 	return this->run_or_not;
 }
 
+bool Timer::counters_available() const {
+	return (counters_fd[0] >= 0);
+}
+
+long long Timer::get_counter_sum(CounterType type) const {
+	if(counters_fd[type] < 0){
+		return -1;
+	}
+	return this->counters_sum[type];
+}
+
+double Timer::get_ipc() const {
+	long long cycles = this->get_counter_sum(COUNTER_CYCLES);
+	long long instructions = this->get_counter_sum(COUNTER_INSTRUCTIONS);
+
+	if(cycles <= 0 || instructions < 0){
+		return -1.0;
+	}
+	return instructions/(double)cycles;
+}
+
+double Timer::get_bytes_per_instruction() const {
+	long long instructions = this->get_counter_sum(COUNTER_INSTRUCTIONS);
+	long long llc_misses = this->get_counter_sum(COUNTER_LLC_MISSES);
+
+	if(instructions <= 0 || llc_misses < 0){
+		return -1.0;
+	}
+	return (TIMER_CACHELINE_SIZE*(double)llc_misses)/(double)instructions;
+}
+
+std::string Timer::get_counters_info() const {
+	std::ostringstream info;
+
+	if(this->counters_available()){
+		info << "cycles=" << this->get_counter_sum(COUNTER_CYCLES);
+		info << ", instr=" << this->get_counter_sum(COUNTER_INSTRUCTIONS);
+		info << ", llc_miss=" << this->get_counter_sum(COUNTER_LLC_MISSES);
+		info << ", IPC=" << this->get_ipc();
+		info << ", B/instr=" << this->get_bytes_per_instruction();
+		if(this->time_sum > 0.0 && this->get_counter_sum(COUNTER_LLC_MISSES) >= 0){
+			info << ", GB/s=" << (TIMER_CACHELINE_SIZE*(double)this->get_counter_sum(COUNTER_LLC_MISSES))/(this->time_sum*1e9);
+		}
+	}
+
+	return info.str();
+}
+
 
 }
 } /* end of namespace */
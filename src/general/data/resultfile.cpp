@@ -0,0 +1,325 @@
+#include "general/data/resultfile.h"
+
+namespace pascinference {
+namespace data {
+
+/* ---------- ResultFileCodec --------- */
+
+int ResultFileCodec::get_labelsize(int K){
+	if(K < 255){
+		return 1; /* 255 is reserved for dense rows */
+	} else {
+		return 2; /* 65535 is reserved for dense rows */
+	}
+}
+
+int ResultFileCodec::encode_raw(const double *values, int nrows, int blocksize, std::vector<char> &buffer){
+	size_t nbytes = (size_t)nrows*blocksize*sizeof(double);
+	size_t old_size = buffer.size();
+	buffer.resize(old_size + nbytes);
+	memcpy(&buffer[old_size], values, nbytes);
+
+	return RESULTFILE_ENCODING_RAW;
+}
+
+int ResultFileCodec::encode_gamma(const double *values, int nrows, int K, double tol, std::vector<char> &buffer){
+	/* there is not enough labels */
+	if(K >= 65535){
+		return encode_raw(values, nrows, K, buffer);
+	}
+
+	int labelsize = get_labelsize(K);
+	int label_dense = (labelsize == 1)? 255 : 65535;
+
+	/* find labels, -1 for rows which are not one-hot */
+	std::vector<int> labels(nrows);
+	int ndense = 0;
+	for(int row=0; row < nrows; row++){
+		const double *values_row = &values[row*K];
+
+		int max_id = 0;
+		for(int k=1; k < K; k++){
+			if(values_row[k] > values_row[max_id]){
+				max_id = k;
+			}
+		}
+
+		bool is_onehot = (std::abs(values_row[max_id] - 1.0) <= tol);
+		for(int k=0; k < K && is_onehot; k++){
+			if(k != max_id && std::abs(values_row[k]) > tol){
+				is_onehot = false;
+			}
+		}
+
+		if(is_onehot){
+			labels[row] = max_id;
+		} else {
+			labels[row] = -1;
+			ndense++;
+		}
+	}
+
+	/* compression does not pay off */
+	if((size_t)nrows*labelsize + (size_t)ndense*K*sizeof(double) >= (size_t)nrows*K*sizeof(double)){
+		return encode_raw(values, nrows, K, buffer);
+	}
+
+	/* labels */
+	size_t old_size = buffer.size();
+	buffer.resize(old_size + (size_t)nrows*labelsize + (size_t)ndense*K*sizeof(double));
+	char *buffer_arr = &buffer[old_size];
+	for(int row=0; row < nrows; row++){
+		int label = (labels[row] >= 0)? labels[row] : label_dense;
+		if(labelsize == 1){
+			((uint8_t *)buffer_arr)[row] = (uint8_t)label;
+		} else {
+			uint16_t label16 = (uint16_t)label;
+			memcpy(&buffer_arr[row*labelsize], &label16, sizeof(uint16_t));
+		}
+	}
+
+	/* dense rows */
+	char *dense_arr = &buffer_arr[nrows*labelsize];
+	for(int row=0; row < nrows; row++){
+		if(labels[row] < 0){
+			memcpy(dense_arr, &values[row*K], K*sizeof(double));
+			dense_arr += K*sizeof(double);
+		}
+	}
+
+	return RESULTFILE_ENCODING_LABEL;
+}
+
+void ResultFileCodec::decode(int encoding, const char *buffer, int64_t nbytes, int nrows, int blocksize, double *values){
+	if(encoding == RESULTFILE_ENCODING_RAW){
+		memcpy(values, buffer, (size_t)nrows*blocksize*sizeof(double));
+	}
+
+	if(encoding == RESULTFILE_ENCODING_LABEL){
+		int labelsize = get_labelsize(blocksize);
+		int label_dense = (labelsize == 1)? 255 : 65535;
+
+		const char *dense_arr = &buffer[nrows*labelsize];
+		for(int row=0; row < nrows; row++){
+			int label;
+			if(labelsize == 1){
+				label = ((const uint8_t *)buffer)[row];
+			} else {
+				uint16_t label16;
+				memcpy(&label16, &buffer[row*labelsize], sizeof(uint16_t));
+				label = label16;
+			}
+
+			if(label == label_dense){
+				memcpy(&values[row*blocksize], dense_arr, blocksize*sizeof(double));
+				dense_arr += blocksize*sizeof(double);
+			} else {
+				for(int k=0; k < blocksize; k++){
+					values[row*blocksize + k] = 0.0;
+				}
+				values[row*blocksize + label] = 1.0;
+			}
+		}
+	}
+}
+
+/* ---------- ResultFileReader --------- */
+
+ResultFileReader::ResultFileReader(std::string filename){
+	LOG_FUNC_BEGIN
+
+	this->filename = filename;
+	this->file.open(filename.c_str(), std::ios::in | std::ios::binary);
+
+	if(!this->file.is_open()){
+		coutMaster << "ERROR: result file " << filename << " cannot be opened" << std::endl;
+		this->header.T = 0;
+		this->header.R = 0;
+		this->header.K = 0;
+		this->header.xdim = 0;
+	} else {
+		/* read header with the position of table of finished records */
+		this->file.read((char *)&this->header, sizeof(ResultFileHeader));
+		if(strncmp(this->header.magic, RESULTFILE_MAGIC, 8) != 0 || this->header.version != RESULTFILE_VERSION){
+			coutMaster << "ERROR: " << filename << " is not a result file of version " << RESULTFILE_VERSION << std::endl;
+			this->header.nrecords = 0;
+		}
+
+		/* read table of records */
+		this->records.resize(this->header.nrecords);
+		if(this->header.nrecords > 0){
+			this->file.seekg(this->header.table_offset, std::ios::beg);
+			this->file.read((char *)&this->records[0], this->header.nrecords*sizeof(ResultFileRecord));
+			if(!this->file){
+				coutMaster << "ERROR: the table of records in result file " << filename << " is damaged" << std::endl;
+				this->records.clear();
+				this->file.clear();
+			}
+		}
+	}
+
+	LOG_FUNC_END
+}
+
+ResultFileReader::~ResultFileReader(){
+	LOG_FUNC_BEGIN
+
+	if(this->file.is_open()){
+		this->file.close();
+	}
+
+	LOG_FUNC_END
+}
+
+void ResultFileReader::print(ConsoleOutput &output) const {
+	LOG_FUNC_BEGIN
+
+	output << "ResultFileReader" << std::endl;
+	output << " - filename: " << this->filename << std::endl;
+	output << " - T:        " << get_T() << std::endl;
+	output << " - R:        " << get_R() << std::endl;
+	output << " - K:        " << get_K() << std::endl;
+	output << " - xdim:     " << get_xdim() << std::endl;
+	output << " - records:  " << get_nrecords() << std::endl;
+	output.push();
+	for(int i=0; i < get_nrecords(); i++){
+		output << i << ": epssqr = " << get_epssqr(i) << ", id = " << get_id(i) << std::endl;
+	}
+	output.pop();
+
+	LOG_FUNC_END
+}
+
+int ResultFileReader::get_T() const {
+	return this->header.T;
+}
+
+int ResultFileReader::get_R() const {
+	return this->header.R;
+}
+
+int ResultFileReader::get_K() const {
+	return this->header.K;
+}
+
+int ResultFileReader::get_xdim() const {
+	return this->header.xdim;
+}
+
+int ResultFileReader::get_nrecords() const {
+	return this->records.size();
+}
+
+double ResultFileReader::get_epssqr(int record) const {
+	return this->records[record].epssqr;
+}
+
+int ResultFileReader::get_id(int record) const {
+	return this->records[record].id;
+}
+
+int ResultFileReader::find_record(double epssqr) const {
+	for(int i=0; i < get_nrecords(); i++){
+		if(this->records[i].epssqr == epssqr){
+			return i;
+		}
+	}
+	return -1;
+}
+
+void ResultFileReader::read_chunks(int record, int field, std::vector<ResultFileChunk> &chunks) {
+	const ResultFileField *fieldinfo = &(this->records[record].fields[field]);
+
+	chunks.resize(fieldinfo->nchunks);
+	if(fieldinfo->nchunks > 0){
+		this->file.seekg(fieldinfo->index_offset, std::ios::beg);
+		this->file.read((char *)&chunks[0], fieldinfo->nchunks*sizeof(ResultFileChunk));
+	}
+}
+
+bool ResultFileReader::read(int record, int field, int component, int tbegin, int tend, double *values) {
+	LOG_FUNC_BEGIN
+
+	/* data are stored only once, in the first record where they were saved */
+	if(field == RESULTFILE_FIELD_DATA && this->records[record].fields[field].nchunks == 0){
+		for(int i=0; i < get_nrecords(); i++){
+			if(this->records[i].fields[field].nchunks > 0){
+				record = i;
+				break;
+			}
+		}
+	}
+
+	const ResultFileField *fieldinfo = &(this->records[record].fields[field]);
+	if(fieldinfo->nchunks == 0){
+		LOG_FUNC_END
+		return false;
+	}
+
+	int R = get_R();
+	int blocksize = fieldinfo->blocksize;
+	int64_t row_begin = (int64_t)tbegin*R;
+	int64_t row_end = (int64_t)tend*R;
+
+	std::vector<ResultFileChunk> chunks;
+	read_chunks(record, field, chunks);
+
+	std::vector<char> buffer;
+	std::vector<double> chunk_values;
+
+	/* go through chunks which intersect with given time window */
+	for(size_t i=0; i < chunks.size(); i++){
+		int64_t chunk_begin = chunks[i].row_begin;
+		int64_t chunk_end = chunks[i].row_begin + chunks[i].nrows;
+		if(chunk_end <= row_begin || chunk_begin >= row_end){
+			continue;
+		}
+
+		buffer.resize(chunks[i].nbytes);
+		this->file.seekg(chunks[i].offset, std::ios::beg);
+		this->file.read(&buffer[0], chunks[i].nbytes);
+
+		chunk_values.resize((size_t)chunks[i].nrows*blocksize);
+		ResultFileCodec::decode(chunks[i].encoding, &buffer[0], chunks[i].nbytes, chunks[i].nrows, blocksize, &chunk_values[0]);
+
+		int64_t from = std::max(chunk_begin, row_begin);
+		int64_t to = std::min(chunk_end, row_end);
+		for(int64_t row = from; row < to; row++){
+			values[row - row_begin] = chunk_values[(row - chunk_begin)*blocksize + component];
+		}
+	}
+
+	LOG_FUNC_END
+
+	return true;
+}
+
+bool ResultFileReader::read_theta(int record, double *values) {
+	LOG_FUNC_BEGIN
+
+	const ResultFileField *fieldinfo = &(this->records[record].fields[RESULTFILE_FIELD_THETA]);
+	if(fieldinfo->nchunks == 0){
+		LOG_FUNC_END
+		return false;
+	}
+
+	std::vector<ResultFileChunk> chunks;
+	read_chunks(record, RESULTFILE_FIELD_THETA, chunks);
+
+	std::vector<char> buffer;
+	for(size_t i=0; i < chunks.size(); i++){
+		buffer.resize(chunks[i].nbytes);
+		this->file.seekg(chunks[i].offset, std::ios::beg);
+		this->file.read(&buffer[0], chunks[i].nbytes);
+
+		ResultFileCodec::decode(chunks[i].encoding, &buffer[0], chunks[i].nbytes, chunks[i].nrows, fieldinfo->blocksize, &values[chunks[i].row_begin*fieldinfo->blocksize]);
+	}
+
+	LOG_FUNC_END
+
+	return true;
+}
+
+
+}
+} /* end namespace */
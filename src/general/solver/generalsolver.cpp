@@ -106,6 +106,16 @@ void GeneralSolver::set_eps(double eps) {
 	this->eps = eps;
 }
 
+int GeneralSolver::get_state_size() const {
+	return 0;
+}
+
+void GeneralSolver::get_state(double *state) const {
+}
+
+void GeneralSolver::set_state(const double *state) {
+}
+
 
 
 }
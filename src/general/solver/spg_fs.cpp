@@ -62,6 +62,29 @@ void SPG_fs::update(double new_fx){
 	LOG_FUNC_END
 }
 
+/* copy the list, the oldest value first */
+void SPG_fs::get_values(double *values) const {
+	LOG_FUNC_BEGIN
+
+	for(int i=0;i<this->m;i++){
+		values[i] = this->fs_list[(this->last_idx + 1 + i) % this->m];
+	}
+
+	LOG_FUNC_END
+}
+
+/* set the list, the newest value is the last one */
+void SPG_fs::set_values(const double *values){
+	LOG_FUNC_BEGIN
+
+	for(int i=0;i<this->m;i++){
+		this->fs_list[i] = values[i];
+	}
+	this->last_idx = this->m-1;
+
+	LOG_FUNC_END
+}
+
 /* print the content of the list */
 void SPG_fs::print(ConsoleOutput &output)
 {
@@ -30,10 +30,89 @@ BGMGraph<PetscVector>::BGMGraph(const double *coordinates_array, int n, int dim)
 	LOG_FUNC_END
 }
 
+template<>
+BGMGraph<PetscVector>::BGMGraph(const BGMGraph<PetscVector> &graph, int nmb_copies){
+	LOG_FUNC_BEGIN
+
+	int n1 = graph.get_n();
+
+	this->dim = graph.get_dim();
+	this->n = nmb_copies*n1;
+
+	/* coordinates of copies, shifted in first dimension */
+	Vec coordinates_Vec;
+	TRYCXX( VecCreateSeq(PETSC_COMM_SELF, this->n*this->dim, &coordinates_Vec) );
+
+	const double *coordinates1_arr;
+	double *coordinates_arr;
+	TRYCXX( VecGetArrayRead(graph.get_coordinates()->get_vector(), &coordinates1_arr) );
+	TRYCXX( VecGetArray(coordinates_Vec, &coordinates_arr) );
+
+	double x_min = std::numeric_limits<double>::max();
+	double x_max = -std::numeric_limits<double>::max();
+	for(int i=0;i<n1;i++){
+		if(coordinates1_arr[i] < x_min) x_min = coordinates1_arr[i];
+		if(coordinates1_arr[i] > x_max) x_max = coordinates1_arr[i];
+	}
+	double shift = (n1 > 0)? x_max - x_min + 2.0 : 0.0;
+
+	for(int c=0;c<nmb_copies;c++){
+		for(int d=0;d<this->dim;d++){
+			for(int i=0;i<n1;i++){
+				coordinates_arr[d*this->n + c*n1 + i] = coordinates1_arr[d*n1 + i] + ((d == 0)? c*shift : 0.0);
+			}
+		}
+	}
+
+	TRYCXX( VecRestoreArray(coordinates_Vec, &coordinates_arr) );
+	TRYCXX( VecRestoreArrayRead(graph.get_coordinates()->get_vector(), &coordinates1_arr) );
+
+	coordinates = new GeneralVector<PetscVector>(coordinates_Vec);
+
+	/* copy neighbors, there are no edges between copies */
+	int *neighbor_nmbs1 = graph.get_neighbor_nmbs();
+	int **neighbor_ids1 = graph.get_neighbor_ids();
+
+	neighbor_nmbs = (int*)malloc(this->n*sizeof(int));
+	neighbor_ids = (int**)malloc(this->n*sizeof(int*));
+	for(int c=0;c<nmb_copies;c++){
+		for(int i=0;i<n1;i++){
+			int idx = c*n1 + i;
+			neighbor_nmbs[idx] = neighbor_nmbs1[i];
+			neighbor_ids[idx] = (int*)malloc(neighbor_nmbs[idx]*sizeof(int));
+			for(int j=0;j<neighbor_nmbs[idx];j++){
+				neighbor_ids[idx][j] = c*n1 + neighbor_ids1[i][j];
+			}
+		}
+	}
+
+	m = nmb_copies*graph.get_m();
+	m_max = graph.get_m_max();
+	threshold = graph.get_threshold();
+
+	DD_decomposed = false;
+
+	/* prepare external content with PETSc stuff */
+	externalcontent = new ExternalContent();
+	externalcontent->n = n;
+
+	MemoryCheck::owned_add("BGMGraph", n*(sizeof(int) + sizeof(int*)) + 2*m*sizeof(int));
+
+	#ifdef USE_CUDA
+		externalcontent->cuda_process(neighbor_nmbs, neighbor_ids);
+	#endif
+
+	processed = true;
+
+	LOG_FUNC_END
+}
+
 template<>
 BGMGraph<PetscVector>::~BGMGraph(){
 	/* if the graph was processed, then free memory */
 	if(processed){
+		MemoryCheck::owned_remove("BGMGraph", n*(sizeof(int) + sizeof(int*)) + 2*m*sizeof(int));
+
 		free(neighbor_nmbs);
 		int i;
 		for(i=0;i<n;i++){
@@ -140,6 +219,8 @@ void BGMGraph<PetscVector>::process(double threshold) {
 		}
 	}
 	free(counters);
+
+	MemoryCheck::owned_add("BGMGraph", n*(sizeof(int) + sizeof(int*)) + 2*m*sizeof(int));
 	
 	/* restore array */
 	TRYCXX( VecRestoreArrayRead(coordinates->get_vector(),&coordinates_arr) );
@@ -169,32 +250,32 @@ void BGMGraph<PetscVector>::saveVTK(std::string filename) const {
 		myfile.open(filename.c_str());
 
 		/* write header to file */
-		myfile << "# vtk DataFile Version 3.1" << std::endl;
-		myfile << "PASCInference: Graph" << std::endl;
-		myfile << "ASCII" << std::endl;
-		myfile << "DATASET UNSTRUCTURED_GRID" << std::endl;
+		myfile << "# vtk DataFile Version 3.1\n";
+		myfile << "PASCInference: Graph\n";
+		myfile << "ASCII\n";
+		myfile << "DATASET UNSTRUCTURED_GRID\n";
 
 		/* write points - coordinates */
-		myfile << "POINTS " << n << " FLOAT" << std::endl;
+		myfile << "POINTS " << n << " FLOAT\n";
 		const double *coordinates_arr;
 		TRYCXX( VecGetArrayRead(coordinates->get_vector(),&coordinates_arr) );
 		for(int i=0;i<n;i++){
 			if(dim == 1){ 
 				/* 1D sample */
-				myfile << coordinates_arr[i] << " 0 0" << std::endl; /* x */
+				myfile << coordinates_arr[i] << " 0 0\n"; /* x */
 			}
 
 			if(dim == 2){ 
 				/* 2D sample */
 				myfile << coordinates_arr[i] << " "; /* x */
-				myfile << coordinates_arr[n+i] << " 0" << std::endl; /* y */
+				myfile << coordinates_arr[n+i] << " 0\n"; /* y */
 			}
 
 			if(dim == 3){ 
 				/* 3D sample */
 				myfile << coordinates_arr[i] << " "; /* x */
 				myfile << coordinates_arr[n+i] << " "; /* y */
-				myfile << coordinates_arr[2*n+i] << std::endl; /* z */
+				myfile << coordinates_arr[2*n+i] << "\n"; /* z */
 			}
 
 			if(dim > 3){
@@ -204,26 +285,29 @@ void BGMGraph<PetscVector>::saveVTK(std::string filename) const {
 		TRYCXX( VecRestoreArrayRead(coordinates->get_vector(),&coordinates_arr) );
 		
 		/* write edges */
-		myfile << "\nCELLS " << 2*m << " " << 2*m*3 << std::endl; /* actually, edges are here twice */
+		/* neighbor lists are symmetric, write every edge only once */
+		myfile << "\nCELLS " << m << " " << m*3 << "\n";
 		for(int i=0;i<n;i++){
 			for(int j=0;j<neighbor_nmbs[i];j++){
-				myfile << "2 " << i << " " << neighbor_ids[i][j] << std::endl;
+				if(i < neighbor_ids[i][j]){
+					myfile << "2 " << i << " " << neighbor_ids[i][j] << "\n";
+				}
 			}
 		}
-		myfile << "\nCELL_TYPES " << 2*m << std::endl;
-		for(int i=0;i<2*m;i++){
-			myfile << "3" << std::endl;
+		myfile << "\nCELL_TYPES " << m << "\n";
+		for(int i=0;i<m;i++){
+			myfile << "3\n";
 		}
 		
 		/* write domain affiliation */
-		myfile << "\nPOINT_DATA " << n << std::endl;
-		myfile << "SCALARS domain float 1" << std::endl;
-		myfile << "LOOKUP_TABLE default" << std::endl;
+		myfile << "\nPOINT_DATA " << n << "\n";
+		myfile << "SCALARS domain float 1\n";
+		myfile << "LOOKUP_TABLE default\n";
 		for(int i=0;i<n;i++){
 			if(DD_decomposed){
-				myfile << DD_affiliation[i] << std::endl;
+				myfile << DD_affiliation[i] << "\n";
 			} else {
-				myfile << "-1" << std::endl;
+				myfile << "-1\n";
 			}
 		}
 		
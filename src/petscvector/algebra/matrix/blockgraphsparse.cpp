@@ -12,48 +12,346 @@ BlockGraphSparseMatrix<PetscVector>::BlockGraphSparseMatrix(Decomposition<PetscV
 	this->alpha = alpha;
 	this->coeffs = new_coeffs;
 
+	consoleArg.set_option_value("blockgraphsparsematrix_lambdamax_lanczos", &this->lambda_max_lanczos, BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_LANCZOS);
+	consoleArg.set_option_value("blockgraphsparsematrix_lambdamax_maxit", &this->lambda_max_maxit, BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_MAXIT);
+	consoleArg.set_option_value("blockgraphsparsematrix_lambdamax_eps", &this->lambda_max_eps, BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_EPS);
+	this->lambda_max_unscaled = -1.0; /* will be computed when it is needed for the first time */
+
 	int K = get_K();
 	
 	int T = get_T();
 	int Tlocal = get_Tlocal();
-	int Tbegin = decomposition->get_Tbegin();
-	int Tend = decomposition->get_Tend();
 	int R = get_R();
 	int Rlocal = get_Rlocal();
+
+	/* prepare external content with PETSc stuff */
+	externalcontent = new ExternalContent();
+	externalcontent->stencil = false;
+	externalcontent->scale = 1.0;
+
+	bool use_stencil;
+	consoleArg.set_option_value("blockgraphsparsematrix_stencil", &use_stencil, BLOCKGRAPHSPARSEMATRIX_DEFAULT_STENCIL);
+
+	#ifndef USE_CUDA
+		/* stencil works with local arrays on host */
+		if(use_stencil){
+			externalcontent->stencil = externalcontent->prepare_stencil(decomposition);
+		}
+	#endif
+
+	if(externalcontent->stencil){
+		/* there is nothing to assemble, MatMult is performed by stencil */
+		TRYCXX( MatCreateShell(PETSC_COMM_WORLD,K*Rlocal*Tlocal,K*Rlocal*Tlocal,K*R*T,K*R*T,(void*)externalcontent,&(externalcontent->A_petsc)) );
+		TRYCXX( MatShellSetOperation(externalcontent->A_petsc, MATOP_MULT, (void(*)(void))(ExternalContent::stencil_mult)) );
+		TRYCXX( MatShellSetOperation(externalcontent->A_petsc, MATOP_MULT_TRANSPOSE, (void(*)(void))(ExternalContent::stencil_mult)) ); /* matrix is symmetric */
+		TRYCXX( MatShellSetOperation(externalcontent->A_petsc, MATOP_SCALE, (void(*)(void))(ExternalContent::stencil_scale)) );
+		TRYCXX( MatShellSetOperation(externalcontent->A_petsc, MATOP_GET_DIAGONAL, (void(*)(void))(ExternalContent::stencil_get_diagonal)) );
+		TRYCXX( PetscObjectSetName((PetscObject)(externalcontent->A_petsc),"Regularization matrix") );
+
+		MemoryCheck::owned_add("BlockGraphSparseMatrix", externalcontent->get_stencil_memory());
+	} else {
+		/* assemble sparse matrix */
+		externalcontent->assemble(decomposition);
+
+		/* register memory of local part of matrix */
+		MatInfo matinfo;
+		TRYCXX( MatGetInfo(externalcontent->A_petsc, MAT_LOCAL, &matinfo) );
+		MemoryCheck::owned_add("BlockGraphSparseMatrix", (long long)matinfo.memory);
+	}
+
+	LOG_FUNC_END
+}	
+
+
+template<>
+BlockGraphSparseMatrix<PetscVector>::~BlockGraphSparseMatrix(){
+	LOG_FUNC_BEGIN
+	
+	if(petscvector::PETSC_INITIALIZED){ /* maybe Petsc was already finalized and there is nothing to destroy */
+		if(externalcontent->stencil){
+			MemoryCheck::owned_remove("BlockGraphSparseMatrix", externalcontent->get_stencil_memory());
+
+			TRYCXX( VecScatterDestroy(&(externalcontent->halo_scatter)) );
+			TRYCXX( VecDestroy(&(externalcontent->halo_Vec)) );
+		} else {
+			MatInfo matinfo;
+			TRYCXX( MatGetInfo(externalcontent->A_petsc, MAT_LOCAL, &matinfo) );
+			MemoryCheck::owned_remove("BlockGraphSparseMatrix", (long long)matinfo.memory);
+		}
+
+		TRYCXX( MatDestroy(&(externalcontent->A_petsc)) );
+	}
+	
+	LOG_FUNC_END	
+}
+
+/* print matrix */
+template<>
+void BlockGraphSparseMatrix<PetscVector>::printcontent(ConsoleOutput &output) const
+{
+	LOG_FUNC_BEGIN
+	
+	if(externalcontent->stencil){
+		output << "BlockGraphMatrix is not assembled, the stencil on grid is used" << std::endl;
+
+		LOG_FUNC_END
+		return;
+	}
+
+	output << "BlockGraphMatrix (sorry, 'only' MatView from Petsc follows):" << std::endl;
+	output << "----------------------------------------------------------" << std::endl;
+	
+	TRYCXX( MatView(externalcontent->A_petsc, PETSC_VIEWER_STDOUT_WORLD) );
+
+	output << "----------------------------------------------------------" << std::endl;
+	
+	LOG_FUNC_END
+}
+
+/* matrix-vector multiplication */
+template<>
+void BlockGraphSparseMatrix<PetscVector>::matmult(PetscVector &y, const PetscVector &x) const { 
+	LOG_FUNC_BEGIN
+	
+	// TODO: maybe y is not initialized, who knows
+
+	/* multiply with constant part of matrix */
+	TRYCXX( MatMult(externalcontent->A_petsc, x.get_vector(), y.get_vector()) );
+
+	/* multiply with coeffs */
+	if(coeffs){
+		int K = decomposition->get_K();
+		
+		double *coeffs_arr;
+		TRYCXX( VecGetArray(coeffs->get_vector(),&coeffs_arr) );
+
+		Vec xk_Vec;
+		Vec x_Vec = y.get_vector();
+		IS xk_is;
+		double coeff;
+		
+		/* get vector corresponding to coeff */
+		for(int k=0;k<K;k++){
+			this->decomposition->createIS_gammaK(&xk_is, k);
+			TRYCXX( VecGetSubVector(x_Vec, xk_is, &xk_Vec) );
+			
+//			coeff = coeffs_arr[k]*coeffs_arr[k];
+			coeff = alpha*coeffs_arr[k]*coeffs_arr[k];
+			TRYCXX( VecScale(xk_Vec, coeff) );
+
+			TRYCXX( VecRestoreSubVector(x_Vec, xk_is, &xk_Vec) );
+			TRYCXX( ISDestroy(&xk_is) );
+		}
+
+		TRYCXX( VecRestoreArray(coeffs->get_vector(),&coeffs_arr) );
+	} else {
+	    TRYCXX( VecScale(y.get_vector(), this->alpha) );
+	}
+
+	TRYCXX( VecAssemblyBegin(y.get_vector()) );
+	TRYCXX( VecAssemblyEnd(y.get_vector()) );
+
+	LOG_FUNC_END
+}
+
+/* the largest eigenvalue of symmetric tridiagonal matrix with diagonal a and offdiagonal b, bisection with Sturm sequence */
+double blockgraphsparse_tridiag_lambda_max(const std::vector<double> &a, const std::vector<double> &b){
+	int n = a.size();
+
+	/* Gershgorin interval */
+	double lower = a[0];
+	double upper = a[0];
+	for(int i=0;i<n;i++){
+		double radius = 0.0;
+		if(i > 0) radius += std::abs(b[i-1]);
+		if(i < n-1) radius += std::abs(b[i]);
+		lower = std::min(lower, a[i] - radius);
+		upper = std::max(upper, a[i] + radius);
+	}
+
+	for(int it=0; it < 100 && upper - lower > 1e-14*std::abs(upper); it++){
+		double middle = 0.5*(lower + upper);
+
+		/* number of eigenvalues smaller than middle */
+		int count = 0;
+		double q = a[0] - middle;
+		if(q < 0.0) count++;
+		for(int i=1;i<n;i++){
+			if(q == 0.0) q = 1e-300;
+			q = a[i] - middle - b[i-1]*b[i-1]/q;
+			if(q < 0.0) count++;
+		}
+
+		if(count == n){
+			upper = middle;
+		} else {
+			lower = middle;
+		}
+	}
+
+	return upper;
+}
+
+/* Lanczos method on the unscaled matrix, the largest Ritz value converges fast to the largest eigenvalue */
+template<>
+void BlockGraphSparseMatrix<PetscVector>::compute_lambda_max() const {
+	LOG_FUNC_BEGIN
+
+	Mat A_Mat = externalcontent->A_petsc;
+
+	Vec v_Vec, v_old_Vec, w_Vec, temp_Vec;
+	TRYCXX( MatCreateVecs(A_Mat, &v_Vec, &w_Vec) );
+	TRYCXX( VecDuplicate(v_Vec, &v_old_Vec) );
+	TRYCXX( VecSet(v_old_Vec, 0.0) );
+
+	/* random initial vector */
+	PetscRandom rctx;
+	TRYCXX( PetscRandomCreate(PETSC_COMM_WORLD,&rctx) );
+	TRYCXX( PetscRandomSetFromOptions(rctx) );
+	TRYCXX( VecSetRandom(v_Vec, rctx) );
+	TRYCXX( PetscRandomDestroy(&rctx) );
+
+	double normv;
+	TRYCXX( VecNorm(v_Vec, NORM_2, &normv) );
+	TRYCXX( VecScale(v_Vec, 1.0/normv) );
+
+	std::vector<double> lanczos_a; /* diagonal of Lanczos tridiagonal matrix */
+	std::vector<double> lanczos_b; /* offdiagonal of Lanczos tridiagonal matrix */
+
+	double a, b;
+	double b_old = 0.0;
+	double lambda = 0.0;
+	double lambda_old;
+	for(int it=0; it < this->lambda_max_maxit; it++){
+		/* w = A*v - a*v - b_old*v_old */
+		TRYCXX( MatMult(A_Mat, v_Vec, w_Vec) );
+		TRYCXX( VecDot(w_Vec, v_Vec, &a) );
+		TRYCXX( VecAXPBYPCZ(w_Vec, -a, -b_old, 1.0, v_Vec, v_old_Vec) );
+		TRYCXX( VecNorm(w_Vec, NORM_2, &b) );
+
+		lanczos_a.push_back(a);
+
+		lambda_old = lambda;
+		lambda = blockgraphsparse_tridiag_lambda_max(lanczos_a, lanczos_b);
+
+		/* invariant subspace was found or the estimation does not change */
+		if(b <= 1e-12*lambda || std::abs(lambda - lambda_old) < this->lambda_max_eps*lambda){
+			break;
+		}
+
+		lanczos_b.push_back(b);
+
+		/* v_old = v, v = w/b */
+		temp_Vec = v_old_Vec;
+		v_old_Vec = v_Vec;
+		v_Vec = w_Vec;
+		w_Vec = temp_Vec;
+		TRYCXX( VecScale(v_Vec, 1.0/b) );
+		b_old = b;
+	}
+
+	TRYCXX( VecDestroy(&v_Vec) );
+	TRYCXX( VecDestroy(&v_old_Vec) );
+	TRYCXX( VecDestroy(&w_Vec) );
+
+	/* Ritz value is not larger than the largest eigenvalue, Gershgorin bound is not smaller */
+	this->lambda_max_unscaled = std::min(std::max(lambda, 0.0), get_lambda_max_gershgorin());
+
+	LOG_FUNC_END
+}
+
+/* the same scaling as in matmult, the step-size has to be the same on all processes */
+template<>
+double BlockGraphSparseMatrix<PetscVector>::get_lambda_max_scale() const {
+	double scale = this->alpha;
+
+	if(coeffs){
+		int K = decomposition->get_K();
+
+		double *coeffs_arr;
+		TRYCXX( VecGetArray(coeffs->get_vector(),&coeffs_arr) );
+
+		double coeff_max_local = 0.0;
+		for(int k=0;k<K;k++){
+			coeff_max_local = std::max(coeff_max_local, coeffs_arr[k]*coeffs_arr[k]);
+		}
+
+		TRYCXX( VecRestoreArray(coeffs->get_vector(),&coeffs_arr) );
+
+		double coeff_max;
+		MPI_Allreduce(&coeff_max_local, &coeff_max, 1, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+
+		scale *= coeff_max;
+	}
+
+	return scale;
+}
+
+template<>
+void BlockGraphSparseMatrix<PetscVector>::get_scaling(std::vector<double> &scaling) const {
+	int K = decomposition->get_K();
+
+	/* the same scaling as in matmult */
+	scaling.assign(K, this->alpha);
+	if(coeffs){
+		double *coeffs_arr;
+		TRYCXX( VecGetArray(coeffs->get_vector(),&coeffs_arr) );
+
+		for(int k=0;k<K;k++){
+			scaling[k] = alpha*coeffs_arr[k]*coeffs_arr[k];
+		}
+
+		TRYCXX( VecRestoreArray(coeffs->get_vector(),&coeffs_arr) );
+	}
+}
+
+template<>
+BlockGraphSparseMatrix<PetscVector>::ExternalContent * BlockGraphSparseMatrix<PetscVector>::get_externalcontent() const {
+	return this->externalcontent;
+}
+
+/* ----------------------- external content */
+void BlockGraphSparseMatrix<PetscVector>::ExternalContent::assemble(Decomposition<PetscVector> *decomposition) {
+	LOG_FUNC_BEGIN
+
+	int K = decomposition->get_K();
+	int T = decomposition->get_T();
+	int Tlocal = decomposition->get_Tlocal();
+	int Tbegin = decomposition->get_Tbegin();
+	int Tend = decomposition->get_Tend();
+	int R = decomposition->get_R();
+	int Rlocal = decomposition->get_Rlocal();
 	int Rbegin = decomposition->get_Rbegin();
 	int Rend = decomposition->get_Rend();
 
 	int* neighbor_nmbs = decomposition->get_graph()->get_neighbor_nmbs();
 	int **neightbor_ids = decomposition->get_graph()->get_neighbor_ids();
 
-	/* prepare external content with PETSc stuff */
-	externalcontent = new ExternalContent();
-
 	/* create matrix */
-	TRYCXX( MatCreate(PETSC_COMM_WORLD,&(externalcontent->A_petsc)) );
-	TRYCXX( MatSetSizes(externalcontent->A_petsc,K*Rlocal*Tlocal,K*Rlocal*Tlocal,K*R*T,K*R*T) );
+	TRYCXX( MatCreate(PETSC_COMM_WORLD,&(A_petsc)) );
+	TRYCXX( MatSetSizes(A_petsc,K*Rlocal*Tlocal,K*Rlocal*Tlocal,K*R*T,K*R*T) );
 
 	#ifndef USE_CUDA
-		TRYCXX( MatSetType(externalcontent->A_petsc,MATMPIAIJ) ); 
+		TRYCXX( MatSetType(A_petsc,MATMPIAIJ) ); 
 	#else
-		TRYCXX( MatSetType(externalcontent->A_petsc,MATAIJCUSPARSE) ); 
+		TRYCXX( MatSetType(A_petsc,MATAIJCUSPARSE) ); 
 	#endif
 
 	/* compute preallocation of number of non-zero elements in matrix */
-	TRYCXX( MatMPIAIJSetPreallocation(externalcontent->A_petsc,3*(1+2*decomposition->get_graph()->get_m_max()),NULL,2*(decomposition->get_graph()->get_m_max()+1),NULL) ); 
-	TRYCXX( MatSeqAIJSetPreallocation(externalcontent->A_petsc,3*(1+2*decomposition->get_graph()->get_m_max()),NULL) );
+	TRYCXX( MatMPIAIJSetPreallocation(A_petsc,3*(1+2*decomposition->get_graph()->get_m_max()),NULL,2*(decomposition->get_graph()->get_m_max()+1),NULL) ); 
+	TRYCXX( MatSeqAIJSetPreallocation(A_petsc,3*(1+2*decomposition->get_graph()->get_m_max()),NULL) );
+
+	TRYCXX( MatSetFromOptions(A_petsc) ); 
 
-	TRYCXX( MatSetFromOptions(externalcontent->A_petsc) ); 
-	
 	double coeff = 1.0;
-	
+
 ////	#pragma omp parallel for
 	for(int k=0; k < K; k++){
 		for(int r=Rbegin; r < Rend; r++){
 			for(int t=Tbegin;t < Tend;t++){
 				int diag_idx = t*R*K + r*K + k;
 				int r_orig = decomposition->get_invPr(r);
-				
+			
 				int Wsum;
 
 				/* compute sum of W entries in row */
@@ -72,19 +370,19 @@ BlockGraphSparseMatrix<PetscVector>::BlockGraphSparseMatrix(Decomposition<PetscV
 						Wsum = (neighbor_nmbs[r_orig])+1; /* +1 for diagonal block */
 					}
 				}
-				
+			
 				/* diagonal entry */
-				TRYCXX( MatSetValue(externalcontent->A_petsc, diag_idx, diag_idx, coeff*Wsum, INSERT_VALUES) );
+				TRYCXX( MatSetValue(A_petsc, diag_idx, diag_idx, coeff*Wsum, INSERT_VALUES) );
 
 				/* my nondiagonal entries */
 				if(T>1){
 					if(t > 0) {
 						/* t - 1 */
-						TRYCXX( MatSetValue(externalcontent->A_petsc, diag_idx, diag_idx-R*K, -2*coeff, INSERT_VALUES) );
+						TRYCXX( MatSetValue(A_petsc, diag_idx, diag_idx-R*K, -2*coeff, INSERT_VALUES) );
 					}
 					if(t < T-1) {
 						/* t + 1 */
-						TRYCXX( MatSetValue(externalcontent->A_petsc, diag_idx, diag_idx+R*K, -2*coeff, INSERT_VALUES) );
+						TRYCXX( MatSetValue(A_petsc, diag_idx, diag_idx+R*K, -2*coeff, INSERT_VALUES) );
 					}
 				}
 
@@ -93,13 +391,13 @@ BlockGraphSparseMatrix<PetscVector>::BlockGraphSparseMatrix(Decomposition<PetscV
 					int r_new = decomposition->get_Pr(neightbor_ids[r_orig][neighbor]);
 					int idx2 = t*R*K + r_new*K + k;
 
-					TRYCXX( MatSetValue(externalcontent->A_petsc, diag_idx, idx2, -coeff, INSERT_VALUES) );
-//					TRYCXX( MatSetValue(externalcontent->A_petsc, idx2, diag_idx, -coeff, INSERT_VALUES) );
+					TRYCXX( MatSetValue(A_petsc, diag_idx, idx2, -coeff, INSERT_VALUES) );
+//					TRYCXX( MatSetValue(A_petsc, idx2, diag_idx, -coeff, INSERT_VALUES) );
 					if(t > 0) {
-						TRYCXX( MatSetValue(externalcontent->A_petsc, diag_idx, idx2-R*K, -coeff, INSERT_VALUES) );
+						TRYCXX( MatSetValue(A_petsc, diag_idx, idx2-R*K, -coeff, INSERT_VALUES) );
 					}
 					if(t < T-1) {
-						TRYCXX( MatSetValue(externalcontent->A_petsc, diag_idx, idx2+R*K, -coeff, INSERT_VALUES) );
+						TRYCXX( MatSetValue(A_petsc, diag_idx, idx2+R*K, -coeff, INSERT_VALUES) );
 					}
 				}
 			} /* end T */
@@ -112,90 +410,322 @@ BlockGraphSparseMatrix<PetscVector>::BlockGraphSparseMatrix(Decomposition<PetscV
 	TRYCXX( PetscBarrier(NULL) );
 
 	/* assemble matrix */
-	TRYCXX( MatAssemblyBegin(externalcontent->A_petsc,MAT_FINAL_ASSEMBLY) );
-	TRYCXX( MatAssemblyEnd(externalcontent->A_petsc,MAT_FINAL_ASSEMBLY) );
-	TRYCXX( PetscObjectSetName((PetscObject)(externalcontent->A_petsc),"Regularization matrix") );
+	TRYCXX( MatAssemblyBegin(A_petsc,MAT_FINAL_ASSEMBLY) );
+	TRYCXX( MatAssemblyEnd(A_petsc,MAT_FINAL_ASSEMBLY) );
+	TRYCXX( PetscObjectSetName((PetscObject)(A_petsc),"Regularization matrix") );
 
 	LOG_FUNC_END
-}	
-
+}
 
-template<>
-BlockGraphSparseMatrix<PetscVector>::~BlockGraphSparseMatrix(){
+bool BlockGraphSparseMatrix<PetscVector>::ExternalContent::prepare_stencil(Decomposition<PetscVector> *decomposition) {
 	LOG_FUNC_BEGIN
-	
-	if(petscvector::PETSC_INITIALIZED){ /* maybe Petsc was already finalized and there is nothing to destroy */
-		TRYCXX( MatDestroy(&(externalcontent->A_petsc)) );
+
+	BGMGraph<PetscVector> *graph = decomposition->get_graph();
+
+	/* dimension of the grid */
+	int width = 0;
+	int height = 0;
+	if(graph){
+		BGMGraphGrid2D<PetscVector> *grid2D = dynamic_cast<BGMGraphGrid2D<PetscVector> *>(graph);
+		BGMGraphGrid1D<PetscVector> *grid1D = dynamic_cast<BGMGraphGrid1D<PetscVector> *>(graph);
+		if(grid2D){
+			width = grid2D->get_width();
+			height = grid2D->get_height();
+		}
+		if(grid1D){
+			width = grid1D->get_width();
+			height = 1;
+		}
 	}
-	
-	LOG_FUNC_END	
-}
 
-/* print matrix */
-template<>
-void BlockGraphSparseMatrix<PetscVector>::printcontent(ConsoleOutput &output) const
-{
-	LOG_FUNC_BEGIN
-	
-	output << "BlockGraphMatrix (sorry, 'only' MatView from Petsc follows):" << std::endl;
-	output << "----------------------------------------------------------" << std::endl;
-	
-	TRYCXX( MatView(externalcontent->A_petsc, PETSC_VIEWER_STDOUT_WORLD) );
+	this->T = decomposition->get_T();
+	this->Tbegin = decomposition->get_Tbegin();
+	this->Tlocal = decomposition->get_Tlocal();
+	this->K = decomposition->get_K();
+	int R = decomposition->get_R();
+	int Rbegin = decomposition->get_Rbegin();
+	int Rlocal = decomposition->get_Rlocal();
+
+	bool is_grid = (width > 0 && height > 0 && width*height == R && graph->get_neighbor_nmbs() != NULL && graph->get_m_max() <= 4);
+
+	/* the graph has to be exactly the 5-point stencil, i.e. neighbors of r are r-1, r+1, r-width, r+width inside the grid
+	 * (grids processed with coeff > 1 or loaded from file could have different neighbors) */
+	if(is_grid){
+		int *neighbor_nmbs = graph->get_neighbor_nmbs();
+		int **neighbor_ids = graph->get_neighbor_ids();
+		for(int r=0;r<R && is_grid;r++){
+			int y = r/width;
+			int x = r - y*width;
+
+			int nmb = 0;
+			if(x > 0) nmb++;
+			if(x < width-1) nmb++;
+			if(y > 0) nmb++;
+			if(y < height-1) nmb++;
+			if(neighbor_nmbs[r] != nmb){
+				is_grid = false;
+			}
+
+			for(int i=0;i<neighbor_nmbs[r] && is_grid;i++){
+				int id = neighbor_ids[r][i];
+				if(!((x > 0 && id == r-1) || (x < width-1 && id == r+1) || (y > 0 && id == r-width) || (y < height-1 && id == r+width))){
+					is_grid = false;
+				}
+				for(int j=0;j<i;j++){
+					if(neighbor_ids[r][j] == id){
+						is_grid = false;
+					}
+				}
+			}
+		}
+	}
+
+	/* local part of vector has to be a contiguous block of rows */
+	is_grid = is_grid && (decomposition->get_DDR_size() == 1 || T == 1) && Rlocal > 0 && Tlocal > 0;
+
+	/* find the bounding box of local nodes */
+	int xbegin = width;
+	int xend = -1;
+	int ybegin = height;
+	int yend = -1;
+	if(is_grid){
+		for(int r=Rbegin;r<Rbegin+Rlocal;r++){
+			int r_orig = decomposition->get_invPr(r);
+			int y = r_orig/width;
+			int x = r_orig - y*width;
+
+			if(x < xbegin) xbegin = x;
+			if(x > xend) xend = x;
+			if(y < ybegin) ybegin = y;
+			if(y > yend) yend = y;
+		}
+		this->grid_width = xend - xbegin + 1;
+		this->grid_height = yend - ybegin + 1;
+
+		/* local nodes have to fill the rectangle in the order of rows */
+		is_grid = (grid_width*grid_height == Rlocal);
+		for(int rl=0;rl<Rlocal && is_grid;rl++){
+			int y = ybegin + rl/grid_width;
+			int x = xbegin + rl%grid_width;
+			if(decomposition->get_invPr(Rbegin + rl) != y*width + x){
+				is_grid = false;
+			}
+		}
+	}
+
+	/* all processes have to use the same type of matrix */
+	int is_grid_local = is_grid;
+	int is_grid_global;
+	MPI_Allreduce(&is_grid_local, &is_grid_global, 1, MPI_INT, MPI_MIN, PETSC_COMM_WORLD);
+
+	if(!is_grid_global){
+		LOG_FUNC_END
+		return false;
+	}
+
+	/* the local rectangle with one layer of neighbors */
+	int ex = grid_width + 2;
+	int ey = grid_height + 2;
+	int et = Tlocal + 2;
+	int layer_size = ey*ex*K;
+
+	TRYCXX( VecCreateSeq(PETSC_COMM_SELF, et*layer_size, &halo_Vec) );
+	TRYCXX( VecSet(halo_Vec, 0.0) ); /* outside the grid, the values stay zero */
+
+	/* indexes of existing nodes in global vector and in halo_Vec */
+	std::vector<int> idx_from;
+	std::vector<int> idx_to;
+	for(int tt=0;tt<et;tt++){
+		int t = Tbegin - 1 + tt;
+		if(t < 0 || t >= T) continue;
+
+		for(int yy=0;yy<ey;yy++){
+			int y = ybegin - 1 + yy;
+			if(y < 0 || y >= height) continue;
+
+			for(int xx=0;xx<ex;xx++){
+				int x = xbegin - 1 + xx;
+				if(x < 0 || x >= width) continue;
+
+				int r_new = decomposition->get_Pr(y*width + x);
+				for(int k=0;k<K;k++){
+					idx_from.push_back(t*R*K + r_new*K + k);
+					idx_to.push_back(((tt*ey + yy)*ex + xx)*K + k);
+				}
+			}
+		}
+	}
+
+	IS from_is;
+	IS to_is;
+	TRYCXX( ISCreateGeneral(PETSC_COMM_SELF, idx_from.size(), &idx_from[0], PETSC_COPY_VALUES, &from_is) );
+	TRYCXX( ISCreateGeneral(PETSC_COMM_SELF, idx_to.size(), &idx_to[0], PETSC_COPY_VALUES, &to_is) );
+
+	Vec x_Vec;
+	decomposition->createGlobalVec_gamma(&x_Vec);
+	TRYCXX( VecScatterCreate(x_Vec, from_is, halo_Vec, to_is, &halo_scatter) );
+	TRYCXX( VecDestroy(&x_Vec) );
+
+	TRYCXX( ISDestroy(&from_is) );
+	TRYCXX( ISDestroy(&to_is) );
+
+	timesum.resize(Tlocal*layer_size);
+
+	/* number of neighbors defines diagonal entries */
+	int *graph_neighbor_nmbs = graph->get_neighbor_nmbs();
+	neighbor_nmbs.resize(Rlocal*K);
+	for(int rl=0;rl<Rlocal;rl++){
+		for(int k=0;k<K;k++){
+			neighbor_nmbs[rl*K + k] = graph_neighbor_nmbs[decomposition->get_invPr(Rbegin + rl)];
+		}
+	}
 
-	output << "----------------------------------------------------------" << std::endl;
-	
 	LOG_FUNC_END
+
+	return true;
 }
 
-/* matrix-vector multiplication */
-template<>
-void BlockGraphSparseMatrix<PetscVector>::matmult(PetscVector &y, const PetscVector &x) const { 
+void BlockGraphSparseMatrix<PetscVector>::ExternalContent::apply_stencil(Vec x, Vec y) {
 	LOG_FUNC_BEGIN
-	
-	// TODO: maybe y is not initialized, who knows
 
-	/* multiply with constant part of matrix */
-	TRYCXX( MatMult(externalcontent->A_petsc, x.get_vector(), y.get_vector()) );
+	/* get the local rectangle with neighbors */
+	TRYCXX( VecScatterBegin(halo_scatter, x, halo_Vec, INSERT_VALUES, SCATTER_FORWARD) );
+	TRYCXX( VecScatterEnd(halo_scatter, x, halo_Vec, INSERT_VALUES, SCATTER_FORWARD) );
+
+	const double *halo_arr;
+	double *y_arr;
+	TRYCXX( VecGetArrayRead(halo_Vec, &halo_arr) );
+	TRYCXX( VecGetArray(y, &y_arr) );
+
+	int row_size = (grid_width + 2)*K;
+	int layer_size = (grid_height + 2)*row_size;
+	int local_row_size = grid_width*K;
+	double *timesum_arr = &timesum[0];
+	const double *neighbor_nmbs_arr = &neighbor_nmbs[0];
+
+	/* timesum = x(t-1) + x(t) + x(t+1) */
+	#pragma omp parallel for
+	for(int t=0;t<Tlocal;t++){
+		const double *xm_arr = halo_arr + t*layer_size;
+		const double *xc_arr = xm_arr + layer_size;
+		const double *xp_arr = xc_arr + layer_size;
+		double *s_arr = timesum_arr + t*layer_size;
+
+		#pragma omp simd
+		for(int i=0;i<layer_size;i++){
+			s_arr[i] = xm_arr[i] + xc_arr[i] + xp_arr[i];
+		}
+	}
 
-	/* multiply with coeffs */
-	if(coeffs){
-		int K = decomposition->get_K();
-		
-		double *coeffs_arr;
-		TRYCXX( VecGetArray(coeffs->get_vector(),&coeffs_arr) );
+	/* y = Wsum*x(t) - 2*(x(t-1) + x(t+1)) - sum of timesum in neighbors, see assembly of matrix */
+	#pragma omp parallel for
+	for(int row=0;row<Tlocal*grid_height;row++){
+		int t = row/grid_height;
+		int yy = row - t*grid_height;
+
+		/* Wsum = a*neighbor_nmbs + b */
+		int t_global = Tbegin + t;
+		double a;
+		double b;
+		if(T > 1){
+			if(t_global == 0 || t_global == T-1){
+				a = 2.0;
+				b = 2.0;
+			} else {
+				a = 3.0;
+				b = 4.0;
+			}
+		} else {
+			a = 1.0;
+			b = 0.0;
+		}
 
-		Vec xk_Vec;
-		Vec x_Vec = y.get_vector();
-		IS xk_is;
-		double coeff;
-		
-		/* get vector corresponding to coeff */
-		for(int k=0;k<K;k++){
-			this->decomposition->createIS_gammaK(&xk_is, k);
-			TRYCXX( VecGetSubVector(x_Vec, xk_is, &xk_Vec) );
-			
-//			coeff = coeffs_arr[k]*coeffs_arr[k];
-			coeff = alpha*coeffs_arr[k]*coeffs_arr[k];
-			TRYCXX( VecScale(xk_Vec, coeff) );
+		int offset = (yy+1)*row_size + K; /* skip the neighbors in space */
+		const double *xc_arr = halo_arr + (t+1)*layer_size + offset;
+		const double *xm_arr = xc_arr - layer_size;
+		const double *xp_arr = xc_arr + layer_size;
+		const double *s_arr = timesum_arr + t*layer_size + offset;
+		const double *nmbs_arr = neighbor_nmbs_arr + yy*local_row_size;
+		double *yrow_arr = y_arr + row*local_row_size;
+
+		#pragma omp simd
+		for(int i=0;i<local_row_size;i++){
+			yrow_arr[i] = scale*((a*nmbs_arr[i] + b)*xc_arr[i] - 2.0*(xm_arr[i] + xp_arr[i])
+						- (s_arr[i-K] + s_arr[i+K] + s_arr[i-row_size] + s_arr[i+row_size]));
+		}
+	}
 
-			TRYCXX( VecRestoreSubVector(x_Vec, xk_is, &xk_Vec) );
-			TRYCXX( ISDestroy(&xk_is) );
+	TRYCXX( VecRestoreArray(y, &y_arr) );
+	TRYCXX( VecRestoreArrayRead(halo_Vec, &halo_arr) );
+
+	LOG_FUNC_END
+}
+
+void BlockGraphSparseMatrix<PetscVector>::ExternalContent::get_diagonal_stencil(Vec d) const {
+	LOG_FUNC_BEGIN
+
+	double *d_arr;
+	TRYCXX( VecGetArray(d, &d_arr) );
+
+	int local_row_size = grid_width*K;
+
+	/* diagonal is Wsum = a*neighbor_nmbs + b, see apply_stencil */
+	for(int t=0;t<Tlocal;t++){
+		int t_global = Tbegin + t;
+		double a;
+		double b;
+		if(T > 1){
+			if(t_global == 0 || t_global == T-1){
+				a = 2.0;
+				b = 2.0;
+			} else {
+				a = 3.0;
+				b = 4.0;
+			}
+		} else {
+			a = 1.0;
+			b = 0.0;
 		}
 
-		TRYCXX( VecRestoreArray(coeffs->get_vector(),&coeffs_arr) );
-	} else {
-	    TRYCXX( VecScale(y.get_vector(), this->alpha) );
+		for(int i=0;i<grid_height*local_row_size;i++){
+			d_arr[t*grid_height*local_row_size + i] = scale*(a*neighbor_nmbs[i] + b);
+		}
 	}
 
-	TRYCXX( VecAssemblyBegin(y.get_vector()) );
-	TRYCXX( VecAssemblyEnd(y.get_vector()) );
+	TRYCXX( VecRestoreArray(d, &d_arr) );
 
 	LOG_FUNC_END
 }
 
-template<>
-BlockGraphSparseMatrix<PetscVector>::ExternalContent * BlockGraphSparseMatrix<PetscVector>::get_externalcontent() const {
-	return this->externalcontent;
+long long BlockGraphSparseMatrix<PetscVector>::ExternalContent::get_stencil_memory() const {
+	return (long long)((Tlocal + 2)*(grid_height + 2)*(grid_width + 2)*K + timesum.size() + neighbor_nmbs.size())*sizeof(double);
+}
+
+PetscErrorCode BlockGraphSparseMatrix<PetscVector>::ExternalContent::stencil_mult(Mat A, Vec x, Vec y) {
+	ExternalContent *externalcontent;
+	TRYCXX( MatShellGetContext(A, &externalcontent) );
+
+	externalcontent->apply_stencil(x, y);
+
+	return 0;
+}
+
+PetscErrorCode BlockGraphSparseMatrix<PetscVector>::ExternalContent::stencil_scale(Mat A, PetscScalar a) {
+	ExternalContent *externalcontent;
+	TRYCXX( MatShellGetContext(A, &externalcontent) );
+
+	externalcontent->scale *= a;
+
+	return 0;
+}
+
+PetscErrorCode BlockGraphSparseMatrix<PetscVector>::ExternalContent::stencil_get_diagonal(Mat A, Vec d) {
+	ExternalContent *externalcontent;
+	TRYCXX( MatShellGetContext(A, &externalcontent) );
+
+	externalcontent->get_diagonal_stencil(d);
+
+	return 0;
 }
 
 }
@@ -4,8 +4,68 @@ namespace petscvector {
 
 int DEBUG_MODE_PETSCVECTOR; 
 bool PETSC_INITIALIZED = false;
+bool FIRSTTOUCH_PETSCVECTOR = PETSCVECTOR_DEFAULT_FIRSTTOUCH;
 petscvector_all_type all;
 
+/* destroy function of container with the array of vector created with first touch */
+static PetscErrorCode firsttouch_array_destroy(void *array){
+	free(array);
+	return 0;
+}
+
+void VecCreateFirstTouch(MPI_Comm comm, int n_local, int n_global, Vec *x_Vec){
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)FUNCTION: VecCreateFirstTouch(comm,int,int,Vec*)" << std::endl;
+
+	void *array = NULL;
+	if(!FIRSTTOUCH_PETSCVECTOR || posix_memalign(&array, PETSCVECTOR_ALIGNMENT, (n_local > 0 ? n_local : 1)*sizeof(double)) != 0){
+		/* standard way */
+		TRYCXX( VecCreate(comm,x_Vec) );
+		TRYCXX( VecSetType(*x_Vec, VECMPI) );
+		TRYCXX( VecSetSizes(*x_Vec,n_local,n_global) );
+		TRYCXX( VecSetFromOptions(*x_Vec) );
+		return;
+	}
+
+	/* the pages are placed on NUMA node of thread which touches them first */
+	double *array_double = (double *)array;
+	#pragma omp parallel for schedule(static)
+	for(int i=0;i<n_local;i++){
+		array_double[i] = 0.0;
+	}
+
+	TRYCXX( VecCreateMPIWithArray(comm, 1, n_local, n_global, array_double, x_Vec) );
+
+	/* the owner of array is the vector */
+	PetscContainer container;
+	TRYCXX( PetscContainerCreate(PETSC_COMM_SELF, &container) );
+	TRYCXX( PetscContainerSetPointer(container, array) );
+	TRYCXX( PetscContainerSetUserDestroy(container, firsttouch_array_destroy) );
+	TRYCXX( PetscObjectCompose((PetscObject)(*x_Vec), "firsttouch_array", (PetscObject)container) );
+	TRYCXX( PetscContainerDestroy(&container) );
+}
+
+void VecDuplicateFirstTouch(Vec x_Vec, Vec *y_Vec){
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)FUNCTION: VecDuplicateFirstTouch(Vec,Vec*)" << std::endl;
+
+	PetscBool is_mpi;
+	TRYCXX( PetscObjectTypeCompare((PetscObject)x_Vec, VECMPI, &is_mpi) );
+
+	int bs;
+	TRYCXX( VecGetBlockSize(x_Vec, &bs) );
+
+	if(FIRSTTOUCH_PETSCVECTOR && is_mpi && bs == 1){
+		MPI_Comm comm;
+		int n_local, n_global;
+		TRYCXX( PetscObjectGetComm((PetscObject)x_Vec, &comm) );
+		TRYCXX( VecGetLocalSize(x_Vec, &n_local) );
+		TRYCXX( VecGetSize(x_Vec, &n_global) );
+
+		VecCreateFirstTouch(comm, n_local, n_global, y_Vec);
+	} else {
+		TRYCXX( VecDuplicate(x_Vec, y_Vec) );
+	}
+}
+
 PetscVector::PetscVector(){
 	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)CONSTRUCTOR: empty" << std::endl;
 
@@ -38,7 +98,7 @@ PetscVector::PetscVector(const PetscVector &vec){
 	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)CONSTRUCTOR: PetscVector(&vec) ---- DUPLICATE ----" << std::endl;
 
 	/* there is duplicate... this function has to be called as less as possible */
-	TRYCXX( VecDuplicate(vec.inner_vector, &inner_vector) );
+	VecDuplicateFirstTouch(vec.inner_vector, &inner_vector);
 	TRYCXX( VecCopy(vec.inner_vector, inner_vector) );
 	
 }
@@ -275,21 +335,11 @@ std::ostream &operator<<(std::ostream &output, const PetscVector &vector)
 {
 	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(PetscVector)OPERATOR: <<" << std::endl;
 
-	PetscScalar *arr_vector;
-	PetscInt i,local_size;
-	
 	// TODO: make more sofisticated for parallel vectors
 
-	output << "[";
-	TRYCXX( VecGetLocalSize(vector.inner_vector,&local_size) );
-	TRYCXX( VecGetArray(vector.inner_vector,&arr_vector) );
-	for (i=0; i<local_size; i++){
-		output << arr_vector[i];
-		if(i < local_size-1) output << ", ";
-	}
-	TRYCXX( VecRestoreArray(vector.inner_vector,&arr_vector) );
-	output << "]";
-			
+	/* print local values through expression, the array is only read, therefore the state of vector is not changed */
+	output << lazy(vector);
+
 	return output;
 }
 
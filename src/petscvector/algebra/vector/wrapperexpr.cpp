@@ -0,0 +1,60 @@
+#include "external/petscvector/algebra/vector/petscvector.h"
+
+namespace petscvector {
+
+/* --------------------- PetscVectorExprVec ----------------------*/
+
+/* constructor from Vec, the array is obtained during evaluation */
+PetscVectorExprVec::PetscVectorExprVec(Vec new_inner_vector){
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(ExprVec)CONSTRUCTOR: ExprVec(inner_vec)" << std::endl;
+
+	inner_vector = new_inner_vector;
+	inner_arr = NULL;
+	restore_arr = false;
+}
+
+/* get local array, if this vector is the result of evaluation, then use the array of result */
+void PetscVectorExprVec::acquire(Vec y, double *y_arr) const {
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(ExprVec)FUNCTION: acquire(Vec,double*)" << std::endl;
+
+	if(inner_vector == y){
+		inner_arr = y_arr;
+		restore_arr = false;
+	} else {
+		TRYCXX( VecGetArrayRead(inner_vector, &inner_arr) );
+		restore_arr = true;
+	}
+}
+
+/* restore local array */
+void PetscVectorExprVec::release() const {
+	if(DEBUG_MODE_PETSCVECTOR >= 100) std::cout << "(ExprVec)FUNCTION: release()" << std::endl;
+
+	if(restore_arr){
+		TRYCXX( VecRestoreArrayRead(inner_vector, &inner_arr) );
+		restore_arr = false;
+	}
+	inner_arr = NULL;
+}
+
+/* all vectors in expression have to have the same local size */
+void PetscVectorExprVec::check_size(int local_size) const {
+	int my_local_size;
+	TRYCXX( VecGetLocalSize(inner_vector, &my_local_size) );
+	if(my_local_size != local_size){
+		TRYCXX( PetscError(PETSC_COMM_SELF, __LINE__, PETSC_FUNCTION_NAME, __FILE__, PETSC_ERR_ARG_SIZ, PETSC_ERROR_INITIAL, "local size of vector in expression %d is different from %d", my_local_size, local_size) );
+	}
+}
+
+Vec PetscVectorExprVec::get_vector() const {
+	return inner_vector;
+}
+
+void PetscVectorExprCheckVector(Vec x){
+	if(x == NULL){
+		TRYCXX( PetscError(PETSC_COMM_SELF, __LINE__, PETSC_FUNCTION_NAME, __FILE__, PETSC_ERR_ARG_WRONG, PETSC_ERROR_INITIAL, "expression does not contain any vector, the size is not known") );
+	}
+}
+
+
+} /* end of petscvector namespace */
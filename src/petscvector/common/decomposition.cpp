@@ -147,6 +147,51 @@ Decomposition<PetscVector>::~Decomposition(){
 	LOG_FUNC_END
 }
 
+template<>
+void Decomposition<PetscVector>::measure_network(double *bandwidth, double *latency){
+	LOG_FUNC_STATIC_BEGIN
+
+	int rank = GlobalManager.get_rank();
+	int size = GlobalManager.get_size();
+
+	/* pairs of processes exchange messages, the last one without pair sends to itself */
+	int partner = rank ^ 1;
+	if(partner >= size){
+		partner = rank;
+	}
+
+	int nmb_small = 100;
+	int nmb_large = 10;
+	int length_large = 1 << 17; /* 1MB of doubles */
+	double small_send = 0.0;
+	double small_recv;
+	std::vector<double> large_send(length_large, 0.0);
+	std::vector<double> large_recv(length_large);
+
+	/* latency from small messages */
+	MPI_Barrier(PETSC_COMM_WORLD);
+	double time_begin = MPI_Wtime();
+	for(int i=0; i < nmb_small; i++){
+		MPI_Sendrecv(&small_send, 1, MPI_DOUBLE, partner, 0, &small_recv, 1, MPI_DOUBLE, partner, 0, PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
+	}
+	double latency_local = (MPI_Wtime() - time_begin)/nmb_small;
+
+	/* bandwidth from large messages */
+	MPI_Barrier(PETSC_COMM_WORLD);
+	time_begin = MPI_Wtime();
+	for(int i=0; i < nmb_large; i++){
+		MPI_Sendrecv(&large_send[0], length_large, MPI_DOUBLE, partner, 1, &large_recv[0], length_large, MPI_DOUBLE, partner, 1, PETSC_COMM_WORLD, MPI_STATUS_IGNORE);
+	}
+	double time_large = (MPI_Wtime() - time_begin)/nmb_large - latency_local;
+	double bandwidth_local = length_large*sizeof(double)/((time_large > 0.0)? time_large : 1e-9);
+
+	/* the slowest pair is used */
+	MPI_Allreduce(&latency_local, latency, 1, MPI_DOUBLE, MPI_MAX, PETSC_COMM_WORLD);
+	MPI_Allreduce(&bandwidth_local, bandwidth, 1, MPI_DOUBLE, MPI_MIN, PETSC_COMM_WORLD);
+
+	LOG_FUNC_STATIC_END
+}
+
 template<>
 void Decomposition<PetscVector>::compute_rank(){
 	LOG_FUNC_BEGIN
@@ -206,17 +251,16 @@ void Decomposition<PetscVector>::createGlobalVec_gamma(Vec *x_Vec) const {
 	int Tlocal = this->get_Tlocal();
 	int Rlocal = this->get_Rlocal();
 
-	TRYCXX( VecCreate(PETSC_COMM_WORLD,x_Vec) );
-
 	#ifdef USE_CUDA
-		TRYCXX(VecSetType(*x_Vec, VECMPICUDA));
+		TRYCXX( VecCreate(PETSC_COMM_WORLD,x_Vec) );
+		TRYCXX( VecSetType(*x_Vec, VECMPICUDA) );
+		TRYCXX( VecSetSizes(*x_Vec,Tlocal*Rlocal*K,T*R*K) );
+		TRYCXX( VecSetFromOptions(*x_Vec) );
 	#else
-		TRYCXX(VecSetType(*x_Vec, VECMPI));
+		/* large vector, place it on NUMA nodes of threads */
+		petscvector::VecCreateFirstTouch(PETSC_COMM_WORLD, Tlocal*Rlocal*K, T*R*K, x_Vec);
 	#endif
 
-	TRYCXX( VecSetSizes(*x_Vec,Tlocal*Rlocal*K,T*R*K) );
-	TRYCXX( VecSetFromOptions(*x_Vec) );
-
 	LOG_FUNC_END
 }
 
@@ -230,17 +274,16 @@ void Decomposition<PetscVector>::createGlobalVec_data(Vec *x_Vec) const {
 	int Tlocal = this->get_Tlocal();
 	int Rlocal = this->get_Rlocal();
 
-	TRYCXX( VecCreate(PETSC_COMM_WORLD,x_Vec) );
-	
 	#ifdef USE_CUDA
-		TRYCXX(VecSetType(*x_Vec,VECMPICUDA));
+		TRYCXX( VecCreate(PETSC_COMM_WORLD,x_Vec) );
+		TRYCXX( VecSetType(*x_Vec, VECMPICUDA) );
+		TRYCXX( VecSetSizes(*x_Vec,Tlocal*Rlocal*xdim,T*R*xdim) );
+		TRYCXX( VecSetFromOptions(*x_Vec) );
 	#else
-		TRYCXX(VecSetType(*x_Vec,VECMPI));
+		/* large vector, place it on NUMA nodes of threads */
+		petscvector::VecCreateFirstTouch(PETSC_COMM_WORLD, Tlocal*Rlocal*xdim, T*R*xdim, x_Vec);
 	#endif
 
-	TRYCXX( VecSetSizes(*x_Vec,Tlocal*Rlocal*xdim,T*R*xdim) );
-	TRYCXX( VecSetFromOptions(*x_Vec) );
-
 	LOG_FUNC_END
 }
 
@@ -47,6 +47,19 @@ bool Initialize<PetscVector>(int argc, char *argv[]){
 	#endif
 
 	petscvector::PETSC_INITIALIZED = true;
+
+	/* NUMA placement of large vectors */
+	consoleArg.set_option_value("petsc_firsttouch", &petscvector::FIRSTTOUCH_PETSCVECTOR, PETSCVECTOR_DEFAULT_FIRSTTOUCH);
+
+	/* binding of processes and threads to cores */
+	bool binding_report;
+	consoleArg.set_option_value("global_binding_report", &binding_report, GLOBAL_DEFAULT_BINDING_REPORT);
+	if(binding_report){
+		std::string binding = GlobalManager.get_binding_report();
+		coutMaster << "- BINDING ----------------------------" << std::endl;
+		coutMaster << binding;
+		coutMaster << "--------------------------------------" << std::endl;
+	}
 	
 	/* cuda warm up */
 	#ifdef USE_CUDA
@@ -63,6 +76,9 @@ void Finalize<PetscVector>(){
 	for(size_t i = 0; i < argc_petsc; ++i)
 		delete[] argv_petsc[i];
 
+	/* if this process runs the task of TaskFarm, then report the end of task */
+	TaskFarm::finalize_child();
+
 	#ifdef USE_PERMON
 		FllopFinalize();
 	#else
@@ -163,8 +163,7 @@ void EdfData<PetscVector>::set_decomposition(Decomposition<PetscVector> &new_dec
 	/* prepare real datavector */
 	Vec data_Vec;
 	this->decomposition->createGlobalVec_data(&data_Vec);
-	this->datavector = new GeneralVector<PetscVector>(data_Vec);
-	this->destroy_datavector = true;
+	this->set_datavector_owned(new GeneralVector<PetscVector>(data_Vec));
 	
 	/* permute orig to new using parallel layout */
 	Vec datapreload_Vec = datavectorpreliminary->get_vector();
@@ -206,207 +205,14 @@ EdfData<PetscVector>::~EdfData(){
 
 template<>
 void EdfData<PetscVector>::saveVTK(std::string filename) const{
-	Timer timer_saveVTK; 
-	timer_saveVTK.restart();
-	timer_saveVTK.start();
-
-	int T = get_T();
-	int Tlocal = get_Tlocal();
-	int Tbegin = get_Tbegin();
-	int Tend = get_Tend();
-	const int *Tranges = decomposition->get_DDT_ranges();
-
-	int K = get_K();
-	int R = get_R();
-	int Rlocal = get_Rlocal();
-	int *DDR_affiliation = decomposition->get_DDR_affiliation();
-	int DDR_rank = decomposition->get_DDR_rank();
-	int DDR_size = decomposition->get_DDR_size();
-
-	int xdim = get_xdim();
-
-	int prank = GlobalManager.get_rank();
-	int psize = GlobalManager.get_size();
+	LOG_FUNC_BEGIN
 
-	/* to manipulate with filename */
+	/* all time steps into one XDMF file with binary heavy data instead of one ASCII .vtu per time step and spatial part */
 	std::ostringstream oss_filename;
+	oss_filename << "results/" << filename;
+	this->saveXDMF(oss_filename.str());
 
-	/* to manipulate with file */
-	std::ofstream myfile;
-
-	/* master writes the main file */
-	if(prank == 0){
-		/* create folder */
-		oss_filename << "results/" << filename << "_vtk";
-		boost::filesystem::path dir(oss_filename.str().c_str());
-		boost::filesystem::create_directory(dir);
-		oss_filename.str("");
-		
-		/* write to the name of file */
-		oss_filename << "results/" << filename << "_vtk/" << filename << ".pvd";
-		myfile.open(oss_filename.str().c_str());
-		oss_filename.str("");
-
-		/* write header to file */
-		myfile << "<?xml version=\"1.0\"?>" << std::endl;
-		myfile << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">" << std::endl;
-		myfile << "<Collection>" << std::endl;
-		for(int t=0;t<T;t++){
-			for(int r=0;r<DDR_size;r++){
-				myfile << " <DataSet timestep=\"" << t << "\" group=\"\" part=\"r\" file=\"edf_" << r << "_" << t <<".vtu\"/>" << std::endl;
-			}
-		}
-
-		myfile << "</Collection>" << std::endl;
-		myfile << "</VTKFile>";
-		
-		myfile.close();
-	}
-
-	TRYCXX( PetscBarrier(NULL));
-
-	/* compute recovered vector */
-	Vec gammak_Vec;
-	IS gammak_is;
-	
-	Vec data_recovered_Vec;
-	TRYCXX( VecDuplicate(datavector->get_vector(), &data_recovered_Vec) );
-	TRYCXX( VecSet(data_recovered_Vec,0.0));
-	GeneralVector<PetscVector> data_recovered(data_recovered_Vec);
-
-	double *theta_arr;
-	TRYCXX( VecGetArray(thetavector->get_vector(),&theta_arr) );
-
-	for(int k=0;k<K;k++){ 
-		/* get gammak */
-		this->decomposition->createIS_gammaK(&gammak_is, k);
-		TRYCXX( VecGetSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-
-		/* add to recovered image */
-		TRYCXX( VecAXPY(data_recovered_Vec, theta_arr[k], gammak_Vec) );
-
-		TRYCXX( VecRestoreSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-		TRYCXX( ISDestroy(&gammak_is) );
-	}	
-
-	double *data_arr;
-	TRYCXX( VecGetArray(datavector->get_vector(), &data_arr) );
-
-	double *data_recovered_arr;
-	TRYCXX( VecGetArray(data_recovered_Vec, &data_recovered_arr) );
-
-	double *gamma_arr;
-	TRYCXX( VecGetArray(gammavector->get_vector(), &gamma_arr) );
-
-	int coordinates_dim = tsmodel->get_coordinatesVTK_dim();
-	double *coordinates_arr;
-	TRYCXX( VecGetArray(tsmodel->get_coordinatesVTK()->get_vector(), &coordinates_arr) );
-
-	double gamma_max;
-	int gamma_maxk;
-
-	/* each processor writes its own portion of data */
-	for(int t=Tbegin;t < Tend;t++){
-		oss_filename.str("");
-		oss_filename << "results/" << filename << "_vtk/edf_" << DDR_rank << "_" << t << ".vtu";
-
-		myfile.open(oss_filename.str().c_str());
-
-		myfile << "<?xml version=\"1.0\"?>" << std::endl;
-		myfile << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">" << std::endl;
-		myfile << "  <UnstructuredGrid>" << std::endl;
-		myfile << "	  <Piece NumberOfPoints=\"" << Rlocal << "\" NumberOfCells=\"0\" >" << std::endl;
-		myfile << "      <PointData Scalars=\"scalars\">" << std::endl;
-
-		/* original data */
-		myfile << "        <DataArray type=\"Float32\" Name=\"original\" format=\"ascii\">" << std::endl;
-		for(int r=0;r<Rlocal;r++){
-			myfile << data_arr[(t-Tbegin)*Rlocal+r] << std::endl;
-		}
-		myfile << "        </DataArray>" << std::endl;
-
-		/* value of gamma */
-		for(int k=0;k<K;k++){
-			myfile << "        <DataArray type=\"Float32\" Name=\"gamma_" << k << "\" format=\"ascii\">" << std::endl;
-			for(int r=0;r<Rlocal;r++){
-				myfile << gamma_arr[(t-Tbegin)*Rlocal*K+r*K+k] << std::endl;
-			}
-			myfile << "        </DataArray>" << std::endl;
-		}
-
-		/* cluster affiliation */
-		myfile << "        <DataArray type=\"Float32\" Name=\"gamma_max\" format=\"ascii\">" << std::endl;
-		for(int r=0;r<Rlocal;r++){
-			gamma_max = 0.0;
-			gamma_maxk = 0;
-			for(int k=0;k<K;k++){
-				if(gamma_arr[(t-Tbegin)*Rlocal*K + r*K + k] > gamma_max){
-					gamma_max = gamma_arr[(t-Tbegin)*Rlocal*K + r*K + k];
-					gamma_maxk = k;
-				}
-			}
-			myfile << gamma_maxk << std::endl;
-		}
-		myfile << "        </DataArray>" << std::endl;
-
-		/* original data */
-		myfile << "        <DataArray type=\"Float32\" Name=\"recovered\" format=\"ascii\">" << std::endl;
-		for(int r=0;r<Rlocal;r++){
-			myfile << data_recovered_arr[(t-Tbegin)*Rlocal+r] << std::endl;
-		}
-		myfile << "        </DataArray>" << std::endl;
-		myfile << "      </PointData>" << std::endl;
-
-		myfile << "      <CellData Scalars=\"scalars\">" << std::endl;
-		myfile << "      </CellData>" << std::endl;
-		myfile << "      <Points>" << std::endl;
-		myfile << "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"ascii\">" << std::endl;
-
-		for(int r=0;r<R;r++){
-			if(DDR_rank == DDR_affiliation[r]){
-				/* 1D */
-				if(coordinates_dim == 1){
-					myfile << coordinates_arr[r] << " 0 0" << std::endl;
-				}
-
-				/* 2D */
-				if(coordinates_dim == 2){
-					myfile << coordinates_arr[r] << " " << coordinates_arr[r+R] << " 0" << std::endl;
-				}
-
-				/* 3D */
-				if(coordinates_dim == 3){
-					myfile << coordinates_arr[r] << coordinates_arr[r+R] << " " << coordinates_arr[r+2*R] << std::endl;
-				}
-			}
-		}
-		
-		myfile << "        </DataArray>" << std::endl;
-		myfile << "      </Points>" << std::endl;
-		myfile << "      <Cells>" << std::endl;
-		myfile << "        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">" << std::endl;
-		myfile << "        </DataArray>" << std::endl;
-		myfile << "		<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">" << std::endl;
-		myfile << "        </DataArray>" << std::endl;
-		myfile << "		<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">" << std::endl;
-		myfile << "        </DataArray>" << std::endl;
-		myfile << "      </Cells>" << std::endl;
-		myfile << "    </Piece>" << std::endl;
-		myfile << "  </UnstructuredGrid>" << std::endl;
-		myfile << "</VTKFile>" << std::endl;
-
-		myfile.close();
-	}
-
-	TRYCXX( VecRestoreArray(gammavector->get_vector(), &gamma_arr) );
-	TRYCXX( VecRestoreArray(thetavector->get_vector(), &theta_arr) );
-	TRYCXX( VecRestoreArray(datavector->get_vector(), &data_arr) );
-	TRYCXX( VecRestoreArray(data_recovered_Vec, &data_arr) );
-	TRYCXX( VecRestoreArray(tsmodel->get_coordinatesVTK()->get_vector(), &coordinates_arr) );
-
-	timer_saveVTK.stop();
-	coutAll <<  " - problem saved to VTK in: " << timer_saveVTK.get_value_sum() << std::endl;
-	coutAll.synchronize();
+	LOG_FUNC_END
 }
 
 template<>
@@ -422,10 +228,6 @@ void EdfData<PetscVector>::saveVector(std::string filename, bool save_original)
 	this->decomposition->createGlobalVec_data(&datasave_Vec);
 	GeneralVector<PetscVector> datasave(datasave_Vec);
 
-	Vec gammasave_Vec;
-	this->decomposition->createGlobalVec_gamma(&gammasave_Vec);
-	GeneralVector<PetscVector> gammasave(gammasave_Vec);
-
 	/* save datavector - just for fun; to see if it was loaded in a right way */
 	if(save_original){
 		oss_name_of_file << "results/" << filename << "_original.bin";
@@ -434,39 +236,26 @@ void EdfData<PetscVector>::saveVector(std::string filename, bool save_original)
 		oss_name_of_file.str("");
 	}
 
-	/* save gamma */
-	oss_name_of_file << "results/" << filename << "_gamma.bin";
-	this->decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
-	gammasave.save_binary(oss_name_of_file.str());
+	/* save gamma, compact labels of clusters instead of dense vector if required */
+	if(this->get_save_labels()){
+		oss_name_of_file << "results/" << filename << "_gamma" << TSDATA_LABELS_EXTENSION;
+		this->save_gammalabels(oss_name_of_file.str());
+	} else {
+		Vec gammasave_Vec;
+		this->decomposition->createGlobalVec_gamma(&gammasave_Vec);
+		GeneralVector<PetscVector> gammasave(gammasave_Vec);
+
+		oss_name_of_file << "results/" << filename << "_gamma.bin";
+		this->decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
+		gammasave.save_binary(oss_name_of_file.str());
+	}
 	oss_name_of_file.str("");
 
-	/* compute recovered signal */
-	Vec gammak_Vec;
-	IS gammak_is;
-
+	/* compute recovered signal, one-hot rows of gamma are gathered from theta */
 	Vec data_recovered_Vec;
 	TRYCXX( VecDuplicate(datavector->get_vector(), &data_recovered_Vec) );
-	TRYCXX( VecSet(data_recovered_Vec,0.0));
 	GeneralVector<PetscVector> data_recovered(data_recovered_Vec);
-
-	double *theta_arr;
-	TRYCXX( VecGetArray(thetavector->get_vector(),&theta_arr) );
-
-	int K = this->get_K();
-
-	for(int k=0;k<K;k++){ 
-		/* get gammak */
-		this->decomposition->createIS_gammaK(&gammak_is, k);
-		TRYCXX( VecGetSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-
-		/* add to recovered image */
-		TRYCXX( VecAXPY(data_recovered_Vec, theta_arr[k], gammak_Vec) );
-
-		TRYCXX( VecRestoreSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-		TRYCXX( ISDestroy(&gammak_is) );
-	}	
-
-	TRYCXX( VecRestoreArray(thetavector->get_vector(),&theta_arr) );
+	this->compute_recovered(data_recovered);
 
 	/* save recovered data */
 	oss_name_of_file << "results/" << filename << "_recovered.bin";
@@ -20,7 +20,7 @@ ImageData<PetscVector>::ImageData(Decomposition<PetscVector> &new_decomposition,
 	/* prepare real datavector */
 	Vec data_Vec;
 	this->decomposition->createGlobalVec_data(&data_Vec);
-	this->datavector = new GeneralVector<PetscVector>(data_Vec);
+	this->set_datavector_owned(new GeneralVector<PetscVector>(data_Vec));
 	
 	/* permute orig to new using parallel layout */
 	this->decomposition->permute_TRxdim(datapreload_Vec, data_Vec);
@@ -29,7 +29,6 @@ ImageData<PetscVector>::ImageData(Decomposition<PetscVector> &new_decomposition,
 //	TRYCXX( VecDestroy(&datapreload_Vec) );
 	
 	/* other vectors will be prepared after setting the model */
-	this->destroy_datavector = true;
 	this->destroy_gammavector = false;
 	this->destroy_thetavector = false;
 
@@ -51,10 +50,6 @@ void ImageData<PetscVector>::saveImage(std::string filename, bool save_original)
 	this->decomposition->createGlobalVec_data(&datasave_Vec);
 	GeneralVector<PetscVector> datasave(datasave_Vec);
 
-	Vec gammasave_Vec;
-	this->decomposition->createGlobalVec_gamma(&gammasave_Vec);
-	GeneralVector<PetscVector> gammasave(gammasave_Vec);
-
 	/* save datavector - just for fun; to see if it was loaded in a right way */
 	if(save_original){
 		oss_name_of_file << "results/" << filename << "_original.bin";
@@ -63,39 +58,26 @@ void ImageData<PetscVector>::saveImage(std::string filename, bool save_original)
 		oss_name_of_file.str("");
 	}
 
-	/* save gamma */
-	oss_name_of_file << "results/" << filename << "_gamma.bin";
-	this->decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
-	gammasave.save_binary(oss_name_of_file.str());
+	/* save gamma, compact labels of clusters instead of dense vector if required */
+	if(this->get_save_labels()){
+		oss_name_of_file << "results/" << filename << "_gamma" << TSDATA_LABELS_EXTENSION;
+		this->save_gammalabels(oss_name_of_file.str());
+	} else {
+		Vec gammasave_Vec;
+		this->decomposition->createGlobalVec_gamma(&gammasave_Vec);
+		GeneralVector<PetscVector> gammasave(gammasave_Vec);
+
+		oss_name_of_file << "results/" << filename << "_gamma.bin";
+		this->decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
+		gammasave.save_binary(oss_name_of_file.str());
+	}
 	oss_name_of_file.str("");
 
-	/* compute recovered image */
-	Vec gammak_Vec;
-	IS gammak_is;
-
+	/* compute recovered image, one-hot rows of gamma are gathered from theta */
 	Vec data_recovered_Vec;
 	TRYCXX( VecDuplicate(datavector->get_vector(), &data_recovered_Vec) );
-	TRYCXX( VecSet(data_recovered_Vec,0.0));
 	GeneralVector<PetscVector> data_recovered(data_recovered_Vec);
-
-	double *theta_arr;
-	TRYCXX( VecGetArray(thetavector->get_vector(),&theta_arr) );
-
-	int K = this->get_K();
-
-	for(int k=0;k<K;k++){ 
-		/* get gammak */
-		this->decomposition->createIS_gammaK(&gammak_is, k);
-		TRYCXX( VecGetSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-
-		/* add to recovered image */
-		TRYCXX( VecAXPY(data_recovered_Vec, theta_arr[k], gammak_Vec) );
-
-		TRYCXX( VecRestoreSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-		TRYCXX( ISDestroy(&gammak_is) );
-	}	
-
-	TRYCXX( VecRestoreArray(thetavector->get_vector(),&theta_arr) );
+	this->compute_recovered(data_recovered);
 
 	/* save recovered data */
 	oss_name_of_file << "results/" << filename << "_recovered.bin";
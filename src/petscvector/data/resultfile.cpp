@@ -0,0 +1,308 @@
+#include "external/petscvector/data/resultfile.h"
+
+#include <cstddef>
+
+namespace pascinference {
+namespace data {
+
+void ResultFile<PetscVector>::ExternalContent::iwrite(ResultFileSnapshot *snapshot, int64_t offset, std::vector<char> &buffer){
+	if(buffer.size() == 0){
+		return;
+	}
+
+	snapshot->buffers.push_back(std::vector<char>());
+	snapshot->buffers.back().swap(buffer);
+
+	/* the count in MPI is int, large buffers are written by more requests */
+	const char *data = &(snapshot->buffers.back()[0]);
+	int64_t nbytes = snapshot->buffers.back().size();
+	for(int64_t begin = 0; begin < nbytes; begin += RESULTFILE_MAX_WRITE_BYTES){
+		MPI_Request request;
+		MPI_File_iwrite_at(this->file, offset + begin, (void *)(data + begin), (int)std::min(nbytes - begin, (int64_t)RESULTFILE_MAX_WRITE_BYTES), MPI_BYTE, &request);
+		snapshot->requests.push_back(request);
+	}
+}
+
+void ResultFile<PetscVector>::ExternalContent::wait_oldest(){
+	ResultFileSnapshot *snapshot = this->inflight.front();
+	if(snapshot->requests.size() > 0){
+		MPI_Waitall(snapshot->requests.size(), &(snapshot->requests[0]), MPI_STATUSES_IGNORE);
+	}
+
+	/* the record is in file on all processes, then master moves the pointer in header to its table */
+	MPI_File_sync(this->file);
+	MPI_Barrier(PETSC_COMM_WORLD);
+	if(GlobalManager.get_rank() == 0){
+		MPI_File_write_at(this->file, offsetof(ResultFileHeader, table_offset), snapshot->header_table, 2, MPI_INT64_T, MPI_STATUS_IGNORE);
+	}
+
+	delete snapshot;
+	this->inflight.pop_front();
+}
+
+template<>
+ResultFile<PetscVector>::ResultFile(TSData<PetscVector> &tsdata, std::string filename){
+	LOG_FUNC_BEGIN
+
+	this->tsdata = &tsdata;
+	this->filename = filename;
+
+	set_settings_from_console();
+
+	this->data_saved = false;
+	this->end_offset = sizeof(ResultFileHeader);
+	this->bytes_written = 0;
+	this->bytes_dense = 0;
+	this->timer_write.restart();
+	this->timer_wait.restart();
+
+	/* prepare external content with MPI stuff */
+	externalcontent = new ExternalContent();
+
+	/* create new file, remove old content */
+	MPI_File_open(PETSC_COMM_WORLD, (char *)filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &(externalcontent->file));
+	MPI_File_set_size(externalcontent->file, 0);
+
+	/* master writes header */
+	if(GlobalManager.get_rank() == 0){
+		ResultFileHeader header;
+		memcpy(header.magic, RESULTFILE_MAGIC, 8);
+		header.version = RESULTFILE_VERSION;
+		header.T = tsdata.get_T();
+		header.R = tsdata.get_R();
+		header.K = tsdata.get_K();
+		header.xdim = tsdata.get_xdim();
+		header.chunk_rows = this->chunk_rows;
+		header.table_offset = 0;
+		header.nrecords = 0;
+
+		MPI_File_write_at(externalcontent->file, 0, &header, sizeof(ResultFileHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+	}
+
+	LOG_FUNC_END
+}
+
+template<>
+ResultFile<PetscVector>::~ResultFile(){
+	LOG_FUNC_BEGIN
+
+	flush();
+	MPI_File_close(&(externalcontent->file));
+	delete externalcontent;
+
+	LOG_FUNC_END
+}
+
+template<>
+void ResultFile<PetscVector>::write_field(int type, const double *values, int64_t row_begin, int nrows_local, int blocksize, int64_t nrows_global, ResultFileField *fieldinfo){
+	LOG_FUNC_BEGIN
+
+	/* compress local chunks, borders of chunks are multiples of chunk_rows (or borders of local parts) */
+	ResultFileSnapshot *snapshot = externalcontent->inflight.back();
+	std::vector<char> buffer;
+	std::vector<ResultFileChunk> chunks;
+
+	int64_t row_end = row_begin + nrows_local;
+	int64_t row = row_begin;
+	while(row < row_end){
+		int64_t chunk_end = std::min((row/this->chunk_rows + 1)*this->chunk_rows, row_end);
+
+		ResultFileChunk chunk;
+		chunk.row_begin = row;
+		chunk.nrows = chunk_end - row;
+		chunk.offset = buffer.size(); /* local position, will be shifted */
+
+		const double *chunk_values = &values[(row - row_begin)*blocksize];
+		if(type == RESULTFILE_FIELD_GAMMA){
+			chunk.encoding = ResultFileCodec::encode_gamma(chunk_values, chunk.nrows, blocksize, this->gamma_tol, buffer);
+		} else {
+			chunk.encoding = ResultFileCodec::encode_raw(chunk_values, chunk.nrows, blocksize, buffer);
+		}
+		chunk.nbytes = buffer.size() - chunk.offset;
+
+		chunks.push_back(chunk);
+		row = chunk_end;
+	}
+
+	/* compute the position of my chunks in file: [bytes, number of chunks] */
+	int64_t local_sizes[2] = {(int64_t)buffer.size(), (int64_t)chunks.size()};
+	int64_t global_sizes[2];
+	int64_t my_begin[2] = {0, 0};
+	MPI_Exscan(local_sizes, my_begin, 2, MPI_INT64_T, MPI_SUM, PETSC_COMM_WORLD);
+	MPI_Allreduce(local_sizes, global_sizes, 2, MPI_INT64_T, MPI_SUM, PETSC_COMM_WORLD);
+	if(GlobalManager.get_rank() == 0){
+		/* result of Exscan is undefined on first process */
+		my_begin[0] = 0;
+		my_begin[1] = 0;
+	}
+
+	for(size_t i=0; i < chunks.size(); i++){
+		chunks[i].offset += this->end_offset + my_begin[0];
+	}
+
+	/* start writing of compressed chunks, the buffer is owned by snapshot until the write is finished */
+	externalcontent->iwrite(snapshot, this->end_offset + my_begin[0], buffer);
+
+	/* write index of chunks; local parts are ordered in the same way as ownership ranges, therefore the index is sorted by rows */
+	int64_t index_offset = this->end_offset + global_sizes[0];
+	std::vector<char> index_buffer(chunks.size()*sizeof(ResultFileChunk));
+	if(chunks.size() > 0){
+		memcpy(&index_buffer[0], &chunks[0], chunks.size()*sizeof(ResultFileChunk));
+	}
+	externalcontent->iwrite(snapshot, index_offset + my_begin[1]*sizeof(ResultFileChunk), index_buffer);
+
+	/* fill the description of field */
+	fieldinfo->type = type;
+	fieldinfo->blocksize = blocksize;
+	fieldinfo->nrows = nrows_global;
+	fieldinfo->nchunks = global_sizes[1];
+	fieldinfo->index_offset = index_offset;
+
+	/* move the end of file */
+	this->end_offset = index_offset + global_sizes[1]*sizeof(ResultFileChunk);
+
+	this->bytes_written += global_sizes[0] + global_sizes[1]*sizeof(ResultFileChunk);
+	this->bytes_dense += nrows_global*blocksize*sizeof(double);
+
+	LOG_FUNC_END
+}
+
+template<>
+void ResultFile<PetscVector>::write(double epssqr, int id){
+	LOG_FUNC_BEGIN
+
+	this->timer_write.start();
+
+	/* new snapshot owns encoded buffers of this record until they are written; permutation and encoding are not in background */
+	ResultFileSnapshot *snapshot = new ResultFileSnapshot();
+	externalcontent->inflight.push_back(snapshot);
+
+	Decomposition<PetscVector> *decomposition = tsdata->get_decomposition();
+	int T = decomposition->get_T();
+	int R = decomposition->get_R();
+	int K = decomposition->get_K();
+	int xdim = decomposition->get_xdim();
+	int TRlocal = decomposition->get_Tlocal()*decomposition->get_Rlocal();
+
+	/* prepare empty record */
+	ResultFileRecord record;
+	memset(&record, 0, sizeof(ResultFileRecord));
+	record.epssqr = epssqr;
+	record.id = id;
+	record.nfields = RESULTFILE_NFIELDS;
+	for(int i=0; i < RESULTFILE_NFIELDS; i++){
+		record.fields[i].type = i;
+	}
+
+	int low, high;
+	const double *save_arr;
+
+	/* data, only once - they are the same for all records */
+	if(this->save_data && !this->data_saved){
+		Vec datasave_Vec;
+		decomposition->createGlobalVec_data(&datasave_Vec);
+		decomposition->permute_TRxdim(datasave_Vec, tsdata->get_datavector()->get_vector(), true);
+
+		TRYCXX( VecGetOwnershipRange(datasave_Vec, &low, &high) );
+		TRYCXX( VecGetArrayRead(datasave_Vec, &save_arr) );
+		write_field(RESULTFILE_FIELD_DATA, save_arr, low/xdim, (high-low)/xdim, xdim, (int64_t)T*R, &(record.fields[RESULTFILE_FIELD_DATA]));
+		TRYCXX( VecRestoreArrayRead(datasave_Vec, &save_arr) );
+
+		TRYCXX( VecDestroy(&datasave_Vec) );
+		this->data_saved = true;
+	}
+
+	/* gamma */
+	Vec gammasave_Vec;
+	decomposition->createGlobalVec_gamma(&gammasave_Vec);
+	decomposition->permute_TRK(gammasave_Vec, tsdata->get_gammavector()->get_vector(), true);
+
+	TRYCXX( VecGetOwnershipRange(gammasave_Vec, &low, &high) );
+	TRYCXX( VecGetArrayRead(gammasave_Vec, &save_arr) );
+	write_field(RESULTFILE_FIELD_GAMMA, save_arr, low/K, (high-low)/K, K, (int64_t)T*R, &(record.fields[RESULTFILE_FIELD_GAMMA]));
+	TRYCXX( VecRestoreArrayRead(gammasave_Vec, &save_arr) );
+
+	TRYCXX( VecDestroy(&gammasave_Vec) );
+
+	/* theta is the same on all processes, master writes it */
+	const double *theta_arr;
+	TRYCXX( VecGetArrayRead(tsdata->get_thetavector()->get_vector(), &theta_arr) );
+	write_field(RESULTFILE_FIELD_THETA, theta_arr, 0, (GlobalManager.get_rank() == 0)? K : 0, xdim, K, &(record.fields[RESULTFILE_FIELD_THETA]));
+
+	/* recovered signal: x[row*xdim+n] = sum_k gamma[row*K+k]*theta[k*xdim+n] */
+	Vec recovered_Vec;
+	decomposition->createGlobalVec_data(&recovered_Vec);
+
+	const double *gamma_arr;
+	double *recovered_arr;
+	TRYCXX( VecGetArrayRead(tsdata->get_gammavector()->get_vector(), &gamma_arr) );
+	TRYCXX( VecGetArray(recovered_Vec, &recovered_arr) );
+	for(int row=0; row < TRlocal; row++){
+		for(int n=0; n < xdim; n++){
+			double value = 0.0;
+			for(int k=0; k < K; k++){
+				value += gamma_arr[row*K + k]*theta_arr[k*xdim + n];
+			}
+			recovered_arr[row*xdim + n] = value;
+		}
+	}
+	TRYCXX( VecRestoreArray(recovered_Vec, &recovered_arr) );
+	TRYCXX( VecRestoreArrayRead(tsdata->get_gammavector()->get_vector(), &gamma_arr) );
+	TRYCXX( VecRestoreArrayRead(tsdata->get_thetavector()->get_vector(), &theta_arr) );
+
+	Vec recoveredsave_Vec;
+	decomposition->createGlobalVec_data(&recoveredsave_Vec);
+	decomposition->permute_TRxdim(recoveredsave_Vec, recovered_Vec, true);
+
+	TRYCXX( VecGetOwnershipRange(recoveredsave_Vec, &low, &high) );
+	TRYCXX( VecGetArrayRead(recoveredsave_Vec, &save_arr) );
+	write_field(RESULTFILE_FIELD_RECOVERED, save_arr, low/xdim, (high-low)/xdim, xdim, (int64_t)T*R, &(record.fields[RESULTFILE_FIELD_RECOVERED]));
+	TRYCXX( VecRestoreArrayRead(recoveredsave_Vec, &save_arr) );
+
+	TRYCXX( VecDestroy(&recovered_Vec) );
+	TRYCXX( VecDestroy(&recoveredsave_Vec) );
+
+	/* append record, master writes the table of all records behind it; the header points to this table after the snapshot is finished */
+	this->records.push_back(record);
+	int64_t table_nbytes = this->records.size()*sizeof(ResultFileRecord);
+	if(GlobalManager.get_rank() == 0){
+		std::vector<char> table_buffer(table_nbytes);
+		memcpy(&table_buffer[0], &(this->records[0]), table_nbytes);
+		externalcontent->iwrite(snapshot, this->end_offset, table_buffer);
+	}
+	snapshot->header_table[0] = this->end_offset;
+	snapshot->header_table[1] = this->records.size();
+	this->end_offset += table_nbytes;
+
+	/* limit the memory of snapshots, solver continues while at most max_inflight records are being written */
+	this->timer_wait.start();
+	while((int)externalcontent->inflight.size() > this->max_inflight){
+		externalcontent->wait_oldest();
+	}
+	this->timer_wait.stop();
+
+	this->timer_write.stop();
+
+	LOG_FUNC_END
+}
+
+template<>
+void ResultFile<PetscVector>::flush(){
+	LOG_FUNC_BEGIN
+
+	this->timer_wait.start();
+	while(externalcontent->inflight.size() > 0){
+		externalcontent->wait_oldest();
+	}
+	this->timer_wait.stop();
+
+	LOG_FUNC_END
+}
+
+template<>
+ResultFile<PetscVector>::ExternalContent * ResultFile<PetscVector>::get_externalcontent() const {
+	return this->externalcontent;
+}
+
+}
+} /* end namespace */
@@ -21,8 +21,9 @@ Signal1DData<PetscVector>::Signal1DData(std::string filename_data){
 	/* get the size of the loaded vector */
 	TRYCXX( VecGetSize(datapreload_Vec, &Tpreliminary) );
 	
-	/* other vectors will be prepared after setting the model */
-	this->destroy_datavector = true;
+	/* datavector will be prepared in set_decomposition, other vectors after setting the model */
+	this->datavector = NULL;
+	this->destroy_datavector = false;
 	this->destroy_gammavector = false;
 	this->destroy_thetavector = false;
 
@@ -38,8 +39,7 @@ void Signal1DData<PetscVector>::set_decomposition(Decomposition<PetscVector> &ne
 	/* prepare real datavector */
 	Vec data_Vec;
 	this->decomposition->createGlobalVec_data(&data_Vec);
-	this->datavector = new GeneralVector<PetscVector>(data_Vec);
-	this->destroy_datavector = true;
+	this->set_datavector_owned(new GeneralVector<PetscVector>(data_Vec));
 	
 	/* permute orig to new using parallel layout */
 	Vec datapreload_Vec = datavectorpreliminary->get_vector();
@@ -66,10 +66,6 @@ void Signal1DData<PetscVector>::saveSignal1D(std::string filename, bool save_ori
 	this->decomposition->createGlobalVec_data(&datasave_Vec);
 	GeneralVector<PetscVector> datasave(datasave_Vec);
 
-	Vec gammasave_Vec;
-	this->decomposition->createGlobalVec_gamma(&gammasave_Vec);
-	GeneralVector<PetscVector> gammasave(gammasave_Vec);
-
 	/* save datavector - just for fun; to see if it was loaded in a right way */
 	if(save_original){
 		oss_name_of_file << "results/" << filename << "_original.bin";
@@ -78,39 +74,26 @@ void Signal1DData<PetscVector>::saveSignal1D(std::string filename, bool save_ori
 		oss_name_of_file.str("");
 	}
 
-	/* save gamma */
-	oss_name_of_file << "results/" << filename << "_gamma.bin";
-	this->decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
-	gammasave.save_binary(oss_name_of_file.str());
+	/* save gamma, compact labels of clusters instead of dense vector if required */
+	if(this->get_save_labels()){
+		oss_name_of_file << "results/" << filename << "_gamma" << TSDATA_LABELS_EXTENSION;
+		this->save_gammalabels(oss_name_of_file.str());
+	} else {
+		Vec gammasave_Vec;
+		this->decomposition->createGlobalVec_gamma(&gammasave_Vec);
+		GeneralVector<PetscVector> gammasave(gammasave_Vec);
+
+		oss_name_of_file << "results/" << filename << "_gamma.bin";
+		this->decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
+		gammasave.save_binary(oss_name_of_file.str());
+	}
 	oss_name_of_file.str("");
 
-	/* compute recovered signal */
-	Vec gammak_Vec;
-	IS gammak_is;
-
+	/* compute recovered signal, one-hot rows of gamma are gathered from theta */
 	Vec data_recovered_Vec;
 	TRYCXX( VecDuplicate(datavector->get_vector(), &data_recovered_Vec) );
-	TRYCXX( VecSet(data_recovered_Vec,0.0));
 	GeneralVector<PetscVector> data_recovered(data_recovered_Vec);
-
-	double *theta_arr;
-	TRYCXX( VecGetArray(thetavector->get_vector(),&theta_arr) );
-
-	int K = this->get_K();
-
-	for(int k=0;k<K;k++){ 
-		/* get gammak */
-		this->decomposition->createIS_gammaK(&gammak_is, k);
-		TRYCXX( VecGetSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-
-		/* add to recovered image */
-		TRYCXX( VecAXPY(data_recovered_Vec, theta_arr[k], gammak_Vec) );
-
-		TRYCXX( VecRestoreSubVector(gammavector->get_vector(), gammak_is, &gammak_Vec) );
-		TRYCXX( ISDestroy(&gammak_is) );
-	}	
-
-	TRYCXX( VecRestoreArray(thetavector->get_vector(),&theta_arr) );
+	this->compute_recovered(data_recovered);
 
 	/* save recovered data */
 	oss_name_of_file << "results/" << filename << "_recovered.bin";
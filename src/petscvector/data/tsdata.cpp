@@ -48,8 +48,7 @@ TSData<PetscVector>::TSData(Decomposition<PetscVector> &new_decomposition){
 	/* we are ready to prepare datavector */
 	Vec data_Vec;
 	this->decomposition->createGlobalVec_data(&data_Vec);
-	this->datavector = new GeneralVector<PetscVector>(data_Vec);
-	destroy_datavector = true;
+	this->set_datavector_owned(new GeneralVector<PetscVector>(data_Vec));
 
 	/* gamma and theta vectors are not given */
 	this->gammavector = NULL;
@@ -159,8 +158,7 @@ void TSData<PetscVector>::set_model(TSModel<PetscVector> &tsmodel){
 	if(!this->datavector){
 		Vec datavector_Vec;
 		decomposition->createGlobalVec_data(&datavector_Vec);
-		this->datavector = new GeneralVector<PetscVector>(datavector_Vec);
-		this->destroy_datavector = true;
+		this->set_datavector_owned(new GeneralVector<PetscVector>(datavector_Vec));
 	}
 
 	if(!this->gammavector){
@@ -170,6 +168,7 @@ void TSData<PetscVector>::set_model(TSModel<PetscVector> &tsmodel){
 
 		this->gammavector = new GeneralVector<PetscVector>(gammavector_Vec);
 		this->destroy_gammavector = true;
+		MemoryCheck::owned_add("TSData", gammavector->local_size()*sizeof(double));
 	}
 
 	/* Theta vector is sequential */
@@ -187,6 +186,7 @@ void TSData<PetscVector>::set_model(TSModel<PetscVector> &tsmodel){
 		
 		this->thetavector = new GeneralVector<PetscVector>(thetavector_Vec);
 		this->destroy_thetavector = true;
+		MemoryCheck::owned_add("TSData", thetavector->local_size()*sizeof(double));
 	}
 
 	LOG_FUNC_END
@@ -394,9 +394,8 @@ void TSData<PetscVector>::scaledata(double a, double b){
 	double k = (b-a)/((double)(scale_max-scale_min));
 	double q = a-k*scale_min;
 
-	/* compute x = (x-scale_min)/(scale_max-scale_min) */
-	TRYCXX( VecScale(x_Vec, k) );
-	TRYCXX( VecShift(x_Vec, q) );
+	/* compute x = (x-scale_min)/(scale_max-scale_min) in one pass */
+	*datavector = k*lazy(*datavector) + q;
 	
 	TRYCXX( VecAssemblyBegin(x_Vec) );
 	TRYCXX( VecAssemblyEnd(x_Vec) );
@@ -431,9 +430,8 @@ void TSData<PetscVector>::unscaledata(double a, double b){
 	double k = (b-a)/((double)(scale_max-scale_min));
 	double q = a-k*scale_min;
 
-	/* compute x = (x-scale_min)/(scale_max-scale_min) */
-	TRYCXX( VecShift(x_Vec, -q) );
-	TRYCXX( VecScale(x_Vec, 1.0/k) );
+	/* compute x = (x-scale_min)/(scale_max-scale_min) in one pass */
+	*datavector = (lazy(*datavector) - q)/k;
 
 	TRYCXX( VecAssemblyBegin(x_Vec) );
 	TRYCXX( VecAssemblyEnd(x_Vec) );
@@ -519,9 +517,8 @@ void TSData<PetscVector>::scaledata(double a, double b, double scale_min, double
 	double k = (b-a)/((double)(scale_max-scale_min));
 	double q = a-k*scale_min;
 
-	/* compute x = (x-scale_min)/(scale_max-scale_min) */
-	TRYCXX( VecScale(x_Vec, k) );
-	TRYCXX( VecShift(x_Vec, q) );
+	/* compute x = (x-scale_min)/(scale_max-scale_min) in one pass */
+	*datavector = k*lazy(*datavector) + q;
 	
 	TRYCXX( VecAssemblyBegin(x_Vec) );
 	TRYCXX( VecAssemblyEnd(x_Vec) );
@@ -599,6 +596,14 @@ void TSData<PetscVector>::load_gammavector(std::string filename) const {
 	
 	//TODO: control existence of file
 
+	/* compact labels of clusters instead of dense gamma */
+	if(is_gammalabels_file(filename)){
+		this->load_gammalabels(filename);
+
+		LOG_FUNC_END
+		return;
+	}
+
 	/* aux vector, we first oad data and then distribute values to procs */
 	Vec gamma_preload_Vec;
 	TRYCXX( VecCreate(PETSC_COMM_WORLD, &gamma_preload_Vec) );
@@ -656,8 +661,654 @@ double TSData<PetscVector>::compute_gammavector_nbins() {
 	return nbins;
 }
 
+/* move values in layout of decomposition [t*R*blocksize + Pr(r)*blocksize + k] by nshift time steps to the begining,
+ * last nshift time steps are filled by the values from the last time step; the nodes are not moved, therefore the shift
+ * does not depend on the permutation of graph */
+static void shift_time(Vec x_Vec, int T, int R, int blocksize, int nshift){
+	int rowsize = R*blocksize;
+	int low, high;
+	TRYCXX( VecGetOwnershipRange(x_Vec, &low, &high) );
+
+	/* for each my index find the index of value which will be moved here */
+	int *from_arr;
+	from_arr = new int [high-low];
+	for(int i=low;i<high;i++){
+		int t = i/rowsize;
+		if(t + nshift < T){
+			from_arr[i-low] = i + nshift*rowsize;
+		} else {
+			from_arr[i-low] = (T-1)*rowsize + i%rowsize;
+		}
+	}
+
+	IS from_is;
+	IS to_is;
+	TRYCXX( ISCreateGeneral(PETSC_COMM_WORLD, high-low, from_arr, PETSC_COPY_VALUES, &from_is) );
+	TRYCXX( ISCreateStride(PETSC_COMM_WORLD, high-low, low, 1, &to_is) );
+	delete [] from_arr;
+
+	/* values are moved between processes, therefore scatter into new vector */
+	Vec x_new_Vec;
+	TRYCXX( VecDuplicate(x_Vec, &x_new_Vec) );
+
+	VecScatter shift_scatter;
+	TRYCXX( VecScatterCreate(x_Vec, from_is, x_new_Vec, to_is, &shift_scatter) );
+	TRYCXX( VecScatterBegin(shift_scatter, x_Vec, x_new_Vec, INSERT_VALUES, SCATTER_FORWARD) );
+	TRYCXX( VecScatterEnd(shift_scatter, x_Vec, x_new_Vec, INSERT_VALUES, SCATTER_FORWARD) );
+
+	TRYCXX( VecCopy(x_new_Vec, x_Vec) );
+
+	TRYCXX( VecScatterDestroy(&shift_scatter) );
+	TRYCXX( VecDestroy(&x_new_Vec) );
+	TRYCXX( ISDestroy(&from_is) );
+	TRYCXX( ISDestroy(&to_is) );
 
 }
-} /* end namespace */
 
+template<>
+void TSData<PetscVector>::append_samples(const double *values, int nsamples){
+	LOG_FUNC_BEGIN
+
+	int T = this->get_T();
+	int R = this->get_R();
+	int xdim = this->get_xdim();
+
+	if(nsamples <= 0){
+		LOG_FUNC_END
+		return;
+	}
 
+	/* only last T samples fit into window */
+	if(nsamples > T){
+		values = &values[(nsamples-T)*R*xdim];
+		nsamples = T;
+	}
+
+	/* data: shift and append new samples, the node of new sample is permuted as in decomposition */
+	shift_time(datavector->get_vector(), T, R, xdim, nsamples);
+
+	int low, high;
+	int new_begin = (T-nsamples)*R*xdim; /* position of first new sample */
+	double *data_arr;
+	TRYCXX( VecGetOwnershipRange(datavector->get_vector(), &low, &high) );
+	TRYCXX( VecGetArray(datavector->get_vector(), &data_arr) );
+	for(int i=(low > new_begin)? low : new_begin;i<high;i++){
+		int t_new = (i - new_begin)/(R*xdim);
+		int r = decomposition->get_invPr((i/xdim)%R);
+		data_arr[i-low] = values[t_new*R*xdim + r*xdim + i%xdim];
+	}
+	TRYCXX( VecRestoreArray(datavector->get_vector(), &data_arr) );
+
+	/* gamma: shift to keep the solution on the overlap as initial approximation */
+	if(gammavector){
+		shift_time(gammavector->get_vector(), T, R, this->get_K(), nsamples);
+	}
+
+	LOG_FUNC_END
+}
+
+
+
+/* write own part of vector in original layout into heavy-data file, everybody together */
+static void write_xdmf_slab(MPI_File file, MPI_Offset offset, Vec x_Vec){
+	int low, high;
+	const double *x_arr;
+	TRYCXX( VecGetOwnershipRange(x_Vec, &low, &high) );
+	TRYCXX( VecGetArrayRead(x_Vec, &x_arr) );
+	MPI_File_write_at_all(file, offset + (MPI_Offset)low*sizeof(double), (void *)x_arr, high-low, MPI_DOUBLE, MPI_STATUS_IGNORE);
+	TRYCXX( VecRestoreArrayRead(x_Vec, &x_arr) );
+}
+
+/* description of one time step of field stored in heavy-data file */
+static void print_xdmf_attribute(std::ofstream &xmf, std::string name, int R, int blocksize, MPI_Offset offset, std::string binname){
+	xmf << "    <Attribute Name=\"" << name << "\" AttributeType=\"" << ((blocksize == 1)? "Scalar" : "Matrix") << "\" Center=\"Node\">\n";
+	xmf << "     <DataItem Format=\"Binary\" Endian=\"Little\" NumberType=\"Float\" Precision=\"8\" Dimensions=\"" << R << " " << blocksize << "\" Seek=\"" << offset << "\">" << binname << "</DataItem>\n";
+	xmf << "    </Attribute>\n";
+}
+
+template<>
+void TSData<PetscVector>::saveXDMF(std::string filename) const{
+	LOG_FUNC_BEGIN
+
+	Timer timer_saveXDMF;
+	timer_saveXDMF.restart();
+	timer_saveXDMF.start();
+
+	int T = decomposition->get_T();
+	int R = decomposition->get_R();
+	int K = decomposition->get_K();
+	int xdim = decomposition->get_xdim();
+
+	/* edges of graph, every edge only once */
+	BGMGraph<PetscVector> *graph = decomposition->get_graph();
+	std::vector<int> edges;
+	if(graph != NULL && graph->get_n() == R && graph->get_neighbor_nmbs() != NULL){
+		int *neighbor_nmbs = graph->get_neighbor_nmbs();
+		int **neighbor_ids = graph->get_neighbor_ids();
+		for(int r=0; r < R; r++){
+			for(int j=0; j < neighbor_nmbs[r]; j++){
+				if(r < neighbor_ids[r][j]){
+					edges.push_back(r);
+					edges.push_back(neighbor_ids[r][j]);
+				}
+			}
+		}
+	}
+	int nedges = edges.size()/2;
+
+	/* layout of heavy-data file */
+	MPI_Offset offset_geometry = 0;
+	MPI_Offset offset_topology = offset_geometry + (MPI_Offset)R*3*sizeof(double);
+	MPI_Offset offset_data = offset_topology + (MPI_Offset)((nedges > 0)? 2*nedges : R)*sizeof(int);
+	MPI_Offset offset_gamma = offset_data + (MPI_Offset)T*R*xdim*sizeof(double);
+	MPI_Offset offset_recovered = offset_gamma + (MPI_Offset)T*R*K*sizeof(double);
+
+	std::string binname = filename + ".bin";
+	size_t slash = binname.find_last_of('/');
+	std::string binname_relative = (slash == std::string::npos)? binname : binname.substr(slash+1);
+
+	MPI_File file;
+	MPI_File_open(PETSC_COMM_WORLD, (char *)binname.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file);
+	MPI_File_set_size(file, 0);
+
+	/* master writes geometry and topology */
+	const double *theta_arr;
+	TRYCXX( VecGetArrayRead(thetavector->get_vector(), &theta_arr) );
+
+	if(GlobalManager.get_rank() == 0){
+		std::vector<double> geometry(R*3, 0.0);
+		GeneralVector<PetscVector> *coordinates = (tsmodel != NULL)? tsmodel->get_coordinatesVTK() : NULL;
+		if(coordinates != NULL){
+			int coordinates_dim = tsmodel->get_coordinatesVTK_dim();
+			const double *coordinates_arr;
+			TRYCXX( VecGetArrayRead(coordinates->get_vector(), &coordinates_arr) );
+			for(int r=0; r < R; r++){
+				for(int d=0; d < coordinates_dim && d < 3; d++){
+					geometry[r*3 + d] = coordinates_arr[d*R + r];
+				}
+			}
+			TRYCXX( VecRestoreArrayRead(coordinates->get_vector(), &coordinates_arr) );
+		} else {
+			/* there are no coordinates, nodes are on line */
+			for(int r=0; r < R; r++){
+				geometry[r*3] = r;
+			}
+		}
+		MPI_File_write_at(file, offset_geometry, &geometry[0], R*3, MPI_DOUBLE, MPI_STATUS_IGNORE);
+
+		if(nedges > 0){
+			MPI_File_write_at(file, offset_topology, &edges[0], 2*nedges, MPI_INT, MPI_STATUS_IGNORE);
+		} else {
+			std::vector<int> vertices(R);
+			for(int r=0; r < R; r++){
+				vertices[r] = r;
+			}
+			MPI_File_write_at(file, offset_topology, &vertices[0], R, MPI_INT, MPI_STATUS_IGNORE);
+		}
+	}
+
+	/* data in original layout */
+	Vec datasave_Vec;
+	decomposition->createGlobalVec_data(&datasave_Vec);
+	decomposition->permute_TRxdim(datasave_Vec, datavector->get_vector(), true);
+	write_xdmf_slab(file, offset_data, datasave_Vec);
+
+	/* gamma in original layout */
+	Vec gammasave_Vec;
+	decomposition->createGlobalVec_gamma(&gammasave_Vec);
+	decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
+	write_xdmf_slab(file, offset_gamma, gammasave_Vec);
+	TRYCXX( VecDestroy(&gammasave_Vec) );
+
+	/* recovered signal: x[row*xdim+n] = sum_k gamma[row*K+k]*theta[k*xdim+n], reuse the vector for data */
+	Vec recovered_Vec;
+	TRYCXX( VecDuplicate(datavector->get_vector(), &recovered_Vec) );
+	GeneralVector<PetscVector> recovered(recovered_Vec);
+	this->compute_recovered(recovered);
+
+	decomposition->permute_TRxdim(datasave_Vec, recovered_Vec, true);
+	write_xdmf_slab(file, offset_recovered, datasave_Vec);
+	TRYCXX( VecDestroy(&datasave_Vec) );
+
+	MPI_File_close(&file);
+
+	/* master writes light-data file, geometry and topology are referenced from all time steps */
+	if(GlobalManager.get_rank() == 0){
+		std::string xmfname = filename + ".xmf";
+		std::ofstream xmf(xmfname.c_str());
+		xmf << "<?xml version=\"1.0\" ?>\n";
+		xmf << "<Xdmf Version=\"2.0\">\n";
+		xmf << " <Domain>\n";
+
+		xmf << "  <Information Name=\"theta\" Value=\"";
+		for(int i=0; i < K*xdim; i++){
+			xmf << theta_arr[i] << ((i < K*xdim-1)? " " : "");
+		}
+		xmf << "\"/>\n";
+
+		if(nedges > 0){
+			xmf << "  <Topology Name=\"graph\" TopologyType=\"Polyline\" NodesPerElement=\"2\" NumberOfElements=\"" << nedges << "\">\n";
+			xmf << "   <DataItem Format=\"Binary\" Endian=\"Little\" NumberType=\"Int\" Precision=\"4\" Dimensions=\"" << nedges << " 2\" Seek=\"" << offset_topology << "\">" << binname_relative << "</DataItem>\n";
+		} else {
+			xmf << "  <Topology Name=\"graph\" TopologyType=\"Polyvertex\" NodesPerElement=\"1\" NumberOfElements=\"" << R << "\">\n";
+			xmf << "   <DataItem Format=\"Binary\" Endian=\"Little\" NumberType=\"Int\" Precision=\"4\" Dimensions=\"" << R << "\" Seek=\"" << offset_topology << "\">" << binname_relative << "</DataItem>\n";
+		}
+		xmf << "  </Topology>\n";
+		xmf << "  <Geometry Name=\"coordinates\" GeometryType=\"XYZ\">\n";
+		xmf << "   <DataItem Format=\"Binary\" Endian=\"Little\" NumberType=\"Float\" Precision=\"8\" Dimensions=\"" << R << " 3\" Seek=\"" << offset_geometry << "\">" << binname_relative << "</DataItem>\n";
+		xmf << "  </Geometry>\n";
+
+		xmf << "  <Grid Name=\"timeseries\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+		for(int t=0; t < T; t++){
+			xmf << "   <Grid Name=\"t" << t << "\" GridType=\"Uniform\">\n";
+			xmf << "    <Time Value=\"" << t << "\"/>\n";
+			xmf << "    <Topology Reference=\"/Xdmf/Domain/Topology[1]\"/>\n";
+			xmf << "    <Geometry Reference=\"/Xdmf/Domain/Geometry[1]\"/>\n";
+			print_xdmf_attribute(xmf, "original", R, xdim, offset_data + (MPI_Offset)t*R*xdim*sizeof(double), binname_relative);
+			print_xdmf_attribute(xmf, "gamma", R, K, offset_gamma + (MPI_Offset)t*R*K*sizeof(double), binname_relative);
+			print_xdmf_attribute(xmf, "recovered", R, xdim, offset_recovered + (MPI_Offset)t*R*xdim*sizeof(double), binname_relative);
+			xmf << "   </Grid>\n";
+		}
+		xmf << "  </Grid>\n";
+		xmf << " </Domain>\n";
+		xmf << "</Xdmf>\n";
+		xmf.close();
+	}
+
+	TRYCXX( VecRestoreArrayRead(thetavector->get_vector(), &theta_arr) );
+
+	TRYCXX( PetscBarrier(NULL) );
+
+	timer_saveXDMF.stop();
+	coutMaster <<  " - results saved to XDMF in: " << timer_saveXDMF.get_value_sum() << std::endl;
+
+	LOG_FUNC_END
+}
+
+
+/* simple deterministic random generator, all processes generate the same sequence from the same state */
+static double kmeans_random(unsigned int *state){
+	*state = (*state)*1103515245u + 12345u;
+	return ((*state >> 8) & 0xFFFFFF)/(double)0x1000000;
+}
+
+static double kmeans_distsqr(const double *x, const double *y, int xdim){
+	double value = 0.0;
+	for(int n=0; n < xdim; n++){
+		value += (x[n] - y[n])*(x[n] - y[n]);
+	}
+	return value;
+}
+
+/* choose one row with probability proportional to weights (uniformly if weights are NULL), all processes obtain the chosen row */
+static void kmeans_choose_row(const double *weights, const double *data_arr, int nrows_local, int xdim, unsigned int *state, double *center){
+	double weight_local = 0.0;
+	for(int i=0; i < nrows_local; i++){
+		weight_local += (weights != NULL)? weights[i] : 1.0;
+	}
+
+	int nproc = GlobalManager.get_size();
+	std::vector<double> weights_all(nproc);
+	MPI_Allgather(&weight_local, 1, MPI_DOUBLE, &weights_all[0], 1, MPI_DOUBLE, PETSC_COMM_WORLD);
+
+	double weight_sum = 0.0;
+	for(int p=0; p < nproc; p++){
+		weight_sum += weights_all[p];
+	}
+
+	/* find the owner of chosen row, all processes make the same decision */
+	double u = kmeans_random(state)*weight_sum;
+	int owner = -1;
+	for(int p=0; p < nproc; p++){
+		if(weights_all[p] > 0.0){
+			owner = p;
+			if(u < weights_all[p]){
+				break;
+			}
+			u -= weights_all[p];
+		}
+	}
+
+	if(GlobalManager.get_rank() == owner){
+		int row = nrows_local-1;
+		double weight_cumsum = 0.0;
+		for(int i=0; i < nrows_local; i++){
+			weight_cumsum += (weights != NULL)? weights[i] : 1.0;
+			if(u < weight_cumsum){
+				row = i;
+				break;
+			}
+		}
+		for(int n=0; n < xdim; n++){
+			center[n] = data_arr[row*xdim + n];
+		}
+	}
+	MPI_Bcast(center, xdim, MPI_DOUBLE, (owner >= 0)? owner : 0, PETSC_COMM_WORLD);
+}
+
+template<>
+void TSData<PetscVector>::init_gammavector_kmeans(int seed, int nmb_lloyd, double softness) const{
+	LOG_FUNC_BEGIN
+
+	int K = decomposition->get_K();
+	int xdim = decomposition->get_xdim();
+	int nrows_local = decomposition->get_Tlocal()*decomposition->get_Rlocal();
+
+	unsigned int state = 2654435761u*(unsigned int)(seed + 1);
+
+	const double *data_arr;
+	TRYCXX( VecGetArrayRead(datavector->get_vector(), &data_arr) );
+
+	/* k-means++ seeding: next center is chosen with probability proportional to squared distance from the nearest chosen center */
+	std::vector<double> centers(K*xdim);
+	std::vector<double> mindist(nrows_local, std::numeric_limits<double>::max());
+	kmeans_choose_row(NULL, data_arr, nrows_local, xdim, &state, &centers[0]);
+	for(int k=1; k < K; k++){
+		double mindist_sum_local = 0.0;
+		for(int i=0; i < nrows_local; i++){
+			mindist[i] = std::min(mindist[i], kmeans_distsqr(&data_arr[i*xdim], &centers[(k-1)*xdim], xdim));
+			mindist_sum_local += mindist[i];
+		}
+		double mindist_sum;
+		MPI_Allreduce(&mindist_sum_local, &mindist_sum, 1, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+		/* all data are already centers, choose uniformly */
+		kmeans_choose_row((mindist_sum > 0.0)? &mindist[0] : NULL, data_arr, nrows_local, xdim, &state, &centers[k*xdim]);
+	}
+
+	/* Lloyd iterations, one reduction of sums and counts per iteration */
+	std::vector<double> sums_local(K*xdim + K);
+	std::vector<double> sums(K*xdim + K);
+	for(int it=0; it < nmb_lloyd; it++){
+		std::fill(sums_local.begin(), sums_local.end(), 0.0);
+		for(int i=0; i < nrows_local; i++){
+			int label = 0;
+			double dist_min = std::numeric_limits<double>::max();
+			for(int k=0; k < K; k++){
+				double dist = kmeans_distsqr(&data_arr[i*xdim], &centers[k*xdim], xdim);
+				if(dist < dist_min){
+					dist_min = dist;
+					label = k;
+				}
+			}
+			for(int n=0; n < xdim; n++){
+				sums_local[label*xdim + n] += data_arr[i*xdim + n];
+			}
+			sums_local[K*xdim + label] += 1.0;
+		}
+		MPI_Allreduce(&sums_local[0], &sums[0], K*xdim + K, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+		/* empty clusters keep old center */
+		for(int k=0; k < K; k++){
+			if(sums[K*xdim + k] > 0.0){
+				for(int n=0; n < xdim; n++){
+					centers[k*xdim + n] = sums[k*xdim + n]/sums[K*xdim + k];
+				}
+			}
+		}
+	}
+
+	/* average distance from the nearest center is the scale of softening */
+	double dist_scale = 1.0;
+	if(softness > 0.0){
+		double dist_local[2] = {0.0, (double)nrows_local};
+		for(int i=0; i < nrows_local; i++){
+			double dist_min = std::numeric_limits<double>::max();
+			for(int k=0; k < K; k++){
+				dist_min = std::min(dist_min, kmeans_distsqr(&data_arr[i*xdim], &centers[k*xdim], xdim));
+			}
+			dist_local[0] += dist_min;
+		}
+		double dist_global[2];
+		MPI_Allreduce(dist_local, dist_global, 2, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+		dist_scale = softness*dist_global[0]/dist_global[1];
+	}
+
+	/* gamma from distances to centers */
+	double *gamma_arr;
+	TRYCXX( VecGetArray(gammavector->get_vector(), &gamma_arr) );
+	std::vector<double> dists(K);
+	for(int i=0; i < nrows_local; i++){
+		int label = 0;
+		for(int k=0; k < K; k++){
+			dists[k] = kmeans_distsqr(&data_arr[i*xdim], &centers[k*xdim], xdim);
+			if(dists[k] < dists[label]){
+				label = k;
+			}
+		}
+
+		if(softness > 0.0 && dist_scale > 0.0){
+			double gamma_sum = 0.0;
+			for(int k=0; k < K; k++){
+				gamma_arr[i*K + k] = exp(-(dists[k] - dists[label])/dist_scale);
+				gamma_sum += gamma_arr[i*K + k];
+			}
+			for(int k=0; k < K; k++){
+				gamma_arr[i*K + k] /= gamma_sum;
+			}
+		} else {
+			for(int k=0; k < K; k++){
+				gamma_arr[i*K + k] = (k == label)? 1.0 : 0.0;
+			}
+		}
+	}
+	TRYCXX( VecRestoreArray(gammavector->get_vector(), &gamma_arr) );
+	TRYCXX( VecRestoreArrayRead(datavector->get_vector(), &data_arr) );
+
+	LOG_FUNC_END
+}
+
+/* header of file with labels of clusters, see save_gammalabels */
+struct TSDataLabelsHeader {
+	char magic[8];
+	int32_t T;
+	int32_t R;
+	int32_t K;
+	int32_t labelsize;
+	int32_t theta_size;
+	int32_t reserved;
+};
+
+template<>
+void TSData<PetscVector>::save_gammalabels(std::string filename) const {
+	LOG_FUNC_BEGIN
+
+	int K = get_K();
+	int labelsize = (K <= 256)? 1 : 2;
+
+	/* gamma in original layout, every row (node in time step) is a block of K values */
+	Vec gammasave_Vec;
+	decomposition->createGlobalVec_gamma(&gammasave_Vec);
+	decomposition->permute_TRK(gammasave_Vec, gammavector->get_vector(), true);
+
+	int low, high;
+	TRYCXX( VecGetOwnershipRange(gammasave_Vec, &low, &high) );
+	int nrows_local = (high - low)/K;
+
+	/* index of maximal value in every row */
+	std::vector<unsigned char> labels((size_t)nrows_local*labelsize);
+	const double *gamma_arr;
+	TRYCXX( VecGetArrayRead(gammasave_Vec, &gamma_arr) );
+	for(int row=0; row < nrows_local; row++){
+		const double *gamma_row = &gamma_arr[row*K];
+		int label = 0;
+		for(int k=1; k < K; k++){
+			if(gamma_row[k] > gamma_row[label]){
+				label = k;
+			}
+		}
+
+		if(labelsize == 1){
+			labels[row] = (unsigned char)label;
+		} else {
+			uint16_t label16 = (uint16_t)label;
+			memcpy(&labels[row*2], &label16, 2);
+		}
+	}
+	TRYCXX( VecRestoreArrayRead(gammasave_Vec, &gamma_arr) );
+	TRYCXX( VecDestroy(&gammasave_Vec) );
+
+	/* theta is the same on all processes */
+	int theta_size;
+	const double *theta_arr;
+	TRYCXX( VecGetLocalSize(thetavector->get_vector(), &theta_size) );
+
+	TSDataLabelsHeader header;
+	memcpy(header.magic, TSDATA_LABELS_MAGIC, 8);
+	header.T = get_T();
+	header.R = get_R();
+	header.K = K;
+	header.labelsize = labelsize;
+	header.theta_size = theta_size;
+	header.reserved = 0;
+
+	MPI_Offset offset_labels = (MPI_Offset)sizeof(TSDataLabelsHeader) + (MPI_Offset)theta_size*sizeof(double);
+
+	MPI_File file;
+	MPI_File_open(PETSC_COMM_WORLD, (char *)filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file);
+	MPI_File_set_size(file, 0);
+
+	/* master writes header and theta */
+	if(GlobalManager.get_rank() == 0){
+		TRYCXX( VecGetArrayRead(thetavector->get_vector(), &theta_arr) );
+		MPI_File_write_at(file, 0, &header, sizeof(TSDataLabelsHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+		MPI_File_write_at(file, sizeof(TSDataLabelsHeader), (void *)theta_arr, theta_size, MPI_DOUBLE, MPI_STATUS_IGNORE);
+		TRYCXX( VecRestoreArrayRead(thetavector->get_vector(), &theta_arr) );
+	}
+
+	/* everybody writes own labels */
+	MPI_File_write_at_all(file, offset_labels + (MPI_Offset)(low/K)*labelsize, (nrows_local > 0)? &labels[0] : NULL, nrows_local*labelsize, MPI_BYTE, MPI_STATUS_IGNORE);
+
+	MPI_File_close(&file);
+
+	LOG_FUNC_END
+}
+
+template<>
+void TSData<PetscVector>::load_gammalabels(std::string filename) const {
+	LOG_FUNC_BEGIN
+
+	int K = get_K();
+
+	MPI_File file;
+	if(MPI_File_open(PETSC_COMM_WORLD, (char *)filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS){
+		coutMaster << "WARNING: file with labels " << filename << " cannot be opened, gamma is not loaded" << std::endl;
+		LOG_FUNC_END
+		return;
+	}
+
+	TSDataLabelsHeader header;
+	MPI_File_read_at_all(file, 0, &header, sizeof(TSDataLabelsHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+
+	if(strncmp(header.magic, TSDATA_LABELS_MAGIC, 8) != 0 || header.T != get_T() || header.R != get_R() || header.K != K){
+		coutMaster << "WARNING: file with labels " << filename << " does not correspond to the data (T=" << get_T() << ", R=" << get_R() << ", K=" << K << "), gamma is not loaded" << std::endl;
+		MPI_File_close(&file);
+		LOG_FUNC_END
+		return;
+	}
+
+	MPI_Offset offset_labels = (MPI_Offset)sizeof(TSDataLabelsHeader) + (MPI_Offset)header.theta_size*sizeof(double);
+	int labelsize = header.labelsize;
+
+	/* one-hot gamma in original layout */
+	Vec gamma_orig_Vec;
+	decomposition->createGlobalVec_gamma(&gamma_orig_Vec);
+
+	int low, high;
+	TRYCXX( VecGetOwnershipRange(gamma_orig_Vec, &low, &high) );
+	int nrows_local = (high - low)/K;
+
+	std::vector<unsigned char> labels((size_t)nrows_local*labelsize);
+	MPI_File_read_at_all(file, offset_labels + (MPI_Offset)(low/K)*labelsize, (nrows_local > 0)? &labels[0] : NULL, nrows_local*labelsize, MPI_BYTE, MPI_STATUS_IGNORE);
+	MPI_File_close(&file);
+
+	double *gamma_arr;
+	TRYCXX( VecGetArray(gamma_orig_Vec, &gamma_arr) );
+	for(int row=0; row < nrows_local; row++){
+		int label;
+		if(labelsize == 1){
+			label = labels[row];
+		} else {
+			uint16_t label16;
+			memcpy(&label16, &labels[row*2], 2);
+			label = label16;
+		}
+
+		for(int k=0; k < K; k++){
+			gamma_arr[row*K + k] = (k == label)? 1.0 : 0.0;
+		}
+	}
+	TRYCXX( VecRestoreArray(gamma_orig_Vec, &gamma_arr) );
+
+	/* permute to the layout of decomposition */
+	decomposition->permute_TRK(gamma_orig_Vec, gammavector->get_vector(), false);
+	TRYCXX( VecDestroy(&gamma_orig_Vec) );
+
+	LOG_FUNC_END
+}
+
+template<>
+void TSData<PetscVector>::compute_recovered(GeneralVector<PetscVector> &recovered) const {
+	LOG_FUNC_BEGIN
+
+	int K = get_K();
+	int xdim = get_xdim();
+	int Rlocal = decomposition->get_Rlocal();
+	int Rbegin = decomposition->get_Rbegin();
+	int TRlocal = decomposition->get_Tlocal()*Rlocal;
+
+	/* the data could be a batch of independent problems, each with its own Theta */
+	int theta_size;
+	TRYCXX( VecGetLocalSize(thetavector->get_vector(), &theta_size) );
+	int nmb_batch = theta_size/(K*xdim);
+	int Rbatch = (nmb_batch > 1)? get_R()/nmb_batch : get_R();
+
+	const double *gamma_arr;
+	const double *theta_arr;
+	double *recovered_arr;
+	TRYCXX( VecGetArrayRead(gammavector->get_vector(), &gamma_arr) );
+	TRYCXX( VecGetArrayRead(thetavector->get_vector(), &theta_arr) );
+	TRYCXX( VecGetArray(recovered.get_vector(), &recovered_arr) );
+
+	for(int row=0; row < TRlocal; row++){
+		/* local row is t*Rlocal + r */
+		const double *theta_b = theta_arr;
+		if(nmb_batch > 1){
+			theta_b = &theta_arr[(decomposition->get_invPr(Rbegin + row%Rlocal)/Rbatch)*K*xdim];
+		}
+
+		const double *gamma_row = &gamma_arr[row*K];
+		int label = 0;
+		int nmb_nonzero = 0;
+		for(int k=0; k < K; k++){
+			if(gamma_row[k] != 0.0){
+				label = k;
+				nmb_nonzero++;
+			}
+		}
+
+		if(nmb_nonzero == 1 && gamma_row[label] == 1.0){
+			/* one-hot row, gather theta of the cluster */
+			for(int n=0; n < xdim; n++){
+				recovered_arr[row*xdim + n] = theta_b[label*xdim + n];
+			}
+		} else {
+			for(int n=0; n < xdim; n++){
+				double value = 0.0;
+				for(int k=0; k < K; k++){
+					value += gamma_row[k]*theta_b[k*xdim + n];
+				}
+				recovered_arr[row*xdim + n] = value;
+			}
+		}
+	}
+
+	TRYCXX( VecRestoreArray(recovered.get_vector(), &recovered_arr) );
+	TRYCXX( VecRestoreArrayRead(thetavector->get_vector(), &theta_arr) );
+	TRYCXX( VecRestoreArrayRead(gammavector->get_vector(), &gamma_arr) );
+
+	LOG_FUNC_END
+}
+
+}
+} /* end namespace */
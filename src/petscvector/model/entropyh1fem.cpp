@@ -124,6 +124,15 @@ void EntropyH1FEMModel<PetscVector>::initialize_gammasolver(GeneralSolver **gamm
 		*gammasolver = new SPGQPSolver<PetscVector>(*gammadata);
 	}
 
+	/* FISTA-QP solver */
+	if(this->gammasolvertype == GSOLVER_FISTAQP){
+		/* the feasible set of QP is simplex */
+		gammadata->set_feasibleset(new SimplexFeasibleSet_Local<PetscVector>(this->tsdata->get_decomposition()->get_Tlocal(),this->tsdata->get_decomposition()->get_K())); 
+
+		/* create solver */
+		*gammasolver = new FISTAQPSolver<PetscVector>(*gammadata);
+	}
+
 	/* SPG-QP solver with special coefficient treatment */
 	if(this->gammasolvertype == GSOLVER_SPGQP_COEFF){
 		/* the feasible set of QP is simplex */
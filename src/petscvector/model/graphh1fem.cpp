@@ -5,7 +5,7 @@ namespace model {
 
 /* constructor */
 template<>
-GraphH1FEMModel<PetscVector>::GraphH1FEMModel(TSData<PetscVector> &new_tsdata, double epssqr, Fem<PetscVector> *new_fem, bool usethetainpenalty) {
+GraphH1FEMModel<PetscVector>::GraphH1FEMModel(TSData<PetscVector> &new_tsdata, double epssqr, Fem<PetscVector> *new_fem, bool usethetainpenalty, int nmb_batch) {
 	LOG_FUNC_BEGIN
 
 	// TODO: enum in boost::program_options, not only int
@@ -18,9 +18,20 @@ GraphH1FEMModel<PetscVector>::GraphH1FEMModel(TSData<PetscVector> &new_tsdata, d
 	/* set given parameters */
 	this->usethetainpenalty = usethetainpenalty;
 	this->tsdata = &new_tsdata;
+
+	/* batch of independent problems, each problem has its own Theta */
+	this->nmb_batch = nmb_batch;
+	if(this->nmb_batch < 1 || tsdata->get_R() % this->nmb_batch != 0){
+		coutMaster << "WARNING: R is not divisible by nmb_batch, solving one problem" << std::endl;
+		this->nmb_batch = 1;
+	}
+	if(this->nmb_batch > 1 && this->usethetainpenalty){
+		coutMaster << "WARNING: Theta in penalty is not available for batch of problems, using usethetainpenalty=false" << std::endl;
+		this->usethetainpenalty = false;
+	}
 	
 	/* prepare sequential vector with Theta - yes, all procesors will have the same information */
-	this->thetavectorlength_local = tsdata->get_K()*tsdata->get_xdim();
+	this->thetavectorlength_local = tsdata->get_K()*tsdata->get_xdim()*this->nmb_batch;
 	this->thetavectorlength_global = GlobalManager.get_size()*(this->thetavectorlength_local);
 
 	/* set this model to data - tsdata will prepare gamma vector and thetavector */
@@ -130,6 +141,8 @@ void GraphH1FEMModel<PetscVector>::initialize_gammasolver(GeneralSolver **gammas
 		
 		/* create the residuum from original gamma vector */
 		residuum = new GeneralVector<PetscVector>(*tsdata->get_gammavector());
+
+		MemoryCheck::owned_add("Fem reduced problem", (2*gammadata->get_x()->local_size() + residuum->local_size())*sizeof(double));
 	
 	} else {
 		/* there is not reduction at all, we can use vectors from original data */
@@ -179,6 +192,41 @@ void GraphH1FEMModel<PetscVector>::initialize_gammasolver(GeneralSolver **gammas
 
 		/* create solver */
 		*gammasolver = new SPGQPSolver<PetscVector>(*gammadata);
+
+		/* problems in batch are independent, solve them with their own step-sizes and stopping criteria */
+		if(this->nmb_batch > 1){
+			Decomposition<PetscVector> *decomposition = get_decomposition_reduced();
+			if(decomposition->get_R() == this->tsdata->get_R()){
+				int Tlocal = decomposition->get_Tlocal();
+				int Rlocal = decomposition->get_Rlocal();
+				int Rbegin = decomposition->get_Rbegin();
+				int Rbatch = decomposition->get_R()/this->nmb_batch;
+				int K = decomposition->get_K();
+
+				std::vector<int> batch_local(Tlocal*Rlocal*K);
+				for(int t=0;t<Tlocal;t++){
+					for(int r=0;r<Rlocal;r++){
+						int b = decomposition->get_invPr(Rbegin+r)/Rbatch;
+						for(int k=0;k<K;k++){
+							batch_local[(t*Rlocal+r)*K+k] = b;
+						}
+					}
+				}
+
+				dynamic_cast<SPGQPSolver<PetscVector> *>(*gammasolver)->set_batch(this->nmb_batch, batch_local);
+			} else {
+				coutMaster << "WARNING: FEM reduction changes the graph, problems in batch are solved together" << std::endl;
+			}
+		}
+	}
+
+	/* FISTA-QP solver */
+	if(this->gammasolvertype == SOLVER_FISTAQP){
+		/* the feasible set of QP is simplex */
+		gammadata->set_feasibleset(new SimplexFeasibleSet_Local<PetscVector>(get_decomposition_reduced()->get_Tlocal()*get_decomposition_reduced()->get_Rlocal(),get_decomposition_reduced()->get_K())); 
+
+		/* create solver */
+		*gammasolver = new FISTAQPSolver<PetscVector>(*gammadata);
 	}
 
 	/* SPG-QP solver with special coefficient treatment */
@@ -244,6 +292,16 @@ void GraphH1FEMModel<PetscVector>::updatebeforesolve_gammasolver(GeneralSolver *
 	int Rlocal = this->tsdata->get_decomposition()->get_Rlocal();
 
 	int K = this->tsdata->get_decomposition()->get_K();
+	int xdim = this->tsdata->get_decomposition()->get_xdim();
+
+	/* coefficient of linear term b = coeff*residuum */
+	double coeff = -1.0;
+	if(this->scalef){
+		coeff *= (1.0/((double)(this->get_T_reduced())));
+	}
+
+	/* if the problem is not reduced, then residuum=b and the coefficient is applied in the same pass */
+	double residuum_coeff = fem->is_reduced()? 1.0 : coeff;
 
 	/* update gamma_solver data - prepare new linear term */
 	const double *theta_arr;
@@ -255,10 +313,58 @@ void GraphH1FEMModel<PetscVector>::updatebeforesolve_gammasolver(GeneralSolver *
 	double *residuum_arr;
 	TRYCXX( VecGetArray(this->residuum->get_vector(), &residuum_arr) );
 
-	for(int t=0;t<Tlocal;t++){
-		for(int r=0;r<Rlocal;r++){
-			for(int k=0;k<K;k++){
-				residuum_arr[t*K*Rlocal + r*K + k] = (data_arr[t*Rlocal+r] - theta_arr[k])*(data_arr[t*Rlocal+r] - theta_arr[k]);
+	/* each node belongs to one problem in batch, the problem has its own Theta */
+	Decomposition<PetscVector> *decomposition = this->tsdata->get_decomposition();
+	int Rbegin = decomposition->get_Rbegin();
+	int Rbatch = R/this->nmb_batch;
+
+	std::vector<int> theta_offset(Rlocal);
+	for(int r=0;r<Rlocal;r++){
+		theta_offset[r] = (decomposition->get_invPr(Rbegin+r)/Rbatch)*K*xdim;
+	}
+
+	if(xdim == 1){
+		for(int t=0;t<Tlocal;t++){
+			for(int r=0;r<Rlocal;r++){
+				const double *theta_b = &theta_arr[theta_offset[r]];
+				double x = data_arr[t*Rlocal+r];
+				for(int k=0;k<K;k++){
+					residuum_arr[t*K*Rlocal + r*K + k] = residuum_coeff*(x - theta_b[k])*(x - theta_b[k]);
+				}
+			}
+		}
+	} else {
+		/* ||x - theta_k||^2 = ||x||^2 - 2*dot(x,theta_k) + ||theta_k||^2, the norms of Theta are computed only once */
+		std::vector<double> theta_norm(this->nmb_batch*K);
+		for(int bk=0;bk<this->nmb_batch*K;bk++){
+			double value = 0.0;
+			for(int n=0;n<xdim;n++){
+				value += theta_arr[bk*xdim+n]*theta_arr[bk*xdim+n];
+			}
+			theta_norm[bk] = value;
+		}
+
+		for(int t=0;t<Tlocal;t++){
+			for(int r=0;r<Rlocal;r++){
+				const double *x = &data_arr[(t*Rlocal+r)*xdim];
+				const double *theta_b = &theta_arr[theta_offset[r]];
+				const double *theta_norm_b = &theta_norm[theta_offset[r]/xdim];
+
+				double x_norm = 0.0;
+				for(int n=0;n<xdim;n++){
+					x_norm += x[n]*x[n];
+				}
+
+				for(int k=0;k<K;k++){
+					double cross = 0.0;
+					for(int n=0;n<xdim;n++){
+						cross += x[n]*theta_b[k*xdim+n];
+					}
+
+					/* the difference of norms could be slightly negative because of rounding */
+					double value = x_norm - 2.0*cross + theta_norm_b[k];
+					residuum_arr[t*K*Rlocal + r*K + k] = (value > 0.0)? residuum_coeff*value : 0.0;
+				}
 			}
 		}
 	}
@@ -274,16 +380,10 @@ void GraphH1FEMModel<PetscVector>::updatebeforesolve_gammasolver(GeneralSolver *
 	if(fem->is_reduced()){
 		this->fem->reduce_gamma(this->residuum, gammadata->get_b());
 		this->fem->reduce_gamma(tsdata->get_gammavector(), gammadata->get_x());
-	}
 
-	/* multiplicate vector b by coefficient */
-	double coeff = -1.0;
-	if(this->scalef){
-		coeff *= (1.0/((double)(this->get_T_reduced())));
+		/* multiplicate vector b by coefficient */
+		TRYCXX( VecScale(gammadata->get_b()->get_vector(), coeff) );
 	}
-	
-//	double coeff = (-1.0/((double)(this->get_T())));
-	TRYCXX( VecScale(gammadata->get_b()->get_vector(), coeff) );
 
 	LOG_FUNC_END
 }
@@ -312,80 +412,145 @@ void GraphH1FEMModel<PetscVector>::updatebeforesolve_thetasolver(GeneralSolver *
 	Vec theta_Vec = tsdata->get_thetavector()->get_vector();
 	Vec data_Vec = tsdata->get_datavector()->get_vector();
 
-	/* I will use A_shared with coefficients equal to 1, therefore I set Theta=1 */
-	TRYCXX( VecSet(tsdata->get_thetavector()->get_vector(),1.0) );
-	TRYCXX( VecAssemblyBegin(tsdata->get_thetavector()->get_vector()) );
-	TRYCXX( VecAssemblyEnd(tsdata->get_thetavector()->get_vector()) );
+	int K = tsdata->get_K();
+
+	/* A*gamma with coefficients equal to 1 is derived from the gradient g = A*gamma - b published by gamma solver,
+	 * block k of A was scaled by scaling_k, therefore (A*gamma)_k = (g + b)_k*alpha/scaling_k */
+	bool Agamma_from_gradient = false;
+	std::vector<double> Agamma_scale(K);
+	Vec gradient_Vec;
+	Vec b_Vec;
+	if(usethetainpenalty && !fem->is_reduced() && gammadata->get_gradient()){
+		PetscObjectState gamma_state;
+		TRYCXX( PetscObjectStateGet((PetscObject)gamma_Vec, &gamma_state) );
+
+		/* the gradient corresponds to actual gamma if gamma was not changed after the solution */
+		const std::vector<double> &scaling = gammadata->get_gradient_scaling();
+		if(gamma_state == gammadata->get_gradient_state() && scaling.size() == K){
+			Agamma_from_gradient = true;
+
+			double alpha = ((BlockGraphSparseMatrix<PetscVector>*)A_shared)->get_coeff();
+			for(int k=0;k<K;k++){
+				if(scaling[k] == 0.0){
+					Agamma_from_gradient = false;
+				} else {
+					Agamma_scale[k] = alpha/scaling[k];
+				}
+			}
+
+			gradient_Vec = gammadata->get_gradient()->get_vector();
+			b_Vec = gammadata->get_b()->get_vector();
+		}
+	}
 
-	/* now compute A*gamma */
+	/* otherwise compute A*gamma */
 	Vec Agamma_Vec;
-	if(usethetainpenalty){
-		/* only if Theta is in penalty term */
-		*Agamma = (*A_shared)*(*(tsdata->get_gammavector()));
+	if(usethetainpenalty && !Agamma_from_gradient){
+		/* I will use A_shared with coefficients equal to 1, therefore I set Theta=1 */
+		TRYCXX( VecSet(tsdata->get_thetavector()->get_vector(),1.0) );
+		TRYCXX( VecAssemblyBegin(tsdata->get_thetavector()->get_vector()) );
+		TRYCXX( VecAssemblyEnd(tsdata->get_thetavector()->get_vector()) );
+
+		/* only if Theta is in penalty term, multiply directly into Agamma without temporary vector */
+		A_shared->matmult(*Agamma, *(tsdata->get_gammavector()));
 		Agamma_Vec = Agamma->get_vector();
 	}
-
-	/* subvectors */
-	Vec gammak_Vec;
-	Vec Agammak_Vec;
-	IS gammak_is;
-	
-	double gammakAgammak;
-	double gammakx;
-	double gammaksum;
-	
-	/* get arrays */
-	double *theta_arr;
-	TRYCXX( VecGetArray(theta_Vec,&theta_arr) );
-
-	int K = tsdata->get_K();
+	int nmb_batch = this->nmb_batch;
 
 	double coeff = 1.0;
 //	double coeff = 1.0/((double)(tsdata->get_R()*tsdata->get_T()));
 
-	/* through clusters */
-	for(int k=0;k<K;k++){
-		
-		/* get gammak */
-		this->tsdata->get_decomposition()->createIS_gammaK(&gammak_is, k);
-		TRYCXX( VecGetSubVector(gamma_Vec, gammak_is, &gammak_Vec) );
+	/* compute gammakx, gammaksum and gammakAgammak of all problems in batch in one sweep through local arrays,
+	 * the layout of sums is [gammakx | gammaksum | gammakAgammak], gammakx is indexed by (b*K+k)*xdim+n, others by b*K+k */
+	Decomposition<PetscVector> *decomposition = this->tsdata->get_decomposition();
+	int Tlocal = decomposition->get_Tlocal();
+	int Rlocal = decomposition->get_Rlocal();
+	int Rbegin = decomposition->get_Rbegin();
+	int Rbatch = decomposition->get_R()/nmb_batch;
+	int xdim = tsdata->get_xdim();
+	int BK = nmb_batch*K;
 
-		/* compute gammakAgammak */
-		if(usethetainpenalty){
-			/* only if Theta is in penalty term */
-			TRYCXX( VecGetSubVector(Agamma_Vec, gammak_is, &Agammak_Vec) );
-			TRYCXX( VecDot(gammak_Vec, Agammak_Vec, &gammakAgammak) );
+	std::vector<double> sums_local(BK*(xdim+2), 0.0);
+	std::vector<double> sums(BK*(xdim+2));
+
+	const double *gamma_arr;
+	const double *data_arr;
+	const double *Agamma_arr;
+	const double *gradient_arr;
+	const double *b_arr;
+	TRYCXX( VecGetArrayRead(gamma_Vec,&gamma_arr) );
+	TRYCXX( VecGetArrayRead(data_Vec,&data_arr) );
+	if(Agamma_from_gradient){
+		TRYCXX( VecGetArrayRead(gradient_Vec,&gradient_arr) );
+		TRYCXX( VecGetArrayRead(b_Vec,&b_arr) );
+	} else if(usethetainpenalty){
+		TRYCXX( VecGetArrayRead(Agamma_Vec,&Agamma_arr) );
+	}
+
+	for(int r=0;r<Rlocal;r++){
+		int bK = (decomposition->get_invPr(Rbegin+r)/Rbatch)*K;
+		double *gammakx_b = &sums_local[bK*xdim];
+		double *gammaksum_b = &sums_local[BK*xdim + bK];
+		double *gammakAgammak_b = &sums_local[BK*xdim + BK + bK];
+
+		for(int t=0;t<Tlocal;t++){
+			int idx = (t*Rlocal + r)*K;
+			const double *x = &data_arr[(t*Rlocal + r)*xdim];
+			for(int k=0;k<K;k++){
+				for(int n=0;n<xdim;n++){
+					gammakx_b[k*xdim+n] += gamma_arr[idx+k]*x[n];
+				}
+				gammaksum_b[k] += gamma_arr[idx+k];
+			}
+			if(Agamma_from_gradient){
+				for(int k=0;k<K;k++){
+					gammakAgammak_b[k] += gamma_arr[idx+k]*(gradient_arr[idx+k] + b_arr[idx+k])*Agamma_scale[k];
+				}
+			} else if(usethetainpenalty){
+				for(int k=0;k<K;k++){
+					gammakAgammak_b[k] += gamma_arr[idx+k]*Agamma_arr[idx+k];
+				}
+			}
 		}
-		
-		/* compute gammakx */
-		TRYCXX( VecDot(data_Vec, gammak_Vec, &gammakx) );
+	}
+
+	if(Agamma_from_gradient){
+		TRYCXX( VecRestoreArrayRead(b_Vec,&b_arr) );
+		TRYCXX( VecRestoreArrayRead(gradient_Vec,&gradient_arr) );
+	} else if(usethetainpenalty){
+		TRYCXX( VecRestoreArrayRead(Agamma_Vec,&Agamma_arr) );
+	}
+	TRYCXX( VecRestoreArrayRead(data_Vec,&data_arr) );
+	TRYCXX( VecRestoreArrayRead(gamma_Vec,&gamma_arr) );
+
+	MPI_Allreduce(&sums_local[0], &sums[0], BK*(xdim+2), MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+	/* get arrays */
+	double *theta_arr;
+	TRYCXX( VecGetArray(theta_Vec,&theta_arr) );
 
-		/* compute gammaksum */
-		TRYCXX( VecSum(gammak_Vec, &gammaksum) );
+	/* through problems and clusters, Theta is the weighted mean of data */
+	for(int bk=0;bk<BK;bk++){
+		double gammaksum = sums[BK*xdim + bk];
+		double gammakAgammak = sums[BK*xdim + BK + bk];
 
+		double denominator;
 		if(usethetainpenalty){
 			/* only if Theta is in penalty term */
-			if(coeff*gammaksum + 0.5*gammakAgammak != 0){
-				theta_arr[k] = (coeff*gammakx)/(coeff*gammaksum + 0.5*gammakAgammak);
-			} else {
-				theta_arr[k] = 0.0;
-			}
+			denominator = coeff*gammaksum + 0.5*gammakAgammak;
 		} else {
 			/* if Theta is not in penalty term, then the computation is based on kmeans */
-			if(gammaksum != 0){
-				theta_arr[k] = gammakx/gammaksum;
+			denominator = gammaksum;
+		}
+
+		for(int n=0;n<xdim;n++){
+			if(denominator != 0){
+				theta_arr[bk*xdim+n] = (coeff*sums[bk*xdim+n])/denominator;
 			} else {
-				theta_arr[k] = 0.0;
+				theta_arr[bk*xdim+n] = 0.0;
 			}
 		}
-	
-		TRYCXX( VecRestoreSubVector(gamma_Vec, gammak_is, &gammak_Vec) );
-		if(usethetainpenalty){
-			/* only if Theta is in penalty term */
-			TRYCXX( VecRestoreSubVector(Agamma_Vec, gammak_is, &Agammak_Vec) );
-		}
-		TRYCXX( ISDestroy(&gammak_is) );
-	}	
+	}
 
 	/* restore arrays */
 	TRYCXX( VecRestoreArray(theta_Vec,&theta_arr) );
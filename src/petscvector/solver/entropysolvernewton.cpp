@@ -61,9 +61,9 @@ template<>
 void EntropySolverNewton<PetscVector>::allocate_temp_vectors(){
 	LOG_FUNC_BEGIN
 
-	/* prepare auxiliary vectors */
-	x_power = new GeneralVector<PetscVector>(*entropydata->get_x());
-	x_power_gammak = new GeneralVector<PetscVector>(*entropydata->get_x());
+	/* moments are computed in one sweep through local arrays, global temp vectors are not necessary */
+	x_power = NULL;
+	x_power_gammak = NULL;
 	
 	/* create aux vector for the computation of moments and integrals */
 	Vec moments_Vec;
@@ -121,8 +121,6 @@ template<>
 void EntropySolverNewton<PetscVector>::free_temp_vectors(){
 	LOG_FUNC_BEGIN
 
-	free(x_power);
-	free(x_power_gammak);
 	free(moments_data);
 	free(integrals);
 
@@ -174,6 +172,10 @@ void EntropySolverNewton<PetscVector>::solve() {
 	Vec g_inner_Vec;
 	double gnorm_inner;
 
+	/* lambda and normalization integrals at the end of solution, to be reused in compute_residuum */
+	externalcontent->lambda_integrated.resize(K*Km);
+	externalcontent->logZ.resize(K);
+
 	/* through all clusters */
 	for(int k = 0; k < K; k++){
 		
@@ -184,7 +186,7 @@ void EntropySolverNewton<PetscVector>::solve() {
 		
 		/* prepare index set to get subvectors from moments, x, g, s, y */
 		TRYCXX( ISCreateStride(PETSC_COMM_SELF, Km, k*Km, 1, &k_is) ); /* Theta is LOCAL ! */
-		TRYCXX( ISCreateStride(PETSC_COMM_SELF, Km+1, k*(Km+1), 1, &integralsk_is) ); 
+		TRYCXX( ISCreateStride(PETSC_COMM_SELF, 2*Km+1, k*(2*Km+1), 1, &integralsk_is) ); /* all integrals are computed */
 	
 		/* get subvectors for this cluster */
 		TRYCXX( VecGetSubVector(x_Vec, k_is, &xk_Vec) );
@@ -338,6 +340,18 @@ void EntropySolverNewton<PetscVector>::solve() {
 		this->fxs[k] = fx;
 		this->gnorms[k] = gnorm;
 
+		/* integrals were computed for actual lambda */
+		const double *xk_arr;
+		const double *integralsk_arr;
+		TRYCXX( VecGetArrayRead(xk_Vec, &xk_arr) );
+		TRYCXX( VecGetArrayRead(integralsk_Vec, &integralsk_arr) );
+		for(int km=0;km<Km;km++){
+			externalcontent->lambda_integrated[k*Km+km] = xk_arr[km];
+		}
+		externalcontent->logZ[k] = log(integralsk_arr[0]);
+		TRYCXX( VecRestoreArrayRead(integralsk_Vec, &integralsk_arr) );
+		TRYCXX( VecRestoreArrayRead(xk_Vec, &xk_arr) );
+
 		/* -------------- end of SPG algorithm ------------ */
 
 		/* restore subvectors */
@@ -361,48 +375,56 @@ template<>
 void EntropySolverNewton<PetscVector>::compute_moments_data() {
 	LOG_FUNC_BEGIN
 
-	Vec x_Vec = entropydata->get_x()->get_vector();
-	Vec x_power_Vec = x_power->get_vector();
-	Vec x_power_gammak_Vec = x_power_gammak->get_vector();
-	Vec gamma_Vec = entropydata->get_gamma()->get_vector();
-	Vec moments_Vec = moments_data->get_vector();
-	
-	Vec gammak_Vec;
-	IS gammak_is;
-	
-	TRYCXX( VecCopy(x_Vec,x_power_Vec) ); /* x^1 */
-	
-	double *moments_arr, mysum, gammaksum;
-	TRYCXX( VecGetArray(moments_Vec, &moments_arr) );
-	for(int km=0; km < entropydata->get_Km(); km++){
-		
-		for(int k=0;k<entropydata->get_K();k++){
-			/* get gammak */
-			this->entropydata->get_decomposition()->createIS_gammaK(&gammak_is, k);
-			TRYCXX( VecGetSubVector(gamma_Vec, gammak_is, &gammak_Vec) );
+	int K = entropydata->get_K();
+	int Km = entropydata->get_Km();
+
+	/* local part of data and gamma, gamma is stored as [t*R*K + r*K + k] */
+	int x_size_local;
+	TRYCXX( VecGetLocalSize(entropydata->get_x()->get_vector(), &x_size_local) );
 
-			/* compute x_power_gammak */
-			TRYCXX( VecPointwiseMult(x_power_gammak_Vec, gammak_Vec, x_power_Vec) ); /* x_power_gammak = x_power.*gammak */
+	const double *x_arr;
+	const double *gamma_arr;
+	TRYCXX( VecGetArrayRead(entropydata->get_x()->get_vector(), &x_arr) );
+	TRYCXX( VecGetArrayRead(entropydata->get_gamma()->get_vector(), &gamma_arr) );
 
-			/* compute gammaksum */
-			TRYCXX( VecSum(gammak_Vec, &gammaksum) );
-			TRYCXX( VecSum(x_power_gammak_Vec, &mysum) );
+	/* one sweep: sums[k*Km + km] = sum gamma_k x^(km+1), sums[K*Km + k] = sum gamma_k */
+	std::vector<double> sums_local(K*Km + K, 0.0);
+	std::vector<double> sums(K*Km + K, 0.0);
 
-			/* store computed moment */
+	for(int i=0;i<x_size_local;i++){
+		double x_value = x_arr[i];
+		for(int k=0;k<K;k++){
+			double gamma_value = gamma_arr[i*K+k];
+			double x_power_gamma = gamma_value;
+
+			sums_local[K*Km + k] += gamma_value;
+			for(int km=0;km<Km;km++){
+				x_power_gamma *= x_value;
+				sums_local[k*Km + km] += x_power_gamma;
+			}
+		}
+	}
+
+	TRYCXX( VecRestoreArrayRead(entropydata->get_gamma()->get_vector(), &gamma_arr) );
+	TRYCXX( VecRestoreArrayRead(entropydata->get_x()->get_vector(), &x_arr) );
+
+	/* all moments and sums of gamma in one reduction */
+	MPI_Allreduce(&sums_local[0], &sums[0], K*Km + K, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+	/* store computed moments */
+	double *moments_arr;
+	TRYCXX( VecGetArray(moments_data->get_vector(), &moments_arr) );
+	for(int k=0;k<K;k++){
+		double gammaksum = sums[K*Km + k];
+		for(int km=0;km<Km;km++){
 			if(gammaksum != 0){
-				moments_arr[k*this->entropydata->get_Km() + km] = mysum/gammaksum;
+				moments_arr[k*Km + km] = sums[k*Km + km]/gammaksum;
 			} else {
-				moments_arr[k*this->entropydata->get_Km() + km] = 0.0;
+				moments_arr[k*Km + km] = 0.0;
 			}
-	
-			TRYCXX( VecRestoreSubVector(gamma_Vec, gammak_is, &gammak_Vec) );
-			TRYCXX( ISDestroy(&gammak_is) );	
 		}
-		
-		TRYCXX( VecPointwiseMult(x_power_Vec, x_Vec, x_power_Vec) ); /* x_power = x_power.*x */
 	}
-	
-	TRYCXX( VecRestoreArray(moments_Vec, &moments_arr) );
+	TRYCXX( VecRestoreArray(moments_data->get_vector(), &moments_arr) );
 
 	LOG_FUNC_END
 }
@@ -411,8 +433,6 @@ template<>
 void EntropySolverNewton<PetscVector>::compute_residuum(GeneralVector<PetscVector> *residuum) const {
 	LOG_FUNC_BEGIN
 
-	int T = entropydata->get_T();
-	int Tlocal = entropydata->get_decomposition()->get_Tlocal();
 	int K = entropydata->get_K();
 	int Km = entropydata->get_Km();
 
@@ -426,32 +446,46 @@ void EntropySolverNewton<PetscVector>::compute_residuum(GeneralVector<PetscVecto
 	const double *lambda_arr;
 	TRYCXX( VecGetArrayRead(entropydata->get_lambda()->get_vector(), &lambda_arr) );
 	
+	int x_size_local;
 	const double *x_arr;
+	TRYCXX( VecGetLocalSize(entropydata->get_x()->get_vector(), &x_size_local) );
 	TRYCXX( VecGetArrayRead(entropydata->get_x()->get_vector(), &x_arr) );
 	
 	double *residuum_arr;
 	TRYCXX( VecGetArray(residuum->get_vector(), &residuum_arr) );
 
-	double mysum, x_power;
-	for(int k=0;k<K;k++){
-		/* compute int_X exp(-sum lambda_j x^j) dx for this cluster
-		/* from arr to Dlib-vec */
-		for(int km=0;km<Km;km++){
-			lambda(km) = lambda_arr[k*Km+km];
+	/* if lambda was not changed after solve(), then the normalization integrals are already known */
+	bool use_logZ = (externalcontent->lambda_integrated.size() == (size_t)(K*Km));
+	for(int i=0;i<K*Km && use_logZ;i++){
+		if(externalcontent->lambda_integrated[i] != lambda_arr[i]){
+			use_logZ = false;
 		}
-		F_ = dlib::integrate_function_adapt_simp(mom_function, -1.0, 1.0, 1e-10);
-		F_ = log(F_);
+	}
 
-		for(int t=0;t<Tlocal;t++){
-			/* compute sum_{j=1}^{Km} lambda_j*x^j */
-			mysum = 0.0;
-			x_power = x_arr[t]; /* x^1 */
+	for(int k=0;k<K;k++){
+		/* log of int_X exp(-sum lambda_j x^j) dx for this cluster */
+		if(use_logZ){
+			F_ = externalcontent->logZ[k];
+		} else {
+			/* from arr to Dlib-vec */
 			for(int km=0;km<Km;km++){
-				mysum += lambda_arr[k*Km+km]*x_power;
-				x_power *= x_arr[t]; /* x_power = x^(km+1) */
+				lambda(km) = lambda_arr[k*Km+km];
+			}
+			F_ = dlib::integrate_function_adapt_simp(mom_function, -1.0, 1.0, 1e-10);
+			F_ = log(F_);
+		}
+
+		/* sum_{j=1}^{Km} lambda_j*x^j = x*(lambda_1 + x*(lambda_2 + ... + x*lambda_Km)) using Horner scheme */
+		const double *lambdak_arr = &(lambda_arr[k*Km]);
+		#pragma omp simd
+		for(int t=0;t<x_size_local;t++){
+			double x_value = x_arr[t];
+			double mysum = lambdak_arr[Km-1];
+			for(int km=Km-2;km>=0;km--){
+				mysum = mysum*x_value + lambdak_arr[km];
 			}
 
-			residuum_arr[t*K + k] = mysum + F_;
+			residuum_arr[t*K + k] = mysum*x_value + F_;
 		}
 	}
 
@@ -0,0 +1,51 @@
+#include "external/petscvector/solver/fistaqpsolver.h"
+
+namespace pascinference {
+namespace solver {
+
+template<>
+std::string FISTAQPSolver<PetscVector>::get_name() const {
+	return "FISTAQPSolver for PETSc"; /* better to see than simple "FISTAQPSolver<PetscVector>" */
+}
+
+/* prepare temp_vectors */
+template<>
+void FISTAQPSolver<PetscVector>::allocate_temp_vectors(){
+	LOG_FUNC_BEGIN
+
+	GeneralVector<PetscVector> *pattern = qpdata->get_b(); /* I will allocate temp vectors subject to linear term */
+
+	g = new GeneralVector<PetscVector>(*pattern);
+	g_old = new GeneralVector<PetscVector>(*pattern);
+	x_old = new GeneralVector<PetscVector>(*pattern);
+	y = new GeneralVector<PetscVector>(*pattern);
+	gy = new GeneralVector<PetscVector>(*pattern);
+	v = new GeneralVector<PetscVector>(*pattern);
+	temp = new GeneralVector<PetscVector>(*pattern);
+
+	MemoryCheck::owned_add("FISTAQPSolver", 7*pattern->local_size()*sizeof(double));
+
+	LOG_FUNC_END
+}
+
+/* destroy temp_vectors */
+template<>
+void FISTAQPSolver<PetscVector>::free_temp_vectors(){
+	LOG_FUNC_BEGIN
+
+	MemoryCheck::owned_remove("FISTAQPSolver", 7*g->local_size()*sizeof(double));
+
+	free(g);
+	free(g_old);
+	free(x_old);
+	free(y);
+	free(gy);
+	free(v);
+	free(temp);
+
+	LOG_FUNC_END
+}
+
+
+}
+} /* end namespace */
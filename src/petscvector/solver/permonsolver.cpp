@@ -39,6 +39,10 @@ PermonSolver<PetscVector>::PermonSolver(QPData<PetscVector> &new_qpdata){
 	BlockGraphSparseMatrix<PetscVector> *Abgs = dynamic_cast<BlockGraphSparseMatrix<PetscVector> *>(qpdata->get_A());
 
 	Mat A = Abgs->get_externalcontent()->A_petsc;
+
+	/* the estimation of the largest eigenvalue is cached, it has to be computed before the scaling of matrix */
+	Abgs->get_lambda_max_unscaled();
+
 	double coeff = Abgs->get_coeff();
 	TRYCXX( MatScale(A, coeff) );
 	TRYCXX( MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY) );
@@ -90,7 +94,6 @@ void PermonSolver<PetscVector>::solve() {
 	Vec b = bg->get_vector();
 
 	BlockGraphSparseMatrix<PetscVector> *Abgs = dynamic_cast<BlockGraphSparseMatrix<PetscVector> *>(qpdata->get_A());
-	double coeff = Abgs->get_coeff();
 
 	/* prepare permon QPS */
 	TRYCXX( QPSCreate(PETSC_COMM_WORLD, &qps) );
@@ -103,7 +106,9 @@ void PermonSolver<PetscVector>::solve() {
 
 	/* provide max eigenvalue to PERMON */
 	if(use_lambdamax){
-		TRYCXX( QPSSMALXESetOperatorMaxEigenvalue(qps, 1.99*4.0*coeff) ); //TODO: only for Laplace!
+		/* Lanczos estimation is from below, Gershgorin bound is from above,
+		 * the operator is A_petsc scaled only by coeff (coeffs of blocks are not applied) */
+		TRYCXX( QPSSMALXESetOperatorMaxEigenvalue(qps, Abgs->get_coeff()*std::min(1.01*Abgs->get_lambda_max_unscaled(), Abgs->get_lambda_max_bound_unscaled())) );
 	}
 
 	TRYCXX( QPSSetUp(qps) ); /* Set up QP and QPS. */
@@ -20,6 +20,8 @@ void SPGQPSolver<PetscVector>::allocate_temp_vectors(){
 	Ad = new GeneralVector<PetscVector>(*pattern);	
 	temp = new GeneralVector<PetscVector>(*pattern);	
 
+	MemoryCheck::owned_add("SPGQPSolver", 4*pattern->local_size()*sizeof(double));
+
 	/* prepare external content with PETSc stuff */
 	externalcontent = new ExternalContent();
 
@@ -39,6 +41,8 @@ template<>
 void SPGQPSolver<PetscVector>::free_temp_vectors(){
 	LOG_FUNC_BEGIN
 
+	MemoryCheck::owned_remove("SPGQPSolver", 4*g->local_size()*sizeof(double));
+
 	free(g);
 	free(d);
 	free(Ad);
@@ -55,6 +59,14 @@ template<>
 void SPGQPSolver<PetscVector>::solve() {
 	LOG_FUNC_BEGIN
 
+	/* independent problems are solved in lockstep */
+	if(this->nmb_batch > 1){
+		solve_batch();
+
+		LOG_FUNC_END
+		return;
+	}
+
 	/* get Petsc objects from general */
 	BlockGraphSparseMatrix<PetscVector> *Abgs = dynamic_cast<BlockGraphSparseMatrix<PetscVector> *>(qpdata->get_A());
 	GeneralVector<PetscVector> *b_p = dynamic_cast<GeneralVector<PetscVector> *>(qpdata->get_b());
@@ -86,6 +98,9 @@ void SPGQPSolver<PetscVector>::solve() {
 
 	this->timer_solve.start(); /* stop this timer in the end of solution */
 
+	/* the gradient from previous solution will be overwritten */
+	qpdata->set_gradient(NULL, std::vector<double>(), 0);
+
 	int it = 0; /* number of iterations */
 	int hessmult = 0; /* number of hessian multiplications */
 
@@ -104,8 +119,11 @@ void SPGQPSolver<PetscVector>::solve() {
 	TRYCXX( VecNorm(b_Vec, NORM_2, &normb) );
 	allbarrier<PetscVector>();
 
-	/* initial step-size */
-	alpha_bb = this->alphainit;
+	/* initial step-size, continue with the last one if it is possible */
+	alpha_bb = get_alphainit();
+	if(this->warmstart && this->alpha_bb_last > 0 && this->alpha_bb_last < std::numeric_limits<double>::max()){
+		alpha_bb = this->alpha_bb_last;
+	}
 
 	//TODO: temp!
 	/* x = x0; set approximation as initial */
@@ -301,7 +319,19 @@ void SPGQPSolver<PetscVector>::solve() {
 	this->it_last = it;
 	this->hessmult_last = hessmult;
 
+	/* store the state for next solution and checkpoints */
+	this->alpha_bb_last = alpha_bb;
+	fs.get_values(&(this->fs_last[0]));
+
 	this->fx = fx;
+
+	/* publish the gradient, A*x = g + b can be reused outside the solver,
+	 * g was computed by A_petsc scaled only by alpha (coeffs are not applied here) */
+	std::vector<double> scaling(Abgs->get_K(), Abgs->get_coeff());
+	PetscObjectState x_state;
+	TRYCXX( PetscObjectStateGet((PetscObject)x_Vec, &x_state) );
+	qpdata->set_gradient(this->g, scaling, x_state);
+
 	this->timer_solve.stop();
 
 	/* write info to log file */
@@ -311,6 +341,298 @@ void SPGQPSolver<PetscVector>::solve() {
 	LOG_FUNC_END
 }
 
+/* solve the batch of independent problems in lockstep */
+template<>
+void SPGQPSolver<PetscVector>::solve_batch() {
+	LOG_FUNC_BEGIN
+
+	/* get Petsc objects from general */
+	BlockGraphSparseMatrix<PetscVector> *Abgs = dynamic_cast<BlockGraphSparseMatrix<PetscVector> *>(qpdata->get_A());
+	GeneralVector<PetscVector> *b_p = dynamic_cast<GeneralVector<PetscVector> *>(qpdata->get_b());
+	GeneralVector<PetscVector> *x_p = dynamic_cast<GeneralVector<PetscVector> *>(qpdata->get_x());
+	GeneralVector<PetscVector> *g_p = dynamic_cast<GeneralVector<PetscVector> *>(this->g);
+	GeneralVector<PetscVector> *d_p = dynamic_cast<GeneralVector<PetscVector> *>(this->d);
+	GeneralVector<PetscVector> *Ad_p = dynamic_cast<GeneralVector<PetscVector> *>(this->Ad);
+
+	Mat A_Mat = Abgs->get_externalcontent()->A_petsc; 
+	Vec b_Vec = b_p->get_vector();
+	Vec x_Vec = x_p->get_vector();
+	Vec g_Vec = g_p->get_vector();
+	Vec d_Vec = d_p->get_vector();
+	Vec Ad_Vec = Ad_p->get_vector();
+
+	int nmb_batch = this->nmb_batch;
+	const int *batch_arr = &(this->batch_local[0]);
+
+	int local_size;
+	TRYCXX( VecGetLocalSize(x_Vec, &local_size) );
+
+	allbarrier<PetscVector>();
+
+	this->timer_solve.start(); /* stop this timer in the end of solution */
+
+	/* the gradient from previous solution will be overwritten */
+	qpdata->set_gradient(NULL, std::vector<double>(), 0);
+
+	int it = 0; /* number of iterations */
+	int hessmult = 0; /* number of hessian multiplications */
+	int nmb_active = nmb_batch; /* number of problems which are not converged yet */
+
+	/* the state of algorithm for each problem */
+	std::vector<double> fx(nmb_batch); /* function values */
+	std::vector<double> fx_old(nmb_batch); /* f(x_{it - 1}) */
+	std::vector<SPG_fs*> fs(nmb_batch); /* store function values for generalized Armijo condition */
+	std::vector<double> beta(nmb_batch); /* step-sizes from Armijo condition */
+	std::vector<double> alpha_bb(nmb_batch); /* BB step-sizes */
+	std::vector<double> normb(nmb_batch); /* norms of linear terms used in stopping criteria */
+	std::vector<int> active(nmb_batch, 1); /* convergence mask */
+
+	/* local and global values of [dd | dAd | gd] for each problem */
+	std::vector<double> dots_local(3*nmb_batch);
+	std::vector<double> dots(3*nmb_batch);
+	double *dd = &dots[0];
+	double *dAd = &dots[nmb_batch];
+	double *gd = &dots[2*nmb_batch];
+
+	double fx_max, xi, beta_bar, beta_hat; /* for Armijo condition */
+
+	/* initial step-size, continue with the last one if it is possible */
+	double alphainit = get_alphainit();
+	for(int b=0;b<nmb_batch;b++){
+		alpha_bb[b] = alphainit;
+		if(this->warmstart && this->alpha_bb_batch_last[b] > 0 && this->alpha_bb_batch_last[b] < std::numeric_limits<double>::max()){
+			alpha_bb[b] = this->alpha_bb_batch_last[b];
+		}
+	}
+
+	this->timer_projection.start();
+	 qpdata->get_feasibleset()->project(*x_p); /* project initial approximation to feasible set */
+ 	 allbarrier<PetscVector>();
+	this->timer_projection.stop();
+
+	/* compute gradient, g = A*x-b */
+	this->timer_matmult.start();
+	 TRYCXX( MatMult(A_Mat, x_Vec, g_Vec) );
+	 TRYCXX( VecScale(g_Vec, Abgs->get_coeff()) );
+	 allbarrier<PetscVector>();
+	 hessmult += 1; /* there was muliplication by A */
+	this->timer_matmult.stop();
+
+	TRYCXX( VecAXPY(g_Vec, -1.0, b_Vec) );
+	allbarrier<PetscVector>();
+
+	double *x_arr;
+	double *g_arr;
+	double *d_arr;
+	const double *b_arr;
+	const double *Ad_arr;
+
+	/* initialize fs, fx = 0.5*dot(g-b,x) and norm(b) of each problem */
+	this->timer_fs.start();
+	 TRYCXX( VecGetArray(x_Vec, &x_arr) );
+	 TRYCXX( VecGetArray(g_Vec, &g_arr) );
+	 TRYCXX( VecGetArrayRead(b_Vec, &b_arr) );
+
+	 std::fill(dots_local.begin(), dots_local.end(), 0.0);
+	 for(int i=0;i<local_size;i++){
+		dots_local[batch_arr[i]] += (g_arr[i] - b_arr[i])*x_arr[i];
+		dots_local[nmb_batch + batch_arr[i]] += b_arr[i]*b_arr[i];
+	 }
+
+	 TRYCXX( VecRestoreArrayRead(b_Vec, &b_arr) );
+	 TRYCXX( VecRestoreArray(g_Vec, &g_arr) );
+	 TRYCXX( VecRestoreArray(x_Vec, &x_arr) );
+
+	 MPI_Allreduce(&dots_local[0], &dots[0], 2*nmb_batch, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+
+	 for(int b=0;b<nmb_batch;b++){
+		fx[b] = 0.5*dots[b];
+		normb[b] = sqrt(dots[nmb_batch + b]);
+		fx_old[b] = std::numeric_limits<double>::max();
+		fs[b] = new SPG_fs(this->m);
+		fs[b]->init(fx[b]);
+	 }
+	this->timer_fs.stop();
+
+	/* main cycle */
+	while(it < this->maxit && nmb_active > 0){
+		/* increase iteration counter */
+		it += 1;
+
+		/* d = x - alpha_bb*g, see next step, it will be d = P(x - alpha_bb*g) - x */
+		this->timer_update.start();
+		 TRYCXX( VecGetArray(x_Vec, &x_arr) );
+		 TRYCXX( VecGetArray(g_Vec, &g_arr) );
+		 TRYCXX( VecGetArray(d_Vec, &d_arr) );
+		 for(int i=0;i<local_size;i++){
+			d_arr[i] = x_arr[i] - alpha_bb[batch_arr[i]]*g_arr[i];
+		 }
+		 TRYCXX( VecRestoreArray(d_Vec, &d_arr) );
+		 TRYCXX( VecRestoreArray(g_Vec, &g_arr) );
+		 TRYCXX( VecRestoreArray(x_Vec, &x_arr) );
+		 allbarrier<PetscVector>();
+		this->timer_update.stop();
+
+		/* d = P(d) */
+		this->timer_projection.start();
+		 qpdata->get_feasibleset()->project(*d_p);
+		this->timer_projection.stop();
+
+		/* d = d - x, the problems which have already converged are not changed */
+		this->timer_update.start();
+		 TRYCXX( VecGetArray(x_Vec, &x_arr) );
+		 TRYCXX( VecGetArray(d_Vec, &d_arr) );
+		 for(int i=0;i<local_size;i++){
+			d_arr[i] = active[batch_arr[i]]? d_arr[i] - x_arr[i] : 0.0;
+		 }
+		 TRYCXX( VecRestoreArray(d_Vec, &d_arr) );
+		 TRYCXX( VecRestoreArray(x_Vec, &x_arr) );
+		 allbarrier<PetscVector>();
+		this->timer_update.stop();
+
+		/* Ad = A*d, A is block-diagonal, therefore Ad of converged problems is zero */
+		this->timer_matmult.start();
+		 TRYCXX( MatMult(A_Mat, d_Vec, Ad_Vec) );
+		 TRYCXX( VecScale(Ad_Vec, Abgs->get_coeff()) );
+		 allbarrier<PetscVector>();
+		 hessmult += 1;
+		this->timer_matmult.stop();
+
+		/* dd = dot(d,d); dAd = dot(Ad,d); gd = dot(g,d); of all problems with one reduction */
+		this->timer_dot.start();
+		 TRYCXX( VecGetArrayRead(Ad_Vec, &Ad_arr) );
+		 TRYCXX( VecGetArray(g_Vec, &g_arr) );
+		 TRYCXX( VecGetArray(d_Vec, &d_arr) );
+		 std::fill(dots_local.begin(), dots_local.end(), 0.0);
+		 for(int i=0;i<local_size;i++){
+			dots_local[batch_arr[i]] += d_arr[i]*d_arr[i];
+			dots_local[nmb_batch + batch_arr[i]] += Ad_arr[i]*d_arr[i];
+			dots_local[2*nmb_batch + batch_arr[i]] += g_arr[i]*d_arr[i];
+		 }
+		 TRYCXX( VecRestoreArray(d_Vec, &d_arr) );
+		 TRYCXX( VecRestoreArray(g_Vec, &g_arr) );
+		 TRYCXX( VecRestoreArrayRead(Ad_Vec, &Ad_arr) );
+		 MPI_Allreduce(&dots_local[0], &dots[0], 3*nmb_batch, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+		this->timer_dot.stop();
+
+		/* compute step-sizes from A-condition */
+		this->timer_stepsize.start();
+		 for(int b=0;b<nmb_batch;b++){
+			beta[b] = 0.0;
+			if(!active[b] || dAd[b] <= 0.0){
+				continue;
+			}
+
+			fx_max = fs[b]->get_max();
+			xi = (fx_max - fx[b])/dAd[b];
+			beta_bar = -gd[b]/dAd[b];
+			beta_hat = this->gamma*beta_bar + PetscSqrtReal(this->gamma*this->gamma*beta_bar*beta_bar + 2*xi);
+
+			/* beta = max(sigma1,min(sigma2,beta_hat)) */
+			if(beta_hat < this->sigma1){
+				beta_hat = this->sigma1;
+			}
+			if(beta_hat < this->sigma2){
+				beta[b] = beta_hat;
+			} else {
+				beta[b] = this->sigma2;
+			}
+		 }
+		this->timer_stepsize.stop();
+
+		/* x = x + beta*d; g = g + beta*Ad; update approximation and gradient */
+		this->timer_update.start();
+		 TRYCXX( VecGetArray(x_Vec, &x_arr) );
+		 TRYCXX( VecGetArray(g_Vec, &g_arr) );
+		 TRYCXX( VecGetArray(d_Vec, &d_arr) );
+		 TRYCXX( VecGetArrayRead(Ad_Vec, &Ad_arr) );
+		 for(int i=0;i<local_size;i++){
+			x_arr[i] += beta[batch_arr[i]]*d_arr[i];
+			g_arr[i] += beta[batch_arr[i]]*Ad_arr[i];
+		 }
+		 TRYCXX( VecRestoreArrayRead(Ad_Vec, &Ad_arr) );
+		 TRYCXX( VecRestoreArray(d_Vec, &d_arr) );
+		 TRYCXX( VecRestoreArray(g_Vec, &g_arr) );
+		 TRYCXX( VecRestoreArray(x_Vec, &x_arr) );
+		 allbarrier<PetscVector>();
+		this->timer_update.stop();
+
+		/* compute new function values using already computed dot products and update fs lists */
+		this->timer_fs.start();
+		 for(int b=0;b<nmb_batch;b++){
+			if(!active[b]){
+				continue;
+			}
+			fx_old[b] = fx[b];
+			fx[b] = get_fx(fx_old[b],beta[b],gd[b],dAd[b]);
+			fs[b]->update(fx[b]);
+		 }
+		this->timer_fs.stop();
+
+		/* update BB step-sizes and the convergence mask */
+		this->timer_stepsize.start();
+		 this->gP = 0.0;
+		 for(int b=0;b<nmb_batch;b++){
+			if(!active[b]){
+				continue;
+			}
+
+			if(dAd[b] > 0.0){
+				alpha_bb[b] = dd[b]/dAd[b];
+			}
+			this->gP = std::max(this->gP, dd[b]);
+
+			/* stopping criteria */
+			if( (this->stop_difff && abs(fx[b] - fx_old[b]) < this->eps)
+			 || (this->stop_normgp && dd[b] < this->eps)
+			 || (this->stop_normgp_normb && dd[b] < this->eps*normb[b])
+			 || (this->stop_Anormgp && dAd[b] < this->eps)
+			 || (this->stop_Anormgp_normb && dAd[b] < this->eps*normb[b])
+			 || dAd[b] <= 0.0 ){
+				active[b] = 0;
+				nmb_active -= 1;
+			}
+		 }
+		this->timer_stepsize.stop();
+
+		/* print progress of algorithm */
+		if(debug_print_it){
+			coutMaster << "\033[33m   it = \033[0m" << it;
+			coutMaster << ", \t\033[36mactive = \033[0m" << nmb_active << "/" << nmb_batch;
+			coutMaster << ", \t\033[36mmax(gP) = \033[0m" << this->gP << std::endl;
+		}
+
+	} /* main cycle end */
+
+	this->it_sum += it;
+	this->hessmult_sum += hessmult;
+	this->it_last = it;
+	this->hessmult_last = hessmult;
+
+	/* store the state for next solution, the function value is the sum of function values of problems */
+	this->fx = 0.0;
+	for(int b=0;b<nmb_batch;b++){
+		this->alpha_bb_batch_last[b] = alpha_bb[b];
+		this->fx += fx[b];
+		delete fs[b];
+	}
+
+	/* publish the gradient, A*x = g + b can be reused outside the solver,
+	 * g was computed by A_petsc scaled only by alpha (coeffs are not applied here) */
+	std::vector<double> scaling(Abgs->get_K(), Abgs->get_coeff());
+	PetscObjectState x_state;
+	TRYCXX( PetscObjectStateGet((PetscObject)x_Vec, &x_state) );
+	qpdata->set_gradient(this->g, scaling, x_state);
+
+	this->timer_solve.stop();
+
+	/* write info to log file */
+	LOG_IT(it)
+	LOG_FX(this->fx)
+
+	LOG_FUNC_END
+}
+
 /* compute function value using inner *x and already computed *g */
 template<>
 double SPGQPSolver<PetscVector>::get_fx() const {
@@ -366,6 +688,22 @@ void SPGQPSolver<PetscVector>::compute_dots(double *dd, double *dAd, double *gd)
 	LOG_FUNC_END
 }
 
+template<>
+double SPGQPSolver<PetscVector>::get_alphainit() const {
+	double alpha = this->alphainit;
+
+	if(this->alphainit_auto){
+		/* solve multiplies by A_petsc scaled only by alpha, the coeffs of blocks are not applied */
+		BlockGraphSparseMatrix<PetscVector> *Abgs = dynamic_cast<BlockGraphSparseMatrix<PetscVector> *>(qpdata->get_A());
+		double lambda_max = (Abgs)? Abgs->get_coeff()*Abgs->get_lambda_max_unscaled() : qpdata->get_A()->get_lambda_max();
+		if(lambda_max > 0.0){
+			alpha = 1.0/lambda_max;
+		}
+	}
+
+	return alpha;
+}
+
 template<> 
 SPGQPSolver<PetscVector>::ExternalContent * SPGQPSolver<PetscVector>::get_externalcontent() const {
 	return this->externalcontent;	
@@ -0,0 +1,290 @@
+#include "external/petscvector/solver/tssolver.h"
+
+namespace pascinference {
+namespace solver {
+
+template<>
+void TSSolver<PetscVector>::save_checkpoint(bool finished, int it_annealing, int it, double L, int it_gammasolver, int it_thetasolver) {
+	LOG_FUNC_BEGIN
+
+	this->timer_checkpoint.start();
+
+	Vec gamma_Vec = tsdata->get_gammavector()->get_vector();
+	Vec theta_Vec = tsdata->get_thetavector()->get_vector();
+	bool has_temp = (this->annealing > 1);
+
+	int gamma_size, theta_size, low, high;
+	TRYCXX( VecGetSize(gamma_Vec, &gamma_size) );
+	TRYCXX( VecGetOwnershipRange(gamma_Vec, &low, &high) );
+	TRYCXX( VecGetLocalSize(theta_Vec, &theta_size) ); /* theta is the same on all processes */
+
+	/* prepare header */
+	TSSolverCheckpointHeader header;
+	memset(&header, 0, sizeof(TSSolverCheckpointHeader));
+	memcpy(header.magic, TSSOLVER_CHECKPOINT_MAGIC, 8);
+	header.version = TSSOLVER_CHECKPOINT_VERSION;
+	header.nproc = GlobalManager.get_size();
+	header.id = this->checkpoint_id;
+	header.finished = finished;
+	header.it_annealing = it_annealing;
+	header.it = it;
+	header.it_sum = this->it_sum;
+	header.it_gammasolver = it_gammasolver;
+	header.it_thetasolver = it_thetasolver;
+	header.has_temp = has_temp;
+	header.gammastate_size = gammasolver->get_state_size();
+	header.thetastate_size = thetasolver->get_state_size();
+	header.gamma_size = gamma_size;
+	header.theta_size = theta_size;
+	header.L = L;
+	header.L_best = this->L;
+	header.deltaL_best = this->deltaL;
+	header.aic = tsdata->get_aic();
+
+	/* positions of parts in file */
+	MPI_Offset offset_gamma = sizeof(TSSolverCheckpointHeader);
+	MPI_Offset offset_gamma_temp = offset_gamma + (MPI_Offset)gamma_size*sizeof(double);
+	MPI_Offset offset_theta = offset_gamma_temp + (has_temp? (MPI_Offset)gamma_size*sizeof(double) : 0);
+	MPI_Offset offset_theta_temp = offset_theta + (MPI_Offset)theta_size*sizeof(double);
+	MPI_Offset offset_state = offset_theta_temp + (has_temp? (MPI_Offset)theta_size*sizeof(double) : 0);
+
+	/* write into temporary file, the old checkpoint stays valid until the new one is complete */
+	std::string filename_temp = this->checkpoint_filename + ".tmp";
+	MPI_File file;
+	MPI_File_open(PETSC_COMM_WORLD, (char *)filename_temp.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file);
+	MPI_File_set_size(file, 0);
+
+	/* gamma in the layout of decomposition, everybody writes own part */
+	const double *arr;
+	TRYCXX( VecGetArrayRead(gamma_Vec, &arr) );
+	MPI_File_write_at_all(file, offset_gamma + (MPI_Offset)low*sizeof(double), (void *)arr, high-low, MPI_DOUBLE, MPI_STATUS_IGNORE);
+	TRYCXX( VecRestoreArrayRead(gamma_Vec, &arr) );
+
+	if(has_temp){
+		TRYCXX( VecGetArrayRead(gammavector_temp->get_vector(), &arr) );
+		MPI_File_write_at_all(file, offset_gamma_temp + (MPI_Offset)low*sizeof(double), (void *)arr, high-low, MPI_DOUBLE, MPI_STATUS_IGNORE);
+		TRYCXX( VecRestoreArrayRead(gammavector_temp->get_vector(), &arr) );
+	}
+
+	/* master writes the rest */
+	if(GlobalManager.get_rank() == 0){
+		MPI_File_write_at(file, 0, &header, sizeof(TSSolverCheckpointHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+
+		TRYCXX( VecGetArrayRead(theta_Vec, &arr) );
+		MPI_File_write_at(file, offset_theta, (void *)arr, theta_size, MPI_DOUBLE, MPI_STATUS_IGNORE);
+		TRYCXX( VecRestoreArrayRead(theta_Vec, &arr) );
+
+		if(has_temp){
+			TRYCXX( VecGetArrayRead(thetavector_temp->get_vector(), &arr) );
+			MPI_File_write_at(file, offset_theta_temp, (void *)arr, theta_size, MPI_DOUBLE, MPI_STATUS_IGNORE);
+			TRYCXX( VecRestoreArrayRead(thetavector_temp->get_vector(), &arr) );
+		}
+
+		std::vector<double> state(header.gammastate_size + header.thetastate_size);
+		if(state.size() > 0){
+			gammasolver->get_state(&state[0]);
+			thetasolver->get_state(&state[header.gammastate_size]);
+			MPI_File_write_at(file, offset_state, &state[0], state.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+		}
+	}
+
+	MPI_File_close(&file);
+
+	/* replace old checkpoint, rename is atomic */
+	if(GlobalManager.get_rank() == 0){
+		if(rename(filename_temp.c_str(), this->checkpoint_filename.c_str()) != 0){
+			coutMaster << "ERROR: checkpoint " << this->checkpoint_filename << " cannot be replaced" << std::endl;
+		}
+	}
+	MPI_Barrier(PETSC_COMM_WORLD);
+
+	this->checkpoint_nsaved++;
+
+	this->timer_checkpoint.stop();
+
+	LOG_FUNC_END
+}
+
+template<>
+bool TSSolver<PetscVector>::read_checkpoint_header(TSSolverCheckpointHeader *header) const {
+	LOG_FUNC_BEGIN
+
+	/* master reads header and sends it to others */
+	int is_valid = 0;
+	if(GlobalManager.get_rank() == 0){
+		std::ifstream file(this->checkpoint_filename.c_str(), std::ios::in | std::ios::binary);
+		if(file.is_open()){
+			file.read((char *)header, sizeof(TSSolverCheckpointHeader));
+			is_valid = (file.gcount() == sizeof(TSSolverCheckpointHeader));
+			file.close();
+		}
+	}
+	MPI_Bcast(&is_valid, 1, MPI_INT, 0, PETSC_COMM_WORLD);
+	if(!is_valid){
+		LOG_FUNC_END
+		return false;
+	}
+	MPI_Bcast(header, sizeof(TSSolverCheckpointHeader), MPI_BYTE, 0, PETSC_COMM_WORLD);
+
+	/* check if the checkpoint matches actual problem */
+	int gamma_size, theta_size;
+	TRYCXX( VecGetSize(tsdata->get_gammavector()->get_vector(), &gamma_size) );
+	TRYCXX( VecGetLocalSize(tsdata->get_thetavector()->get_vector(), &theta_size) );
+
+	if(strncmp(header->magic, TSSOLVER_CHECKPOINT_MAGIC, 8) != 0 || header->version != TSSOLVER_CHECKPOINT_VERSION){
+		coutMaster << "ERROR: " << this->checkpoint_filename << " is not a checkpoint file" << std::endl;
+		LOG_FUNC_END
+		return false;
+	}
+
+	if(header->nproc != GlobalManager.get_size()
+		|| header->gamma_size != gamma_size
+		|| header->theta_size != theta_size
+		|| header->has_temp != (this->annealing > 1)
+		|| header->gammastate_size != gammasolver->get_state_size()
+		|| header->thetastate_size != thetasolver->get_state_size()){
+		coutMaster << "ERROR: checkpoint " << this->checkpoint_filename << " does not match actual problem (nproc = " << header->nproc << ", gamma size = " << header->gamma_size << ")" << std::endl;
+		LOG_FUNC_END
+		return false;
+	}
+
+	LOG_FUNC_END
+
+	return true;
+}
+
+template<>
+bool TSSolver<PetscVector>::load_checkpoint() {
+	LOG_FUNC_BEGIN
+
+	TSSolverCheckpointHeader header;
+	if(this->checkpoint_filename.empty() || !read_checkpoint_header(&header) || header.id != this->checkpoint_id){
+		LOG_FUNC_END
+		return false;
+	}
+
+	Vec gamma_Vec = tsdata->get_gammavector()->get_vector();
+	Vec theta_Vec = tsdata->get_thetavector()->get_vector();
+	bool has_temp = header.has_temp;
+
+	int low, high;
+	TRYCXX( VecGetOwnershipRange(gamma_Vec, &low, &high) );
+
+	/* positions of parts in file, the same as in save_checkpoint */
+	MPI_Offset offset_gamma = sizeof(TSSolverCheckpointHeader);
+	MPI_Offset offset_gamma_temp = offset_gamma + (MPI_Offset)header.gamma_size*sizeof(double);
+	MPI_Offset offset_theta = offset_gamma_temp + (has_temp? (MPI_Offset)header.gamma_size*sizeof(double) : 0);
+	MPI_Offset offset_theta_temp = offset_theta + (MPI_Offset)header.theta_size*sizeof(double);
+	MPI_Offset offset_state = offset_theta_temp + (has_temp? (MPI_Offset)header.theta_size*sizeof(double) : 0);
+
+	MPI_File file;
+	MPI_File_open(PETSC_COMM_WORLD, (char *)this->checkpoint_filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file);
+
+	/* gamma, everybody reads own part */
+	double *arr;
+	TRYCXX( VecGetArray(gamma_Vec, &arr) );
+	MPI_File_read_at_all(file, offset_gamma + (MPI_Offset)low*sizeof(double), arr, high-low, MPI_DOUBLE, MPI_STATUS_IGNORE);
+	TRYCXX( VecRestoreArray(gamma_Vec, &arr) );
+
+	if(has_temp){
+		TRYCXX( VecGetArray(gammavector_temp->get_vector(), &arr) );
+		MPI_File_read_at_all(file, offset_gamma_temp + (MPI_Offset)low*sizeof(double), arr, high-low, MPI_DOUBLE, MPI_STATUS_IGNORE);
+		TRYCXX( VecRestoreArray(gammavector_temp->get_vector(), &arr) );
+	}
+
+	/* theta is the same on all processes */
+	TRYCXX( VecGetArray(theta_Vec, &arr) );
+	MPI_File_read_at_all(file, offset_theta, arr, header.theta_size, MPI_DOUBLE, MPI_STATUS_IGNORE);
+	TRYCXX( VecRestoreArray(theta_Vec, &arr) );
+
+	if(has_temp){
+		TRYCXX( VecGetArray(thetavector_temp->get_vector(), &arr) );
+		MPI_File_read_at_all(file, offset_theta_temp, arr, header.theta_size, MPI_DOUBLE, MPI_STATUS_IGNORE);
+		TRYCXX( VecRestoreArray(thetavector_temp->get_vector(), &arr) );
+	}
+
+	/* inner state of solvers */
+	std::vector<double> state(header.gammastate_size + header.thetastate_size);
+	MPI_File_read_at_all(file, offset_state, (state.size() > 0)? &state[0] : NULL, state.size(), MPI_DOUBLE, MPI_STATUS_IGNORE);
+	if(state.size() > 0){
+		gammasolver->set_state(&state[0]);
+		thetasolver->set_state(&state[header.gammastate_size]);
+	}
+
+	MPI_File_close(&file);
+
+	/* state of the best annealing step */
+	this->it_sum = header.it_sum;
+	this->L = header.L_best;
+	this->deltaL = header.deltaL_best;
+	tsdata->set_aic(header.aic);
+	if(header.finished){
+		this->it_last = header.it;
+	}
+
+	this->checkpoint_loaded = header;
+
+	LOG_FUNC_END
+
+	return true;
+}
+
+template<>
+int TSSolver<PetscVector>::get_checkpoint_restart_id() const {
+	LOG_FUNC_BEGIN
+
+	int id = -1;
+
+	TSSolverCheckpointHeader header;
+	if(this->checkpoint_restart && !this->checkpoint_filename.empty() && read_checkpoint_header(&header)){
+		id = header.id;
+	}
+
+	LOG_FUNC_END
+
+	return id;
+}
+
+template<>
+double TSSolver<PetscVector>::extrapolate_gamma(GeneralVector<PetscVector> *gammavector_prev, double beta) {
+	LOG_FUNC_BEGIN
+
+	Vec gamma_Vec = tsdata->get_gammavector()->get_vector();
+	Vec gamma_prev_Vec = gammavector_prev->get_vector();
+
+	int local_size;
+	TRYCXX( VecGetLocalSize(gamma_Vec, &local_size) );
+
+	double *gamma_arr;
+	const double *gamma_prev_arr;
+	TRYCXX( VecGetArray(gamma_Vec, &gamma_arr) );
+	TRYCXX( VecGetArrayRead(gamma_prev_Vec, &gamma_prev_arr) );
+
+	/* the largest coefficient which keeps gamma nonnegative */
+	double beta_local = beta;
+	for(int i=0; i < local_size; i++){
+		double diff = gamma_arr[i] - gamma_prev_arr[i];
+		if(diff < 0.0 && gamma_arr[i] + beta_local*diff < 0.0){
+			beta_local = -gamma_arr[i]/diff;
+		}
+	}
+	double beta_used;
+	MPI_Allreduce(&beta_local, &beta_used, 1, MPI_DOUBLE, MPI_MIN, PETSC_COMM_WORLD);
+
+	/* rows of both iterates sum to one, therefore the extrapolated rows also sum to one */
+	if(beta_used > 0.0){
+		for(int i=0; i < local_size; i++){
+			gamma_arr[i] += beta_used*(gamma_arr[i] - gamma_prev_arr[i]);
+		}
+	}
+
+	TRYCXX( VecRestoreArrayRead(gamma_prev_Vec, &gamma_prev_arr) );
+	TRYCXX( VecRestoreArray(gamma_Vec, &gamma_arr) );
+
+	LOG_FUNC_END
+
+	return beta_used;
+}
+
+}
+} /* end namespace */
@@ -0,0 +1,23 @@
+#include "external/seqarrayvector/algebra/feasibleset/simplex_local.h"
+
+namespace pascinference {
+namespace algebra {
+
+template<>
+void SimplexFeasibleSet_Local<SeqArrayVector>::project(GeneralVector<SeqArrayVector> &x) {
+	LOG_FUNC_BEGIN
+
+	double *x_arr = x.get_array();
+
+	/* the subsets are disjoint, therefore they can be projected independently */
+	#pragma omp parallel for schedule(static) if(T*K > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int t=0;t<T;t++){
+		project_sub(x_arr,t,T,K);
+	}
+
+	LOG_FUNC_END
+}
+
+
+}
+} /* end of namespace */
@@ -0,0 +1,91 @@
+#include "external/seqarrayvector/algebra/graph/bgmgraph.h"
+
+namespace pascinference {
+namespace algebra {
+
+template<>
+BGMGraph<SeqArrayVector>::BGMGraph(const double *coordinates_array, int n, int dim){
+	LOG_FUNC_BEGIN
+
+	/* copy coordinates, given array could be temporary */
+	coordinates = new GeneralVector<SeqArrayVector>(n*dim);
+	double *coordinates_arr = coordinates->get_array();
+	for(int i=0;i<n*dim;i++){
+		coordinates_arr[i] = coordinates_array[i];
+	}
+
+	this->dim = dim;
+	this->n = n;
+
+	m = 0;
+	m_max = 0;
+	threshold = -1;
+	processed = false;
+
+	DD_decomposed = false;
+
+	externalcontent = NULL;
+
+	LOG_FUNC_END
+}
+
+template<>
+void BGMGraph<SeqArrayVector>::process(double threshold) {
+	LOG_FUNC_BEGIN
+
+	this->threshold = threshold;
+
+	const double *coordinates_arr = coordinates->get_array();
+	int n = this->n;
+
+	/* prepare array for number of neighbors */
+	neighbor_nmbs = (int*)malloc(n*sizeof(int));
+
+	/* go throught graph - compute number of neighbors,
+	 * every thread writes only to its own rows, therefore all pairs are tested twice */
+	#pragma omp parallel for schedule(dynamic,64)
+	for(int i=0;i<n;i++){
+		int counter = 0;
+		for(int j=0;j<n;j++){
+			if(j != i && compute_normsqr(coordinates_arr, i, j) < threshold*threshold){
+				counter++;
+			}
+		}
+		neighbor_nmbs[i] = counter;
+	}
+
+	/* prepare storages for neightbors ids */
+	neighbor_ids = (int**)malloc(n*sizeof(int*));
+	for(int i=0;i<n;i++){
+		neighbor_ids[i] = (int*)malloc(neighbor_nmbs[i]*sizeof(int));
+	}
+
+	/* go throught graph - fill indexes of neighbors in ascending order */
+	#pragma omp parallel for schedule(dynamic,64)
+	for(int i=0;i<n;i++){
+		int counter = 0;
+		for(int j=0;j<n;j++){
+			if(j != i && compute_normsqr(coordinates_arr, i, j) < threshold*threshold){
+				neighbor_ids[i][counter] = j;
+				counter++;
+			}
+		}
+	}
+
+	/* compute number of edges and m_max (max degree of vertex) */
+	int nmb_sum = 0;
+	for(int i=0;i<n;i++){
+		nmb_sum += neighbor_nmbs[i];
+		if(neighbor_nmbs[i] > m_max){
+			this->m_max = neighbor_nmbs[i];
+		}
+	}
+	this->m = nmb_sum/2;
+
+	this->processed = true;
+
+	LOG_FUNC_END
+}
+
+}
+} /* end of namespace */
@@ -0,0 +1,161 @@
+#include "external/seqarrayvector/algebra/matrix/blockgraphsparse.h"
+
+namespace pascinference {
+namespace algebra {
+
+template<>
+BlockGraphSparseMatrix<SeqArrayVector>::BlockGraphSparseMatrix(Decomposition<SeqArrayVector> &new_decomposition, double alpha, GeneralVector<SeqArrayVector> *new_coeffs){
+	LOG_FUNC_BEGIN
+
+	this->decomposition = &new_decomposition;
+
+	this->alpha = alpha;
+	this->coeffs = new_coeffs;
+
+	consoleArg.set_option_value("blockgraphsparsematrix_lambdamax_lanczos", &this->lambda_max_lanczos, BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_LANCZOS);
+	consoleArg.set_option_value("blockgraphsparsematrix_lambdamax_maxit", &this->lambda_max_maxit, BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_MAXIT);
+	consoleArg.set_option_value("blockgraphsparsematrix_lambdamax_eps", &this->lambda_max_eps, BLOCKGRAPHSPARSEMATRIX_DEFAULT_LAMBDAMAX_EPS);
+	this->lambda_max_unscaled = -1.0; /* will be computed when it is needed for the first time */
+
+	int R = get_R();
+
+	int* neighbor_nmbs = decomposition->get_graph()->get_neighbor_nmbs();
+	int **neightbor_ids = decomposition->get_graph()->get_neighbor_ids();
+
+	/* the matrix is not assembled, store only the graph in permuted numbering,
+	 * the entries are generated during multiplication */
+	externalcontent = new ExternalContent();
+	externalcontent->neighbor_begin.resize(R+1);
+	externalcontent->neighbor_begin[0] = 0;
+	for(int r=0; r < R; r++){
+		int r_orig = decomposition->get_invPr(r);
+		externalcontent->neighbor_begin[r+1] = externalcontent->neighbor_begin[r] + neighbor_nmbs[r_orig];
+	}
+
+	externalcontent->neighbor_ids.resize(externalcontent->neighbor_begin[R]);
+	for(int r=0; r < R; r++){
+		int r_orig = decomposition->get_invPr(r);
+		for(int neighbor=0;neighbor<neighbor_nmbs[r_orig];neighbor++){
+			externalcontent->neighbor_ids[externalcontent->neighbor_begin[r] + neighbor] = decomposition->get_Pr(neightbor_ids[r_orig][neighbor]);
+		}
+	}
+
+	LOG_FUNC_END
+}
+
+
+template<>
+BlockGraphSparseMatrix<SeqArrayVector>::~BlockGraphSparseMatrix(){
+	LOG_FUNC_BEGIN
+
+	delete externalcontent;
+
+	LOG_FUNC_END
+}
+
+/* matrix-vector multiplication */
+template<>
+void BlockGraphSparseMatrix<SeqArrayVector>::matmult(SeqArrayVector &y, const SeqArrayVector &x) const {
+	LOG_FUNC_BEGIN
+
+	int T = get_T();
+	int R = get_R();
+	int K = get_K();
+
+	const double *x_arr = x.get_array();
+	double *y_arr = y.get_array();
+
+	const int *neighbor_begin = &(externalcontent->neighbor_begin[0]);
+	const int *neighbor_ids = (externalcontent->neighbor_ids.size() > 0)? &(externalcontent->neighbor_ids[0]) : NULL;
+
+	/* coefficients of blocks (the same entries as in PETSc variant of matrix) */
+	std::vector<double> coeff(K);
+	if(coeffs){
+		const double *coeffs_arr = coeffs->get_array();
+		for(int k=0;k<K;k++){
+			coeff[k] = alpha*coeffs_arr[k]*coeffs_arr[k];
+		}
+	} else {
+		for(int k=0;k<K;k++){
+			coeff[k] = alpha;
+		}
+	}
+
+	#pragma omp parallel for schedule(static) if(T*R*K > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int t=0;t<T;t++){
+		for(int r=0;r<R;r++){
+			int nmb = neighbor_begin[r+1] - neighbor_begin[r];
+			const int *ids = &neighbor_ids[neighbor_begin[r]];
+
+			/* compute sum of W entries in row */
+			int Wsum;
+			if(t == 0 || t == T-1){
+				if(T > 1){
+					Wsum = 2*nmb+2; /* +1 for diagonal block */
+				} else {
+					Wsum = nmb;
+				}
+			} else {
+				Wsum = 3*nmb+4; /* +2 for diagonal block */
+			}
+
+			const double *x_t = &x_arr[t*R*K];
+			double *y_tr = &y_arr[t*R*K + r*K];
+
+			for(int k=0;k<K;k++){
+				/* diagonal entry */
+				double value = Wsum*x_t[r*K+k];
+
+				/* my nondiagonal entries */
+				if(t > 0) {
+					value -= 2*x_t[r*K+k - R*K];
+				}
+				if(t < T-1) {
+					value -= 2*x_t[r*K+k + R*K];
+				}
+
+				/* non-diagonal neighbor entries */
+				for(int neighbor=0;neighbor<nmb;neighbor++){
+					int idx2 = ids[neighbor]*K + k;
+
+					value -= x_t[idx2];
+					if(t > 0) {
+						value -= x_t[idx2 - R*K];
+					}
+					if(t < T-1) {
+						value -= x_t[idx2 + R*K];
+					}
+				}
+
+				y_tr[k] = coeff[k]*value;
+			}
+		}
+	}
+
+	LOG_FUNC_END
+}
+
+template<>
+double BlockGraphSparseMatrix<SeqArrayVector>::get_lambda_max_scale() const {
+	double scale = alpha;
+	if(coeffs){
+		int K = get_K();
+		const double *coeffs_arr = coeffs->get_array();
+
+		double coeff_max = 0.0;
+		for(int k=0;k<K;k++){
+			coeff_max = std::max(coeff_max, coeffs_arr[k]*coeffs_arr[k]);
+		}
+		scale *= coeff_max;
+	}
+
+	return scale;
+}
+
+template<>
+BlockGraphSparseMatrix<SeqArrayVector>::ExternalContent * BlockGraphSparseMatrix<SeqArrayVector>::get_externalcontent() const {
+	return this->externalcontent;
+}
+
+}
+} /* end of namespace */
@@ -5,12 +5,11 @@ namespace algebra {
 
 template<>
 void GeneralVector<SeqArrayVector>::set_random() { 
-
-
 	double *inner_array = this->get_array();
 
+	/* uniform values from [0,1], rand() is not thread-safe, therefore sequentially */
 	for(int i=0;i<this->size();i++){
-		inner_array[i] = rand();
+		inner_array[i] = rand()/(double)RAND_MAX;
 	}
 
 }
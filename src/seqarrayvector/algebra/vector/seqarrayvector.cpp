@@ -1,51 +1,92 @@
 #include "external/seqarrayvector/algebra/vector/seqarrayvector.h"
 
+#include <fstream>
+#include <vector>
+
 namespace seqarrayvector {
 
 seqarrayvector_all_type all;
 
+double *allocate_aligned(int n){
+	void *new_array = NULL;
+	if(posix_memalign(&new_array, SEQARRAYVECTOR_ALIGNMENT, (n > 0 ? n : 1)*sizeof(double)) != 0){
+		std::cerr << "ERROR: SeqArrayVector cannot allocate " << n << " components" << std::endl;
+		return NULL;
+	}
+
+	/* first touch by the threads which will work with the values */
+	double *new_array_double = (double *)new_array;
+	#pragma omp parallel for schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		new_array_double[i] = 0.0;
+	}
+
+	return new_array_double;
+}
+
 SeqArrayVector::SeqArrayVector(){
+	this->inner_array = NULL;
 	this->inner_size = -1;
+	this->destroy_inner_array = false;
 }
 
 
 SeqArrayVector::SeqArrayVector(int n){
 	this->inner_size = n;
-	this->inner_array = new double(this->inner_size);
+	this->inner_array = allocate_aligned(this->inner_size);
+	this->destroy_inner_array = true;
 }
 
 
 SeqArrayVector::SeqArrayVector(double *values, int n){
 	this->inner_size = n;
 	this->inner_array = values; /* owner of this array is somewhere else */
-
+	this->destroy_inner_array = false;
 }
 
 
 SeqArrayVector::SeqArrayVector(const SeqArrayVector &vec){
 	/* there is duplicate... this function has to be called as less as possible */
 	this->inner_size = vec.size();
-	this->inner_array = new double(this->inner_size);
+	this->inner_array = allocate_aligned(this->inner_size);
+	this->destroy_inner_array = true;
 
-	double *inner_array2 = vec.get_array();
+	const double *inner_array2 = vec.get_array();
+	double *inner_array1 = this->inner_array;
+	int n = this->inner_size;
 
-	for(int i=0;i<this->inner_size;i++){
-		this->inner_array[i] = inner_array2[i];
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array1[i] = inner_array2[i];
 	}
-	
+}
+
+SeqArrayVector::SeqArrayVector(SeqArrayVector &&vec){
+	this->inner_size = vec.inner_size;
+	this->inner_array = vec.inner_array;
+	this->destroy_inner_array = vec.destroy_inner_array;
+
+	/* the temporary vector is not the owner anymore */
+	vec.inner_array = NULL;
+	vec.inner_size = -1;
+	vec.destroy_inner_array = false;
 }
 
 SeqArrayVector::~SeqArrayVector(){
-	/* if there is any inner vector, then destroy it */
-	if(this->inner_size > 0){
+	/* if this vector is the owner of inner array, then destroy it */
+	if(this->destroy_inner_array){
 		free(this->inner_array);
 	}
 }
 
 
 void SeqArrayVector::set(double new_value){
-	for(int i=0;i<this->inner_size;i++){
-		this->inner_array[i] = new_value;
+	double *inner_array1 = this->inner_array;
+	int n = this->inner_size;
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array1[i] = new_value;
 	}
 }
 
@@ -59,14 +100,122 @@ void SeqArrayVector::set(int index, double new_value){
 }
 
 void SeqArrayVector::load_csv(std::string filename){
-	//TODO
+	std::ifstream myfile(filename.c_str());
+	if(!myfile.is_open()){
+		std::cerr << "ERROR: file " << filename << " cannot be opened" << std::endl;
+		return;
+	}
+
+	/* values are separated by commas or white spaces */
+	std::vector<double> values;
+	std::string item;
+	while(myfile >> item){
+		size_t begin = 0;
+		while(begin < item.size()){
+			size_t end = item.find(',', begin);
+			if(end == std::string::npos){
+				end = item.size();
+			}
+			if(end > begin){
+				values.push_back(atof(item.substr(begin, end-begin).c_str()));
+			}
+			begin = end+1;
+		}
+	}
+	myfile.close();
+
+	/* prepare new inner array */
+	if(this->destroy_inner_array){
+		free(this->inner_array);
+	}
+	this->inner_size = values.size();
+	this->inner_array = allocate_aligned(this->inner_size);
+	this->destroy_inner_array = true;
+
+	for(int i=0;i<this->inner_size;i++){
+		this->inner_array[i] = values[i];
+	}
 }
 
 void SeqArrayVector::save_csv(std::string filename){
-	//TODO
+	std::ofstream myfile(filename.c_str());
+
+	myfile.precision(17);
+	for(int i=0;i<this->inner_size;i++){
+		myfile << this->inner_array[i];
+		if(i < this->inner_size-1) myfile << ",";
+	}
+	myfile << "\n";
+
+	myfile.close();
+}
+
+/* swap the order of bytes on little-endian host, PETSc binary files are big-endian */
+static void swap_bigendian(char *bytes, int nmb_bytes){
+	const unsigned short one = 1;
+	if(*((const unsigned char *)&one) == 1){
+		for(int i=0;i<nmb_bytes/2;i++){
+			char temp = bytes[i];
+			bytes[i] = bytes[nmb_bytes-1-i];
+			bytes[nmb_bytes-1-i] = temp;
+		}
+	}
 }
 
-double* SeqArrayVector::get_array() const { 
+void SeqArrayVector::load_binary(std::string filename){
+	std::ifstream myfile(filename.c_str(), std::ios::binary);
+	if(!myfile.is_open()){
+		std::cerr << "ERROR: file " << filename << " cannot be opened" << std::endl;
+		return;
+	}
+
+	/* header: classid and size (32-bit integers) */
+	int header[2];
+	myfile.read((char *)header, 2*sizeof(int));
+	swap_bigendian((char *)&header[0], sizeof(int));
+	swap_bigendian((char *)&header[1], sizeof(int));
+	if(!myfile || header[0] != SEQARRAYVECTOR_VEC_CLASSID || header[1] < 0){
+		std::cerr << "ERROR: file " << filename << " is not a vector in PETSc binary format" << std::endl;
+		return;
+	}
+
+	/* prepare new inner array */
+	if(this->destroy_inner_array){
+		free(this->inner_array);
+	}
+	this->inner_size = header[1];
+	this->inner_array = allocate_aligned(this->inner_size);
+	this->destroy_inner_array = true;
+
+	myfile.read((char *)this->inner_array, this->inner_size*sizeof(double));
+	if(!myfile){
+		std::cerr << "ERROR: file " << filename << " is shorter than declared size " << this->inner_size << std::endl;
+	}
+	myfile.close();
+
+	for(int i=0;i<this->inner_size;i++){
+		swap_bigendian((char *)&this->inner_array[i], sizeof(double));
+	}
+}
+
+void SeqArrayVector::save_binary(std::string filename) const {
+	std::ofstream myfile(filename.c_str(), std::ios::binary);
+
+	int header[2] = {SEQARRAYVECTOR_VEC_CLASSID, this->inner_size};
+	swap_bigendian((char *)&header[0], sizeof(int));
+	swap_bigendian((char *)&header[1], sizeof(int));
+	myfile.write((const char *)header, 2*sizeof(int));
+
+	for(int i=0;i<this->inner_size;i++){
+		double value = this->inner_array[i];
+		swap_bigendian((char *)&value, sizeof(double));
+		myfile.write((const char *)&value, sizeof(double));
+	}
+
+	myfile.close();
+}
+
+double* SeqArrayVector::get_array() const {
 	return this->inner_array;
 }
 
@@ -74,31 +223,43 @@ int SeqArrayVector::size() const{
 	return this->inner_size;
 }
 
+int SeqArrayVector::local_size() const{
+	return this->inner_size;
+}
 
 double SeqArrayVector::get(int i)
 {
 	return this->inner_array[i];
 }
 
+void SeqArrayVector::get_ownership(int *low, int *high){
+	*low = 0;
+	*high = this->inner_size;
+}
+
 
 void SeqArrayVector::scale(double alpha){
-	for(int i=0;i<this->inner_size;i++){
-		this->inner_array[i] *= alpha;
+	double *inner_array1 = this->inner_array;
+	int n = this->inner_size;
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array1[i] *= alpha;
 	}
 }
 
 
-std::ostream &operator<<(std::ostream &output, const SeqArrayVector &vector)		
+std::ostream &operator<<(std::ostream &output, const SeqArrayVector &vector)
 {
 	double *inner_array = vector.get_array();
-	
+
 	output << "[";
 	for(int i=0; i<vector.size(); i++){
 		output << inner_array[i];
 		if(i < vector.size()-1) output << ", ";
 	}
 	output << "]";
-			
+
 	return output;
 }
 
@@ -106,58 +267,54 @@ std::ostream &operator<<(std::ostream &output, const SeqArrayVector &vector)
 SeqArrayVector &SeqArrayVector::operator=(const SeqArrayVector &vec2){
 	/* check for self-assignment by comparing the address of the implicit object and the parameter */
 	/* vec1 = vec1 */
-    if (this == &vec2){
+    if (this == &vec2 || this->inner_array == vec2.get_array()){
         return *this;
 	}
 
 	/* vec1 is not initialized yet */
 	if (this->inner_size <= 0){
 		this->inner_size = vec2.size();
-		this->inner_array = new double(this->inner_size);
+		this->inner_array = allocate_aligned(this->inner_size);
+		this->destroy_inner_array = true;
 	}
 
 	//TODO: this->inner_size == vec2.size() ?
 
 	/* copy values */
-	double *inner_array2 = vec2.get_array();
-	for(int i=0;i<this->inner_size;i++){
-		this->inner_array[i] = inner_array2[i];
+	const double *inner_array2 = vec2.get_array();
+	double *inner_array1 = this->inner_array;
+	int n = this->inner_size;
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array1[i] = inner_array2[i];
 	}
-	
-	return *this;	
+
+	return *this;
 }
 
 /* vec1 = scalar_value <=> vec1(all) = scalar_value, assignment operator */
 SeqArrayVector &SeqArrayVector::operator=(double scalar_value){
 	this->set(scalar_value);
-	return *this;	
+	return *this;
 }
 
-/* return subvector to be able to overload vector(index) = new_value */ 
+/* return subvector to be able to overload vector(index) = new_value */
 SeqArrayVector SeqArrayVector::operator()(int index) const
-{   
-	double *new_array = new double(1);
-	new_array[0] = this->inner_array[index];
-	
-	return SeqArrayVector(new_array,1);
+{
+	return SeqArrayVector(&(this->inner_array[index]), 1);
 }
 
-/* return subvector vector(index_begin:index_end), i.e. components with indexes: [index_begin, index_begin+1, ..., index_end] */ 
+/* return subvector vector(index_begin:index_end), i.e. components with indexes: [index_begin, index_begin+1, ..., index_end-1] */
 SeqArrayVector SeqArrayVector::operator()(int index_begin, int index_end) const
-{   
-	double *new_array = new double(index_end-index_begin);
-
-	for(int i=0;i<index_end-index_begin;i++){
-		new_array[i] = this->inner_array[index_begin+i];
-	}
-	
-	return SeqArrayVector(new_array, index_end-index_begin);
+{
+	return SeqArrayVector(&(this->inner_array[index_begin]), index_end-index_begin);
 }
 
 /* define SeqArrayVector(all) */
 SeqArrayVector SeqArrayVector::operator()(seqarrayvector_all_type all_type) const{
-	return *this;
-} 
+	return SeqArrayVector(this->inner_array, this->inner_size);
+}
 
 
 /* vec1 *= alpha */
@@ -166,34 +323,43 @@ void operator*=(SeqArrayVector &vec1, double alpha)
 	vec1.scale(alpha);
 }
 
-/* vec1 += comb */
-void operator+=(const SeqArrayVector &vec1, SeqArrayVector vec2)
+/* vec1 += vec2 */
+void operator+=(const SeqArrayVector &vec1, const SeqArrayVector &vec2)
 {
 	double *inner_array1 = vec1.get_array();
-	double *inner_array2 = vec2.get_array();
-	for(int i=0;i<vec1.inner_size;i++){
-		inner_array1[i] += inner_array2[i]; 		
+	const double *inner_array2 = vec2.get_array();
+	int n = vec1.size();
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array1[i] += inner_array2[i];
 	}
 }
 
-/* vec1 -= comb */
-void operator-=(const SeqArrayVector &vec1, SeqArrayVector vec2)
+/* vec1 -= vec2 */
+void operator-=(const SeqArrayVector &vec1, const SeqArrayVector &vec2)
 {
 	double *inner_array1 = vec1.get_array();
-	double *inner_array2 = vec2.get_array();
-	for(int i=0;i<vec1.size();i++){
-		inner_array1[i] -= inner_array2[i]; 		
+	const double *inner_array2 = vec2.get_array();
+	int n = vec1.size();
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array1[i] -= inner_array2[i];
 	}
 }
 
 /* dot = dot(vec1,vec2) */
 double dot(const SeqArrayVector &vec1, const SeqArrayVector &vec2)
 {
-	double dot_value=0;
+	double dot_value = 0.0;
 
-	double *inner_array1 = vec1.get_array();
-	double *inner_array2 = vec2.get_array();
-	for(int i=0;i<vec1.size();i++){
+	const double *inner_array1 = vec1.get_array();
+	const double *inner_array2 = vec2.get_array();
+	int n = vec1.size();
+
+	#pragma omp parallel for simd schedule(static) reduction(+:dot_value) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
 		dot_value += inner_array1[i]*inner_array2[i];
 	}
 
@@ -212,8 +378,11 @@ double max(const SeqArrayVector &vec1)
 {
 	double max_value = -std::numeric_limits<double>::max(); /* - Inf */
 
-	double *inner_array1 = vec1.get_array();
-	for(int i=0;i<vec1.size();i++){
+	const double *inner_array1 = vec1.get_array();
+	int n = vec1.size();
+
+	#pragma omp parallel for simd schedule(static) reduction(max:max_value) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
 		if(inner_array1[i] > max_value){
 			max_value = inner_array1[i];
 		}
@@ -227,8 +396,11 @@ double min(const SeqArrayVector &vec1)
 {
 	double min_value = std::numeric_limits<double>::max(); /* + Inf */
 
-	double *inner_array1 = vec1.get_array();
-	for(int i=0;i<vec1.size();i++){
+	const double *inner_array1 = vec1.get_array();
+	int n = vec1.size();
+
+	#pragma omp parallel for simd schedule(static) reduction(min:min_value) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
 		if(inner_array1[i] < min_value){
 			min_value = inner_array1[i];
 		}
@@ -241,30 +413,80 @@ double min(const SeqArrayVector &vec1)
 double sum(const SeqArrayVector &vec1)
 {
 	double sum_value = 0.0;
-	
-	double *inner_array1 = vec1.get_array();
-	for(int i=0;i<vec1.size();i++){
+
+	const double *inner_array1 = vec1.get_array();
+	int n = vec1.size();
+
+	#pragma omp parallel for simd schedule(static) reduction(+:sum_value) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
 		sum_value += inner_array1[i];
 	}
-	
+
 	return sum_value;
 }
 
 /* vec3 = vec1./vec2 */
 const SeqArrayVector operator/(const SeqArrayVector &vec1, const SeqArrayVector &vec2)
 {
-	//TODO
-	return vec1;
+	int n = vec1.size();
+	SeqArrayVector vec3(n);
+
+	const double *inner_array1 = vec1.get_array();
+	const double *inner_array2 = vec2.get_array();
+	double *inner_array3 = vec3.get_array();
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array3[i] = inner_array1[i]/inner_array2[i];
+	}
+
+	return vec3;
 }
 
+/* vec3 = vec1.*vec2 */
 SeqArrayVector mul(const SeqArrayVector &vec1, const SeqArrayVector &vec2)
 {
-	//TODO
-	return vec1;
+	int n = vec1.size();
+	SeqArrayVector vec3(n);
 
+	const double *inner_array1 = vec1.get_array();
+	const double *inner_array2 = vec2.get_array();
+	double *inner_array3 = vec3.get_array();
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		inner_array3[i] = inner_array1[i]*inner_array2[i];
+	}
+
+	return vec3;
+}
+
+/* y = y + alpha*x */
+void axpy(SeqArrayVector &y, double alpha, const SeqArrayVector &x)
+{
+	double *y_arr = y.get_array();
+	const double *x_arr = x.get_array();
+	int n = y.size();
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		y_arr[i] += alpha*x_arr[i];
+	}
 }
 
+/* w = y + alpha*x */
+void waxpy(SeqArrayVector &w, const SeqArrayVector &y, double alpha, const SeqArrayVector &x)
+{
+	double *w_arr = w.get_array();
+	const double *y_arr = y.get_array();
+	const double *x_arr = x.get_array();
+	int n = w.size();
+
+	#pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		w_arr[i] = y_arr[i] + alpha*x_arr[i];
+	}
+}
 
 
 } /* end of namespace */
-
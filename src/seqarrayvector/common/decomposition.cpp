@@ -11,13 +11,42 @@ Decomposition<SeqArrayVector>::Decomposition(int T, int R, int K, int xdim, int
 	this->R = R;
 	this->K = K;
 	this->xdim = xdim;
-		
+
+	/* there is only one process, the layout is natural */
 	this->DDT_size = 1;
 	this->DDR_size = 1;
-	
+
+	/* prepare new layout for T */
+	destroy_DDT_arrays = true;
+	DDT_ranges = (int *)malloc((this->DDT_size+1)*sizeof(int));
+	DDT_ranges[0] = 0;
+	DDT_ranges[1] = T;
+
+	/* prepare new layout for R */
+	/* no graph provided - allocate arrays */
+	destroy_DDR_arrays = true;
+
+	DDR_affiliation = (int *)malloc(R*sizeof(int));
+	DDR_permutation = (int *)malloc(R*sizeof(int));
+	DDR_invpermutation = (int *)malloc(R*sizeof(int));
+	for(int i=0;i<R;i++){
+		DDR_affiliation[i] = 0;
+		DDR_permutation[i] = i;
+		DDR_invpermutation[i] = i;
+	}
+
+	DDR_lengths = (int *)malloc((this->DDR_size)*sizeof(int));
+	DDR_lengths[0] = R;
+
+	DDR_ranges = (int *)malloc((this->DDR_size+1)*sizeof(int));
+	DDR_ranges[0] = 0;
+	DDR_ranges[1] = R;
+
 	/* no graph provided */
 	graph = NULL;
 
+	compute_rank();
+
 	LOG_FUNC_END
 }
 
@@ -30,11 +59,15 @@ Decomposition<SeqArrayVector>::Decomposition(int T, BGMGraph<SeqArrayVector> &ne
 	this->K = K;
 	this->xdim = xdim;
 
+	/* prepare new layout for R, there is only one domain */
+	destroy_DDR_arrays = false;
+	set_graph(new_graph, 1);
+
 	this->DDT_size = 1;
 	this->DDR_size = 1;
 
 	/* prepare new layout for T */
-	destroy_DDT_arrays = true;	
+	destroy_DDT_arrays = true;
 	DDT_ranges = (int *)malloc((this->DDT_size+1)*sizeof(int));
 	DDT_ranges[0] = 0;
 	DDT_ranges[1] = T;
@@ -53,26 +86,19 @@ Decomposition<SeqArrayVector>::Decomposition(int T, BGMGraph<SeqArrayVector> &ne
 	this->K = K;
 	this->xdim = xdim;
 
-	/* prepare new layout for R */
+	/* prepare new layout for R, there is only one domain */
 	destroy_DDR_arrays = false;
-	set_graph(new_graph, DDR_size);
+	set_graph(new_graph, 1);
+
+	/* there is only one process, given DDT_size and DDR_size are ignored */
+	this->DDT_size = 1;
+	this->DDR_size = 1;
 
-	this->DDT_size = DDT_size;
-	this->DDR_size = graph->get_DD_size();
-	
 	/* prepare new layout for T */
-	destroy_DDT_arrays = true;	
-	/* unfortunatelly, we have to compute distribution of T manually */
-	int DDT_optimal_local_size = T/(double)DDT_size;
-	int DDT_optimal_local_size_residue = T - DDT_optimal_local_size*DDT_size;
+	destroy_DDT_arrays = true;
 	DDT_ranges = (int *)malloc((this->DDT_size+1)*sizeof(int));
 	DDT_ranges[0] = 0;
-	for(int i=0;i<DDT_size;i++){
-		DDT_ranges[i+1] = DDT_ranges[i] + DDT_optimal_local_size;
-		if(i < DDT_optimal_local_size_residue){
-			DDT_ranges[i+1] += 1;
-		}
-	}
+	DDT_ranges[1] = T;
 
 	compute_rank();
 
@@ -102,22 +128,10 @@ template<>
 void Decomposition<SeqArrayVector>::compute_rank(){
 	LOG_FUNC_BEGIN
 
-	/* get rank of this processor */
-	int rank = GlobalManager.get_rank();
-
-	this->DDT_rank = rank/(double)this->DDR_size;
-	this->DDR_rank = rank - (this->DDT_rank)*(this->DDR_size);
+	/* there is only one process */
+	this->DDT_rank = 0;
+	this->DDR_rank = 0;
 
-	/* control the decomposition */
-//	if(this->DDT_size*this->DDR_size != GlobalManager.get_size()){
-//		coutMaster << "Sorry, DDT_size*DDR_size != nproc" << std::endl;
-//		coutMaster << " DDT_size = " << this->DDT_size << std::endl;
-//		coutMaster << " DDR_size = " << this->DDR_size << std::endl;
-//		coutMaster << " nproc    = " << GlobalManager.get_size() << std::endl;
-
-		// TODO: throw error
-//	}
-	
 	LOG_FUNC_END
 }
 
@@ -132,9 +146,9 @@ void Decomposition<SeqArrayVector>::set_graph(BGMGraph<SeqArrayVector> &new_grap
 		free(DDR_ranges);
 	}
 
-	/* decompose graph */
-	this->DDR_size = DDR_size;
-	new_graph.decompose(DDR_size);
+	/* decompose graph, there is only one domain */
+	this->DDR_size = 1;
+	new_graph.decompose(1);
 
 	this->graph = &new_graph;
 	destroy_DDR_arrays = false;
@@ -142,12 +156,34 @@ void Decomposition<SeqArrayVector>::set_graph(BGMGraph<SeqArrayVector> &new_grap
 	DDR_permutation = new_graph.get_DD_permutation();
 	DDR_invpermutation = new_graph.get_DD_invpermutation();
 	DDR_lengths = new_graph.get_DD_lengths();
-	DDR_ranges = new_graph.get_DD_ranges();	
-	
+	DDR_ranges = new_graph.get_DD_ranges();
+
 	compute_rank();
 }
 
+template<>
+void Decomposition<SeqArrayVector>::permute_TRblocksize(double *orig_arr, double *new_arr, int blocksize, bool invert) const {
+	LOG_FUNC_BEGIN
+
+	/* there is only one domain, only the nodes of graph are permuted */
+	#pragma omp parallel for schedule(static) if(T*R*blocksize > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int t=0;t<T;t++){
+		for(int r=0;r<R;r++){
+			int orig_idx = t*R*blocksize + r*blocksize;
+			int new_idx = t*R*blocksize + get_Pr(r)*blocksize;
+			for(int k=0;k<blocksize;k++){
+				if(!invert){
+					new_arr[new_idx+k] = orig_arr[orig_idx+k];
+				} else {
+					orig_arr[orig_idx+k] = new_arr[new_idx+k];
+				}
+			}
+		}
+	}
+
+	LOG_FUNC_END
+}
+
 
 }
 } /* end of namespace */
-
@@ -16,6 +16,15 @@ bool Initialize<SeqArrayVector>(int argc, char *argv[]){
 	} else {
 		srand(0);
 	}
+
+	/* binding of threads to cores */
+	bool binding_report;
+	consoleArg.set_option_value("global_binding_report", &binding_report, GLOBAL_DEFAULT_BINDING_REPORT);
+	if(binding_report){
+		coutMaster << "- BINDING ----------------------------" << std::endl;
+		coutMaster << GlobalManager.get_binding_report();
+		coutMaster << "--------------------------------------" << std::endl;
+	}
 	
 	return true;
 }
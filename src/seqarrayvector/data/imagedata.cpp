@@ -0,0 +1,89 @@
+#include "external/seqarrayvector/data/imagedata.h"
+
+namespace pascinference {
+namespace data {
+
+/* from filename, the file is in PETSc binary format */
+template<>
+ImageData<SeqArrayVector>::ImageData(Decomposition<SeqArrayVector> &new_decomposition, std::string filename_data, int width, int height){
+	LOG_FUNC_BEGIN
+
+	this->width = width;
+	this->height = height;
+	this->decomposition = &new_decomposition;
+
+	/* prepare preliminary datavector and load data */
+	GeneralVector<SeqArrayVector> datapreload;
+	datapreload.load_binary(filename_data);
+
+	/* prepare real datavector */
+	this->set_datavector_owned(new GeneralVector<SeqArrayVector>(decomposition->get_T()*decomposition->get_R()*decomposition->get_xdim()));
+
+	if(datapreload.size() != datavector->size()){
+		coutMaster << "WARNING: size of image in " << filename_data << " is " << datapreload.size() << ", expected " << datavector->size() << std::endl;
+	} else {
+		/* permute orig to new layout */
+		this->decomposition->permute_TRblocksize(datapreload.get_array(), datavector->get_array(), decomposition->get_xdim(), false);
+	}
+
+	/* other vectors will be prepared after setting the model */
+	this->destroy_gammavector = false;
+	this->destroy_thetavector = false;
+
+	LOG_FUNC_END
+}
+
+template<>
+void ImageData<SeqArrayVector>::saveImage(std::string filename, bool save_original) const{
+	LOG_FUNC_BEGIN
+	
+	Timer timer_saveImage; 
+	timer_saveImage.restart();
+	timer_saveImage.start();
+
+	std::ostringstream oss_name_of_file;
+
+	int xdim = decomposition->get_xdim();
+	int K = decomposition->get_K();
+
+	/* prepare vector to save as a permutation to original layout */
+	GeneralVector<SeqArrayVector> datasave(datavector->size());
+
+	/* save datavector - just for fun; to see if it was loaded in a right way */
+	if(save_original){
+		oss_name_of_file << "results/" << filename << "_original.bin";
+		this->decomposition->permute_TRblocksize(datasave.get_array(), datavector->get_array(), xdim, true);
+		datasave.save_binary(oss_name_of_file.str());
+		oss_name_of_file.str("");
+	}
+
+	/* save gamma, labels of clusters are not available in this backend */
+	if(this->get_save_labels()){
+		coutMaster << "WARNING: labels of clusters are not available for SeqArrayVector, dense gamma is saved" << std::endl;
+	}
+	GeneralVector<SeqArrayVector> gammasave(gammavector->size());
+	oss_name_of_file << "results/" << filename << "_gamma.bin";
+	this->decomposition->permute_TRblocksize(gammasave.get_array(), gammavector->get_array(), K, true);
+	gammasave.save_binary(oss_name_of_file.str());
+	oss_name_of_file.str("");
+
+	/* compute recovered image */
+	GeneralVector<SeqArrayVector> data_recovered(datavector->size());
+	this->compute_recovered(data_recovered);
+
+	/* save recovered data, at first permute it to original layout, datasave can be used */
+	oss_name_of_file << "results/" << filename << "_recovered.bin";
+	this->decomposition->permute_TRblocksize(datasave.get_array(), data_recovered.get_array(), xdim, true);
+	datasave.save_binary(oss_name_of_file.str());
+	oss_name_of_file.str("");
+
+	timer_saveImage.stop();
+	coutAll <<  " - problem saved in: " << timer_saveImage.get_value_sum() << std::endl;
+	coutAll.synchronize();
+	
+	LOG_FUNC_END
+}
+
+
+}
+} /* end namespace */
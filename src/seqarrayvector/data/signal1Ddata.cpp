@@ -0,0 +1,123 @@
+#include "external/seqarrayvector/data/signal1Ddata.h"
+
+namespace pascinference {
+namespace data {
+
+/* from filename, the file is in PETSc binary format */
+template<>
+Signal1DData<SeqArrayVector>::Signal1DData(std::string filename_data){
+	LOG_FUNC_BEGIN
+
+	/* prepare preliminary datavector and load data */
+	this->datavectorpreliminary = new GeneralVector<SeqArrayVector>();
+	this->datavectorpreliminary->load_binary(filename_data);
+
+	/* get the size of the loaded vector */
+	this->Tpreliminary = this->datavectorpreliminary->size();
+
+	/* datavector will be prepared in set_decomposition, other vectors after setting the model */
+	this->datavector = NULL;
+	this->destroy_datavector = false;
+	this->destroy_gammavector = false;
+	this->destroy_thetavector = false;
+
+	LOG_FUNC_END
+}
+
+template<>
+void Signal1DData<SeqArrayVector>::set_decomposition(Decomposition<SeqArrayVector> &new_decomposition) {
+	LOG_FUNC_BEGIN
+
+	this->decomposition = &new_decomposition;
+
+	/* prepare real datavector */
+	this->set_datavector_owned(new GeneralVector<SeqArrayVector>(decomposition->get_T()*decomposition->get_R()*decomposition->get_xdim()));
+
+	/* permute orig to new layout */
+	this->decomposition->permute_TRblocksize(datavectorpreliminary->get_array(), datavector->get_array(), decomposition->get_xdim(), false);
+
+	/* destroy preliminary data */
+	delete this->datavectorpreliminary;
+	this->datavectorpreliminary = NULL;
+
+	LOG_FUNC_END
+}
+
+template<>
+void Signal1DData<SeqArrayVector>::saveSignal1D(std::string filename, bool save_original) const{
+	LOG_FUNC_BEGIN
+
+	Timer timer_saveSignal1D; 
+	timer_saveSignal1D.restart();
+	timer_saveSignal1D.start();
+
+	std::ostringstream oss_name_of_file;
+
+	int xdim = decomposition->get_xdim();
+	int K = decomposition->get_K();
+
+	/* prepare vector to save as a permutation to original layout */
+	GeneralVector<SeqArrayVector> datasave(datavector->size());
+
+	/* save datavector - just for fun; to see if it was loaded in a right way */
+	if(save_original){
+		oss_name_of_file << "results/" << filename << "_original.bin";
+		this->decomposition->permute_TRblocksize(datasave.get_array(), datavector->get_array(), xdim, true);
+		datasave.save_binary(oss_name_of_file.str());
+		oss_name_of_file.str("");
+	}
+
+	/* save gamma, labels of clusters are not available in this backend */
+	if(this->get_save_labels()){
+		coutMaster << "WARNING: labels of clusters are not available for SeqArrayVector, dense gamma is saved" << std::endl;
+	}
+	GeneralVector<SeqArrayVector> gammasave(gammavector->size());
+	oss_name_of_file << "results/" << filename << "_gamma.bin";
+	this->decomposition->permute_TRblocksize(gammasave.get_array(), gammavector->get_array(), K, true);
+	gammasave.save_binary(oss_name_of_file.str());
+	oss_name_of_file.str("");
+
+	/* compute recovered signal */
+	GeneralVector<SeqArrayVector> data_recovered(datavector->size());
+	this->compute_recovered(data_recovered);
+
+	/* save recovered data, at first permute it to original layout, datasave can be used */
+	oss_name_of_file << "results/" << filename << "_recovered.bin";
+	this->decomposition->permute_TRblocksize(datasave.get_array(), data_recovered.get_array(), xdim, true);
+	datasave.save_binary(oss_name_of_file.str());
+	oss_name_of_file.str("");
+
+	timer_saveSignal1D.stop();
+	coutAll <<  " - problem saved in: " << timer_saveSignal1D.get_value_sum() << std::endl;
+	coutAll.synchronize();
+
+	LOG_FUNC_END
+}
+
+template<>
+double Signal1DData<SeqArrayVector>::compute_abserr_reconstructed(GeneralVector<SeqArrayVector> &solution) const {
+	LOG_FUNC_BEGIN	
+
+	/* compute recovered signal */
+	GeneralVector<SeqArrayVector> data_recovered(datavector->size());
+	this->compute_recovered(data_recovered);
+
+	/* compute norm_1(recovered - solution) */
+	const double *recovered_arr = data_recovered.get_array();
+	const double *solution_arr = solution.get_array();
+	int n = data_recovered.size();
+
+	double abserr = 0.0;
+	#pragma omp parallel for reduction(+:abserr) schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		abserr += std::abs(recovered_arr[i] - solution_arr[i]);
+	}
+
+	LOG_FUNC_END
+	
+	return abserr;
+}
+
+
+}
+} /* end namespace */
@@ -0,0 +1,121 @@
+#include "external/seqarrayvector/data/tsdata.h"
+
+namespace pascinference {
+namespace data {
+
+/* no datavector provided - prepare own data vector */
+template<>
+TSData<SeqArrayVector>::TSData(Decomposition<SeqArrayVector> &new_decomposition){
+	LOG_FUNC_BEGIN
+
+	this->decomposition = &new_decomposition;
+
+	/* we are ready to prepare datavector */
+	this->set_datavector_owned(new GeneralVector<SeqArrayVector>(decomposition->get_T()*decomposition->get_R()*decomposition->get_xdim()));
+
+	/* gamma and theta vectors are not given */
+	this->gammavector = NULL;
+	destroy_gammavector = false;
+
+	this->thetavector = NULL;
+	destroy_thetavector = false;
+
+	/* we don't know anything about model */
+	this->tsmodel = NULL;
+
+	/* set initial aic */
+	this->aic_solution = std::numeric_limits<double>::max();
+
+	LOG_FUNC_END
+}
+
+/* destructor, the vectors are owners of their arrays, therefore delete instead of free */
+template<>
+TSData<SeqArrayVector>::~TSData(){
+	LOG_FUNC_BEGIN
+
+	if(this->destroy_datavector){
+		MemoryCheck::owned_remove("TSData", datavector->local_size()*sizeof(double));
+		delete this->datavector;
+	}
+
+	if(this->destroy_gammavector){
+		MemoryCheck::owned_remove("TSData", gammavector->local_size()*sizeof(double));
+		delete this->gammavector;
+	}
+
+	if(this->destroy_thetavector){
+		MemoryCheck::owned_remove("TSData", thetavector->local_size()*sizeof(double));
+		delete this->thetavector;
+	}
+
+	LOG_FUNC_END
+}
+
+template<>
+void TSData<SeqArrayVector>::set_model(TSModel<SeqArrayVector> &tsmodel){
+	LOG_FUNC_BEGIN
+
+	/* set initial content */
+	this->tsmodel = &tsmodel;
+
+	/* prepare new vectors based on model */
+	if(!this->datavector){
+		this->set_datavector_owned(new GeneralVector<SeqArrayVector>(decomposition->get_T()*decomposition->get_R()*decomposition->get_xdim()));
+	}
+
+	if(!this->gammavector){
+		this->gammavector = new GeneralVector<SeqArrayVector>(decomposition->get_T()*decomposition->get_R()*decomposition->get_K());
+		this->destroy_gammavector = true;
+		MemoryCheck::owned_add("TSData", gammavector->local_size()*sizeof(double));
+	}
+
+	if(!this->thetavector){
+		this->thetavector = new GeneralVector<SeqArrayVector>(this->tsmodel->get_thetavectorlength_local());
+		this->destroy_thetavector = true;
+		MemoryCheck::owned_add("TSData", thetavector->local_size()*sizeof(double));
+	}
+
+	LOG_FUNC_END
+}
+
+template<>
+void TSData<SeqArrayVector>::compute_recovered(GeneralVector<SeqArrayVector> &recovered) const {
+	LOG_FUNC_BEGIN
+
+	int K = get_K();
+	int xdim = get_xdim();
+	int R = get_R();
+	int TR = get_T()*R;
+
+	/* the data could be a batch of independent problems, each with its own Theta */
+	int nmb_batch = thetavector->size()/(K*xdim);
+	int Rbatch = (nmb_batch > 1)? R/nmb_batch : R;
+
+	const double *gamma_arr = gammavector->get_array();
+	const double *theta_arr = thetavector->get_array();
+	double *recovered_arr = recovered.get_array();
+
+	#pragma omp parallel for schedule(static) if(TR*K > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int row=0; row < TR; row++){
+		/* row is t*R + r */
+		const double *theta_b = theta_arr;
+		if(nmb_batch > 1){
+			theta_b = &theta_arr[(decomposition->get_invPr(row%R)/Rbatch)*K*xdim];
+		}
+
+		const double *gamma_row = &gamma_arr[row*K];
+		for(int n=0; n < xdim; n++){
+			double value = 0.0;
+			for(int k=0; k < K; k++){
+				value += gamma_row[k]*theta_b[k*xdim + n];
+			}
+			recovered_arr[row*xdim + n] = value;
+		}
+	}
+
+	LOG_FUNC_END
+}
+
+}
+} /* end namespace */
@@ -0,0 +1,370 @@
+#include "external/seqarrayvector/model/graphh1fem.h"
+
+namespace pascinference {
+namespace model {
+
+/* constructor */
+template<>
+GraphH1FEMModel<SeqArrayVector>::GraphH1FEMModel(TSData<SeqArrayVector> &new_tsdata, double epssqr, Fem<SeqArrayVector> *new_fem, bool usethetainpenalty, int nmb_batch) {
+	LOG_FUNC_BEGIN
+
+	// TODO: enum in boost::program_options, not only int
+	int gammasolvertype_int;
+	consoleArg.set_option_value("graphh1femmodel_gammasolvertype", &gammasolvertype_int, SOLVER_AUTO);
+	consoleArg.set_option_value("graphh1femmodel_scalef", &scalef, GRAPHH1FEMMODEL_DEFAULT_SCALEF);
+
+	this->gammasolvertype = static_cast<GammaSolverType>(gammasolvertype_int);
+
+	/* set given parameters */
+	this->usethetainpenalty = usethetainpenalty;
+	this->tsdata = &new_tsdata;
+
+	/* batch of independent problems, each problem has its own Theta */
+	this->nmb_batch = nmb_batch;
+	if(this->nmb_batch < 1 || tsdata->get_R() % this->nmb_batch != 0){
+		coutMaster << "WARNING: R is not divisible by nmb_batch, solving one problem" << std::endl;
+		this->nmb_batch = 1;
+	}
+	if(this->nmb_batch > 1 && this->usethetainpenalty){
+		coutMaster << "WARNING: Theta in penalty is not available for batch of problems, using usethetainpenalty=false" << std::endl;
+		this->usethetainpenalty = false;
+	}
+
+	/* theta vector is local, there is only one process */
+	this->thetavectorlength_local = tsdata->get_K()*tsdata->get_xdim()*this->nmb_batch;
+	this->thetavectorlength_global = this->thetavectorlength_local;
+
+	/* set this model to data - tsdata will prepare gamma vector and thetavector */
+	tsdata->set_model(*this);
+
+	/* control the existence of graph, if there is no graph, then create graph of disjoint nodes without any edge */
+	if(get_graph() == NULL){
+		std::vector<double> coordinates_array(this->tsdata->get_R());
+		for(int r=0;r<this->tsdata->get_R();r++){
+			coordinates_array[r] = r;
+		}
+
+		BGMGraph<SeqArrayVector> *graph = new BGMGraph<SeqArrayVector>(&coordinates_array[0], this->tsdata->get_R(), 1);
+		graph->process(0.0);
+
+		this->tsdata->get_decomposition()->set_graph(*graph);
+	}
+
+	/* prepare parameters and decomposition of reduced problem */
+	if(new_fem == NULL){
+		this->fem = new Fem<SeqArrayVector>(1.0);
+	} else {
+		this->fem = new_fem;
+	}
+
+	this->fem->set_decomposition_original(this->tsdata->get_decomposition());
+	this->fem->compute_decomposition_reduced();
+
+	/* set regularization parameter */
+	this->epssqr = epssqr;
+
+	LOG_FUNC_END
+}
+
+/* print model solution */
+template<>
+void GraphH1FEMModel<SeqArrayVector>::printsolution(ConsoleOutput &output_global, ConsoleOutput &output_local) const {
+	LOG_FUNC_BEGIN
+
+	output_global <<  this->get_name() << std::endl;
+
+	/* give information about presence of the data */
+	output_global <<  "theta:" << std::endl;
+
+	const double *theta = thetadata->get_x()->get_array();
+
+	output_global.push();
+	for(int k=0;k<tsdata->get_K();k++){
+		output_global <<  "- k = " << k << std::endl;
+
+		output_global.push();
+		output_global <<  "- theta = [";
+		for(int n=0;n<tsdata->get_xdim();n++){
+			output_global << theta[k*tsdata->get_xdim() + n];
+			if(n < tsdata->get_xdim()-1){
+				output_global << ", ";
+			}
+		}
+		output_global <<  "]" << std::endl;
+		output_global.pop();
+	}
+	output_global.pop();
+
+	LOG_FUNC_END
+}
+
+/* prepare gamma solver */
+template<>
+void GraphH1FEMModel<SeqArrayVector>::initialize_gammasolver(GeneralSolver **gammasolver){
+	LOG_FUNC_BEGIN
+
+	/* create data */
+	gammadata = new QPData<SeqArrayVector>();
+
+	/* deal with problem reduction */
+	if(fem->is_reduced()){
+		/* there is a reduction, we have to create new reduced gammavector */
+		gammadata->set_x(new GeneralVector<SeqArrayVector>(get_decomposition_reduced()->get_T()*get_decomposition_reduced()->get_R()*get_decomposition_reduced()->get_K()));
+		gammadata->set_x0(gammadata->get_x()); /* the initial approximation of QP problem is gammavector */
+		gammadata->set_b(new GeneralVector<SeqArrayVector>(*gammadata->get_x0())); /* create new linear term of QP problem */
+
+		/* create the residuum from original gamma vector */
+		residuum = new GeneralVector<SeqArrayVector>(*tsdata->get_gammavector());
+
+		MemoryCheck::owned_add("Fem reduced problem", (2*gammadata->get_x()->local_size() + residuum->local_size())*sizeof(double));
+	} else {
+		/* there is not reduction at all, we can use vectors from original data */
+		gammadata->set_x(tsdata->get_gammavector()); /* the solution of QP problem is gamma */
+		gammadata->set_x0(gammadata->get_x()); /* the initial approximation of QP problem is gammavector */
+		gammadata->set_b(new GeneralVector<SeqArrayVector>(*gammadata->get_x0())); /* create new linear term of QP problem */
+
+		/* moreover, for the residuum computation, we can use directly vector b */
+		residuum = gammadata->get_b();
+	}
+
+	/* use old T to scale the function to obtain the same scale of function values */
+	double coeff = this->epssqr;
+	if(scalef){
+		coeff *= (1.0/((double)(this->get_T())));
+	} else {
+		coeff *= ((double)(this->get_T_reduced())/((double)(this->get_T())));
+	}
+
+	if(usethetainpenalty){
+		/* use thetavector as a vector of coefficient for scaling blocks */
+		A_shared = new BlockGraphSparseMatrix<SeqArrayVector>(*(get_decomposition_reduced()), coeff, tsdata->get_thetavector() );
+	} else {
+		/* the vector of coefficient of blocks is set to NULL, therefore Theta will be not used to scale in penalisation */
+		A_shared = new BlockGraphSparseMatrix<SeqArrayVector>(*(get_decomposition_reduced()), coeff, NULL );
+	}
+
+	gammadata->set_A(A_shared);
+
+	/* generate random data to gamma */
+	gammadata->get_x0()->set_random();
+
+	/* only SPG-QP is implemented for this backend */
+	if(this->gammasolvertype != SOLVER_AUTO && this->gammasolvertype != SOLVER_SPGQP){
+		coutMaster << "WARNING: only SPGQP gamma solver is available for SeqArrayVector, using SPGQP" << std::endl;
+	}
+	this->gammasolvertype = SOLVER_SPGQP;
+
+	/* the feasible set of QP is simplex */
+	gammadata->set_feasibleset(new SimplexFeasibleSet_Local<SeqArrayVector>(get_decomposition_reduced()->get_T()*get_decomposition_reduced()->get_R(),get_decomposition_reduced()->get_K()));
+
+	/* create solver */
+	*gammasolver = new SPGQPSolver<SeqArrayVector>(*gammadata);
+
+	LOG_FUNC_END
+}
+
+/* prepare theta solver */
+template<>
+void GraphH1FEMModel<SeqArrayVector>::initialize_thetasolver(GeneralSolver **thetasolver){
+	LOG_FUNC_BEGIN
+
+	/* create data */
+	thetadata = new SimpleData<SeqArrayVector>();
+	thetadata->set_x(tsdata->get_thetavector());
+
+	/* create solver */
+	*thetasolver = new SimpleSolver<SeqArrayVector>(*thetadata);
+
+	/* create aux vector for gamma^T A gamma */
+	Agamma = new GeneralVector<SeqArrayVector>(*tsdata->get_gammavector());
+
+	LOG_FUNC_END
+}
+
+template<>
+void GraphH1FEMModel<SeqArrayVector>::updatebeforesolve_gammasolver(GeneralSolver *gammasolver){
+	LOG_FUNC_BEGIN
+
+	int T = this->tsdata->get_decomposition()->get_T();
+	int R = this->tsdata->get_decomposition()->get_R();
+	int K = this->tsdata->get_decomposition()->get_K();
+	int xdim = this->tsdata->get_decomposition()->get_xdim();
+
+	/* update gamma_solver data - prepare new linear term */
+	const double *theta_arr = tsdata->get_thetavector()->get_array();
+	const double *data_arr = tsdata->get_datavector()->get_array();
+	double *residuum_arr = this->residuum->get_array();
+
+	/* multiplicate vector b by coefficient, if the problem is not reduced, then residuum=b and the scaling is fused with the computation */
+	double coeff = -1.0;
+	if(this->scalef){
+		coeff *= (1.0/((double)(this->get_T_reduced())));
+	}
+	double coeff_residuum = (fem->is_reduced())? 1.0 : coeff;
+
+	/* each node belongs to one problem in batch, the problem has its own Theta */
+	int Rbatch = R/this->nmb_batch;
+
+	if(xdim == 1){
+		#pragma omp parallel for schedule(static) if(T*R*K > SEQARRAYVECTOR_PARALLEL_MIN)
+		for(int tr=0;tr<T*R;tr++){
+			const double *theta_b = &theta_arr[((tr%R)/Rbatch)*K];
+			double x = data_arr[tr];
+			for(int k=0;k<K;k++){
+				residuum_arr[tr*K + k] = coeff_residuum*(x - theta_b[k])*(x - theta_b[k]);
+			}
+		}
+	} else {
+		/* ||x - theta_k||^2 = ||x||^2 - 2*dot(x,theta_k) + ||theta_k||^2, the norms of Theta are computed only once */
+		std::vector<double> theta_norm(this->nmb_batch*K);
+		for(int bk=0;bk<this->nmb_batch*K;bk++){
+			double value = 0.0;
+			for(int n=0;n<xdim;n++){
+				value += theta_arr[bk*xdim+n]*theta_arr[bk*xdim+n];
+			}
+			theta_norm[bk] = value;
+		}
+
+		#pragma omp parallel for schedule(static) if(T*R*K > SEQARRAYVECTOR_PARALLEL_MIN)
+		for(int tr=0;tr<T*R;tr++){
+			int bK = ((tr%R)/Rbatch)*K;
+			const double *x = &data_arr[tr*xdim];
+			const double *theta_b = &theta_arr[bK*xdim];
+
+			double x_norm = 0.0;
+			for(int n=0;n<xdim;n++){
+				x_norm += x[n]*x[n];
+			}
+
+			for(int k=0;k<K;k++){
+				double cross = 0.0;
+				for(int n=0;n<xdim;n++){
+					cross += x[n]*theta_b[k*xdim+n];
+				}
+
+				/* the difference of norms could be slightly negative because of rounding */
+				double value = x_norm - 2.0*cross + theta_norm[bK+k];
+				residuum_arr[tr*K + k] = coeff_residuum*((value > 0.0)? value : 0.0);
+			}
+		}
+	}
+
+	/* coeffs of A_shared are updated via computation of Theta :) */
+
+	/* if the problem is not reduced, then residuum=b, therefore it is not neccessary to perform reduction */
+	if(fem->is_reduced()){
+		this->fem->reduce_gamma(this->residuum, gammadata->get_b());
+		this->fem->reduce_gamma(tsdata->get_gammavector(), gammadata->get_x());
+
+		gammadata->get_b()->scale(coeff);
+	}
+
+	LOG_FUNC_END
+}
+
+template<>
+void GraphH1FEMModel<SeqArrayVector>::updateaftersolve_gammasolver(GeneralSolver *gammasolver){
+	LOG_FUNC_BEGIN
+
+	/* if the problem is not reduced, then gammasolver->x = tsdata->gammavector, therefore it is not neccessary to perform prolongation */
+	if(fem->is_reduced()){
+		this->fem->prolongate_gamma(gammadata->get_x(), tsdata->get_gammavector());
+	}
+
+	LOG_FUNC_END
+}
+
+
+/* update theta solver */
+template<>
+void GraphH1FEMModel<SeqArrayVector>::updatebeforesolve_thetasolver(GeneralSolver *thetasolver){
+	LOG_FUNC_BEGIN
+
+	int T = this->tsdata->get_decomposition()->get_T();
+	int R = this->tsdata->get_decomposition()->get_R();
+	int K = this->tsdata->get_K();
+	int xdim = this->tsdata->get_xdim();
+
+	double *theta_arr = tsdata->get_thetavector()->get_array();
+	const double *gamma_arr = tsdata->get_gammavector()->get_array();
+	const double *data_arr = tsdata->get_datavector()->get_array();
+
+	/* I will use A_shared with coefficients equal to 1, therefore I set Theta=1 */
+	tsdata->get_thetavector()->set(1.0);
+
+	/* now compute A*gamma, only if Theta is in penalty term */
+	const double *Agamma_arr = NULL;
+	if(usethetainpenalty){
+		A_shared->matmult(*Agamma, *(tsdata->get_gammavector()));
+		Agamma_arr = Agamma->get_array();
+	}
+
+	/* gammakx, gammaksum and gammakAgammak for all clusters of all problems in batch in one pass through gamma */
+	int BK = this->nmb_batch*K;
+	int Rbatch = R/this->nmb_batch;
+
+	std::vector<double> sums(BK*(xdim+2), 0.0);
+	double *gammakx = &sums[0];
+	double *gammaksum = &sums[BK*xdim];
+	double *gammakAgammak = &sums[BK*xdim + BK];
+
+	#pragma omp parallel if(T*R*K > SEQARRAYVECTOR_PARALLEL_MIN)
+	{
+		std::vector<double> sums_local(BK*(xdim+2), 0.0);
+
+		#pragma omp for schedule(static)
+		for(int tr=0;tr<T*R;tr++){
+			int bK = ((tr%R)/Rbatch)*K;
+			for(int k=0;k<K;k++){
+				double gamma_value = gamma_arr[tr*K+k];
+				for(int n=0;n<xdim;n++){
+					sums_local[(bK+k)*xdim+n] += gamma_value*data_arr[tr*xdim+n];
+				}
+				sums_local[BK*xdim + bK + k] += gamma_value;
+				if(Agamma_arr){
+					sums_local[BK*xdim + BK + bK + k] += gamma_value*Agamma_arr[tr*K+k];
+				}
+			}
+		}
+
+		#pragma omp critical
+		{
+			for(int i=0;i<BK*(xdim+2);i++){
+				sums[i] += sums_local[i];
+			}
+		}
+	}
+
+	double coeff = 1.0;
+
+	for(int k=0;k<BK;k++){
+		double denominator;
+		if(usethetainpenalty){
+			/* only if Theta is in penalty term */
+			denominator = coeff*gammaksum[k] + 0.5*gammakAgammak[k];
+		} else {
+			/* if Theta is not in penalty term, then the computation is based on kmeans */
+			denominator = gammaksum[k];
+		}
+
+		for(int n=0;n<xdim;n++){
+			if(denominator != 0){
+				theta_arr[k*xdim+n] = (coeff*gammakx[k*xdim+n])/denominator;
+			} else {
+				theta_arr[k*xdim+n] = 0.0;
+			}
+		}
+	}
+
+	LOG_FUNC_END
+}
+
+template<>
+void GraphH1FEMModel<SeqArrayVector>::updateaftersolve_thetasolver(GeneralSolver *thetasolver){
+	LOG_FUNC_BEGIN
+
+	LOG_FUNC_END
+}
+
+}
+} /* end namespace */
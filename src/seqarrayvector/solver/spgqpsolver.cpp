@@ -0,0 +1,322 @@
+#include "external/seqarrayvector/solver/spgqpsolver.h"
+
+namespace pascinference {
+namespace solver {
+
+template<>
+std::string SPGQPSolver<SeqArrayVector>::get_name() const {
+	return "SPGQPSolver for SeqArrayVector";
+}
+
+/* prepare temp_vectors */
+template<>
+void SPGQPSolver<SeqArrayVector>::allocate_temp_vectors(){
+	LOG_FUNC_BEGIN
+
+	GeneralVector<SeqArrayVector> *pattern = qpdata->get_b(); /* I will allocate temp vectors subject to linear term */
+
+	g = new GeneralVector<SeqArrayVector>(*pattern);
+	d = new GeneralVector<SeqArrayVector>(*pattern);
+	Ad = new GeneralVector<SeqArrayVector>(*pattern);
+	temp = new GeneralVector<SeqArrayVector>(*pattern);
+
+	/* dot products are computed in one pass, see compute_dots */
+	Mdots_val = NULL;
+	externalcontent = NULL;
+
+	LOG_FUNC_END
+}
+
+/* destroy temp_vectors */
+template<>
+void SPGQPSolver<SeqArrayVector>::free_temp_vectors(){
+	LOG_FUNC_BEGIN
+
+	delete g;
+	delete d;
+	delete Ad;
+	delete temp;
+
+	LOG_FUNC_END
+}
+
+/* solve the problem */
+template<>
+void SPGQPSolver<SeqArrayVector>::solve() {
+	LOG_FUNC_BEGIN
+
+	GeneralMatrix<SeqArrayVector> *A = qpdata->get_A();
+	GeneralVector<SeqArrayVector> *b = qpdata->get_b();
+	GeneralVector<SeqArrayVector> *x = qpdata->get_x();
+	GeneralVector<SeqArrayVector> *x0 = qpdata->get_x0();
+
+	int n = x->size();
+	double *x_arr = x->get_array();
+	double *g_arr = this->g->get_array();
+	double *d_arr = this->d->get_array();
+	const double *Ad_arr = this->Ad->get_array();
+
+	this->timer_solve.start(); /* stop this timer in the end of solution */
+
+	int it = 0; /* number of iterations */
+	int hessmult = 0; /* number of hessian multiplications */
+
+	double fx; /* function value */
+	double fx_old; /* f(x_{it - 1}) */
+	SPG_fs fs(this->m); /* store function values for generalized Armijo condition */
+	double fx_max; /* max(fs) */
+	double xi, beta_bar, beta_hat, beta; /* for Armijo condition */
+	double dd; /* dot(d,d) */
+	double gd; /* dot(g,d) */
+	double dAd; /* dot(Ad,d) */
+	double alpha_bb; /* BB step-size */
+	double normb = norm(*b); /* norm of linear term used in stopping criteria */
+
+	/* initial step-size, continue with the last one if it is possible */
+	alpha_bb = get_alphainit();
+	if(this->warmstart && this->alpha_bb_last > 0 && this->alpha_bb_last < std::numeric_limits<double>::max()){
+		alpha_bb = this->alpha_bb_last;
+	}
+
+	/* x = x0; set approximation as initial */
+	*x = *x0;
+
+	this->timer_projection.start();
+	 qpdata->get_feasibleset()->project(*x); /* project initial approximation to feasible set */
+	this->timer_projection.stop();
+
+	/* compute gradient, g = A*x-b */
+	this->timer_matmult.start();
+	 A->matmult(*(this->g), *x);
+	 hessmult += 1; /* there was muliplication by A */
+	this->timer_matmult.stop();
+
+	*(this->g) -= *b;
+
+	/* initialize fs */
+	this->timer_fs.start();
+	 fx = get_fx();
+	 fx_old = std::numeric_limits<double>::max();
+	 this->fx = fx;
+	 fs.init(fx);
+	this->timer_fs.stop();
+
+	/* main cycle */
+	while(it < this->maxit){
+		/* increase iteration counter */
+		it += 1;
+
+		/* d = x - alpha_bb*g, see next step, it will be d = P(x - alpha_bb*g) - x */
+		this->timer_update.start();
+		 #pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+		 for(int i=0;i<n;i++){
+			d_arr[i] = x_arr[i] - alpha_bb*g_arr[i];
+		 }
+		this->timer_update.stop();
+
+		/* d = P(d) */
+		this->timer_projection.start();
+		 qpdata->get_feasibleset()->project(*(this->d));
+		this->timer_projection.stop();
+
+		/* d = d - x */
+		this->timer_update.start();
+		 *(this->d) -= *x;
+		this->timer_update.stop();
+
+		/* Ad = A*d */
+		this->timer_matmult.start();
+		 A->matmult(*(this->Ad), *(this->d));
+		 hessmult += 1;
+		this->timer_matmult.stop();
+
+		this->timer_dot.start();
+		 compute_dots(&dd, &dAd, &gd);
+		this->timer_dot.stop();
+
+		/* fx_max = max(fs) */
+		this->timer_fs.start();
+		 fx_max = fs.get_max();
+		this->timer_fs.stop();
+
+		/* compute step-size from A-condition */
+		this->timer_stepsize.start();
+		 xi = (fx_max - fx)/dAd;
+		 beta_bar = -gd/dAd;
+		 beta_hat = this->gamma*beta_bar + sqrt(this->gamma*this->gamma*beta_bar*beta_bar + 2*xi);
+
+		 /* beta = max(sigma1,min(sigma2,beta_hat)) */
+		 if(beta_hat < this->sigma1){
+			 beta_hat = this->sigma1;
+		 }
+
+		 if(beta_hat < this->sigma2){
+			beta = beta_hat;
+		 } else {
+			beta = this->sigma2;
+		 }
+		this->timer_stepsize.stop();
+
+		/* x = x + beta*d; g = g + beta*Ad; update approximation and gradient in one pass */
+		this->timer_update.start();
+		 #pragma omp parallel for simd schedule(static) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+		 for(int i=0;i<n;i++){
+			x_arr[i] += beta*d_arr[i];
+			g_arr[i] += beta*Ad_arr[i];
+		 }
+		this->timer_update.stop();
+
+		/* compute new function value using gradient and update fs list */
+		this->timer_fs.start();
+		 fx_old = fx;
+		 fx = get_fx();
+		 fs.update(fx);
+		this->timer_fs.stop();
+
+		/* update BB step-size */
+		this->timer_stepsize.start();
+		 alpha_bb = dd/dAd;
+		this->timer_stepsize.stop();
+
+		this->gP = dd;
+
+		/* print progress of algorithm */
+		if(debug_print_it){
+			coutMaster << "\033[33m   it = \033[0m" << it;
+
+			std::streamsize ss = std::cout.precision();
+			coutMaster << ", \t\033[36mfx = \033[0m" << std::setprecision(17) << fx << std::setprecision(ss);
+
+			coutMaster << ", \t\033[36mgP = \033[0m" << this->gP;
+			coutMaster << ", \t\033[36mdd = \033[0m" << dd << std::endl;
+
+			/* log function value */
+			LOG_FX(fx)
+
+		}
+
+		if(debug_print_scalars){
+			coutMaster << "\033[36m    alpha_bb = \033[0m" << alpha_bb << ",";
+			coutMaster << "\033[36m dAd = \033[0m" << dAd << ",";
+			coutMaster << "\033[36m gd = \033[0m" << gd << std::endl;
+
+			coutMaster << "\033[36m    fx = \033[0m" << fx << ",";
+			coutMaster << "\033[36m fx_max = \033[0m" << fx_max << ",";
+			coutMaster << "\033[36m xi = \033[0m" << xi << std::endl;
+
+			coutMaster << "\033[36m    beta_bar = \033[0m" << beta_bar << ",";
+			coutMaster << "\033[36m beta_hat = \033[0m" << beta_hat << ",";
+			coutMaster << "\033[36m beta = \033[0m" << beta << std::endl;
+
+		}
+
+		/* stopping criteria */
+		if( this->stop_difff && std::abs(fx - fx_old) < this->eps){
+			break;
+		}
+		if(this->stop_normgp && dd < this->eps){
+			break;
+		}
+		if(this->stop_normgp_normb && dd < this->eps*normb){
+			break;
+		}
+		if(this->stop_Anormgp && dAd < this->eps){
+			break;
+		}
+		if(this->stop_Anormgp_normb && dAd < this->eps*normb){
+			break;
+		}
+
+		/* monitor - export values of stopping criteria */
+		if(this->monitor){
+			std::ofstream myfile;
+			myfile.open("log/spgqpsolver_monitor.m", std::fstream::in | std::fstream::out | std::fstream::app);
+
+			std::streamsize ss = myfile.precision();
+			myfile << std::setprecision(17);
+
+			myfile << "fx(" << it << ") = " << fx << "; ";
+			myfile << "alpha_bb(" << it << ") = " << alpha_bb << "; ";
+			myfile << "beta(" << it << ") = " << beta << "; ";
+			myfile << "norm_difff(" << it << ") = " << std::abs(fx - fx_old) << "; ";
+			myfile << "norm_gp(" << it << ") = " << dd << "; ";
+			myfile << "norm_Agp(" << it << ") = " << dAd << "; ";
+			myfile << std::endl;
+
+			myfile << std::setprecision(ss);
+			myfile.close();
+		}
+
+	} /* main cycle end */
+
+	this->it_sum += it;
+	this->hessmult_sum += hessmult;
+	this->it_last = it;
+	this->hessmult_last = hessmult;
+
+	/* store the state for next solution and checkpoints */
+	this->alpha_bb_last = alpha_bb;
+	fs.get_values(&(this->fs_last[0]));
+
+	this->fx = fx;
+	this->timer_solve.stop();
+
+	/* write info to log file */
+	LOG_IT(it)
+	LOG_FX(fx)
+
+	LOG_FUNC_END
+}
+
+/* compute function value using inner *x and already computed *g */
+template<>
+double SPGQPSolver<SeqArrayVector>::get_fx() const {
+	LOG_FUNC_BEGIN
+
+	/* fx = 0.5*dot(g - b, x) in one pass without temp vector */
+	const double *x_arr = qpdata->get_x()->get_array();
+	const double *b_arr = qpdata->get_b()->get_array();
+	const double *g_arr = this->g->get_array();
+	int n = this->g->size();
+
+	double tempt = 0.0;
+	#pragma omp parallel for simd schedule(static) reduction(+:tempt) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		tempt += (g_arr[i] - b_arr[i])*x_arr[i];
+	}
+
+	double fx = 0.5*tempt;
+
+	LOG_FUNC_END
+	return fx;
+}
+
+template<>
+void SPGQPSolver<SeqArrayVector>::compute_dots(double *dd, double *dAd, double *gd) const {
+	LOG_FUNC_BEGIN
+
+	/* all three dot products with d in one pass */
+	const double *d_arr = this->d->get_array();
+	const double *Ad_arr = this->Ad->get_array();
+	const double *g_arr = this->g->get_array();
+	int n = this->d->size();
+
+	double dd_value = 0.0;
+	double dAd_value = 0.0;
+	double gd_value = 0.0;
+	#pragma omp parallel for simd schedule(static) reduction(+:dd_value,dAd_value,gd_value) if(n > SEQARRAYVECTOR_PARALLEL_MIN)
+	for(int i=0;i<n;i++){
+		dd_value += d_arr[i]*d_arr[i];
+		dAd_value += Ad_arr[i]*d_arr[i];
+		gd_value += g_arr[i]*d_arr[i];
+	}
+
+	*dd = dd_value;
+	*dAd = dAd_value;
+	*gd = gd_value;
+
+	LOG_FUNC_END
+}
+
+}
+}
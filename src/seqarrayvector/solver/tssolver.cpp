@@ -0,0 +1,34 @@
+#include "external/seqarrayvector/solver/tssolver.h"
+
+namespace pascinference {
+namespace solver {
+
+template<>
+void TSSolver<SeqArrayVector>::gammavector_permute() const{
+	LOG_FUNC_BEGIN
+
+	/* store permuted values into new vector */
+	GeneralVector<SeqArrayVector> gammavector_new(tsdata->get_gammavector()->size());
+	this->tsdata->get_decomposition()->permute_TRblocksize(tsdata->get_gammavector()->get_array(), gammavector_new.get_array(), tsdata->get_K(), false);
+
+	/* copy values to original vector */
+	*(tsdata->get_gammavector()) = gammavector_new;
+
+	LOG_FUNC_END
+}
+
+template<>
+void TSSolver<SeqArrayVector>::set_solution_theta(double *Theta) {
+	LOG_FUNC_BEGIN
+
+	double *theta_arr = tsdata->get_thetavector()->get_array();
+	for(int k=0;k<this->model->get_thetavectorlength_local();k++){
+		theta_arr[k] = Theta[k];
+	}
+
+	this->thetasolved = true;
+	LOG_FUNC_END
+}
+
+}
+} /* end namespace */